@@ -25,40 +25,40 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 #include "FEDomainShapeInterpolator.h"
 #include <FECore/FESolidDomain.h>
-#include <FECore/FEOctreeSearch.h>
+#include <FECore/FEMesh.h>
 
 FEDomainShapeInterpolator::FEDomainShapeInterpolator(FEDomain* domain)
 {
 	m_dom = domain;
 	m_mesh = m_dom->GetMesh();
-	m_os = nullptr;
-}
-
-FEDomainShapeInterpolator::~FEDomainShapeInterpolator()
-{
-	delete m_os;
 }
 
 bool FEDomainShapeInterpolator::Init()
 {
 	if (m_mesh == nullptr) return false;
 
-	if (m_os == nullptr)
-	{
-		m_os = new FEOctreeSearch(m_dom);
-		if (m_os->Init() == false) return false;
-	}
+	// find the elements of all the target points (in the reference configuration)
+	vector<FESolidElement*> el;
+	vector<vec3d> r;
+	m_mesh->FindSolidElements(m_trgPoints, el, r, true);
 
 	int nodes = m_trgPoints.size();
 	m_data.resize(nodes);
 	for (int i = 0; i < nodes; ++i)
 	{
 		Data& di = m_data[i];
-		vec3d ri = m_trgPoints[i];
+		di.el = el[i];
+		di.r[0] = r[i].x;
+		di.r[1] = r[i].y;
+		di.r[2] = r[i].z;
+
+		// points on the boundary of the domain may have been found in a neighboring domain
+		if ((di.el == nullptr) || (di.el->GetMeshPartition() != m_dom))
+		{
+			di.r[0] = di.r[1] = di.r[2] = 0.0;
+			di.el = m_mesh->FindReferenceSolidElement(m_trgPoints[i], di.r, m_dom);
+		}
 
-		// find the element
-		di.r[0] = di.r[1] = di.r[2] = 0.0;
-		di.el = (FESolidElement*)m_os->FindElement(ri, di.r);
 		if (di.el == nullptr)
 		{
 			assert(false);
@@ -29,7 +29,6 @@ SOFTWARE.*/
 class FEDomain;
 class FESolidElement;
 class FEMesh;
-class FEOctreeSearch;
 
 //! Maps data by using element shape functions
 class FEDomainShapeInterpolator : public FEMeshDataInterpolator
@@ -42,7 +41,6 @@ class FEDomainShapeInterpolator : public FEMeshDataInterpolator
 
 public:
 	FEDomainShapeInterpolator(FEDomain* domain);
-	~FEDomainShapeInterpolator();
 
 	bool Init() override;
 
@@ -58,7 +56,6 @@ private:
 	FEDomain*	m_dom;
 	FEMesh*	m_mesh;
 
-	FEOctreeSearch*	m_os;
 	vector<vec3d>	m_trgPoints;
 	vector<Data>	m_data;
 };
@@ -24,45 +24,36 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 #include "FEMeshShapeInterpolator.h"
-#include <FECore/FEOctreeSearch.h>
 #include <FECore/FEMesh.h>
 
 //=============================================================================================
 FEMeshShapeInterpolator::FEMeshShapeInterpolator(FEMesh* mesh) : m_mesh(mesh)
 {
-	m_os = nullptr;
-}
-
-FEMeshShapeInterpolator::~FEMeshShapeInterpolator()
-{
-	delete m_os;
 }
 
 bool FEMeshShapeInterpolator::Init()
 {
 	if (m_mesh == nullptr) return false;
 
-	if (m_os == nullptr)
-	{
-		m_os = new FEOctreeSearch(m_mesh);
-		if (m_os->Init() == false) return false;
-	}
+	// find the elements of all the target points (in the reference configuration)
+	vector<FESolidElement*> el;
+	vector<vec3d> r;
+	m_mesh->FindSolidElements(m_trgPoints, el, r, true);
 
 	int nodes = m_trgPoints.size();
 	m_data.resize(nodes);
 	for (int i = 0; i < nodes; ++i)
 	{
 		Data& di = m_data[i];
-		vec3d ri = m_trgPoints[i];
-
-		// find the element
-		di.r[0] = di.r[1] = di.r[2] = 0.0;
-		di.el = (FESolidElement*)m_os->FindElement(ri, di.r);
+		di.el = el[i];
 		if (di.el == nullptr)
 		{
 			assert(false);
 			return false;
 		}
+		di.r[0] = r[i].x;
+		di.r[1] = r[i].y;
+		di.r[2] = r[i].z;
 	}
 
 	return true;
@@ -28,7 +28,6 @@ SOFTWARE.*/
 
 //=======================================================================================
 class FEMesh;
-class FEOctreeSearch;
 class FESolidElement;
 
 //! Interpolates data by using the element shape functions
@@ -42,7 +41,6 @@ class FEMeshShapeInterpolator : public FEMeshDataInterpolator
 
 public:
 	FEMeshShapeInterpolator(FEMesh* mesh);
-	~FEMeshShapeInterpolator();
 
 	bool Init() override;
 
@@ -56,7 +54,6 @@ public:
 
 private:
 	FEMesh*	m_mesh;
-	FEOctreeSearch*	m_os;
 	vector<vec3d>	m_trgPoints;
 	vector<Data>	m_data;
 };
@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include "breakpoint.h"
 #include <FEBioLib/febio.h>
 #include <FEBioLib/version.h>
+#include <FEBioXML/FEBModelCache.h>
 #include "febio_cb.h"
 #include "Interrupt.h"
 #include "ping.h"
@@ -162,6 +163,8 @@ int FEBioApp::RunModel()
 	// set options that were passed on the command line
 	fem.SetDebugLevel(m_ops.ndebug);
 	fem.SetDumpLevel(m_ops.dumpLevel);
+	fem.SetModelCacheMode(m_ops.cacheMode);
+	if (m_ops.bprofile) fem.SetProfileFilename(m_ops.szprof);
 
 	// set the output filenames
 	fem.SetLogFilename(m_ops.szlog);
@@ -241,6 +244,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 	bool blog = false;
 	bool bplt = false;
 	bool bdmp = false;
+	bool bprf = false;
 	bool brun = true;
 
 	// initialize file names
@@ -251,6 +255,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 	ops.sztask[0] = 0;
 	ops.szctrl[0] = 0;
 	ops.szimp[0] = 0;
+	ops.szprof[0] = 0;
 
 	// set initial configuration file name
 	if (ops.szcnf[0] == 0)
@@ -306,6 +311,42 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 				}
 			}
 		}
+		else if (strncmp(sz, "-cache", 6) == 0)
+		{
+			// -cache is the same as -cache=use
+			ops.cacheMode = FEBModelCache::USE_CACHE;
+			if (sz[6] == '=')
+			{
+				const char* szmode = sz + 7;
+				if      (strcmp(szmode, "use"   ) == 0) ops.cacheMode = FEBModelCache::USE_CACHE;
+				else if (strcmp(szmode, "create") == 0) ops.cacheMode = FEBModelCache::CREATE_CACHE;
+				else if (strcmp(szmode, "ignore") == 0) ops.cacheMode = FEBModelCache::IGNORE_CACHE;
+				else
+				{
+					fprintf(stderr, "FATAL ERROR: invalid cache mode.\n");
+					return false;
+				}
+			}
+			else if (sz[6] != 0)
+			{
+				fprintf(stderr, "FATAL ERROR: Invalid command line option.\n");
+				return false;
+			}
+		}
+		else if (strcmp(sz, "-profile") == 0)
+		{
+			ops.bprofile = true;
+			if (i<nargs - 1)
+			{
+				char* szi = argv[i + 1];
+				if (szi[0] != '-')
+				{
+					// assume this is the name of the trace file
+					strcpy(ops.szprof, argv[++i]);
+					bprf = true;
+				}
+			}
+		}
 		else if (strcmp(sz, "-o") == 0)
 		{
 			blog = true;
@@ -363,6 +404,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 		{
 			if (sz[5] != '=') { fprintf(stderr, "command line error when parsing task\n"); return false; }
 			strcpy(ops.sztask, sz+6);
+			ops.binteractive = false;
 
 			if (i<nargs-1)
 			{
@@ -472,6 +514,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 		if (!blog) sprintf(ops.szlog, "%s.log", szlogbase);
 		if (!bplt) sprintf(ops.szplt, "%s.xplt", szbase);
 		if (!bdmp) sprintf(ops.szdmp, "%s.dmp", szbase);
+		if (!bprf) sprintf(ops.szprof, "%s_trace.json", szlogbase);
 	}
 	else if (ops.szctrl[0])
 	{
@@ -483,6 +526,7 @@ bool FEBioApp::ParseCmdLine(int nargs, char* argv[])
 		if (!blog) sprintf(ops.szlog, "%s.log", szbase);
 		if (!bplt) sprintf(ops.szplt, "%s.xplt", szbase);
 		if (!bdmp) sprintf(ops.szdmp, "%s.dmp", szbase);
+		if (!bprf) sprintf(ops.szprof, "%s_trace.json", szbase);
 	}
 
 	return brun;
@@ -40,6 +40,8 @@ struct CMDOPTIONS
 	bool	binteractive;		//!< start FEBio interactively
 
 	int		dumpLevel;		//!< requested restart level
+	int		cacheMode;		//!< model cache mode (0 = ignore, 1 = use, 2 = create)
+	bool	bprofile;		//!< enable the profiler
 
 	char	szfile[MAXFILE];	//!< model input file name
 	char	szlog[MAXFILE];	//!< log file name
@@ -49,6 +51,7 @@ struct CMDOPTIONS
 	char	sztask[MAXFILE];	//!< task name
 	char	szctrl[MAXFILE];	//!< control file for tasks
 	char	szimp[MAXFILE];		//!< import file
+	char	szprof[MAXFILE];	//!< profiler trace file
 
 	CMDOPTIONS()
 	{
@@ -62,6 +65,8 @@ struct CMDOPTIONS
 		bsilent = false;
 		binteractive = false;
 		dumpLevel = 0;
+		cacheMode = 0;
+		bprofile = false;
 
 		szfile[0] = 0;
 		szlog[0] = 0;
@@ -71,5 +76,6 @@ struct CMDOPTIONS
 		sztask[0] = 0;
 		szctrl[0] = 0;
 		szimp[0] = 0;
+		szprof[0] = 0;
 	}
 };
@@ -333,7 +333,7 @@ void FEMultiphasicFSIDomain3D::UnpackLM(FEElement& el, vector<int>& lm)
     for (int i=0; i<N; ++i)
     {
         FENode& node = m_pMesh->Node(el.m_node[i]);
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[ndpn*i  ] = id[m_dofU[0]];
@@ -361,7 +361,7 @@ void FEMultiphasicFSIDomain3D::UnpackLM(FEElement& el, vector<int>& lm)
     {
         if (sel.m_bitfc[i]) {
             FENode& node = m_pMesh->Node(el.m_node[i]);
-            vector<int>& id = node.m_ID;
+            FENodeDofArray<int>& id = node.m_ID;
             
             // first the displacement dofs
             lm[ndpn*i  ] = id[m_dofSU[0]];
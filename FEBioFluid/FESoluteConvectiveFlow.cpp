@@ -66,8 +66,6 @@ bool FESoluteConvectiveFlow::Init()
     if ((m_sol < 1) || (m_sol > MAX_CDOFS)) return false;
     
     FEMesh& mesh = fem.GetMesh();
-    m_octree = new FEOctreeSearch(&mesh);
-    m_octree->Init();
     
     FESurface* ps = &GetSurface();
     m_np = new FENormalProjection(*ps);
@@ -110,6 +108,9 @@ void FESoluteConvectiveFlow::Update()
     FEModel& fem = *GetFEModel();
     FEMesh& mesh = fem.GetMesh();
     
+    // find the upstream points of all nodes
+    vector<int> nodeList;
+    vector<vec3d> X;
     for (int i=0; i<mesh.Nodes(); ++i)
     {
         if (!m_bexclude[i]) {
@@ -118,54 +119,65 @@ void FESoluteConvectiveFlow::Update()
             vec3d vt = node.get_vec3d(m_dofW[0], m_dofW[1], m_dofW[2]);
             vec3d vp = node.get_vec3d_prev(m_dofW[0], m_dofW[1], m_dofW[2]);
             
-            vec3d X = x - (vt*m_gamma + vp*(1-m_gamma))*m_dt;
-            
-            int dofc = m_dofC + m_sol - 1;
-            double r[3] = { 0 };
-            double c = 0;
-            
-            // search for the solid element in which X lies
-            FESolidElement* el = (FESolidElement*)m_octree->FindElement(X, r);
-            if (el) {
-                const int NELN = FESolidElement::MAX_NODES;
+            nodeList.push_back(i);
+            X.push_back(x - (vt*m_gamma + vp*(1-m_gamma))*m_dt);
+        }
+    }
+    
+    // search for the solid elements in which the points X lie
+    vector<FESolidElement*> elem;
+    vector<vec3d> q;
+    mesh.FindSolidElements(X, elem, q, true);
+    
+    for (int k=0; k<(int)nodeList.size(); ++k)
+    {
+        FENode& node = mesh.Node(nodeList[k]);
+        vec3d x = node.m_rt;
+        
+        int dofc = m_dofC + m_sol - 1;
+        double r[3] = { q[k].x, q[k].y, q[k].z };
+        double c = 0;
+        
+        FESolidElement* el = elem[k];
+        if (el) {
+            const int NELN = FESolidElement::MAX_NODES;
+            double ep[NELN], cp[NELN];
+            int neln = el->Nodes();
+            for (int j=0; j<neln; ++j) {
+                FENode& node = mesh.Node(el->m_node[j]);
+                ep[j] = node.get_prev(m_dofEF);
+                cp[j] = node.get_prev(dofc);
+            }
+            double Jt = 1 + node.get(m_dofEF);
+            double Jp = 1 + el->evaluate(ep, r[0], r[1], r[2]);
+            c = Jp*el->evaluate(cp, r[0], r[1], r[2])/Jt;
+        }
+        // if solid element is not found, project x onto the solute inlet surface
+        else {
+            vec2d r2;
+            FESurfaceElement* pme;
+            vec3d n = x - X[k];
+            n.unit();
+            pme = m_np->Project(x, n, r);
+            if (pme) {
+                const int NELN = FEShellElement::MAX_NODES;
                 double ep[NELN], cp[NELN];
-                int neln = el->Nodes();
+                int neln = pme->Nodes();
                 for (int j=0; j<neln; ++j) {
-                    FENode& node = mesh.Node(el->m_node[j]);
-                    ep[j] = node.get_prev(m_dofEF);
-                    cp[j] = node.get_prev(dofc);
+                    FENode& mode = mesh.Node(pme->m_node[j]);
+                    ep[j] = mode.get_prev(m_dofEF);
+                    cp[j] = mode.get_prev(dofc);
                 }
                 double Jt = 1 + node.get(m_dofEF);
-                double Jp = 1 + el->evaluate(ep, r[0], r[1], r[2]);
-                c = Jp*el->evaluate(cp, r[0], r[1], r[2])/Jt;
+                double Jp = 1 + pme->eval(ep, r[0], r[1]);
+                c = Jp*pme->eval(cp, r[0], r[1])/Jt;
             }
-            // if solid element is not found, project x onto the solute inlet surface
-            else {
-                vec2d r2;
-                FESurfaceElement* pme;
-                vec3d n = x - X;
-                n.unit();
-                pme = m_np->Project(x, n, r);
-                if (pme) {
-                    const int NELN = FEShellElement::MAX_NODES;
-                    double ep[NELN], cp[NELN];
-                    int neln = pme->Nodes();
-                    for (int j=0; j<neln; ++j) {
-                        FENode& mode = mesh.Node(pme->m_node[j]);
-                        ep[j] = mode.get_prev(m_dofEF);
-                        cp[j] = mode.get_prev(dofc);
-                    }
-                    double Jt = 1 + node.get(m_dofEF);
-                    double Jp = 1 + pme->eval(ep, r[0], r[1]);
-                    c = Jp*pme->eval(cp, r[0], r[1])/Jt;
-                }
-                else
-                    c = node.get_prev(dofc);
-            }
-            
-            if (node.m_ID[dofc] < -1)
-                node.set(dofc, c);
+            else
+                c = node.get_prev(dofc);
         }
+        
+        if (node.m_ID[dofc] < -1)
+            node.set(dofc, c);
     }
 }
 
@@ -28,7 +28,6 @@ SOFTWARE.*/
 
 #pragma once
 #include <FECore/FESurfaceLoad.h>
-#include <FECore/FEOctreeSearch.h>
 #include "FECore/FENormalProjection.h"
 #include "febiofluid_api.h"
 
@@ -70,7 +69,6 @@ private:
     double      m_dt;
     vector<bool>    m_bexclude;
     FENormalProjection* m_np;
-    FEOctreeSearch* m_octree;
     
     DECLARE_FECORE_CLASS();
 };
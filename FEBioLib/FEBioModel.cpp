@@ -57,15 +57,17 @@ SOFTWARE.*/
 #include <FECore/FEDomain.h>
 #include <FECore/FEMaterial.h>
 #include <FECore/FEPlotDataStore.h>
+#include <FECore/FEMemoryReport.h>
+#include <FECore/FEProfiler.h>
 #include "febio.h"
 #include "version.h"
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <algorithm>
 
-#ifdef WIN32
 size_t FEBIOLIB_API GetPeakMemory();	// in memory.cpp
-#endif
+size_t FEBIOLIB_API GetCurrentMemory();	// in memory.cpp
 
 //-----------------------------------------------------------------------------
 BEGIN_FECORE_CLASS(FEBioModel, FEMechModel)
@@ -106,6 +108,7 @@ FEBioModel::FEBioModel()
 	m_logLevel = 1;
 
 	m_dumpLevel = FE_DUMP_NEVER;
+	m_cacheMode = FEBModelCache::IGNORE_CACHE;
 
 	// --- I/O-Data ---
 	m_ndebug = 0;
@@ -165,6 +168,16 @@ int FEBioModel::GetDumpLevel() const { return m_dumpLevel; }
 //! Set the log level
 void FEBioModel::SetLogLevel(int logLevel) { m_logLevel = logLevel; }
 
+//! set the model cache mode
+void FEBioModel::SetModelCacheMode(int mode) { m_cacheMode = mode; }
+
+//! set the profiler trace file
+void FEBioModel::SetProfileFilename(const std::string& sfile)
+{
+	m_sprofile = sfile;
+	GetProfiler()->Enable(sfile.empty() == false);
+}
+
 //-----------------------------------------------------------------------------
 //! Set the title of the model
 void FEBioModel::SetTitle(const char* sz)
@@ -305,6 +318,7 @@ bool FEBioModel::Input(const char* szfile)
 
 	// create file reader
 	FEBioImport fim;
+	fim.SetModelCacheMode(m_cacheMode);
 
 	feLog("Reading file %s ...", szfile);
 
@@ -320,6 +334,20 @@ bool FEBioModel::Input(const char* szfile)
 	}
 	else feLog("SUCCESS!\n");
 
+	// report on the model cache
+	if (fim.MeshFromCache())
+	{
+		const FEBModelCache& cache = fim.ModelCache();
+		double tread = fim.MeshReadTime();
+		double tparse = cache.ParseTime();
+		feLog("Mesh read from cache %s (%lg sec, saved %lg sec)\n", cache.CacheFile().c_str(), tread, tparse - tread);
+	}
+	else if (fim.CacheCreated())
+	{
+		const FEBModelCache& cache = fim.ModelCache();
+		feLog("Mesh cache %s created (mesh read in %lg sec)\n", cache.CacheFile().c_str(), fim.MeshReadTime());
+	}
+
 	// set the input file name
 	SetInputFilename(szfile);
 
@@ -595,6 +623,9 @@ void FEBioModel::DumpData(int nevent)
 	if ((nevent == CB_MAJOR_ITERS) && (ndump == FE_DUMP_MAJOR_ITRS)) bdump = true;
 	if (bdump)
 	{
+		// make sure the plot file is up to date with the restart point
+		if (m_plot) m_plot->Flush();
+
 		DumpFile ar(*this);
 		if (ar.Create(m_sdump.c_str()) == false)
 		{
@@ -1484,6 +1515,108 @@ bool FEBioModel::Reset()
 //                               S O L V E
 //=============================================================================
 
+//-----------------------------------------------------------------------------
+void FEBioModel::MemoryReport(FEMemoryReport& report)
+{
+	FEMechModel::MemoryReport(report);
+
+	// plot file
+	if (m_plot) report.Add("output", "plot file", m_plot->MemoryUsage());
+
+	// data records
+	DataStore& data = GetDataStore();
+	size_t bytes = 0;
+	for (int i = 0; i < data.Size(); ++i)
+	{
+		DataRecord* pd = data.GetDataRecord(i);
+		bytes += sizeof(DataRecord) + fecore_memory_size(pd->m_item);
+	}
+	report.Add("output", "data records", bytes);
+}
+
+//-----------------------------------------------------------------------------
+// helper function for printing a line with a dotted leader
+static void print_memory_line(FEBioModel* fem, const std::string& name, int indent, size_t bytes)
+{
+	char szline[64];
+	int l = snprintf(szline, 35, "\t%*s%s ", indent, "", name.c_str());
+	for (int i = l; i < 34; ++i) szline[i] = '.';
+	szline[34] = 0;
+	fem->Logf(0, "%s : %.1lf MB\n", szline, (double)bytes / 1048576.0);
+}
+
+//-----------------------------------------------------------------------------
+void FEBioModel::PrintMemoryReport()
+{
+	FEMemoryReport mem;
+	MemoryReport(mem);
+
+	feLog(" M E M O R Y   U S A G E\n\n");
+
+	// print the totals of each category, followed by its items
+	std::vector<std::string> cats;
+	for (int i = 0; i < mem.Items(); ++i)
+	{
+		const std::string& cat = mem.GetItem(i).category;
+		if (std::find(cats.begin(), cats.end(), cat) == cats.end()) cats.push_back(cat);
+	}
+
+	for (size_t n = 0; n < cats.size(); ++n)
+	{
+		print_memory_line(this, cats[n], 0, mem.Total(cats[n]));
+		for (int i = 0; i < mem.Items(); ++i)
+		{
+			const FEMemoryReport::ITEM& it = mem.GetItem(i);
+			if ((it.category == cats[n]) && !it.name.empty()) print_memory_line(this, it.name, 3, it.bytes);
+		}
+		feLog("\n");
+	}
+	print_memory_line(this, "Total (estimated)", 0, mem.Total());
+
+	size_t current = GetCurrentMemory();
+	if (current != 0) print_memory_line(this, "Current process memory", 0, current);
+	feLog("\n");
+}
+
+//-----------------------------------------------------------------------------
+// helper function for printing a node of the profiler's call tree and all its children
+static void print_profile_node(FEBioModel* fem, FEProfiler& prof, int thread, int n, int depth, double parentTime)
+{
+	const FEProfiler::Node& node = prof.GetNode(thread, n);
+
+	char szline[64];
+	int l = snprintf(szline, 47, "\t%*s%s ", 3*depth, "", node.name.c_str());
+	for (int i = l; i < 46; ++i) szline[i] = '.';
+	szline[46] = 0;
+
+	double pct = (parentTime > 0.0 ? 100.0*node.time / parentTime : 100.0);
+	fem->Logf(0, "%s : %10d %12.3lf %6.1lf%%\n", szline, node.calls, node.time, pct);
+
+	for (size_t i = 0; i < node.children.size(); ++i)
+		print_profile_node(fem, prof, thread, node.children[i], depth + 1, node.time);
+}
+
+//-----------------------------------------------------------------------------
+void FEBioModel::PrintProfile()
+{
+	FEProfiler& prof = *GetProfiler();
+
+	feLog(" P R O F I L E R   S U M M A R Y\n\n");
+	feLog("\t%-44s   %10s %12s %7s\n", "region", "calls", "time (sec)", "parent");
+	for (int n = 0; n < prof.Threads(); ++n)
+	{
+		if (prof.Nodes(n) == 0) continue;
+		if (n > 0) feLog("\n\tthread %d:\n", n);
+
+		// print the root nodes and their children
+		for (int i = 0; i < prof.Nodes(n); ++i)
+		{
+			if (prof.GetNode(n, i).parent == -1) print_profile_node(this, prof, n, i, 0, 0.0);
+		}
+	}
+	feLog("\n");
+}
+
 //-----------------------------------------------------------------------------
 void FEBioModel::on_cb_solved()
 {
@@ -1510,14 +1643,12 @@ void FEBioModel::on_cb_solved()
 	m_log.flush();
 
 	// get peak memory usage
-#ifdef WIN32
 	size_t memsize = GetPeakMemory();
 	if (memsize != 0)
 	{
 		double mb = (double)memsize / 1048576.0;
 		feLog(" Peak memory  : %.1lf MB\n", mb);
 	}
-#endif
 
 	// print the elapsed time
 	GetSolveTimer().time_str(sztime);
@@ -1555,6 +1686,12 @@ void FEBioModel::on_cb_solved()
 		Timer::time_str(total_linsol, sztime); feLog("\t   time in linear solver ........ : %s (%lg sec)\n\n", sztime, total_linsol);
 		Timer::time_str(total_time  , sztime); feLog("\tTotal elapsed time .............. : %s (%lg sec)\n\n", sztime, total_time);
 
+		// print the memory usage
+		PrintMemoryReport();
+
+		// print the profiler's call tree
+		if (GetProfiler()->IsEnabled()) PrintProfile();
+
 		m_log.SetMode(old_mode);
 
 		bool bconv = IsSolved();
@@ -1571,6 +1708,15 @@ void FEBioModel::on_cb_solved()
 		m_log.flush();
 	}
 
+	// write the profiler trace
+	if (GetProfiler()->IsEnabled() && (m_sprofile.empty() == false))
+	{
+		if (GetProfiler()->WriteTrace(m_sprofile.c_str()))
+			feLog(" Profiler trace written to %s\n\n", m_sprofile.c_str());
+		else
+			feLogError("Failed writing profiler trace to %s", m_sprofile.c_str());
+	}
+
 	// close the plot file
 	int hint = GetStep(Steps() - 1)->GetPlotHint();
 	if (hint != FE_PLOT_APPEND)
@@ -171,6 +171,21 @@ public:
 	//! Set the log level
 	void SetLogLevel(int logLevel);
 
+	//! set the model cache mode (see FEBModelCache::Mode)
+	void SetModelCacheMode(int mode);
+
+	//! collect the memory usage of the model (including output)
+	void MemoryReport(FEMemoryReport& report) override;
+
+	//! print the memory report to the log
+	void PrintMemoryReport();
+
+	//! Set the file name for the profiler trace. This also enables the profiler.
+	void SetProfileFilename(const std::string& sfile);
+
+	//! print the profiler's call tree to the log
+	void PrintProfile();
+
 private:
 	void print_parameter(FEParam& p, int level = 0);
 	void print_parameter_list(FEParameterList& pl, int level = 0);
@@ -193,6 +208,7 @@ private:
 	int			m_logLevel;		//!< output level for log file
 
 	int			m_dumpLevel;	//!< level or writing restart file
+	int			m_cacheMode;	//!< mode of the model cache
 
 private:
 	// accumulative statistics
@@ -206,6 +222,7 @@ protected: // file names
 	std::string		m_sfile;			//!< input file name (= path + title)
 	std::string		m_splot;			//!< plot output file name
 	std::string		m_slog ;			//!< log output file name
+	std::string		m_sprofile;			//!< profiler trace file name
 	std::string		m_sdump;			//!< dump file name
 
 	std::string	m_title;	//!< model title
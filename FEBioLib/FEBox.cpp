@@ -30,6 +30,8 @@ SOFTWARE.*/
 #include "FEBox.h"
 #include "FEBioMech/FEElasticSolidDomain.h"
 #include <FECore/FEModel.h>
+#include <FECore/FECoreKernel.h>
+#include <FECore/FEMaterial.h>
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -47,36 +49,73 @@ FEBoxMesh::~FEBoxMesh()
 
 void FEBoxMesh::Create(int nx, int ny, int nz, vec3d r0, vec3d r1, FE_Element_Type nhex)
 {
-	int i, j, k, n;
+	FESolidDomain* pbd = AddBox(*this, nx, ny, nz, r0, r1, nhex);
+	if (pbd) pbd->SetMatID(-1);
+}
 
+//-----------------------------------------------------------------------------
+// The six tets of a cell. They all share the diagonal 0-6, which makes the 
+// subdivision conforming between neighboring cells.
+static const int TET_CELL[6][4] = {
+	{ 0, 1, 2, 6 },{ 0, 2, 3, 6 },{ 0, 3, 7, 6 },{ 0, 7, 4, 6 },{ 0, 4, 5, 6 },{ 0, 5, 1, 6 }
+};
+
+// corner pairs of the edges of the hex20 (nodes 8 - 19) and tet10 (nodes 4 - 9)
+static const int HEX20_EDGE[12][2] = {
+	{ 0, 1 },{ 1, 2 },{ 2, 3 },{ 3, 0 },{ 4, 5 },{ 5, 6 },{ 6, 7 },{ 7, 4 },{ 0, 4 },{ 1, 5 },{ 2, 6 },{ 3, 7 }
+};
+static const int TET10_EDGE[6][2] = {
+	{ 0, 1 },{ 1, 2 },{ 2, 0 },{ 0, 3 },{ 1, 3 },{ 2, 3 }
+};
+
+FESolidDomain* FEBoxMesh::AddBox(FEMesh& mesh, int nx, int ny, int nz, vec3d r0, vec3d r1, FE_Element_Type etype, FEMaterial* pmat)
+{
 	// make sure the parameters make sense
 	assert((nx > 0) && (ny > 0) && (nz > 0));
 
+	FE_Element_Spec spec = FEElementLibrary::GetElementSpecFromType(etype);
+	bool btet = false, bquad = false;
+	switch (spec.eshape)
+	{
+	case ET_HEX8 : break;
+	case ET_HEX20: bquad = true; break;
+	case ET_TET4 : btet = true; break;
+	case ET_TET10: btet = true; bquad = true; break;
+	default:
+		return nullptr;
+	}
+
+	// Quadratic elements use a grid with twice the resolution, so that the 
+	// mid-side nodes are grid points as well. 
+	int s = (bquad ? 2 : 1);
+	int mx = s*nx, my = s*ny, mz = s*nz;
+
 	// count items
-	int nodes = (nx+1)*(ny+1)*(nz+1);
-	int elems = nx*ny*nz;
+	int nodes = (mx+1)*(my+1)*(mz+1);
+	int elems = nx*ny*nz*(btet ? 6 : 1);
 
 	// allocate data
-	FEMesh::CreateNodes(nodes);
+	int N0 = mesh.Nodes();
+	int E0 = mesh.Elements();
+	mesh.AddNodes(nodes);
 
-	FEModel* fem = GetFEModel();
+	FEModel* fem = mesh.GetFEModel();
 	int MAX_DOFS = fem->GetDOFS().GetTotalDOFS();
-	FEMesh::SetDOFS(MAX_DOFS);
+	for (int i = N0; i<N0 + nodes; ++i) mesh.Node(i).SetDOFS(MAX_DOFS);
 
 	// create the nodes
-	double x, y, z;
-	n = 0;
-	for (i=0; i<=nx; ++i)
+	int n = N0;
+	for (int i=0; i<=mx; ++i)
 	{
-		x = r0.x + ((r1.x - r0.x)*i)/nx;
-		for (j=0; j<=ny; ++j)
+		double x = r0.x + ((r1.x - r0.x)*i)/mx;
+		for (int j=0; j<=my; ++j)
 		{
-			y = r0.y + ((r1.y - r0.y)*j)/ny;
-			for (k=0; k<=nz; ++k, ++n)
+			double y = r0.y + ((r1.y - r0.y)*j)/my;
+			for (int k=0; k<=mz; ++k, ++n)
 			{
-				z = r0.z + ((r1.z - r0.z)*k)/nz;
+				double z = r0.z + ((r1.z - r0.z)*k)/mz;
 
-				FENode& node = Node(n);
+				FENode& node = mesh.Node(n);
 
 				node.m_r0 = vec3d(x, y, z);
 
@@ -88,34 +127,90 @@ void FEBoxMesh::Create(int nx, int ny, int nz, vec3d r0, vec3d r1, FE_Element_Ty
 		}
 	}
 
+	// grid point (i,j,k) of the (refined) grid
+	#define GRID(i,j,k) (N0 + (i)*(my+1)*(mz+1) + (j)*(mz+1) + (k))
+
+	// create the domain
+	FESolidDomain* pbd = nullptr;
+	if (pmat)
+	{
+		FECoreKernel& febio = FECoreKernel::GetInstance();
+		pbd = dynamic_cast<FESolidDomain*>(febio.CreateDomain(spec, &mesh, pmat));
+		if (pbd == nullptr) return nullptr;
+	}
+	else pbd = new FEElasticSolidDomain(fem);
+	pbd->Create(elems, spec);
+	mesh.AddDomain(pbd);
+
 	// create the elements
-	int *en;
 	n = 0;
-	FEElasticSolidDomain* pbd = new FEElasticSolidDomain(fem);
-	pbd->Create(elems, FEElementLibrary::GetElementSpecFromType(nhex));
-	pbd->SetMatID(-1);
-	AddDomain(pbd);
-	for (i=0; i<nx; ++i)
+	for (int i=0; i<nx; ++i)
 	{
-		for (j=0; j<ny; ++j)
+		for (int j=0; j<ny; ++j)
 		{
-			for (k=0; k<nz; ++k, ++n)
+			for (int k=0; k<nz; ++k)
 			{
-				FESolidElement& el = pbd->Element(n);
-
-				el.SetID(n+1);
-
-				en = &el.m_node[0];
-
-				en[0] = (i  )*(ny+1)*(nz+1) + (j  )*(nz+1) + (k  );
-				en[1] = (i+1)*(ny+1)*(nz+1) + (j  )*(nz+1) + (k  );
-				en[2] = (i+1)*(ny+1)*(nz+1) + (j+1)*(nz+1) + (k  );
-				en[3] = (i  )*(ny+1)*(nz+1) + (j+1)*(nz+1) + (k  );
-				en[4] = (i  )*(ny+1)*(nz+1) + (j  )*(nz+1) + (k+1);
-				en[5] = (i+1)*(ny+1)*(nz+1) + (j  )*(nz+1) + (k+1);
-				en[6] = (i+1)*(ny+1)*(nz+1) + (j+1)*(nz+1) + (k+1);
-				en[7] = (i  )*(ny+1)*(nz+1) + (j+1)*(nz+1) + (k+1);
+				// grid coordinates of the cell corners (in hex8 order)
+				int I = s*i, J = s*j, K = s*k;
+				int c[8][3] = {
+					{ I  , J  , K   },{ I+s, J  , K   },{ I+s, J+s, K   },{ I  , J+s, K   },
+					{ I  , J  , K+s },{ I+s, J  , K+s },{ I+s, J+s, K+s },{ I  , J+s, K+s }
+				};
+
+				if (btet == false)
+				{
+					FESolidElement& el = pbd->Element(n++);
+					el.SetID(E0 + n);
+					int* en = &el.m_node[0];
+					for (int a = 0; a < 8; ++a) en[a] = GRID(c[a][0], c[a][1], c[a][2]);
+					if (bquad)
+					{
+						for (int a = 0; a < 12; ++a)
+						{
+							const int* p = c[HEX20_EDGE[a][0]];
+							const int* q = c[HEX20_EDGE[a][1]];
+							en[8 + a] = GRID((p[0] + q[0]) / 2, (p[1] + q[1]) / 2, (p[2] + q[2]) / 2);
+						}
+					}
+				}
+				else
+				{
+					for (int l = 0; l < 6; ++l)
+					{
+						FESolidElement& el = pbd->Element(n++);
+						el.SetID(E0 + n);
+
+						int t[4][3];
+						for (int a = 0; a < 4; ++a)
+							for (int b = 0; b < 3; ++b) t[a][b] = c[TET_CELL[l][a]][b];
+
+						// make sure the tet has a positive volume
+						vec3d a1((double)(t[1][0] - t[0][0]), (double)(t[1][1] - t[0][1]), (double)(t[1][2] - t[0][2]));
+						vec3d a2((double)(t[2][0] - t[0][0]), (double)(t[2][1] - t[0][1]), (double)(t[2][2] - t[0][2]));
+						vec3d a3((double)(t[3][0] - t[0][0]), (double)(t[3][1] - t[0][1]), (double)(t[3][2] - t[0][2]));
+						if ((a1 ^ a2)*a3 < 0)
+						{
+							for (int b = 0; b < 3; ++b) { int tmp = t[1][b]; t[1][b] = t[2][b]; t[2][b] = tmp; }
+						}
+
+						int* en = &el.m_node[0];
+						for (int a = 0; a < 4; ++a) en[a] = GRID(t[a][0], t[a][1], t[a][2]);
+						if (bquad)
+						{
+							for (int a = 0; a < 6; ++a)
+							{
+								const int* p = t[TET10_EDGE[a][0]];
+								const int* q = t[TET10_EDGE[a][1]];
+								en[4 + a] = GRID((p[0] + q[0]) / 2, (p[1] + q[1]) / 2, (p[2] + q[2]) / 2);
+							}
+						}
+					}
+				}
 			}
 		}
 	}
+
+	#undef GRID
+
+	return pbd;
 }
@@ -28,12 +28,23 @@ SOFTWARE.*/
 
 #pragma once
 #include "FECore/FEMesh.h"
+#include "febiolib_api.h"
 
-class FEBoxMesh : public FEMesh  
+class FESolidDomain;
+class FEMaterial;
+
+class FEBIOLIB_API FEBoxMesh : public FEMesh  
 {
 public:
 	FEBoxMesh(FEModel* fem);
 	virtual ~FEBoxMesh();
 
 	void Create(int nx, int ny, int nz, vec3d r0, vec3d r1, FE_Element_Type nhex = FE_HEX8G8);
+
+	//! Add a box of nx x ny x nz cells between r0 and r1 to an existing mesh. 
+	//! Supported element shapes are hex8, hex20, tet4 and tet10. For tets, each cell 
+	//! is split into six tets. The new nodes are appended to the mesh and the domain 
+	//! is created for the material (or an elastic domain when pmat is null).
+	//! Returns the new domain, or null when the element type is not supported.
+	static FESolidDomain* AddBox(FEMesh& mesh, int nx, int ny, int nz, vec3d r0, vec3d r1, FE_Element_Type etype, FEMaterial* pmat = nullptr);
 };
@@ -25,19 +25,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 #include "stdafx.h"
 #include "febiolib_api.h"
+#include <FECore/FEMemoryReport.h>
 #include <stddef.h>
-#ifdef WIN32
-#include <windows.h>
-#include <psapi.h>
-#endif
 
 size_t FEBIOLIB_API GetPeakMemory()
 {
-#ifdef WIN32
-	PROCESS_MEMORY_COUNTERS memCounters;
-	GetProcessMemoryInfo(GetCurrentProcess(), &memCounters, sizeof(memCounters));
-	return (size_t)memCounters.PeakWorkingSetSize;
-#else
-	return 0;
-#endif
+	return FEMemoryReport::PeakMemory();
+}
+
+size_t FEBIOLIB_API GetCurrentMemory()
+{
+	return FEMemoryReport::CurrentMemory();
 }
@@ -134,10 +134,7 @@ void FE3FieldElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 	FEModel& fem = *GetFEModel();
 
 	// repeat over all solid elements
-	int NE = (int)m_Elem.size();
-	#pragma omp parallel for
-	for (int iel=0; iel<NE; ++iel)
-	{
+	ParallelElementLoop(LS, [&](int iel) {
 		FESolidElement& el = m_Elem[iel];
 
 		// element stiffness matrix
@@ -171,7 +168,7 @@ void FE3FieldElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 
 		// assemble element matrix in global stiffness matrix
 		LS.Assemble(ke);
-	}
+	});
 }
 
 //-----------------------------------------------------------------------------
@@ -156,7 +156,7 @@ double FENodeForceX::value(int nnode)
 	{
 		vector<double>& Fr = psolid_solver->m_Fr;
 		vector<double>& Fn = psolid_solver->m_Fn;
-		vector<int>& id = mesh.Node(nnode).m_ID;
+		FENodeDofArray<int>& id = mesh.Node(nnode).m_ID;
 
 		double Fx = 0.0;
 		if (id[0] >= 0) Fx = Fn[id[0]];
@@ -174,7 +174,7 @@ double FENodeForceY::value(int nnode)
 	if (psolid_solver)
 	{
 		vector<double>& Fr = psolid_solver->m_Fr;
-		vector<int>& id = mesh.Node(nnode).m_ID;
+		FENodeDofArray<int>& id = mesh.Node(nnode).m_ID;
 		return (-id[1] - 2 >= 0 ? Fr[-id[1]-2] : 0);
 	}
 	return 0;
@@ -188,7 +188,7 @@ double FENodeForceZ::value(int nnode)
 	if (psolid_solver)
 	{
 		vector<double>& Fr = psolid_solver->m_Fr;
-		vector<int>& id = mesh.Node(nnode).m_ID;
+		FENodeDofArray<int>& id = mesh.Node(nnode).m_ID;
 		return (-id[2] - 2 >= 0 ? Fr[-id[2]-2] : 0);
 	}
 	return 0;
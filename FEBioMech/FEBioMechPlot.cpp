@@ -560,6 +560,12 @@ bool FEPlotSurfaceArea::Save(FESurface &surf, FEDataStream &a)
 
 //-----------------------------------------------------------------------------
 bool FEPlotElementVelocity::Save(FEDomain &dom, FEDataStream& a)
+{
+	return Save(dom, 0, dom.Elements(), a);
+}
+
+//-----------------------------------------------------------------------------
+bool FEPlotElementVelocity::Save(FEDomain& dom, int n0, int n1, FEDataStream& a)
 {
 	FESolidMaterial* pme = dom.GetMaterial()->ExtractProperty<FESolidMaterial>();
 	if ((pme == 0) || pme->IsRigid()) return false;
@@ -567,13 +573,19 @@ bool FEPlotElementVelocity::Save(FEDomain &dom, FEDataStream& a)
 	writeAverageElementValue<vec3d>(dom, a, [](const FEMaterialPoint& mp) {
 		const FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 		return pt.m_v;
-	});
+	}, n0, n1);
 
     return true;
 }
 
 //-----------------------------------------------------------------------------
 bool FEPlotElementAcceleration::Save(FEDomain &dom, FEDataStream& a)
+{
+	return Save(dom, 0, dom.Elements(), a);
+}
+
+//-----------------------------------------------------------------------------
+bool FEPlotElementAcceleration::Save(FEDomain& dom, int n0, int n1, FEDataStream& a)
 {
 	FESolidMaterial* pme = dom.GetMaterial()->ExtractProperty<FESolidMaterial>();
     if ((pme == 0) || pme->IsRigid()) return false;
@@ -581,7 +593,7 @@ bool FEPlotElementAcceleration::Save(FEDomain &dom, FEDataStream& a)
 	writeAverageElementValue<vec3d>(dom, a, [](const FEMaterialPoint& mp) {
 		const FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 		return pt.m_a;
-	});
+	}, n0, n1);
 
 	return true;
 }
@@ -600,6 +612,12 @@ public:
 //-----------------------------------------------------------------------------
 //! Store the average stresses for each element. 
 bool FEPlotElementStress::Save(FEDomain& dom, FEDataStream& a)
+{
+	return Save(dom, 0, dom.Elements(), a);
+}
+
+//-----------------------------------------------------------------------------
+bool FEPlotElementStress::Save(FEDomain& dom, int n0, int n1, FEDataStream& a)
 {
 	FESolidMaterial* pme = dom.GetMaterial()->ExtractProperty<FESolidMaterial>();
 	if ((pme == 0) || pme->IsRigid()) return false;
@@ -607,7 +625,7 @@ bool FEPlotElementStress::Save(FEDomain& dom, FEDataStream& a)
 	FEDomainParameter* var = pme->FindDomainParameter("stress");
 	if (var == nullptr) return false;
 
-	writeAverageElementValue<mat3ds>(dom, a, var);
+	writeAverageElementValue<mat3ds>(dom, a, var, n0, n1);
 
 	return true;
 }
@@ -615,6 +633,12 @@ bool FEPlotElementStress::Save(FEDomain& dom, FEDataStream& a)
 //-----------------------------------------------------------------------------
 //! Store the average stresses for each element. 
 bool FEPlotElementPK2Stress::Save(FEDomain& dom, FEDataStream& a)
+{
+	return Save(dom, 0, dom.Elements(), a);
+}
+
+//-----------------------------------------------------------------------------
+bool FEPlotElementPK2Stress::Save(FEDomain& dom, int n0, int n1, FEDataStream& a)
 {
 	FESolidMaterial* pme = dom.GetMaterial()->ExtractProperty<FESolidMaterial>();
 	if ((pme == 0) || pme->IsRigid()) return false;
@@ -624,7 +648,7 @@ bool FEPlotElementPK2Stress::Save(FEDomain& dom, FEDataStream& a)
 		mat3ds s = ep.m_s;
 		mat3ds S = ep.pull_back(s);
 		return S;
-		});
+		}, n0, n1);
 
 	return true;
 }
@@ -632,6 +656,12 @@ bool FEPlotElementPK2Stress::Save(FEDomain& dom, FEDataStream& a)
 //-----------------------------------------------------------------------------
 //! Store the average PK1 stress for each element. 
 bool FEPlotElementPK1Stress::Save(FEDomain& dom, FEDataStream& a)
+{
+	return Save(dom, 0, dom.Elements(), a);
+}
+
+//-----------------------------------------------------------------------------
+bool FEPlotElementPK1Stress::Save(FEDomain& dom, int n0, int n1, FEDataStream& a)
 {
 	FESolidMaterial* pme = dom.GetMaterial()->ExtractProperty<FESolidMaterial>();
 	if ((pme == 0) || pme->IsRigid()) return false;
@@ -644,7 +674,7 @@ bool FEPlotElementPK1Stress::Save(FEDomain& dom, FEDataStream& a)
 
 		mat3d P = (s * F.transinv()) * J;
 		return P;
-		});
+		}, n0, n1);
 
 	return true;
 }
@@ -1611,13 +1641,19 @@ bool FEPlotCurrentElementAngularMomentum::Save(FEDomain &dom, FEDataStream& a)
 
 //-----------------------------------------------------------------------------
 bool FEPlotRelativeVolume::Save(FEDomain &dom, FEDataStream& a)
+{
+	return Save(dom, 0, dom.Elements(), a);
+}
+
+//-----------------------------------------------------------------------------
+bool FEPlotRelativeVolume::Save(FEDomain& dom, int n0, int n1, FEDataStream& a)
 {
 	if (dom.Class() != FE_DOMAIN_SOLID) return false;
 
 	writeAverageElementValue<double>(dom, a, [](const FEMaterialPoint& mp) {
 		const FEElasticMaterialPoint* pt = mp.ExtractData<FEElasticMaterialPoint>();
 		return (pt ? pt->m_J : 0.0);
-	});
+	}, n0, n1);
 
 	return true;
 }
@@ -1852,10 +1888,16 @@ public:
 
 //-----------------------------------------------------------------------------
 bool FEPlotLagrangeStrain::Save(FEDomain& dom, FEDataStream& a)
+{
+	return Save(dom, 0, dom.Elements(), a);
+}
+
+//-----------------------------------------------------------------------------
+bool FEPlotLagrangeStrain::Save(FEDomain& dom, int n0, int n1, FEDataStream& a)
 {
 	FEElasticMaterial* pme = dom.GetMaterial()->ExtractProperty<FEElasticMaterial>();
 	if (pme == nullptr) return false;
-	writeAverageElementValue<mat3ds>(dom, a, FELagrangeStrain());
+	writeAverageElementValue<mat3ds>(dom, a, FELagrangeStrain(), n0, n1);
 	return true;
 }
 
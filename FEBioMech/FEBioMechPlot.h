@@ -40,7 +40,7 @@ SOFTWARE.*/
 class FEPlotNodeVelocity : public FEPlotNodeData
 {
 public:
-	FEPlotNodeVelocity(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){}
+	FEPlotNodeVelocity(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE) { SetConcurrent(true); }
 	bool Save(FEMesh& m, FEDataStream& a);
 };
 
@@ -50,7 +50,7 @@ public:
 class FEPlotNodeAcceleration : public FEPlotNodeData
 {
 public:
-	FEPlotNodeAcceleration(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE){}
+	FEPlotNodeAcceleration(FEModel* pfem) : FEPlotNodeData(pfem, PLT_VEC3F, FMT_NODE) { SetConcurrent(true); }
 	bool Save(FEMesh& m, FEDataStream& a);
 };
 
@@ -263,8 +263,9 @@ public:
 class FEPlotElementVelocity : public FEPlotDomainData
 {
 public:
-    FEPlotElementVelocity(FEModel* pfem) : FEPlotDomainData(pfem, PLT_VEC3F, FMT_ITEM){}
+    FEPlotElementVelocity(FEModel* pfem) : FEPlotDomainData(pfem, PLT_VEC3F, FMT_ITEM) { SetConcurrent(true); SetSplittable(true); }
     bool Save(FEDomain& dom, FEDataStream& a);
+    bool Save(FEDomain& dom, int n0, int n1, FEDataStream& a);
 };
 
 //-----------------------------------------------------------------------------
@@ -272,8 +273,9 @@ public:
 class FEPlotElementAcceleration : public FEPlotDomainData
 {
 public:
-    FEPlotElementAcceleration(FEModel* pfem) : FEPlotDomainData(pfem, PLT_VEC3F, FMT_ITEM){}
+    FEPlotElementAcceleration(FEModel* pfem) : FEPlotDomainData(pfem, PLT_VEC3F, FMT_ITEM) { SetConcurrent(true); SetSplittable(true); }
     bool Save(FEDomain& dom, FEDataStream& a);
+    bool Save(FEDomain& dom, int n0, int n1, FEDataStream& a);
 };
 
 //-----------------------------------------------------------------------------
@@ -281,8 +283,9 @@ public:
 class FEPlotElementStress : public FEPlotDomainData
 {
 public:
-	FEPlotElementStress(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM){}
+	FEPlotElementStress(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM) { SetConcurrent(true); SetSplittable(true); }
 	bool Save(FEDomain& dom, FEDataStream& a);
+	bool Save(FEDomain& dom, int n0, int n1, FEDataStream& a);
 };
 
 //-----------------------------------------------------------------------------
@@ -290,8 +293,9 @@ public:
 class FEPlotElementPK2Stress : public FEPlotDomainData
 {
 public:
-	FEPlotElementPK2Stress(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM) {}
+	FEPlotElementPK2Stress(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM) { SetConcurrent(true); SetSplittable(true); }
 	bool Save(FEDomain& dom, FEDataStream& a);
+	bool Save(FEDomain& dom, int n0, int n1, FEDataStream& a);
 };
 
 //-----------------------------------------------------------------------------
@@ -299,8 +303,9 @@ public:
 class FEPlotElementPK1Stress : public FEPlotDomainData
 {
 public:
-	FEPlotElementPK1Stress(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3F, FMT_ITEM) {}
+	FEPlotElementPK1Stress(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3F, FMT_ITEM) { SetConcurrent(true); SetSplittable(true); }
 	bool Save(FEDomain& dom, FEDataStream& a);
+	bool Save(FEDomain& dom, int n0, int n1, FEDataStream& a);
 };
 
 //-----------------------------------------------------------------------------
@@ -482,8 +487,9 @@ public:
 class FEPlotRelativeVolume : public FEPlotDomainData
 {
 public:
-	FEPlotRelativeVolume(FEModel* pfem) : FEPlotDomainData(pfem, PLT_FLOAT, FMT_ITEM){}
+	FEPlotRelativeVolume(FEModel* pfem) : FEPlotDomainData(pfem, PLT_FLOAT, FMT_ITEM) { SetConcurrent(true); SetSplittable(true); }
 	bool Save(FEDomain& dom, FEDataStream& a);
+	bool Save(FEDomain& dom, int n0, int n1, FEDataStream& a);
 };
 
 //-----------------------------------------------------------------------------
@@ -798,8 +804,9 @@ public:
 class FEPlotLagrangeStrain : public FEPlotDomainData
 {
 public:
-	FEPlotLagrangeStrain(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM){}
+	FEPlotLagrangeStrain(FEModel* pfem) : FEPlotDomainData(pfem, PLT_MAT3FS, FMT_ITEM) { SetConcurrent(true); SetSplittable(true); }
 	bool Save(FEDomain& dom, FEDataStream& a);
+	bool Save(FEDomain& dom, int n0, int n1, FEDataStream& a);
 };
 
 //-----------------------------------------------------------------------------
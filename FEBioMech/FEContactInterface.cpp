@@ -50,6 +50,7 @@ FEContactInterface::FEContactInterface(FEModel* pfem) : FESurfacePairConstraint(
 	m_laugon = 0;	// penalty method by default
     m_psf = 1.0;    // default scale factor is 1
     m_psfmax = 0;   // default max scale factor is not set
+	m_bparallel = false;
 }
 
 FEContactInterface::~FEContactInterface()
@@ -80,6 +80,7 @@ public:
 	int		m_laugon;	//!< contact enforcement method
     double  m_psf;      //!< penalty scale factor during Lagrange augmentation
     double  m_psfmax;   //!< max allowable penalty scale factor during laugon
+	bool	m_bparallel;	//!< assemble residual and stiffness with OpenMP (only used by interfaces that support it)
 
 	DECLARE_FECORE_CLASS();
 };
@@ -216,7 +216,7 @@ void FEDiscreteContact::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		NODE& nodeData = m_Node[i];
 
 		FENode& node = mesh.Node(nodeData.nid);
-		vector<int>& sLM = node.m_ID;
+		FENodeDofArray<int>& sLM = node.m_ID;
 
 		FESurfaceElement* pe = nodeData.pe;
 
@@ -342,7 +342,7 @@ void FEDiscreteContact::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo& tp
 	{
 		NODE& nodeData = m_Node[i];
 
-		vector<int>& sLM = mesh.Node(nodeData.nid).m_ID;
+		FENodeDofArray<int>& sLM = mesh.Node(nodeData.nid).m_ID;
 
 		// see if this node's constraint is active
 		// that is, if it has a secondary element associated with it
@@ -687,7 +687,7 @@ void FEDiscreteContact::BuildMatrixProfile(FEGlobalMatrix& K)
 
 			for (int k=0; k<n; ++k)
 			{
-				vector<int>& id = mesh.Node(en[k]).m_ID;
+				FENodeDofArray<int>& id = mesh.Node(en[k]).m_ID;
 				lm[6*(k+1)  ] = id[dof_X];
 				lm[6*(k+1)+1] = id[dof_Y];
 				lm[6*(k+1)+2] = id[dof_Z];
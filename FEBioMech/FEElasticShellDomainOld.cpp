@@ -793,7 +793,7 @@ void FEElasticShellDomainOld::UnpackLM(FEElement& el, vector<int>& lm)
 	for (int i=0; i<N; ++i)
 	{
 		FENode& node = m_pMesh->Node(el.m_node[i]);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		// first the displacement dofs
 		lm[6*i  ] = id[m_dofSU[0]];
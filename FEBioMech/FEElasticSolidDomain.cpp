@@ -36,6 +36,252 @@ SOFTWARE.*/
 #include <FECore/sys.h>
 #include "FEBioMech.h"
 #include <FECore/FELinearSystem.h>
+#include <FECore/FEException.h>
+
+//-----------------------------------------------------------------------------
+// Batched element kernels
+//
+// These kernels evaluate BATCH_SIZE elements of the same type together. The element
+// data is gathered into tiles that are laid out as [value][lane], where the lane is
+// the position of the element in the batch. All inner loops run over the lanes, so
+// that the compiler can map each tile row onto a SIMD register.
+namespace {
+
+const int BATCH_SIZE = 4;
+
+// gather the nodal coordinates, evaluated at the intermediate time point alpha
+template <int NEN> void BatchNodalCoordinates(FEMesh& mesh, FESolidElement* const* pe, double alpha, double x[NEN][3][BATCH_SIZE])
+{
+	for (int l = 0; l < BATCH_SIZE; ++l)
+	{
+		const int* en = &pe[l]->m_node[0];
+		for (int i = 0; i < NEN; ++i)
+		{
+			FENode& nd = mesh.Node(en[i]);
+			vec3d r = (alpha == 1.0 ? nd.m_rt : nd.m_rt*alpha + nd.m_rp*(1 - alpha));
+			x[i][0][l] = r.x;
+			x[i][1][l] = r.y;
+			x[i][2][l] = r.z;
+		}
+	}
+}
+
+// Calculate the spatial shape function gradients G and the jacobian determinants at
+// integration point n. Returns the first lane with a non-positive jacobian, or -1.
+template <int NEN> int BatchShapeGradient(FESolidElement& el, int n, const double x[NEN][3][BATCH_SIZE], double G[NEN][3][BATCH_SIZE], double detJ[BATCH_SIZE])
+{
+	const double* Gr = el.Gr(n);
+	const double* Gs = el.Gs(n);
+	const double* Gt = el.Gt(n);
+
+	// jacobian (row-major)
+	double J[9][BATCH_SIZE] = { 0 };
+	for (int i = 0; i < NEN; ++i)
+	{
+		const double gr = Gr[i], gs = Gs[i], gt = Gt[i];
+		for (int l = 0; l < BATCH_SIZE; ++l)
+		{
+			const double xi = x[i][0][l], yi = x[i][1][l], zi = x[i][2][l];
+			J[0][l] += gr*xi; J[1][l] += gs*xi; J[2][l] += gt*xi;
+			J[3][l] += gr*yi; J[4][l] += gs*yi; J[5][l] += gt*yi;
+			J[6][l] += gr*zi; J[7][l] += gs*zi; J[8][l] += gt*zi;
+		}
+	}
+
+	// inverse jacobian
+	double Ji[9][BATCH_SIZE];
+	for (int l = 0; l < BATCH_SIZE; ++l)
+	{
+		double det = J[0][l]*(J[4][l]*J[8][l] - J[5][l]*J[7][l])
+				   + J[1][l]*(J[5][l]*J[6][l] - J[8][l]*J[3][l])
+				   + J[2][l]*(J[3][l]*J[7][l] - J[4][l]*J[6][l]);
+		detJ[l] = det;
+
+		double deti = 1.0 / det;
+		Ji[0][l] = deti*(J[4][l]*J[8][l] - J[5][l]*J[7][l]);
+		Ji[3][l] = deti*(J[5][l]*J[6][l] - J[3][l]*J[8][l]);
+		Ji[6][l] = deti*(J[3][l]*J[7][l] - J[4][l]*J[6][l]);
+
+		Ji[1][l] = deti*(J[2][l]*J[7][l] - J[1][l]*J[8][l]);
+		Ji[4][l] = deti*(J[0][l]*J[8][l] - J[2][l]*J[6][l]);
+		Ji[7][l] = deti*(J[1][l]*J[6][l] - J[0][l]*J[7][l]);
+
+		Ji[2][l] = deti*(J[1][l]*J[5][l] - J[4][l]*J[2][l]);
+		Ji[5][l] = deti*(J[2][l]*J[3][l] - J[0][l]*J[5][l]);
+		Ji[8][l] = deti*(J[0][l]*J[4][l] - J[1][l]*J[3][l]);
+	}
+
+	for (int l = 0; l < BATCH_SIZE; ++l)
+		if (detJ[l] <= 0) return l;
+
+	// global gradients of shape functions (using the transposed of Ji)
+	for (int i = 0; i < NEN; ++i)
+	{
+		const double gr = Gr[i], gs = Gs[i], gt = Gt[i];
+		for (int l = 0; l < BATCH_SIZE; ++l)
+		{
+			G[i][0][l] = Ji[0][l]*gr + Ji[3][l]*gs + Ji[6][l]*gt;
+			G[i][1][l] = Ji[1][l]*gr + Ji[4][l]*gs + Ji[7][l]*gt;
+			G[i][2][l] = Ji[2][l]*gr + Ji[5][l]*gs + Ji[8][l]*gt;
+		}
+	}
+
+	return -1;
+}
+
+// gather the Cauchy stress at integration point n
+void BatchStress(FESolidElement* const* pe, int n, double s[6][BATCH_SIZE])
+{
+	for (int l = 0; l < BATCH_SIZE; ++l)
+	{
+		FEElasticMaterialPoint& pt = *pe[l]->GetMaterialPoint(n)->ExtractData<FEElasticMaterialPoint>();
+		const mat3ds& sl = pt.m_s;
+		s[0][l] = sl.xx(); s[1][l] = sl.yy(); s[2][l] = sl.zz();
+		s[3][l] = sl.xy(); s[4][l] = sl.yz(); s[5][l] = sl.xz();
+	}
+}
+
+// internal force vectors, stored as fe[3*NEN][lane]
+template <int NEN> void BatchInternalForce(FEMesh& mesh, FESolidElement* const* pe, double alpha, double fe[3*NEN][BATCH_SIZE])
+{
+	FESolidElement& el = *pe[0];
+	const int nint = el.GaussPoints();
+	const double* gw = el.GaussWeights();
+
+	double x[NEN][3][BATCH_SIZE];
+	BatchNodalCoordinates<NEN>(mesh, pe, alpha, x);
+
+	for (int i = 0; i < 3*NEN; ++i)
+		for (int l = 0; l < BATCH_SIZE; ++l) fe[i][l] = 0.0;
+
+	double G[NEN][3][BATCH_SIZE], detJ[BATCH_SIZE], s[6][BATCH_SIZE];
+	for (int n = 0; n < nint; ++n)
+	{
+		int lneg = BatchShapeGradient<NEN>(el, n, x, G, detJ);
+		if (lneg >= 0) throw NegativeJacobian(pe[lneg]->GetID(), n + 1, detJ[lneg]);
+
+		BatchStress(pe, n, s);
+
+		for (int l = 0; l < BATCH_SIZE; ++l) detJ[l] *= gw[n];
+
+		// the '-' sign is so that the internal forces get subtracted
+		// from the global residual vector
+		for (int i = 0; i < NEN; ++i)
+		{
+			for (int l = 0; l < BATCH_SIZE; ++l)
+			{
+				const double Gx = G[i][0][l], Gy = G[i][1][l], Gz = G[i][2][l];
+				fe[3*i  ][l] -= (Gx*s[0][l] + Gy*s[3][l] + Gz*s[5][l])*detJ[l];
+				fe[3*i+1][l] -= (Gy*s[1][l] + Gx*s[3][l] + Gz*s[4][l])*detJ[l];
+				fe[3*i+2][l] -= (Gz*s[2][l] + Gy*s[4][l] + Gx*s[5][l])*detJ[l];
+			}
+		}
+	}
+}
+
+// Geometrical and material stiffness. Only the node blocks (a,b) with b >= a are
+// evaluated. They are packed row by row in K[block][3x3 entry][lane].
+template <int NEN> void BatchStiffness(FEMesh& mesh, FESolidMaterial* mat, FESolidElement* const* pe, double alpha, double K[NEN*(NEN+1)/2][9][BATCH_SIZE])
+{
+	FESolidElement& el = *pe[0];
+	const int nint = el.GaussPoints();
+	const double* gw = el.GaussWeights();
+
+	double x[NEN][3][BATCH_SIZE];
+	BatchNodalCoordinates<NEN>(mesh, pe, alpha, x);
+
+	const int NB = NEN*(NEN + 1)/2;
+	for (int b = 0; b < NB; ++b)
+		for (int k = 0; k < 9; ++k)
+			for (int l = 0; l < BATCH_SIZE; ++l) K[b][k][l] = 0.0;
+
+	double G[NEN][3][BATCH_SIZE], w[BATCH_SIZE], s[6][BATCH_SIZE];
+	double D[6][6][BATCH_SIZE];
+	for (int n = 0; n < nint; ++n)
+	{
+		int lneg = BatchShapeGradient<NEN>(el, n, x, G, w);
+		if (lneg >= 0) throw NegativeJacobian(pe[lneg]->GetID(), n + 1, w[lneg]);
+		for (int l = 0; l < BATCH_SIZE; ++l) w[l] *= gw[n]*alpha;
+
+		BatchStress(pe, n, s);
+
+		// NOTE: deformation gradient and determinant have already been evaluated in the stress routine
+		for (int l = 0; l < BATCH_SIZE; ++l)
+		{
+			double Dl[6][6];
+			tens4dmm C = mat->SolidTangent(*pe[l]->GetMaterialPoint(n));
+			C.extract(Dl);
+			for (int a = 0; a < 6; ++a)
+				for (int b = 0; b < 6; ++b) D[a][b][l] = Dl[a][b];
+		}
+
+		for (int i = 0, b = 0; i < NEN; ++i)
+		{
+			for (int j = i; j < NEN; ++j, ++b)
+			{
+				double (&Kb)[9][BATCH_SIZE] = K[b];
+				for (int l = 0; l < BATCH_SIZE; ++l)
+				{
+					const double Gxi = G[i][0][l], Gyi = G[i][1][l], Gzi = G[i][2][l];
+					const double Gxj = G[j][0][l], Gyj = G[j][1][l], Gzj = G[j][2][l];
+
+					// geometrical stiffness
+					double sGx = s[0][l]*Gxj + s[3][l]*Gyj + s[5][l]*Gzj;
+					double sGy = s[3][l]*Gxj + s[1][l]*Gyj + s[4][l]*Gzj;
+					double sGz = s[5][l]*Gxj + s[4][l]*Gyj + s[2][l]*Gzj;
+					double kab = Gxi*sGx + Gyi*sGy + Gzi*sGz;
+
+					// D*BL matrix
+					double DBL[6][3];
+					for (int k = 0; k < 6; ++k)
+					{
+						DBL[k][0] = (D[k][0][l]*Gxj + D[k][3][l]*Gyj + D[k][5][l]*Gzj);
+						DBL[k][1] = (D[k][1][l]*Gyj + D[k][3][l]*Gxj + D[k][4][l]*Gzj);
+						DBL[k][2] = (D[k][2][l]*Gzj + D[k][4][l]*Gyj + D[k][5][l]*Gxj);
+					}
+
+					const double wl = w[l];
+					Kb[0][l] += (Gxi*DBL[0][0] + Gyi*DBL[3][0] + Gzi*DBL[5][0] + kab)*wl;
+					Kb[1][l] += (Gxi*DBL[0][1] + Gyi*DBL[3][1] + Gzi*DBL[5][1])*wl;
+					Kb[2][l] += (Gxi*DBL[0][2] + Gyi*DBL[3][2] + Gzi*DBL[5][2])*wl;
+
+					Kb[3][l] += (Gyi*DBL[1][0] + Gxi*DBL[3][0] + Gzi*DBL[4][0])*wl;
+					Kb[4][l] += (Gyi*DBL[1][1] + Gxi*DBL[3][1] + Gzi*DBL[4][1] + kab)*wl;
+					Kb[5][l] += (Gyi*DBL[1][2] + Gxi*DBL[3][2] + Gzi*DBL[4][2])*wl;
+
+					Kb[6][l] += (Gzi*DBL[2][0] + Gyi*DBL[4][0] + Gxi*DBL[5][0])*wl;
+					Kb[7][l] += (Gzi*DBL[2][1] + Gyi*DBL[4][1] + Gxi*DBL[5][1])*wl;
+					Kb[8][l] += (Gzi*DBL[2][2] + Gyi*DBL[4][2] + Gxi*DBL[5][2] + kab)*wl;
+				}
+			}
+		}
+	}
+}
+
+// copy the packed upper block triangle of lane l into ke and fill the lower half by symmetry
+template <int NEN> void BatchUnpackStiffness(const double K[NEN*(NEN+1)/2][9][BATCH_SIZE], int l, matrix& ke)
+{
+	for (int i = 0, b = 0; i < NEN; ++i)
+	{
+		for (int j = i; j < NEN; ++j, ++b)
+		{
+			for (int p = 0; p < 3; ++p)
+				for (int q = 0; q < 3; ++q)
+				{
+					double kpq = K[b][3*p + q][l];
+					ke[3*i + p][3*j + q] = kpq;
+					if (j > i) ke[3*j + q][3*i + p] = kpq;
+				}
+		}
+	}
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(FEElasticSolidDomain, FESolidDomain)
+	ADD_PARAMETER(m_bbatch, "batched_kernels");
+END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -47,6 +293,7 @@ FEElasticSolidDomain::FEElasticSolidDomain(FEModel* pfem) : FESolidDomain(pfem),
     m_alphaf = m_beta = 1;
     m_alpham = 2;
 	m_update_dynamic = true; // default for backward compatibility
+	m_bbatch = false;
 
 	// TODO: Move this elsewhere since there is no error checking
 	if (pfem)
@@ -160,30 +407,55 @@ void FEElasticSolidDomain::PreSolveUpdate(const FETimeInfo& timeInfo)
 void FEElasticSolidDomain::InternalForces(FEGlobalVector& R)
 {
 	int NE = Elements();
+
+	if (m_bbatch)
+	{
+		// process the elements in batches. Batches that the batched
+		// kernels cannot handle are processed one element at a time.
+		int NB = (NE + BATCH_SIZE - 1) / BATCH_SIZE;
+		#pragma omp parallel for shared (NB)
+		for (int b = 0; b < NB; ++b)
+		{
+			int iel[BATCH_SIZE];
+			int n = 0;
+			for (int i = b*BATCH_SIZE; (i < NE) && (n < BATCH_SIZE); ++i) iel[n++] = i;
+
+			if (BatchInternalForces(R, iel, n) == false)
+			{
+				for (int i = 0; i < n; ++i) AssembleElementInternalForce(R, m_Elem[iel[i]]);
+			}
+		}
+		return;
+	}
+
 	#pragma omp parallel for shared (NE)
 	for (int i=0; i<NE; ++i)
 	{
-		// get the element
-		FESolidElement& el = m_Elem[i];
+		AssembleElementInternalForce(R, m_Elem[i]);
+	}
+}
 
-		if (el.isActive()) {
-			// element force vector
-			vector<double> fe;
-			vector<int> lm;
+//-----------------------------------------------------------------------------
+//! assemble the internal force vector of one element
+void FEElasticSolidDomain::AssembleElementInternalForce(FEGlobalVector& R, FESolidElement& el)
+{
+	if (el.isActive()) {
+		// element force vector
+		vector<double> fe;
+		vector<int> lm;
 
-			// get the element force vector and initialize it to zero
-			int ndof = 3 * el.Nodes();
-			fe.assign(ndof, 0);
+		// get the element force vector and initialize it to zero
+		int ndof = 3 * el.Nodes();
+		fe.assign(ndof, 0);
 
-			// calculate internal force vector
-			ElementInternalForce(el, fe);
+		// calculate internal force vector
+		ElementInternalForce(el, fe);
 
-			// get the element's LM vector
-			UnpackLM(el, lm);
+		// get the element's LM vector
+		UnpackLM(el, lm);
 
-			// assemble element 'fe'-vector into global R vector
-			R.Assemble(el.m_node, lm, fe);
-		}
+		// assemble element 'fe'-vector into global R vector
+		R.Assemble(el.m_node, lm, fe);
 	}
 }
 
@@ -413,12 +685,8 @@ void FEElasticSolidDomain::ElementMaterialStiffness(FESolidElement &el, matrix &
 //-----------------------------------------------------------------------------
 void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 {
-	// repeat over all solid elements
-	int NE = Elements();
-	
-	#pragma omp parallel for shared (NE)
-	for (int iel=0; iel<NE; ++iel)
-	{
+	// element stiffness evaluation and assembly
+	auto elementStiffness = [&](int iel) {
 		FESolidElement& el = m_Elem[iel];
 
 		if (el.isActive()) {
@@ -451,7 +719,118 @@ void FEElasticSolidDomain::StiffnessMatrix(FELinearSystem& LS)
 			// assemble element matrix in global stiffness matrix
 			LS.Assemble(ke);
 		}
+	};
+
+	// The batched kernels only evaluate the upper half of the element
+	// matrices, so they can only be used for symmetric systems.
+	if (m_bbatch && LS.IsSymmetric())
+	{
+		ParallelElementBatchLoop(LS, BATCH_SIZE, [&](const int* iel, int n) {
+			if (BatchStiffnessMatrix(LS, iel, n) == false)
+			{
+				for (int i = 0; i < n; ++i) elementStiffness(iel[i]);
+			}
+		});
 	}
+	else
+	{
+		// repeat over all solid elements
+		ParallelElementLoop(LS, elementStiffness);
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Checks if a batch of elements can be processed by the batched kernels. This
+//! requires a full batch of active hex8 or tet4 elements of the same type 
+//! without solid-shell interface nodes. Returns the number of element nodes, or
+//! zero if the batch has to be processed one element at a time.
+int FEElasticSolidDomain::BatchNodes(const int* iel, int n)
+{
+	if (n != BATCH_SIZE) return 0;
+
+	int etype = m_Elem[iel[0]].Type();
+	int neln = 0;
+	switch (etype)
+	{
+	case FE_HEX8G8:
+	case FE_HEX8RI:
+	case FE_HEX8G1: neln = 8; break;
+	case FE_TET4G1:
+	case FE_TET4G4: neln = 4; break;
+	default:
+		return 0;
+	}
+
+	for (int i = 0; i < n; ++i)
+	{
+		FESolidElement& el = m_Elem[iel[i]];
+		if ((el.Type() != etype) || (el.isActive() == false) || (el.m_bitfc.empty() == false)) return 0;
+	}
+
+	return neln;
+}
+
+//-----------------------------------------------------------------------------
+bool FEElasticSolidDomain::BatchInternalForces(FEGlobalVector& R, const int* iel, int n)
+{
+	int neln = BatchNodes(iel, n);
+	if (neln == 0) return false;
+
+	FESolidElement* pe[BATCH_SIZE];
+	for (int l = 0; l < BATCH_SIZE; ++l) pe[l] = &m_Elem[iel[l]];
+
+	double alpha = (m_update_dynamic ? m_alphaf : 1.0);
+
+	double fe[24][BATCH_SIZE];
+	if (neln == 8) BatchInternalForce<8>(*m_pMesh, pe, alpha, fe);
+	else BatchInternalForce<4>(*m_pMesh, pe, alpha, fe);
+
+	// assemble the element vectors
+	vector<double> fl(3 * neln);
+	vector<int> lm;
+	for (int l = 0; l < BATCH_SIZE; ++l)
+	{
+		FESolidElement& el = *pe[l];
+		for (int i = 0; i < 3 * neln; ++i) fl[i] = fe[i][l];
+		UnpackLM(el, lm);
+		R.Assemble(el.m_node, lm, fl);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEElasticSolidDomain::BatchStiffnessMatrix(FELinearSystem& LS, const int* iel, int n)
+{
+	int neln = BatchNodes(iel, n);
+	if (neln == 0) return false;
+
+	FESolidElement* pe[BATCH_SIZE];
+	for (int l = 0; l < BATCH_SIZE; ++l) pe[l] = &m_Elem[iel[l]];
+
+	// packed upper block triangle (large enough for hex8)
+	double K[36][9][BATCH_SIZE];
+	if (neln == 8) BatchStiffness<8>(*m_pMesh, m_pMat, pe, m_alphaf, K);
+	else BatchStiffness<4>(*m_pMesh, m_pMat, pe, m_alphaf, K);
+
+	// assemble the element matrices
+	int ndof = 3 * neln;
+	for (int l = 0; l < BATCH_SIZE; ++l)
+	{
+		FESolidElement& el = *pe[l];
+
+		vector<int> lm;
+		UnpackLM(el, lm);
+
+		FEElementMatrix ke(el, lm);
+		ke.resize(ndof, ndof);
+		if (neln == 8) BatchUnpackStiffness<8>(K, l, ke);
+		else BatchUnpackStiffness<4>(K, l, ke);
+
+		LS.Assemble(ke);
+	}
+
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -678,7 +1057,7 @@ void FEElasticSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
 	for (int i=0; i<N; ++i)
 	{
 		FENode& node = m_pMesh->Node(el.m_node[i]);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		// first the displacement dofs
 		lm[3*i  ] = id[m_dofU[0]];
@@ -697,7 +1076,7 @@ void FEElasticSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
     {
         if (sel.m_bitfc[i]) {
             FENode& node = m_pMesh->Node(el.m_node[i]);
-            vector<int>& id = node.m_ID;
+            FENodeDofArray<int>& id = node.m_ID;
             
             // first the displacement dofs
             lm[3*i  ] = id[m_dofSU[0]];
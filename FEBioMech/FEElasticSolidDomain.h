@@ -116,11 +116,30 @@ public:
     //! Calculates the inertial force vector for solid elements
     void ElementInertialForce(FESolidElement& el, vector<double>& fe);
     
+protected:
+	// --- B A T C H E D   K E R N E L S ---
+
+	//! Checks if the elements can be processed by the batched kernels. If so, the
+	//! number of element nodes is returned. Otherwise, zero is returned.
+	int BatchNodes(const int* iel, int n);
+
+	//! Internal forces of a batch of elements. 
+	//! Returns false if the batch has to be processed one element at a time.
+	bool BatchInternalForces(FEGlobalVector& R, const int* iel, int n);
+
+	//! Stiffness matrices of a batch of elements.
+	//! Returns false if the batch has to be processed one element at a time.
+	bool BatchStiffnessMatrix(FELinearSystem& LS, const int* iel, int n);
+
+	//! assemble the internal force vector of one element
+	void AssembleElementInternalForce(FEGlobalVector& R, FESolidElement& el);
+
 protected:
     double              m_alphaf;
     double              m_alpham;
     double              m_beta;
 	bool				m_update_dynamic;	//!< flag for updating quantities only used in dynamic analysis
+	bool				m_bbatch;			//!< use batched element kernels for hex8 and tet4 elements
 
 protected:
 	FEDofList	m_dofU;		// displacement dofs
@@ -132,4 +151,6 @@ protected:
 	FEDofList	m_dof;		// total dof list
 
 	FESolidMaterial*	m_pMat;
+
+	DECLARE_FECORE_CLASS();
 };
@@ -44,12 +44,16 @@ SOFTWARE.*/
 #include <FECore/FELinearConstraintManager.h>
 #include "FEResidualVector.h"
 #include "FEBioMech.h"
+#include <float.h>
 
 //-----------------------------------------------------------------------------
 // define the parameter list
 BEGIN_FECORE_CLASS(FEExplicitSolidSolver, FESolver)
 	ADD_PARAMETER(m_mass_lumping, "mass_lumping");
 	ADD_PARAMETER(m_dyn_damping, "dyn_damping");
+	ADD_PARAMETER(m_log_stride, "log_stride");
+	ADD_PARAMETER(m_dt_scale, "dt_scale");
+	ADD_PARAMETER(m_dt_update, "dt_update");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -64,6 +68,11 @@ FEExplicitSolidSolver::FEExplicitSolidSolver(FEModel* pfem) :
 
 	m_mass_lumping = HRZ_LUMPING;
 
+	m_log_stride = 1;
+	m_dt_scale = 0.0;
+	m_dt_update = 10;
+	m_ndt = 0;
+
 	// Allocate degrees of freedom
 	DOFS& dofs = pfem->GetDOFS();
 	int varD = dofs.AddVariable("displacement", VAR_VEC3);
@@ -369,12 +378,30 @@ bool FEExplicitSolidSolver::Init()
 	m_ui.assign(neq, 0);
 	m_Ut.assign(neq, 0);
 	m_Mi.assign(neq, 0.0);
+	m_Un.assign(neq, 0.0);
+	m_vn.assign(neq, 0.0);
+	m_an.assign(neq, 0.0);
 
 	GetFEModel()->Update();
 
 	// we need to fill the total displacement vector m_Ut
 	FEModel& fem = *GetFEModel();
 	FEMesh& mesh = fem.GetMesh();
+
+	// store the equation numbers of the (shell) displacement dofs
+	int NN = mesh.Nodes();
+	m_nodeEq.resize(6 * NN);
+	for (int i = 0; i < NN; ++i)
+	{
+		FENode& node = mesh.Node(i);
+		int* eq = &m_nodeEq[6 * i];
+		eq[0] = node.m_ID[m_dofU[0]];
+		eq[1] = node.m_ID[m_dofU[1]];
+		eq[2] = node.m_ID[m_dofU[2]];
+		eq[3] = node.m_ID[m_dofSU[0]];
+		eq[4] = node.m_ID[m_dofSU[1]];
+		eq[5] = node.m_ID[m_dofSU[2]];
+	}
 	gather(m_Ut, mesh, m_dofU[0]);
 	gather(m_Ut, mesh, m_dofU[1]);
 	gather(m_Ut, mesh, m_dofU[2]);
@@ -396,18 +423,10 @@ bool FEExplicitSolidSolver::Init()
 	if (Residual(m_R0) == false) return false;
 
 	// calculate the initial acceleration
-	for (int i = 0; i < mesh.Nodes(); ++i)
-	{
-		FENode& node = mesh.Node(i);
-		int n;
-		if ((n = node.m_ID[m_dofU[0]]) >= 0) node.m_at.x = m_R0[n] * m_Mi[n];
-		if ((n = node.m_ID[m_dofU[1]]) >= 0) node.m_at.y = m_R0[n] * m_Mi[n];
-		if ((n = node.m_ID[m_dofU[2]]) >= 0) node.m_at.z = m_R0[n] * m_Mi[n];
-
-		if ((n = node.m_ID[m_dofSU[0]]) >= 0) node.set(m_dofSA[0], m_R0[n] * m_Mi[n]);
-		if ((n = node.m_ID[m_dofSU[1]]) >= 0) node.set(m_dofSA[1], m_R0[n] * m_Mi[n]);
-		if ((n = node.m_ID[m_dofSU[2]]) >= 0) node.set(m_dofSA[2], m_R0[n] * m_Mi[n]);
-	}
+	GatherState();
+	#pragma omp parallel for
+	for (int i = 0; i < neq; ++i) m_an[i] = m_R0[i] * m_Mi[i];
+	ScatterState();
 
 	// set the dynamic update flag only if we are running a dynamic analysis
 	bool b = (fem.GetCurrentStep()->m_nanalysis == FE_DYNAMIC ? true : false);
@@ -419,9 +438,181 @@ bool FEExplicitSolidSolver::Init()
 		if (s) s->SetDynamicUpdateFlag(b);
 	}
 
+	// report the critical time step (this also evaluates the wave speeds)
+	double dtc = CriticalTimeStep(true);
+	m_ndt = 0;
+	if (dtc < DBL_MAX)
+	{
+		feLog("\tCritical time step estimate ................ : %lg\n", dtc);
+		if ((m_dt_scale <= 0.0) && (fem.GetCurrentStep()->m_dt > dtc))
+		{
+			feLogWarning("The time step size exceeds the critical time step estimate (%lg).", dtc);
+		}
+	}
+
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! Initialize the time step. If requested, the time step size is set to a 
+//! fraction of the critical time step before the loads are evaluated.
+bool FEExplicitSolidSolver::InitStep(double time)
+{
+	if (m_dt_scale > 0.0)
+	{
+		FEModel& fem = *GetFEModel();
+		FEAnalysis* pstep = fem.GetCurrentStep();
+		FETimeInfo& tp = fem.GetTime();
+
+		// the wave speeds are only re-evaluated every m_dt_update steps since this requires
+		// the material tangents, which are about as expensive as a stiffness evaluation.
+		m_ndt++;
+		bool bupdate = ((m_dt_update > 0) && (m_ndt >= m_dt_update));
+		if (bupdate) m_ndt = 0;
+
+		double t0 = time - tp.timeIncrement;
+		double dt = m_dt_scale*CriticalTimeStep(bupdate);
+		if (dt < DBL_MAX)
+		{
+			// don't overshoot the end of the step
+			if (t0 + dt > pstep->m_tend) dt = pstep->m_tend - t0;
+
+			time = t0 + dt;
+			tp.currentTime = time;
+			tp.timeIncrement = dt;
+			pstep->m_dt = dt;
+		}
+	}
+
+	return FESolver::InitStep(time);
+}
+
+//-----------------------------------------------------------------------------
+//! Estimate the critical time step as the smallest ratio of the element size
+//! and the dilatational wave speed over all solid elements. The element size
+//! is taken as the smallest distance between two nodes of the element and the
+//! wave speed is evaluated from the material tangent at the first integration point.
+//! The (squared) wave speeds are stored and only re-evaluated when bupdate is true.
+//! Returns DBL_MAX if no estimate can be made.
+double FEExplicitSolidSolver::CriticalTimeStep(bool bupdate)
+{
+	FEMesh& mesh = GetFEModel()->GetMesh();
+
+	if ((int)m_c2.size() != mesh.Domains())
+	{
+		m_c2.assign(mesh.Domains(), vector<double>());
+		bupdate = true;
+	}
+
+	double dtc = DBL_MAX;
+	for (int nd = 0; nd < mesh.Domains(); ++nd)
+	{
+		FEElasticSolidDomain* dom = dynamic_cast<FEElasticSolidDomain*>(&mesh.Domain(nd));
+		if ((dom == nullptr) || (dom->IsActive() == false)) continue;
+
+		FESolidMaterial* pm = dynamic_cast<FESolidMaterial*>(dom->GetMaterial());
+		if ((pm == nullptr) || pm->IsRigid()) continue;
+
+		const int NE = dom->Elements();
+		vector<double>& c2 = m_c2[nd];
+		bool bmod = (bupdate || ((int)c2.size() != NE));
+		if ((int)c2.size() != NE) c2.assign(NE, 0.0);
+
+		#pragma omp parallel shared(dtc)
+		{
+			double dtl = DBL_MAX;
+
+			#pragma omp for nowait
+			for (int i = 0; i < NE; ++i)
+			{
+				FESolidElement& el = dom->Element(i);
+				if (el.isActive() == false) continue;
+
+				// characteristic element length
+				int neln = el.Nodes();
+				double L2 = DBL_MAX;
+				for (int a = 0; a < neln; ++a)
+				{
+					vec3d ra = mesh.Node(el.m_node[a]).m_rt;
+					for (int b = a + 1; b < neln; ++b)
+					{
+						double l2 = (mesh.Node(el.m_node[b]).m_rt - ra).norm2();
+						if ((l2 > 0.0) && (l2 < L2)) L2 = l2;
+					}
+				}
+				if (L2 == DBL_MAX) continue;
+
+				// (squared) dilatational wave speed
+				if (bmod)
+				{
+					FEMaterialPoint& mp = *el.GetMaterialPoint(0);
+					double rho = pm->Density(mp);
+					tens4ds C = pm->Tangent(mp);
+					double M = C(0, 0, 0, 0);
+					if (C(1, 1, 1, 1) > M) M = C(1, 1, 1, 1);
+					if (C(2, 2, 2, 2) > M) M = C(2, 2, 2, 2);
+					c2[i] = ((rho > 0.0) && (M > 0.0) ? M / rho : 0.0);
+				}
+				if (c2[i] <= 0.0) continue;
+
+				double dte = sqrt(L2 / c2[i]);
+				if (dte < dtl) dtl = dte;
+			}
+
+			#pragma omp critical
+			{
+				if (dtl < dtc) dtc = dtl;
+			}
+		}
+	}
+
+	return dtc;
+}
+
+//-----------------------------------------------------------------------------
+//! Collect the nodal velocities and accelerations into the equation arrays
+void FEExplicitSolidSolver::GatherState()
+{
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	const int NN = mesh.Nodes();
+	#pragma omp parallel for
+	for (int i = 0; i < NN; ++i)
+	{
+		FENode& node = mesh.Node(i);
+		const int* eq = &m_nodeEq[6 * i];
+		int n;
+		if ((n = eq[0]) >= 0) { m_vn[n] = node.get(m_dofV[0]); m_an[n] = node.m_at.x; }
+		if ((n = eq[1]) >= 0) { m_vn[n] = node.get(m_dofV[1]); m_an[n] = node.m_at.y; }
+		if ((n = eq[2]) >= 0) { m_vn[n] = node.get(m_dofV[2]); m_an[n] = node.m_at.z; }
+
+		if ((n = eq[3]) >= 0) { m_vn[n] = node.get(m_dofSV[0]); m_an[n] = node.get(m_dofSA[0]); }
+		if ((n = eq[4]) >= 0) { m_vn[n] = node.get(m_dofSV[1]); m_an[n] = node.get(m_dofSA[1]); }
+		if ((n = eq[5]) >= 0) { m_vn[n] = node.get(m_dofSV[2]); m_an[n] = node.get(m_dofSA[2]); }
+	}
+}
+
+//-----------------------------------------------------------------------------
+//! Copy the velocities and accelerations back to the nodes
+void FEExplicitSolidSolver::ScatterState()
+{
+	FEMesh& mesh = GetFEModel()->GetMesh();
+	const int NN = mesh.Nodes();
+	#pragma omp parallel for
+	for (int i = 0; i < NN; ++i)
+	{
+		FENode& node = mesh.Node(i);
+		const int* eq = &m_nodeEq[6 * i];
+		int n;
+		if ((n = eq[0]) >= 0) { node.set(m_dofV[0], m_vn[n]); node.m_at.x = m_an[n]; }
+		if ((n = eq[1]) >= 0) { node.set(m_dofV[1], m_vn[n]); node.m_at.y = m_an[n]; }
+		if ((n = eq[2]) >= 0) { node.set(m_dofV[2], m_vn[n]); node.m_at.z = m_an[n]; }
+
+		if ((n = eq[3]) >= 0) { node.set(m_dofSV[0], m_vn[n]); node.set(m_dofSA[0], m_an[n]); }
+		if ((n = eq[4]) >= 0) { node.set(m_dofSV[1], m_vn[n]); node.set(m_dofSA[1], m_an[n]); }
+		if ((n = eq[5]) >= 0) { node.set(m_dofSV[2], m_vn[n]); node.set(m_dofSA[2], m_an[n]); }
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! Updates the current state of the model
 void FEExplicitSolidSolver::Update(vector<double>& ui)
@@ -449,22 +640,31 @@ void FEExplicitSolidSolver::UpdateKinematics(vector<double>& ui)
 	UpdateRigidBodies(ui);
 
 	// total displacements
-	vector<double> U(m_Ut.size());
-	for (size_t i=0; i<m_Ut.size(); ++i) U[i] = ui[i] + m_Ut[i];
+	vector<double>& U = m_Un;
+	const int neq = (int)m_Ut.size();
+	#pragma omp parallel for
+	for (int i=0; i<neq; ++i) U[i] = ui[i] + m_Ut[i];
 
 	// update flexible nodes
-	// translational dofs
-	scatter(U, mesh, m_dofU[0]);
-	scatter(U, mesh, m_dofU[1]);
-	scatter(U, mesh, m_dofU[2]);
-	// rotational dofs
-	scatter(U, mesh, m_dofSQ[0]);
-	scatter(U, mesh, m_dofSQ[1]);
-	scatter(U, mesh, m_dofSQ[2]);
-	// shell displacement
-	scatter(U, mesh, m_dofSU[0]);
-	scatter(U, mesh, m_dofSU[1]);
-	scatter(U, mesh, m_dofSU[2]);
+	const int NN = mesh.Nodes();
+	#pragma omp parallel for
+	for (int i=0; i<NN; ++i)
+	{
+		FENode& node = mesh.Node(i);
+		int n;
+		// translational dofs
+		if ((n = node.m_ID[m_dofU[0]]) >= 0) node.set(m_dofU[0], U[n]);
+		if ((n = node.m_ID[m_dofU[1]]) >= 0) node.set(m_dofU[1], U[n]);
+		if ((n = node.m_ID[m_dofU[2]]) >= 0) node.set(m_dofU[2], U[n]);
+		// rotational dofs
+		if ((n = node.m_ID[m_dofSQ[0]]) >= 0) node.set(m_dofSQ[0], U[n]);
+		if ((n = node.m_ID[m_dofSQ[1]]) >= 0) node.set(m_dofSQ[1], U[n]);
+		if ((n = node.m_ID[m_dofSQ[2]]) >= 0) node.set(m_dofSQ[2], U[n]);
+		// shell displacement
+		if ((n = node.m_ID[m_dofSU[0]]) >= 0) node.set(m_dofSU[0], U[n]);
+		if ((n = node.m_ID[m_dofSU[1]]) >= 0) node.set(m_dofSU[1], U[n]);
+		if ((n = node.m_ID[m_dofSU[2]]) >= 0) node.set(m_dofSU[2], U[n]);
+	}
 
 	// make sure the prescribed displacements are fullfilled
 	int ndis = fem.BoundaryConditions();
@@ -485,7 +685,8 @@ void FEExplicitSolidSolver::UpdateKinematics(vector<double>& ui)
 
 	// Update the spatial nodal positions
 	// Don't update rigid nodes since they are already updated
-	for (int i=0; i<mesh.Nodes(); ++i)
+	#pragma omp parallel for
+	for (int i=0; i<NN; ++i)
 	{
 		FENode& node = mesh.Node(i);
 		if (node.m_rid == -1)
@@ -665,7 +866,9 @@ void FEExplicitSolidSolver::PrepStep()
 	// we need them for velocity and acceleration calculations
 	FEMechModel& fem = static_cast<FEMechModel&>(*GetFEModel());
 	FEMesh& mesh = fem.GetMesh();
-	for (i=0; i<mesh.Nodes(); ++i)
+	const int NN = mesh.Nodes();
+	#pragma omp parallel for
+	for (int i=0; i<NN; ++i)
 	{
 		FENode& ni = mesh.Node(i);
 		ni.m_rp = ni.m_rt;
@@ -679,9 +882,9 @@ void FEExplicitSolidSolver::PrepStep()
 	// apply concentrated nodal forces
 	// since these forces do not depend on the geometry
 	// we can do this once outside the NR loop.
-	vector<double> dummy(m_neq, 0.0);
+	// (The reaction forces are not needed here, and are reset in Residual.)
 	zero(m_Fn);
-	FEResidualVector Fn(*GetFEModel(), m_Fn, dummy);
+	FEResidualVector Fn(*GetFEModel(), m_Fn, m_Fr);
 	NodalLoads(Fn, tp);
 
 	// apply prescribed displacements
@@ -810,87 +1013,66 @@ bool FEExplicitSolidSolver::DoSolve()
 	// prepare for solve
 	PrepStep();
 
-//	feLog(" %d\n", m_niter+1);
-
-	// get the mesh
-	FEMesh& mesh = fem.GetMesh();
-	int N = mesh.Nodes(); // this is the total number of nodes in the mesh
-    double dt = fem.GetTime().timeIncrement;
+	// see if we need to print the norms for this time step
+	bool blog = ((m_log_stride > 0) && (pstep->m_ntimesteps % m_log_stride == 0));
 
-	// collect accelerations, velocities, displacements
-	vector<double> an(m_neq, 0.0), vn(m_neq, 0.0), un(m_neq, 0.0);
-	for (int i = 0; i < mesh.Nodes(); ++i)
-	{
-		FENode& node = mesh.Node(i);
-		vec3d vt = node.get_vec3d(m_dofV[0], m_dofV[1], m_dofV[2]);
-		int n;
-		if ((n = node.m_ID[m_dofU[0]]) >= 0) { un[n] = node.m_rt.x - node.m_r0.x; vn[n] = vt.x; an[n] = node.m_at.x; }
-		if ((n = node.m_ID[m_dofU[1]]) >= 0) { un[n] = node.m_rt.y - node.m_r0.y; vn[n] = vt.y; an[n] = node.m_at.y; }
-		if ((n = node.m_ID[m_dofU[2]]) >= 0) { un[n] = node.m_rt.z - node.m_r0.z; vn[n] = vt.z; an[n] = node.m_at.z; }
+	double dt = fem.GetTime().timeIncrement;
+	const int neq = m_neq;
 
-		if ((n = node.m_ID[m_dofSU[0]]) >= 0) { un[n] = node.get(m_dofSU[0]); vn[n] = node.get(m_dofSV[0]); an[n] = node.get(m_dofSA[0]); }
-		if ((n = node.m_ID[m_dofSU[1]]) >= 0) { un[n] = node.get(m_dofSU[1]); vn[n] = node.get(m_dofSV[1]); an[n] = node.get(m_dofSA[1]); }
-		if ((n = node.m_ID[m_dofSU[2]]) >= 0) { un[n] = node.get(m_dofSU[2]); vn[n] = node.get(m_dofSV[2]); an[n] = node.get(m_dofSA[2]); }
-	}
+	// collect velocities and accelerations
+	GatherState();
 
-	// velocity predictor
-	vector<double> v_pred(m_neq, 0.0);
-	for (int i = 0; i < m_neq; ++i)
+	// velocity predictor and displacement update
+	// (the predicted velocity is stored in m_vn)
+	double* vn = &m_vn[0];
+	double* an = &m_an[0];
+	double* ui = &m_ui[0];
+	#pragma omp parallel for
+	for (int i = 0; i < neq; ++i)
 	{
-		v_pred[i] = vn[i] + an[i] * dt*0.5;
+		vn[i] += an[i] * dt*0.5;
+		ui[i] = dt * vn[i];
 	}
 
-	// update displacements
-	for (int i = 0; i < m_neq; ++i)
+	if (blog)
 	{
-		m_ui[i] = dt * v_pred[i];
+		double Dnorm = sqrt(m_ui * m_ui);
+		feLog("\t displacement norm : %lg\n", Dnorm);
 	}
-	double Dnorm = sqrt(m_ui * m_ui);
-	feLog("\t displacement norm : %lg\n", Dnorm);
 	Update(m_ui);
 
 	// evaluate acceleration
 	Residual(m_R1);
-	double Rnorm = sqrt(m_R1 * m_R1);
-	feLog("\t force vector norm : %lg\n", Rnorm);
-
-	vector<double> anp1(m_neq);
-	for (int i = 0; i < m_neq; ++i)
+	if (blog)
 	{
-		anp1[i] = m_R1[i] * m_Mi[i];
+		double Rnorm = sqrt(m_R1 * m_R1);
+		feLog("\t force vector norm : %lg\n", Rnorm);
 	}
 
-	// update velocity
-	vector<double> vnp1(m_neq, 0.0);
-	for (int i = 0; i < m_neq; ++i)
+	// new acceleration and velocity corrector
+	const double* R1 = &m_R1[0];
+	const double* Mi = &m_Mi[0];
+	#pragma omp parallel for
+	for (int i = 0; i < neq; ++i)
 	{
-		vnp1[i] = v_pred[i] + anp1[i]*dt*0.5;
+		an[i] = R1[i] * Mi[i];
+		vn[i] += an[i] * dt*0.5;
 	}
 
 	// increase iteration number
 	m_niter++;
 
 	// scatter velocity and accelerations
-	for (int i = 0; i < mesh.Nodes(); ++i)
-	{
-		FENode& node = mesh.Node(i);
-		int n;
-		if ((n = node.m_ID[m_dofU[0]]) >= 0) { node.set(m_dofV[0], vnp1[n]); node.m_at.x = anp1[n]; }
-		if ((n = node.m_ID[m_dofU[1]]) >= 0) { node.set(m_dofV[1], vnp1[n]); node.m_at.y = anp1[n]; }
-		if ((n = node.m_ID[m_dofU[2]]) >= 0) { node.set(m_dofV[2], vnp1[n]); node.m_at.z = anp1[n]; }
-
-		if ((n = node.m_ID[m_dofSU[0]]) >= 0) { node.set(m_dofSV[0], vnp1[n]); node.set(m_dofSA[0], anp1[n]); }
-		if ((n = node.m_ID[m_dofSU[1]]) >= 0) { node.set(m_dofSV[1], vnp1[n]); node.set(m_dofSA[1], anp1[n]); }
-		if ((n = node.m_ID[m_dofSU[2]]) >= 0) { node.set(m_dofSV[2], vnp1[n]); node.set(m_dofSA[2], anp1[n]); }
-	}
+	ScatterState();
 
 	// do minor iterations callbacks
 	fem.DoCallback(CB_MINOR_ITERS);
 
 	// update the total displacements
-	m_Ut += m_ui;
+	#pragma omp parallel for
+	for (int i = 0; i < neq; ++i) m_Ut[i] += ui[i];
 
-	m_R0 = m_R1;
+	m_R0.swap(m_R1);
 
 	return true;
 }
@@ -972,7 +1154,9 @@ bool FEExplicitSolidSolver::Residual(vector<double>& R)
 
 	// set the nodal reaction forces
 	// TODO: Is this a good place to do this?
-	for (int i=0; i<mesh.Nodes(); ++i)
+	const int NN = mesh.Nodes();
+	#pragma omp parallel for
+	for (int i=0; i<NN; ++i)
 	{
 		FENode& node = mesh.Node(i);
 		node.set_load(m_dofU[0], 0);
@@ -58,6 +58,9 @@ public:
 	//! clean up
 	void Clean() override;
 
+	//! Initialize the time step (adjusts the time step to the critical time step if requested)
+	bool InitStep(double time) override;
+
 	//! Solve an analysis step
 	bool SolveStep() override;
 
@@ -85,12 +88,25 @@ public:
 
 	void ContactForces(FEGlobalVector& R);
 
+	//! estimate the critical (i.e. stable) time step from the solid elements
+	//! (the wave speeds are re-evaluated from the material tangents if bupdate is true)
+	double CriticalTimeStep(bool bupdate = false);
+
 private:
 	bool CalculateMassMatrix();
 
+	//! collect the nodal velocities and accelerations
+	void GatherState();
+
+	//! store the nodal velocities and accelerations
+	void ScatterState();
+
 public:
 	int			m_mass_lumping;	//!< specify mass lumping method
 	double		m_dyn_damping;	//!< velocity damping for the explicit solver
+	int			m_log_stride;	//!< print the solution norms every n-th time step (0 = never)
+	double		m_dt_scale;		//!< if positive, the time step is set to this fraction of the critical time step
+	int			m_dt_update;	//!< re-evaluate the wave speeds every n-th time step (0 = only at the start)
 
 public:
 	// equation numbers
@@ -106,6 +122,15 @@ public:
 	vector<double> m_R0;	//!< residual at iteration i-1
 	vector<double> m_R1;	//!< residual at iteration i
 
+protected:
+	// These buffers are allocated once in Init so that no allocations are needed during the time loop
+	vector<double> m_vn;	//!< velocities
+	vector<double> m_an;	//!< accelerations
+	vector<double> m_Un;	//!< total displacements
+	vector<int>    m_nodeEq;	//!< equation numbers of the displacement and shell displacement dofs (6 per node)
+	vector< vector<double> >	m_c2;	//!< squared wave speeds of the solid elements (per domain)
+	int		m_ndt;			//!< time steps since the wave speeds were last evaluated
+
 protected:
 	FEDofList	m_dofU, m_dofV, m_dofSQ, m_dofRQ;
 	FEDofList	m_dofSU, m_dofSV, m_dofSA;
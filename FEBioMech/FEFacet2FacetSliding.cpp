@@ -268,6 +268,16 @@ FEFacet2FacetSliding::FEFacet2FacetSliding(FEModel* pfem) : FEContactInterface(p
 
 	m_ss.SetSibling(&m_ms);
 	m_ms.SetSibling(&m_ss);
+
+	m_cpps = nullptr;
+	m_cppm = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FEFacet2FacetSliding::~FEFacet2FacetSliding()
+{
+	delete m_cpps;
+	delete m_cppm;
 }
 
 //-----------------------------------------------------------------------------
@@ -314,7 +324,7 @@ void FEFacet2FacetSliding::BuildMatrixProfile(FEGlobalMatrix& K)
 
 					for (int l=0; l<nseln; ++l)
 					{
-						vector<int>& id = mesh.Node(sn[l]).m_ID;
+						FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
 						lm[6*l  ] = id[dof_X];
 						lm[6*l+1] = id[dof_Y];
 						lm[6*l+2] = id[dof_Z];
@@ -325,7 +335,7 @@ void FEFacet2FacetSliding::BuildMatrixProfile(FEGlobalMatrix& K)
 
 					for (int l=0; l<nmeln; ++l)
 					{
-						vector<int>& id = mesh.Node(mn[l]).m_ID;
+						FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
 						lm[6*(l+nseln)  ] = id[dof_X];
 						lm[6*(l+nseln)+1] = id[dof_Y];
 						lm[6*(l+nseln)+2] = id[dof_Z];
@@ -420,11 +430,21 @@ void FEFacet2FacetSliding::CalcAutoPenalty(FEFacetSlidingSurface& s)
 //
 void FEFacet2FacetSliding::ProjectSurface(FEFacetSlidingSurface &ss, FEFacetSlidingSurface &ms, bool bsegup, bool bmove)
 {
-	FEClosestPointProjection cpp(ms);
-	cpp.HandleSpecialCases(true);
+	// The projection is kept between calls so that the surface's node-element
+	// and neighbor lists are only built once and the nearest-neighbor search
+	// only needs to be updated.
+	FEClosestPointProjection*& pcpp = (&ms == &m_ms ? m_cppm : m_cpps);
+	if (pcpp == nullptr)
+	{
+		pcpp = new FEClosestPointProjection(ms);
+		pcpp->HandleSpecialCases(true);
+		pcpp->Init();
+	}
+	else pcpp->Update();
+
+	FEClosestPointProjection& cpp = *pcpp;
 	cpp.SetSearchRadius(m_srad);
 	cpp.SetTolerance(m_stol);
-	cpp.Init();
 
 	// if we need to project the nodes onto the secondary surface,
 	// let's do this first
@@ -470,6 +490,9 @@ void FEFacet2FacetSliding::ProjectSurface(FEFacetSlidingSurface &ss, FEFacetSlid
 		}
 	}
 
+	// the primary nodes moved, so the reference geometry changed
+	if (bmove) GetFEModel()->GetMesh().UpdateReferenceCache();
+
 	// loop over all primary surface elements
 	int NE = ss.Elements();
 
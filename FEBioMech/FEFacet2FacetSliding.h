@@ -79,6 +79,9 @@ public:
 	vector<vec3d>	m_Fn;	//!< equivalent nodal forces
 };
 
+//-----------------------------------------------------------------------------
+class FEClosestPointProjection;
+
 //-----------------------------------------------------------------------------
 //! Sliding interface with facet to facet integration
 
@@ -92,6 +95,9 @@ public:
 	//! constructor
 	FEFacet2FacetSliding(FEModel* pfem);
 
+	//! destructor
+	~FEFacet2FacetSliding();
+
 	//! initialization routine
 	bool Init() override;
 
@@ -165,6 +171,9 @@ private:
 	bool	m_bfirst;
 	double	m_normg0;
 
+	FEClosestPointProjection*	m_cpps;	//!< projection onto primary surface (kept between updates)
+	FEClosestPointProjection*	m_cppm;	//!< projection onto secondary surface (kept between updates)
+
 public:
 	DECLARE_FECORE_CLASS();
 };
@@ -110,5 +110,8 @@ void FEInitialPreStrain::Activate()
 			node.set(dofY, 0.0);
 			node.set(dofZ, 0.0);
 		}
+
+		// the reference configuration changed
+		mesh.UpdateReferenceCache();
 	}
 }
@@ -227,9 +227,8 @@ FEParamValue FEMechModel::GetParameterValue(const ParamString& paramString)
 }
 
 //-----------------------------------------------------------------------------
-void FEMechModel::SerializeGeometry(DumpStream& ar)
+void FEMechModel::SerializeAuxGeometry(DumpStream& ar)
 {
-	FEModel::SerializeGeometry(ar);
 	m_prs->Serialize(ar);
 }
 
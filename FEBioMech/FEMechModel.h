@@ -61,8 +61,8 @@ public:
 	// find a parameter value
 	FEParamValue GetParameterValue(const ParamString& param) override;
 
-	//! serialize data for restarts
-	void SerializeGeometry(DumpStream& ar) override;
+	//! serialize rigid body data
+	void SerializeAuxGeometry(DumpStream& ar) override;
 
 	//! Build the matrix profile for this model
 	void BuildMatrixProfile(FEGlobalMatrix& G, bool breset) override;
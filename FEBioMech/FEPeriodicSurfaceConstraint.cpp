@@ -182,7 +182,7 @@ void FEPeriodicSurfaceConstraint::BuildMatrixProfile(FEGlobalMatrix& K)
 
 	for (int k = 0; k<n0; ++k)
 	{
-		vector<int>& id = mesh.Node(nr0[k]).m_ID;
+		FENodeDofArray<int>& id = mesh.Node(nr0[k]).m_ID;
 		lm[6 * (k + 1)] = id[dof_X];
 		lm[6 * (k + 1) + 1] = id[dof_Y];
 		lm[6 * (k + 1) + 2] = id[dof_Z];
@@ -209,7 +209,7 @@ void FEPeriodicSurfaceConstraint::BuildMatrixProfile(FEGlobalMatrix& K)
 
 		for (int k = 0; k<n; ++k)
 		{
-			vector<int>& id = mesh.Node(en[k]).m_ID;
+			FENodeDofArray<int>& id = mesh.Node(en[k]).m_ID;
 			lm[6 * (k + 1)] = id[dof_X];
 			lm[6 * (k + 1) + 1] = id[dof_Y];
 			lm[6 * (k + 1) + 2] = id[dof_Z];
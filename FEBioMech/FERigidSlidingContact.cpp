@@ -135,7 +135,7 @@ void FERigidSlidingSurface::UnpackLM(FEElement& el, vector<int>& lm)
 	{
 		int n = el.m_lnode[i];
 		FENode& node = Node(n);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		lm[3*i  ] = id[m_dofX];
 		lm[3*i+1] = id[m_dofY];
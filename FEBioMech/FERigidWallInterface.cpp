@@ -192,7 +192,7 @@ void FERigidWallSurface::UnpackLM(FEElement& el, vector<int>& lm)
 	{
 		int n = el.m_node[i];
 		FENode& node = m_pMesh->Node(n);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		lm[3*i  ] = id[m_dofX];
 		lm[3*i+1] = id[m_dofY];
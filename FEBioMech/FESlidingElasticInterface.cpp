@@ -58,6 +58,7 @@ BEGIN_FECORE_CLASS(FESlidingElasticInterface, FEContactInterface)
 	ADD_PARAMETER(m_bflipm   , "flip_secondary"     );
     ADD_PARAMETER(m_bshellbs , "shell_bottom_primary"  );
     ADD_PARAMETER(m_bshellbm , "shell_bottom_secondary");
+    ADD_PARAMETER(m_bparallel, "parallel_assembly"  );
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -309,6 +310,9 @@ FESlidingElasticInterface::FESlidingElasticInterface(FEModel* pfem) : FEContactI
     
     m_naugmin = 0;
     m_naugmax = 10;
+    m_naug = 0;
+    m_biter = 0;
+    m_bfirst = true;
     
     m_bfreeze = false;
     m_bflipm = m_bflips = false;
@@ -316,11 +320,16 @@ FESlidingElasticInterface::FESlidingElasticInterface(FEModel* pfem) : FEContactI
 
     m_ss.SetSibling(&m_ms);
     m_ms.SetSibling(&m_ss);
+
+	m_nps = nullptr;
+	m_npm = nullptr;
 }
 
 //-----------------------------------------------------------------------------
 FESlidingElasticInterface::~FESlidingElasticInterface()
 {
+	delete m_nps;
+	delete m_npm;
 }
 
 //-----------------------------------------------------------------------------
@@ -423,7 +432,7 @@ void FESlidingElasticInterface::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nseln; ++l)
                     {
-                        vector<int>& id = mesh.Node(sn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
                         lm[6*l  ] = id[dof_X];
                         lm[6*l+1] = id[dof_Y];
                         lm[6*l+2] = id[dof_Z];
@@ -434,7 +443,7 @@ void FESlidingElasticInterface::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nmeln; ++l)
                     {
-                        vector<int>& id = mesh.Node(mn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
                         lm[6*(l+nseln)  ] = id[dof_X];
                         lm[6*(l+nseln)+1] = id[dof_Y];
                         lm[6*(l+nseln)+2] = id[dof_Z];
@@ -481,10 +490,14 @@ void FESlidingElasticInterface::ProjectSurface(FESlidingElasticSurface& ss, FESl
     FEMesh& mesh = GetFEModel()->GetMesh();
     
     // initialize projection data
-    FENormalProjection np(ms);
+    // The projection is kept between calls so that its octree
+    // only needs to be refitted when the surface moved a little.
+    FENormalProjection*& pnp = (&ms == &m_ms ? m_npm : m_nps);
+    if (pnp == nullptr) pnp = new FENormalProjection(ms);
+    FENormalProjection& np = *pnp;
     np.SetTolerance(m_stol);
     np.SetSearchRadius(m_srad);
-    np.Init();
+    np.Update();
     
     double psf = GetPenaltyScaleFactor();
     
@@ -557,6 +570,9 @@ void FESlidingElasticInterface::ProjectSurface(FESlidingElasticSurface& ss, FESl
         }
     }
     
+    // the primary nodes moved, so the reference geometry changed
+    if (bmove) mesh.UpdateReferenceCache();
+
     // loop over all integration points
 #pragma omp parallel for schedule(dynamic)
     for (int i=0; i<ss.Elements(); ++i)
@@ -641,9 +657,6 @@ void FESlidingElasticInterface::ProjectSurface(FESlidingElasticSurface& ss, FESl
 
 void FESlidingElasticInterface::Update()
 {
-    static int naug = 0;
-    static int biter = 0;
-    
     FEModel& fem = *GetFEModel();
     
     // get the iteration number
@@ -652,15 +665,15 @@ void FESlidingElasticInterface::Update()
     FEAnalysis* pstep = fem.GetCurrentStep();
     FESolver* psolver = pstep->GetFESolver();
     if (psolver->m_niter == 0) {
-        biter = 0;
-        naug = psolver->m_naug;
+        m_biter = 0;
+        m_naug = psolver->m_naug;
         // check update of auto-penalty
         if (m_bautopen && m_bupdtpen) UpdateAutoPenalty();
-    } else if (psolver->m_naug > naug) {
-        biter = psolver->m_niter;
-        naug = psolver->m_naug;
+    } else if (psolver->m_naug > m_naug) {
+        m_biter = psolver->m_niter;
+        m_naug = psolver->m_naug;
     }
-    int niter = psolver->m_niter - biter;
+    int niter = psolver->m_niter - m_biter;
     bool bupseg = ((m_nsegup == 0)? true : (niter <= m_nsegup));
     // get the logfile
     //	Logfile& log = GetLogfile();
@@ -668,9 +681,8 @@ void FESlidingElasticInterface::Update()
     
     // project the surfaces onto each other
     // this will update the gap functions as well
-    static bool bfirst = true;
-    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
-    bfirst = false;
+    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && m_bfirst));
+    m_bfirst = false;
     if (m_btwo_pass) ProjectSurface(m_ms, m_ss, bupseg);
     
 	int nsolve_iter = GetFEModel()->GetCurrentStep()->GetFESolver()->m_niter;
@@ -952,8 +964,11 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
         FESlidingElasticSurface& ss = (np == 0? m_ss : m_ms);
         FESlidingElasticSurface& ms = (np == 0? m_ms : m_ss);
         
+        // per-element contact forces
+        vector<vec3d> Fs(ss.Elements()), Fm(ss.Elements());
+
         // loop over all primary elements
-        //#pragma omp parallel for private(sLM, mLM, LM, en, fe, detJ, w, Hm, N)
+#pragma omp parallel for if (m_bparallel) schedule(dynamic) private(sLM, mLM, LM, en, fe, detJ, w, Hm, N)
         for (int i=0; i<ss.Elements(); ++i)
         {
             // get the surface element
@@ -1063,12 +1078,12 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
                         // calculate contact forces
                         for (int k=0; k<nseln; ++k)
                         {
-                            ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+                            Fs[i] += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
                         }
                         
                         for (int k = 0; k<nmeln; ++k)
                         {
-                            ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+                            Fm[i] += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
                         }
                         
                         // assemble the global residual
@@ -1077,6 +1092,13 @@ void FESlidingElasticInterface::LoadVector(FEGlobalVector& R, const FETimeInfo&
                 }
             }
         }
+
+        // sum the element forces in a fixed order so the totals do not depend on the thread count
+        for (int i=0; i<ss.Elements(); ++i)
+        {
+            ss.m_Ft += Fs[i];
+            ms.m_Ft += Fm[i];
+        }
     }
 }
 
@@ -1104,7 +1126,7 @@ void FESlidingElasticInterface::StiffnessMatrix(FELinearSystem& LS, const FETime
         FESlidingElasticSurface& ms = (np == 0? m_ms : m_ss);
         
         // loop over all primary elements
-        //#pragma omp parallel for private(detJ, w, Hm, N, sLM, mLM, LM, en, ke)
+#pragma omp parallel for if (m_bparallel) schedule(dynamic) private(detJ, w, Hm, N, sLM, mLM, LM, en, ke)
         for (int i=0; i<ss.Elements(); ++i)
         {
             // get ths primary element
@@ -95,6 +95,9 @@ public:
     vec3d    m_Ft;     //!< total contact force (from equivalent nodal forces)
 };
 
+//-----------------------------------------------------------------------------
+class FENormalProjection;
+
 //-----------------------------------------------------------------------------
 class FESlidingElasticInterface : public FEContactInterface
 {
@@ -185,5 +188,14 @@ public:
 	bool            m_bshellbs;     //!< flag for prescribing pressure on shell bottom for primary surface
 	bool            m_bshellbm;     //!< flag for prescribing pressure on shell bottom for secondary surface
 
+private:
+	FENormalProjection*	m_nps;		//!< projection onto primary surface (kept between updates)
+	FENormalProjection*	m_npm;		//!< projection onto secondary surface (kept between updates)
+
+	// segment update state (kept per interface)
+	int		m_naug;		//!< augmentation count at last update
+	int		m_biter;	//!< solver iteration at start of current augmentation
+	bool	m_bfirst;	//!< first surface projection has not been done yet
+
     DECLARE_FECORE_CLASS();
 };
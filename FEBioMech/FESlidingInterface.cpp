@@ -145,7 +145,7 @@ void FESlidingInterface::BuildMatrixProfile(FEGlobalMatrix& K)
 
 				for (int k=0; k<n; ++k)
 				{
-					vector<int>& id = mesh.Node(en[k]).m_ID;
+					FENodeDofArray<int>& id = mesh.Node(en[k]).m_ID;
 					lm[6*(k+1)  ] = id[dof_X];
 					lm[6*(k+1)+1] = id[dof_Y];
 					lm[6*(k+1)+2] = id[dof_Z];
@@ -638,6 +638,9 @@ void FESlidingInterface::ProjectSurface(FESlidingSurface& ss, FESlidingSurface&
 			ss.m_data[i].m_Lt[0] = ss.m_data[i].m_Lt[1] = 0;
 		}
 	}
+
+	// if primary nodes were moved, the reference geometry changed
+	if (bmove) GetFEModel()->GetMesh().UpdateReferenceCache();
 }
 
 //-----------------------------------------------------------------------------
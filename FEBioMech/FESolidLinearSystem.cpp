@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include "FESolidSolver.h"
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/FEModel.h>
+#include <FECore/FEMesh.h>
 
 FESolidLinearSystem::FESolidLinearSystem(FESolver* solver, FERigidSolver* rigidSolver, FEGlobalMatrix& K, std::vector<double>& F, std::vector<double>& u, bool bsymm, double alpha, int nreq) : FELinearSystem(solver, K, F, u, bsymm)
 {
@@ -109,8 +110,12 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 						if (I >= 0)
 						{
 							// dof i is not a prescribed degree of freedom
-							#pragma omp atomic
-							m_F[I] -= ke[i][j] * ui[J];
+							if (m_bcolored) m_F[I] -= ke[i][j] * ui[J];
+							else
+							{
+								#pragma omp atomic
+								m_F[I] -= ke[i][j] * ui[J];
+							}
 						}
 					}
 
@@ -121,7 +126,19 @@ void FESolidLinearSystem::Assemble(const FEElementMatrix& ke)
 		}
 
 		// see if there are any rigid body dofs here
-		#pragma omp critical 
-		m_rigidSolver->RigidStiffness(m_K, m_u, m_F, ke, m_alpha);
+		// (only then do we need the critical section)
+		FEMesh& mesh = fem->GetMesh();
+		const vector<int>& en = ke.Nodes();
+		bool brigid = false;
+		for (size_t i = 0; i < en.size(); ++i)
+		{
+			if ((en[i] >= 0) && (mesh.Node(en[i]).m_rid >= 0)) { brigid = true; break; }
+		}
+
+		if (brigid)
+		{
+			#pragma omp critical 
+			m_rigidSolver->RigidStiffness(m_K, m_u, m_F, ke, m_alpha);
+		}
 	}
 }
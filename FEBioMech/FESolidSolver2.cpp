@@ -48,6 +48,7 @@ SOFTWARE.*/
 #include <FECore/FEModelLoad.h>
 #include <FECore/FELinearConstraintManager.h>
 #include <FECore/vector.h>
+#include <FECore/FEProfiler.h>
 #include "FESolidLinearSystem.h"
 #include "FEBioMech.h"
 
@@ -769,6 +770,9 @@ bool FESolidSolver2::Quasin()
 	// prepare for the first iteration
 	PrepStep();
 
+	// use the solution of the previous run as initial guess
+	if (m_arcLength == 0) WarmStart();
+
 	// Initialize the QN-method
 	if (QNInit() == false) return false;
 
@@ -1082,6 +1086,7 @@ bool FESolidSolver2::StiffnessMatrix()
 		if (mesh.Domain(i).IsActive()) 
 		{
 			FEElasticDomain& dom = dynamic_cast<FEElasticDomain&>(mesh.Domain(i));
+			FE_PROFILE_SCOPE(&fem, "domain", &mesh.Domain(i));
 			dom.StiffnessMatrix(LS);
 		}
 	}
@@ -1090,7 +1095,11 @@ bool FESolidSolver2::StiffnessMatrix()
 	for (int j = 0; j<fem.BodyLoads(); ++j)
 	{
 		FEBodyLoad* pbl =fem.GetBodyLoad(j);
-		if (pbl->IsActive()) pbl->StiffnessMatrix(LS, tp);
+		if (pbl->IsActive())
+		{
+			FE_PROFILE_SCOPE(&fem, "load", pbl);
+			pbl->StiffnessMatrix(LS, tp);
+		}
 	}
     
     // TODO: add body force stiffness for rigid bodies
@@ -1131,6 +1140,7 @@ bool FESolidSolver2::StiffnessMatrix()
 		FESurfaceLoad* psl = fem.SurfaceLoad(i);
 		if (psl->IsActive())
 		{
+			FE_PROFILE_SCOPE(&fem, "load", psl);
 			psl->StiffnessMatrix(LS, tp);
 		}
 	}
@@ -1142,7 +1152,11 @@ bool FESolidSolver2::StiffnessMatrix()
 	NonLinearConstraintStiffness(LS, tp);
 
 	// calculate the stiffness contributions for the rigid forces
-	for (int i = 0; i<fem.ModelLoads(); ++i) fem.ModelLoad(i)->StiffnessMatrix(LS, tp);
+	for (int i = 0; i<fem.ModelLoads(); ++i)
+	{
+		FE_PROFILE_SCOPE(&fem, "load", fem.ModelLoad(i));
+		fem.ModelLoad(i)->StiffnessMatrix(LS, tp);
+	}
 
 	// add contributions from rigid bodies
 	m_rigidSolver.StiffnessMatrix(*m_pK, tp);
@@ -1159,7 +1173,11 @@ void FESolidSolver2::NonLinearConstraintStiffness(FELinearSystem& LS, const FETi
 	for (int i=0; i<N; ++i) 
 	{
 		FENLConstraint* plc = fem.NonlinearConstraint(i);
-		if (plc->IsActive()) plc->StiffnessMatrix(LS, tp);
+		if (plc->IsActive())
+		{
+			FE_PROFILE_SCOPE(&fem, "constraint", plc);
+			plc->StiffnessMatrix(LS, tp);
+		}
 	}
 }
 
@@ -1173,7 +1191,11 @@ void FESolidSolver2::ContactStiffness(FELinearSystem& LS)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->StiffnessMatrix(LS, tp);
+		if (pci->IsActive())
+		{
+			FE_PROFILE_SCOPE(&fem, "contact", pci);
+			pci->StiffnessMatrix(LS, tp);
+		}
 	}
 }
 
@@ -1186,7 +1208,11 @@ void FESolidSolver2::ContactForces(FEGlobalVector& R)
 	for (int i = 0; i<fem.SurfacePairConstraints(); ++i)
 	{
 		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
-		if (pci->IsActive()) pci->LoadVector(R, tp);
+		if (pci->IsActive())
+		{
+			FE_PROFILE_SCOPE(&fem, "contact", pci);
+			pci->LoadVector(R, tp);
+		}
 	}
 }
 
@@ -1286,6 +1312,7 @@ void FESolidSolver2::InternalForces(FEGlobalVector& R)
 		if ((mat == nullptr) || (mat->IsRigid() == false))
 		{
 			FEElasticDomain& edom = dynamic_cast<FEElasticDomain&>(dom);
+			FE_PROFILE_SCOPE(GetFEModel(), "domain", &dom);
 			edom.InternalForces(R);
 		}
 	}
@@ -1306,7 +1333,11 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 	for (int j = 0; j<fem.BodyLoads(); ++j)
 	{
 		FEBodyLoad* pbl = fem.GetBodyLoad(j);
-		if (pbl->IsActive()) pbl->LoadVector(RHS, tp);
+		if (pbl->IsActive())
+		{
+			FE_PROFILE_SCOPE(&fem, "load", pbl);
+			pbl->LoadVector(RHS, tp);
+		}
 	}
 
 	// calculate body forces for rigid bodies
@@ -1344,7 +1375,11 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 	for (int i = 0; i<nsl; ++i)
 	{
 		FESurfaceLoad* psl = fem.SurfaceLoad(i);
-		if (psl->IsActive()) psl->LoadVector(RHS, tp);
+		if (psl->IsActive())
+		{
+			FE_PROFILE_SCOPE(&fem, "load", psl);
+			psl->LoadVector(RHS, tp);
+		}
 	}
 
 	// calculate contact forces
@@ -1365,6 +1400,7 @@ void FESolidSolver2::ExternalForces(FEGlobalVector& RHS)
 		FEModelLoad& mli = *fem.ModelLoad(i);
 		if (mli.IsActive())
 		{
+			FE_PROFILE_SCOPE(&fem, "load", &mli);
 			mli.LoadVector(RHS, tp);
 		}
 	}
@@ -1400,6 +1436,10 @@ void FESolidSolver2::NonLinearConstraintForces(FEGlobalVector& R, const FETimeIn
 	for (int i=0; i<N; ++i) 
 	{
 		FENLConstraint* plc = fem.NonlinearConstraint(i);
-		if (plc->IsActive()) plc->LoadVector(R, tp);
+		if (plc->IsActive())
+		{
+			FE_PROFILE_SCOPE(&fem, "constraint", plc);
+			plc->LoadVector(R, tp);
+		}
 	}
 }
@@ -320,7 +320,7 @@ void FETiedElasticInterface::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nseln; ++l)
                     {
-                        vector<int>& id = mesh.Node(sn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
                         lm[ndpn*l  ] = id[dof_X];
                         lm[ndpn*l+1] = id[dof_Y];
                         lm[ndpn*l+2] = id[dof_Z];
@@ -331,7 +331,7 @@ void FETiedElasticInterface::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nmeln; ++l)
                     {
-                        vector<int>& id = mesh.Node(mn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
                         lm[ndpn*(l+nseln)  ] = id[dof_X];
                         lm[ndpn*(l+nseln)+1] = id[dof_Y];
                         lm[ndpn*(l+nseln)+2] = id[dof_Z];
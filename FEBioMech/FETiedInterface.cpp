@@ -126,7 +126,7 @@ void FETiedInterface::BuildMatrixProfile(FEGlobalMatrix& K)
 
 				for (int k = 0; k < n; ++k)
 				{
-					vector<int>& id = mesh.Node(en[k]).m_ID;
+					FENodeDofArray<int>& id = mesh.Node(en[k]).m_ID;
 					lm[6 * (k + 1)] = id[dof_X];
 					lm[6 * (k + 1) + 1] = id[dof_Y];
 					lm[6 * (k + 1) + 2] = id[dof_Z];
@@ -159,7 +159,7 @@ void FETiedInterface::BuildMatrixProfile(FEGlobalMatrix& K)
 
 				for (int k = 0; k < n; ++k)
 				{
-					vector<int>& id = mesh.Node(en[k]).m_ID;
+					FENodeDofArray<int>& id = mesh.Node(en[k]).m_ID;
 					lm[3 * (k + 1)    ] = id[dof_X];
 					lm[3 * (k + 1) + 1] = id[dof_Y];
 					lm[3 * (k + 1) + 2] = id[dof_Z];
@@ -301,6 +301,9 @@ void FETiedInterface::ProjectSurface(FETiedContactSurface& ss, FETiedContactSurf
 			}
 		}
 	}
+
+	// if primary nodes were moved, the reference geometry changed
+	if (bmove) GetFEModel()->GetMesh().UpdateReferenceCache();
 }
 
 //-----------------------------------------------------------------------------
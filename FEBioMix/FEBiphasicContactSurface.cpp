@@ -125,7 +125,7 @@ void FEBiphasicContactSurface::UnpackLM(FEElement& el, vector<int>& lm)
 		int n = el.m_node[i];
 
 		FENode& node = m_pMesh->Node(n);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		// first the displacement dofs
 		lm[3*i  ] = id[m_dofX];
@@ -176,7 +176,7 @@ void FEBiphasicSoluteSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
         int n = el.m_node[i];
         FENode& node = m_pMesh->Node(n);
         
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[5*i  ] = id[m_dofU[0]];
@@ -202,7 +202,7 @@ void FEBiphasicSoluteSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
     {
         if (sel.m_bitfc[i]) {
             FENode& node = m_pMesh->Node(el.m_node[i]);
-            vector<int>& id = node.m_ID;
+            FENodeDofArray<int>& id = node.m_ID;
             
             // first the back-face displacement dofs
             lm[5*i  ] = id[m_dofSU[0]];
@@ -85,7 +85,7 @@ void FEMultiphasicShellDomain::UnpackLM(FEElement& el, vector<int>& lm)
         int n = el.m_node[i];
         FENode& node = m_pMesh->Node(n);
         
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[ndpn*i  ] = id[m_dofU[0]];
@@ -133,7 +133,7 @@ void FEMultiphasicShellDomain::UnpackMembraneLM(FEShellElement& el, vector<int>&
         int n = el.m_node[i];
         
         FENode& node = mesh.Node(n);
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[ndpn*i  ] = id[m_dofU[0]];
@@ -80,7 +80,7 @@ void FEMultiphasicSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
         int n = el.m_node[i];
         FENode& node = m_pMesh->Node(n);
         
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[ndpn*i  ] = id[m_dofU[0]];
@@ -107,7 +107,7 @@ void FEMultiphasicSolidDomain::UnpackLM(FEElement& el, vector<int>& lm)
     {
         if (sel.m_bitfc[i]) {
             FENode& node = m_pMesh->Node(sel.m_node[i]);
-            vector<int>& id = node.m_ID;
+            FENodeDofArray<int>& id = node.m_ID;
             
             // first the back-face displacement dofs
             lm[ndpn*i  ] = id[m_dofSU[0]];
@@ -39,7 +39,7 @@ BEGIN_FECORE_CLASS(FESBMPointSource, FEBodyLoad)
 	ADD_PARAMETER(m_weighVolume, "weigh_volume");
 END_FECORE_CLASS();
 
-FESBMPointSource::FESBMPointSource(FEModel* fem) : FEBodyLoad(fem), m_search(&fem->GetMesh())
+FESBMPointSource::FESBMPointSource(FEModel* fem) : FEBodyLoad(fem)
 {
 	static bool bfirst = true;
 	m_sbm = -1;
@@ -54,14 +54,13 @@ FESBMPointSource::FESBMPointSource(FEModel* fem) : FEBodyLoad(fem), m_search(&fe
 bool FESBMPointSource::Init()
 {
 	if (m_sbm == -1) return false;
-	if (m_search.Init() == false) return false;
 	return FEBodyLoad::Init();
 }
 
 // allow species to accumulate at the point source
 void FESBMPointSource::Accumulate(double dc) {
 	double rt[3] = { 0, 0, 0 };
-	m_el = dynamic_cast<FESolidElement*>(m_search.FindElement(m_pos, rt));
+	m_el = GetFEModel()->GetMesh().FindReferenceSolidElement(m_pos, rt);
 	if (m_el == nullptr) return;
 
 	// make sure this element is part of a multiphasic domain
@@ -93,7 +92,7 @@ void FESBMPointSource::Update()
 	if (m_accumulate) {
 		// find the element in which the point lies
 		double rt[3] = { 0, 0, 0 };
-		m_el = dynamic_cast<FESolidElement*>(m_search.FindElement(m_pos, rt));
+		m_el = GetFEModel()->GetMesh().FindReferenceSolidElement(m_pos, rt);
 		if (m_el == nullptr) return;
 
 		// make sure this element is part of a multiphasic domain
@@ -128,7 +127,7 @@ void FESBMPointSource::Update()
 			double H[FEElement::MAX_NODES];
 			double m_q[3];
 			m_q[0] = m_q[1] = m_q[2] = 0.0;
-			m_el = dynamic_cast<FESolidElement*>(m_search.FindElement(m_pos, m_q));
+			m_el = GetFEModel()->GetMesh().FindReferenceSolidElement(m_pos, m_q);
 			if (m_el == nullptr) return;
 			m_el->shape_fnc(H, m_q[0], m_q[1], m_q[2]);
 
@@ -144,7 +143,7 @@ void FESBMPointSource::Update()
 			int nint_in = possible_ints.size();
 			double m_q[3];
 			m_q[0] = m_q[1] = m_q[2] = 0.0;
-			m_el = dynamic_cast<FESolidElement*>(m_search.FindElement(m_pos, m_q));
+			m_el = GetFEModel()->GetMesh().FindReferenceSolidElement(m_pos, m_q);
 			if (m_el == nullptr) return;
 			for (auto iter = possible_ints.begin(); iter != possible_ints.end(); ++iter)
 			{
@@ -56,6 +56,7 @@ BEGIN_FECORE_CLASS(FESlidingInterface2, FEContactInterface)
 	ADD_PARAMETER(m_breloc   , "node_reloc"         );
     ADD_PARAMETER(m_bsmaug   , "smooth_aug"         );
     ADD_PARAMETER(m_bdupr    , "dual_proj"          );
+    ADD_PARAMETER(m_bparallel, "parallel_assembly"  );
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -491,6 +492,9 @@ FESlidingInterface2::FESlidingInterface2(FEModel* pfem) : FEContactInterface(pfe
 
 	m_naugmin = 0;
 	m_naugmax = 10;
+	m_naug = 0;
+	m_biter = 0;
+	m_bfirst = true;
 
 	m_dofP = pfem->GetDOFIndex("p");
 
@@ -558,7 +562,7 @@ void FESlidingInterface2::BuildMatrixProfile(FEGlobalMatrix& K)
 
 					for (l=0; l<nseln; ++l)
 					{
-						vector<int>& id = mesh.Node(sn[l]).m_ID;
+						FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
 						lm[7*l  ] = id[dof_X];
 						lm[7*l+1] = id[dof_Y];
 						lm[7*l+2] = id[dof_Z];
@@ -570,7 +574,7 @@ void FESlidingInterface2::BuildMatrixProfile(FEGlobalMatrix& K)
 
 					for (l=0; l<nmeln; ++l)
 					{
-						vector<int>& id = mesh.Node(mn[l]).m_ID;
+						FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
 						lm[7*(l+nseln)  ] = id[dof_X];
 						lm[7*(l+nseln)+1] = id[dof_Y];
 						lm[7*(l+nseln)+2] = id[dof_Z];
@@ -780,6 +784,9 @@ void FESlidingInterface2::ProjectSurface(FESlidingSurface2& ss, FESlidingSurface
 		}
 	}
 
+	// the primary nodes moved, so the reference geometry changed
+	if (bmove) mesh.UpdateReferenceCache();
+
 	// loop over all integration points
  //   #pragma omp parallel for shared(R, bupseg)
 	for (int i=0; i<ss.Elements(); ++i)
@@ -900,9 +907,6 @@ void FESlidingInterface2::Update()
 {	
 	double rs[2];
 
-	static int naug = 0;
-	static int biter = 0;
-
 	FEModel& fem = *GetFEModel();
 	
 	// get the iteration number
@@ -911,15 +915,15 @@ void FESlidingInterface2::Update()
 	FEAnalysis* pstep = fem.GetCurrentStep();
 	FESolver* psolver = pstep->GetFESolver();
 	if (psolver->m_niter == 0) {
-		biter = 0;
-		naug = psolver->m_naug;
+		m_biter = 0;
+		m_naug = psolver->m_naug;
         // check update of auto-penalty
         if (m_bupdtpen) UpdateAutoPenalty();
-	} else if (psolver->m_naug > naug) {
-		biter = psolver->m_niter;
-		naug = psolver->m_naug;
+	} else if (psolver->m_naug > m_naug) {
+		m_biter = psolver->m_niter;
+		m_naug = psolver->m_naug;
 	}
-	int niter = psolver->m_niter - biter;
+	int niter = psolver->m_niter - m_biter;
 	bool bupseg = ((m_nsegup == 0)? true : (niter <= m_nsegup));
 	// get the logfile
 //	Logfile& log = GetLogfile();
@@ -927,10 +931,9 @@ void FESlidingInterface2::Update()
 	
 	// project the surfaces onto each other
 	// this will update the gap functions as well
-	static bool bfirst = true;
-	ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
+	ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && m_bfirst));
 	if (m_btwo_pass || m_ms.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
-	bfirst = false;
+	m_bfirst = false;
 
 	// Update the net contact pressures
 	UpdateContactPressures();
@@ -1051,7 +1054,11 @@ void FESlidingInterface2::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		FESlidingSurface2& ss = (np == 0? m_ss : m_ms);
 		FESlidingSurface2& ms = (np == 0? m_ms : m_ss);
 
+		// per-element contact forces
+		vector<vec3d> Fs(ss.Elements()), Fm(ss.Elements());
+
 		// loop over all primary surface elements
+#pragma omp parallel for if (m_bparallel) schedule(dynamic) private(j, k, sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, N)
 		for (i=0; i<ss.Elements(); ++i)
 		{
 			// get the surface element
@@ -1173,12 +1180,12 @@ void FESlidingInterface2::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 
 					for (k=0; k<nseln; ++k)
 					{
-						ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+						Fs[i] += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
 					}
 
 					for (k = 0; k<nmeln; ++k)
 					{
-						ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+						Fm[i] += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
 					}
 
 					// assemble the global residual
@@ -1214,6 +1221,13 @@ void FESlidingInterface2::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 				}
 			}
 		}
+
+		// sum the element forces in a fixed order so the totals do not depend on the thread count
+		for (int i=0; i<ss.Elements(); ++i)
+		{
+			ss.m_Ft += Fs[i];
+			ms.m_Ft += Fm[i];
+		}
 	}
 }
 
@@ -1259,6 +1273,7 @@ void FESlidingInterface2::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 		FESlidingSurface2& ms = (np == 0? m_ms : m_ss);
 
 		// loop over all primary surface elements
+#pragma omp parallel for if (m_bparallel) schedule(dynamic) private(j, k, l, sLM, mLM, LM, en, detJ, w, Hs, Hm, pt, dpr, dps, N, ke)
 		for (i=0; i<ss.Elements(); ++i)
 		{
 			// get the next element
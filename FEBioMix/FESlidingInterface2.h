@@ -193,5 +193,10 @@ public:
 protected:
 	int	m_dofP;
 
+	// segment update state (kept per interface)
+	int		m_naug;		//!< augmentation count at last update
+	int		m_biter;	//!< solver iteration at start of current augmentation
+	bool	m_bfirst;	//!< first surface projection has not been done yet
+
 	DECLARE_FECORE_CLASS();
 };
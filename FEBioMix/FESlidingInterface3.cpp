@@ -61,6 +61,7 @@ BEGIN_FECORE_CLASS(FESlidingInterface3, FEContactInterface)
     ADD_PARAMETER(m_bsmaug   , "smooth_aug"         );
 	ADD_PARAMETER(m_ambp     , "ambient_pressure"     );
 	ADD_PARAMETER(m_ambc     , "ambient_concentration");
+	ADD_PARAMETER(m_bparallel, "parallel_assembly"  );
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -135,7 +136,7 @@ void FESlidingSurface3::UnpackLM(FEElement& el, vector<int>& lm)
 		int n = el.m_node[i];
 
 		FENode& node = m_pMesh->Node(n);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		// first the displacement dofs
 		lm[3*i  ] = id[m_dofX];
@@ -452,6 +453,9 @@ FESlidingInterface3::FESlidingInterface3(FEModel* pfem) : FEContactInterface(pfe
 	
 	m_naugmin = 0;
 	m_naugmax = 10;
+	m_naug = 0;
+	m_biter = 0;
+	m_bfirst = true;
 
 	m_dofP = pfem->GetDOFIndex("p");
 	m_dofC = pfem->GetDOFIndex("concentration", 0);
@@ -533,7 +537,7 @@ void FESlidingInterface3::BuildMatrixProfile(FEGlobalMatrix& K)
 									
 					for (l=0; l<nseln; ++l)
 					{
-						vector<int>& id = mesh.Node(sn[l]).m_ID;
+						FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
 						lm[8*l  ] = id[dof_X];
 						lm[8*l+1] = id[dof_Y];
 						lm[8*l+2] = id[dof_Z];
@@ -546,7 +550,7 @@ void FESlidingInterface3::BuildMatrixProfile(FEGlobalMatrix& K)
 									
 					for (l=0; l<nmeln; ++l)
 					{
-						vector<int>& id = mesh.Node(mn[l]).m_ID;
+						FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
 						lm[8*(l+nseln)  ] = id[dof_X];
 						lm[8*(l+nseln)+1] = id[dof_Y];
 						lm[8*(l+nseln)+2] = id[dof_Z];
@@ -865,6 +869,9 @@ void FESlidingInterface3::ProjectSurface(FESlidingSurface3& ss, FESlidingSurface
         }
     }
     
+	// the primary nodes moved, so the reference geometry changed
+	if (bmove) mesh.UpdateReferenceCache();
+
 	// loop over all integration points
 //    #pragma omp parallel for shared(R, bupseg)
 	for (int i=0; i<ss.Elements(); ++i)
@@ -1015,24 +1022,21 @@ void FESlidingInterface3::Update()
     
 	double R = m_srad*fem.GetMesh().GetBoundingBox().radius();
 	
-	static int naug = 0;
-	static int biter = 0;
-
 	// get the iteration number
 	// we need this number to see if we can do segment updates or not
 	// also reset number of iterations after each augmentation
 	FEAnalysis* pstep = fem.GetCurrentStep();
 	FESolver* psolver = pstep->GetFESolver();
 	if (psolver->m_niter == 0) {
-		biter = 0;
-		naug = psolver->m_naug;
+		m_biter = 0;
+		m_naug = psolver->m_naug;
         // check update of auto-penalty
         if (m_bupdtpen) UpdateAutoPenalty();
-	} else if (psolver->m_naug > naug) {
-		biter = psolver->m_niter;
-		naug = psolver->m_naug;
+	} else if (psolver->m_naug > m_naug) {
+		m_biter = psolver->m_niter;
+		m_naug = psolver->m_naug;
 	}
-	int niter = psolver->m_niter - biter;
+	int niter = psolver->m_niter - m_biter;
 	bool bupseg = ((m_nsegup == 0)? true : (niter <= m_nsegup));
 	// get the logfile
 	//	Logfile& log = GetLogfile();
@@ -1040,10 +1044,9 @@ void FESlidingInterface3::Update()
 	
 	// project the surfaces onto each other
 	// this will update the gap functions as well
-    static bool bfirst = true;
-    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
+    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && m_bfirst));
 	if (m_btwo_pass || m_ss.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
-    bfirst = false;
+    m_bfirst = false;
 	
 	// Update the net contact pressures
 	UpdateContactPressures();
@@ -1174,7 +1177,11 @@ void FESlidingInterface3::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		FESlidingSurface3& ss = (np == 0? m_ss : m_ms);
 		FESlidingSurface3& ms = (np == 0? m_ms : m_ss);
 		
+		// per-element contact forces
+		vector<vec3d> Fs(ss.Elements()), Fm(ss.Elements());
+
 		// loop over all primary surface elements
+#pragma omp parallel for if (m_bparallel) schedule(dynamic) private(sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, N)
 		for (int i = 0; i<ss.Elements(); ++i)
 		{
 			// get the surface element
@@ -1298,12 +1305,12 @@ void FESlidingInterface3::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 					
                     for (int k=0; k<nseln; ++k)
                     {
-                        ss.m_Ft += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
+                        Fs[i] += vec3d(fe[k*3], fe[k*3+1], fe[k*3+2]);
                     }
                     
                     for (int k = 0; k<nmeln; ++k)
                     {
-                        ms.m_Ft += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
+                        Fm[i] += vec3d(fe[(k + nseln) * 3], fe[(k + nseln) * 3 + 1], fe[(k + nseln) * 3 + 2]);
                     }
                     
 					// assemble the global residual
@@ -1368,6 +1375,13 @@ void FESlidingInterface3::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 				}
 			}
 		}
+
+		// sum the element forces in a fixed order so the totals do not depend on the thread count
+		for (int i=0; i<ss.Elements(); ++i)
+		{
+			ss.m_Ft += Fs[i];
+			ms.m_Ft += Fm[i];
+		}
 	}
 }
 
@@ -1415,6 +1429,7 @@ void FESlidingInterface3::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 		FESlidingSurface3& ms = (np == 0? m_ms : m_ss);
 		
 		// loop over all primary surface elements
+#pragma omp parallel for if (m_bparallel) schedule(dynamic) private(j, k, l, sLM, mLM, LM, en, detJ, w, Hs, Hm, pt, dpr, dps, ct, dcr, dcs, N, ke)
 		for (i=0; i<ss.Elements(); ++i)
 		{
 			// get the next element
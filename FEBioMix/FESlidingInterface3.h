@@ -211,5 +211,10 @@ protected:
 	int	m_dofP;
 	int	m_dofC;
 
+	// segment update state (kept per interface)
+	int		m_naug;		//!< augmentation count at last update
+	int		m_biter;	//!< solver iteration at start of current augmentation
+	bool	m_bfirst;	//!< first surface projection has not been done yet
+
 	DECLARE_FECORE_CLASS();
 };
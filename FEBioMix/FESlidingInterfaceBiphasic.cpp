@@ -61,6 +61,7 @@ BEGIN_FECORE_CLASS(FESlidingInterfaceBiphasic, FEContactInterface)
     ADD_PARAMETER(m_bflipm   , "flip_secondary"     );
     ADD_PARAMETER(m_bshellbs , "shell_bottom_primary"  );
     ADD_PARAMETER(m_bshellbm , "shell_bottom_secondary");
+    ADD_PARAMETER(m_bparallel, "parallel_assembly"  );
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -548,6 +549,9 @@ FESlidingInterfaceBiphasic::FESlidingInterfaceBiphasic(FEModel* pfem) : FEContac
     
     m_naugmin = 0;
     m_naugmax = 10;
+    m_naug = 0;
+    m_biter = 0;
+    m_bfirst = true;
     
     m_bfreeze = false;
     m_bflipm = m_bflips = false;
@@ -628,7 +632,7 @@ void FESlidingInterfaceBiphasic::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nseln; ++l)
                     {
-                        vector<int>& id = mesh.Node(sn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
                         lm[7*l  ] = id[dof_X];
                         lm[7*l+1] = id[dof_Y];
                         lm[7*l+2] = id[dof_Z];
@@ -640,7 +644,7 @@ void FESlidingInterfaceBiphasic::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nmeln; ++l)
                     {
-                        vector<int>& id = mesh.Node(mn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
                         lm[7*(l+nseln)  ] = id[dof_X];
                         lm[7*(l+nseln)+1] = id[dof_Y];
                         lm[7*(l+nseln)+2] = id[dof_Z];
@@ -845,6 +849,9 @@ void FESlidingInterfaceBiphasic::ProjectSurface(FESlidingSurfaceBiphasic& ss, FE
         }
     }
     
+    // the primary nodes moved, so the reference geometry changed
+    if (bmove) mesh.UpdateReferenceCache();
+
     // loop over all integration points
 #pragma omp parallel for
     for (int i=0; i<ss.Elements(); ++i)
@@ -975,9 +982,6 @@ void FESlidingInterfaceBiphasic::ProjectSurface(FESlidingSurfaceBiphasic& ss, FE
 
 void FESlidingInterfaceBiphasic::Update()
 {
-    static int naug = 0;
-    static int biter = 0;
-    
     FEModel& fem = *GetFEModel();
     
     // get the iteration number
@@ -986,15 +990,15 @@ void FESlidingInterfaceBiphasic::Update()
     FEAnalysis* pstep = fem.GetCurrentStep();
     FESolver* psolver = pstep->GetFESolver();
     if (psolver->m_niter == 0) {
-        biter = 0;
-        naug = psolver->m_naug;
+        m_biter = 0;
+        m_naug = psolver->m_naug;
         // check update of auto-penalty
         if (m_bupdtpen) UpdateAutoPenalty();
-    } else if (psolver->m_naug > naug) {
-        biter = psolver->m_niter;
-        naug = psolver->m_naug;
+    } else if (psolver->m_naug > m_naug) {
+        m_biter = psolver->m_niter;
+        m_naug = psolver->m_naug;
     }
-    int niter = psolver->m_niter - biter;
+    int niter = psolver->m_niter - m_biter;
     bool bupseg = ((m_nsegup == 0)? true : (niter <= m_nsegup));
     // get the logfile
     //	Logfile& log = GetLogfile();
@@ -1002,10 +1006,9 @@ void FESlidingInterfaceBiphasic::Update()
     
     // project the surfaces onto each other
     // this will update the gap functions as well
-    static bool bfirst = true;
-    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
+    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && m_bfirst));
     if (m_btwo_pass || m_ms.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
-    bfirst = false;
+    m_bfirst = false;
     
     // Call InitSlidingSurface on the first iteration of each time step
 	int nsolve_iter = psolver->m_niter;
@@ -1466,7 +1469,11 @@ void FESlidingInterfaceBiphasic::LoadVector(FEGlobalVector& R, const FETimeInfo&
         FESlidingSurfaceBiphasic& ss = (np == 0? m_ss : m_ms);
         FESlidingSurfaceBiphasic& ms = (np == 0? m_ms : m_ss);
         
+        // per-element contact forces
+        vector<vec3d> Fs(ss.Elements()), Fm(ss.Elements());
+
         // loop over all primary surface elements
+#pragma omp parallel for if (m_bparallel) schedule(dynamic) private(sLM, mLM, LM, en, fe, detJ, w, Hs, Hm, N)
         for (int i=0; i<ss.Elements(); ++i)
         {
             // get the surface element
@@ -1579,10 +1586,10 @@ void FESlidingInterfaceBiphasic::LoadVector(FEGlobalVector& R, const FETimeInfo&
                         
                         // calculate contact forces
                         for (int k=0; k<nseln; ++k)
-                            ss.m_Ft += vec3d(fe[3*k], fe[3*k+1], fe[3*k+2]);
+                            Fs[i] += vec3d(fe[3*k], fe[3*k+1], fe[3*k+2]);
                         
                         for (int k = 0; k<nmeln; ++k)
-                            ms.m_Ft += vec3d(fe[3*(k+nseln)], fe[3*(k+nseln)+1], fe[3*(k+nseln)+2]);
+                            Fm[i] += vec3d(fe[3*(k+nseln)], fe[3*(k+nseln)+1], fe[3*(k+nseln)+2]);
                         
                         // assemble the global residual
                         R.Assemble(en, LM, fe);
@@ -1618,6 +1625,13 @@ void FESlidingInterfaceBiphasic::LoadVector(FEGlobalVector& R, const FETimeInfo&
                 }
             }
         }
+
+        // sum the element forces in a fixed order so the totals do not depend on the thread count
+        for (int i=0; i<ss.Elements(); ++i)
+        {
+            ss.m_Ft += Fs[i];
+            ms.m_Ft += Fm[i];
+        }
     }
 }
 
@@ -1649,6 +1663,7 @@ void FESlidingInterfaceBiphasic::StiffnessMatrix(FELinearSystem& LS, const FETim
         FEMesh& mesh = *ms.GetMesh();
         
         // loop over all primary elements
+#pragma omp parallel for if (m_bparallel) schedule(dynamic) private(detJ, w, Hs, Hm, N, sLM, mLM, LM, en, ke)
         for (int i=0; i<ss.Elements(); ++i)
         {
             // get the primary element
@@ -550,7 +550,7 @@ void FESlidingSurfaceBiphasicMixed::UnpackLM(FEElement& el, vector<int>& lm)
 		int n = el.m_node[i];
 
 		FENode& node = m_pMesh->Node(n);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		// first the displacement dofs
 		lm[3 * i    ] = id[m_dofX];
@@ -593,6 +593,9 @@ FESlidingInterfaceBiphasicMixed::FESlidingInterfaceBiphasicMixed(FEModel* pfem)
     
     m_naugmin = 0;
     m_naugmax = 10;
+    m_naug = 0;
+    m_biter = 0;
+    m_bfirst = true;
     
     m_bfreeze = false;
     m_bflipm = m_bflips = false;
@@ -673,7 +676,7 @@ void FESlidingInterfaceBiphasicMixed::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nseln; ++l)
                     {
-                        vector<int>& id = mesh.Node(sn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
                         lm[7*l  ] = id[dof_X];
                         lm[7*l+1] = id[dof_Y];
                         lm[7*l+2] = id[dof_Z];
@@ -685,7 +688,7 @@ void FESlidingInterfaceBiphasicMixed::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nmeln; ++l)
                     {
-                        vector<int>& id = mesh.Node(mn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
                         lm[7*(l+nseln)  ] = id[dof_X];
                         lm[7*(l+nseln)+1] = id[dof_Y];
                         lm[7*(l+nseln)+2] = id[dof_Z];
@@ -894,6 +897,9 @@ void FESlidingInterfaceBiphasicMixed::ProjectSurface(FESlidingSurfaceBiphasicMix
         }
     }
     
+    // the primary nodes moved, so the reference geometry changed
+    if (bmove) mesh.UpdateReferenceCache();
+
     // loop over all integration points
 #pragma omp parallel for
     for (int i=0; i<ss.Elements(); ++i)
@@ -1029,9 +1035,6 @@ void FESlidingInterfaceBiphasicMixed::Update()
 	DOFS& dofs = GetFEModel()->GetDOFS();
 	int degree_p = dofs.GetVariableInterpolationOrder(m_ss.m_varP);
 
-    static int naug = 0;
-    static int biter = 0;
-    
     FEModel& fem = *GetFEModel();
     
     // get the iteration number
@@ -1040,15 +1043,15 @@ void FESlidingInterfaceBiphasicMixed::Update()
     FEAnalysis* pstep = fem.GetCurrentStep();
     FESolver* psolver = pstep->GetFESolver();
     if (psolver->m_niter == 0) {
-        biter = 0;
-        naug = psolver->m_naug;
+        m_biter = 0;
+        m_naug = psolver->m_naug;
         // check update of auto-penalty
         if (m_bupdtpen) UpdateAutoPenalty();
-    } else if (psolver->m_naug > naug) {
-        biter = psolver->m_niter;
-        naug = psolver->m_naug;
+    } else if (psolver->m_naug > m_naug) {
+        m_biter = psolver->m_niter;
+        m_naug = psolver->m_naug;
     }
-    int niter = psolver->m_niter - biter;
+    int niter = psolver->m_niter - m_biter;
     bool bupseg = ((m_nsegup == 0)? true : (niter <= m_nsegup));
     // get the logfile
     //	Logfile& log = GetLogfile();
@@ -1056,10 +1059,9 @@ void FESlidingInterfaceBiphasicMixed::Update()
     
     // project the surfaces onto each other
     // this will update the gap functions as well
-    static bool bfirst = true;
-    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && bfirst));
+    ProjectSurface(m_ss, m_ms, bupseg, (m_breloc && m_bfirst));
     if (m_btwo_pass || m_ms.m_bporo) ProjectSurface(m_ms, m_ss, bupseg);
-    bfirst = false;
+    m_bfirst = false;
     
     // Call InitSlidingSurface on the first iteration of each time step
 	int nsolve_iter = psolver->m_niter;
@@ -40,7 +40,7 @@ BEGIN_FECORE_CLASS(FESolutePointSource, FEBodyLoad)
 	ADD_PARAMETER(m_pos.z, "z");
 END_FECORE_CLASS();
 
-FESolutePointSource::FESolutePointSource(FEModel* fem) : FEBodyLoad(fem), m_search(&fem->GetMesh())
+FESolutePointSource::FESolutePointSource(FEModel* fem) : FEBodyLoad(fem)
 {
 	m_dofC = -1;
 	m_soluteId = -1;
@@ -101,9 +101,6 @@ bool FESolutePointSource::Init()
 	}
 	if (bfound == false) return false;
 
-	// initialize octree search
-	if (m_search.Init() == false) return false;
-
 	// get the degree of freedom of the concentration
 	m_dofC = fem->GetDOFIndex("concentration", m_soluteId - 1);
 
@@ -113,7 +110,7 @@ bool FESolutePointSource::Init()
 void FESolutePointSource::Accumulate(double dc) {
 	// find the element in which the point lies
 	m_q[0] = m_q[1] = m_q[2] = 0.0;
-	m_el = dynamic_cast<FESolidElement*>(m_search.FindElement(m_pos, m_q));
+	m_el = GetFEModel()->GetMesh().FindReferenceSolidElement(m_pos, m_q);
 	if (m_el == nullptr) return;
 
 	// make sure this element is part of a multiphasic domain
@@ -148,7 +145,7 @@ void FESolutePointSource::Update()
 	//if (m_accumulate_ca) {
 	//	// find the element in which the point lies
 	//	m_q[0] = m_q[1] = m_q[2] = 0.0;
-	//	m_el = dynamic_cast<FESolidElement*>(m_search.FindElement(m_pos, m_q));
+	//	m_el = GetFEModel()->GetMesh().FindReferenceSolidElement(m_pos, m_q);
 	//	if (m_el == nullptr) return;
 
 	//	// make sure this element is part of a multiphasic domain
@@ -182,7 +179,7 @@ void FESolutePointSource::Update()
 	//	double H[FEElement::MAX_NODES];
 	//	double m_q[3];
 	//	m_q[0] = m_q[1] = m_q[2] = 0.0;
-	//	FESolidElement* m_el = dynamic_cast<FESolidElement*>(m_search.FindElement(m_pos, m_q));
+	//	FESolidElement* m_el = GetFEModel()->GetMesh().FindReferenceSolidElement(m_pos, m_q);
 	//	if (m_el == nullptr) return;
 	//	m_el->shape_fnc(H, m_q[0], m_q[1], m_q[2]);
 
@@ -25,7 +25,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.*/
 #pragma once
 #include <FECore/FEBodyLoad.h>
-#include <FECore/FEOctreeSearch.h>
+#include <FECore/vec3d.h>
 
 class FESolidElement;
 
@@ -76,7 +76,6 @@ private:
 	double	m_radius;
 
 private:
-	FEOctreeSearch		m_search;
 	FESolidElement*		m_el;
 	double				m_q[3];
 	int					m_dofC;
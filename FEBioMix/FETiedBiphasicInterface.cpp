@@ -304,7 +304,7 @@ void FETiedBiphasicInterface::BuildMatrixProfile(FEGlobalMatrix& K)
 									
 					for (l=0; l<nseln; ++l)
 					{
-						vector<int>& id = mesh.Node(sn[l]).m_ID;
+						FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
 						lm[7*l  ] = id[dof_X];
 						lm[7*l+1] = id[dof_Y];
 						lm[7*l+2] = id[dof_Z];
@@ -316,7 +316,7 @@ void FETiedBiphasicInterface::BuildMatrixProfile(FEGlobalMatrix& K)
 									
 					for (l=0; l<nmeln; ++l)
 					{
-						vector<int>& id = mesh.Node(mn[l]).m_ID;
+						FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
 						lm[7*(l+nseln)  ] = id[dof_X];
 						lm[7*(l+nseln)+1] = id[dof_Y];
 						lm[7*(l+nseln)+2] = id[dof_Z];
@@ -121,7 +121,7 @@ void FETiedMultiphasicSurface::UnpackLM(FEElement& el, vector<int>& lm)
         int n = el.m_node[i];
         
         FENode& node = m_pMesh->Node(n);
-        vector<int>& id = node.m_ID;
+        FENodeDofArray<int>& id = node.m_ID;
         
         // first the displacement dofs
         lm[3*i  ] = id[m_dofX];
@@ -400,7 +400,7 @@ void FETiedMultiphasicInterface::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nseln; ++l)
                     {
-                        vector<int>& id = mesh.Node(sn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(sn[l]).m_ID;
                         lm[ndpn*l  ] = id[dof_X];
                         lm[ndpn*l+1] = id[dof_Y];
                         lm[ndpn*l+2] = id[dof_Z];
@@ -412,7 +412,7 @@ void FETiedMultiphasicInterface::BuildMatrixProfile(FEGlobalMatrix& K)
                     
                     for (l=0; l<nmeln; ++l)
                     {
-                        vector<int>& id = mesh.Node(mn[l]).m_ID;
+                        FENodeDofArray<int>& id = mesh.Node(mn[l]).m_ID;
                         lm[ndpn*(l+nseln)  ] = id[dof_X];
                         lm[ndpn*(l+nseln)+1] = id[dof_Y];
                         lm[ndpn*(l+nseln)+2] = id[dof_Z];
@@ -84,7 +84,7 @@ void FETriphasicDomain::UnpackLM(FEElement& el, vector<int>& lm)
 		int n = el.m_node[i];
 		FENode& node = m_pMesh->Node(n);
 
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		// first the displacement dofs
 		lm[6*i  ] = id[m_dofU[0]];
@@ -80,7 +80,7 @@ void FEDataParameter::update()
 	m_rf.Add(x, y);
 }
 
-FEDataParameter::FEDataParameter(FEModel* fem) : FEDataSource(fem), m_rf(fem)
+FEDataParameter::FEDataParameter(FEModel* fem) : FEDataSource(fem), m_rf(fem), m_rfs(fem)
 {
 	m_ord = "fem.time";
 }
@@ -362,6 +362,16 @@ double FEDataParameter::Evaluate(double x)
 	return m_rf.value(x);
 }
 
+void FEDataParameter::SaveState()
+{
+	m_rfs.CopyFrom(m_rf);
+}
+
+void FEDataParameter::RestoreState()
+{
+	m_rf.CopyFrom(m_rfs);
+}
+
 //=================================================================================================
 FEDataFilterPositive::FEDataFilterPositive(FEModel* fem) : FEDataSource(fem)
 {
@@ -397,9 +407,19 @@ double FEDataFilterPositive::Evaluate(double t)
 	return (v >= 0.0 ? v : -v);
 }
 
+void FEDataFilterPositive::SaveState()
+{
+	if (m_src) m_src->SaveState();
+}
+
+void FEDataFilterPositive::RestoreState()
+{
+	if (m_src) m_src->RestoreState();
+}
+
 
 //=================================================================================================
-FEDataFilterSum::FEDataFilterSum(FEModel* fem) : FEDataSource(fem), m_rf(fem)
+FEDataFilterSum::FEDataFilterSum(FEModel* fem) : FEDataSource(fem), m_rf(fem), m_rfs(fem)
 {
 	m_data = nullptr;
 	m_nodeSet = nullptr;
@@ -443,6 +463,16 @@ double FEDataFilterSum::Evaluate(double x)
 	return m_rf.value(x);
 }
 
+void FEDataFilterSum::SaveState()
+{
+	m_rfs.CopyFrom(m_rf);
+}
+
+void FEDataFilterSum::RestoreState()
+{
+	m_rf.CopyFrom(m_rfs);
+}
+
 bool FEDataFilterSum::update(FEModel* pmdl, unsigned int nwhen, void* pd)
 {
 	// get the optimizaton data
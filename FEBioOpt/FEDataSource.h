@@ -50,6 +50,12 @@ public:
 	// Evaluate source at x
 	virtual double Evaluate(double x) = 0;
 
+	// store the data that was collected so far
+	virtual void SaveState() {}
+
+	// restore the data that was stored with SaveState
+	virtual void RestoreState() {}
+
 protected:
 	FEModel&			m_fem;	//!< reference to model
 };
@@ -78,6 +84,10 @@ public:
 	// Evaluate the model parameter at x
 	double Evaluate(double x) override;
 
+	// store/restore collected data
+	void SaveState() override;
+	void RestoreState() override;
+
 	// evaluate the current value
 	double value() { return m_fy(); }
 
@@ -91,6 +101,7 @@ private:
 	std::function<double()>	m_fx;				//!< pointer to ordinate value
 	std::function<double()>	m_fy;				//!< pointer to variable data
 	FEPointFunction		m_rf;	//!< reaction force data
+	FEPointFunction		m_rfs;	//!< stored reaction force data
 };
 
 //-------------------------------------------------------------------------------------------------
@@ -115,6 +126,10 @@ public:
 	// evaluate data source at x
 	double Evaluate(double x) override;
 
+	// store/restore collected data
+	void SaveState() override;
+	void RestoreState() override;
+
 private:
 	FEDataSource*	m_src;
 };
@@ -137,6 +152,9 @@ public:
 	// evaluate data source at x
 	double Evaluate(double x) override;
 
+	// store/restore collected data
+	void SaveState() override;
+	void RestoreState() override;
 
 private:
 	static bool update(FEModel* pmdl, unsigned int nwhen, void* pd);
@@ -146,4 +164,5 @@ private:
 	FENodeLogData*	m_data;
 	FENodeSet*		m_nodeSet;
 	FEPointFunction		m_rf;
+	FEPointFunction		m_rfs;
 };
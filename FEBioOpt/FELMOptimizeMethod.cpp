@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include "FEOptimizeInput.h"
 #include "FECore/FEAnalysis.h"
 #include "FECore/log.h"
+#include "FECore/sys.h"
 
 //-----------------------------------------------------------------------------
 BEGIN_FECORE_CLASS(FELMOptimizeMethod, FEOptimizeMethod)
@@ -39,6 +40,8 @@ BEGIN_FECORE_CLASS(FELMOptimizeMethod, FEOptimizeMethod)
 	ADD_PARAMETER(m_fdiff , "f_diff_scale");
 	ADD_PARAMETER(m_nmax  , "max_iter"    );
 	ADD_PARAMETER(m_bcov  , "print_cov"   );
+	ADD_PARAMETER(m_nmodels , "fd_models" );
+	ADD_PARAMETER(m_nthreads, "fd_threads");
 END_FECORE_CLASS();
 
 //-----------------------------------------------------------------------------
@@ -75,6 +78,8 @@ FELMOptimizeMethod::FELMOptimizeMethod()
 	m_fdiff  = 0.001;
 	m_nmax   = 100;
 	m_bcov   = 0;
+	m_nmodels  = 1;
+	m_nthreads = 0;
 	m_loglevel = LogLevel::LOG_NEVER;
 }
 
@@ -196,6 +201,13 @@ void FELMOptimizeMethod::ObjFun(vector<double>& x, vector<double>& a, vector<dou
 		}
 	}
 	
+	// solve the base point and the forward differences concurrently
+	if (m_nmodels > 1)
+	{
+		ConcurrentObjFun(a, y, dyda, dir);
+		return;
+	}
+
 	// evaluate at a
 	if (opt.FESolve(a) == false) throw FEErrorTermination();
 	
@@ -223,6 +235,47 @@ void FELMOptimizeMethod::ObjFun(vector<double>& x, vector<double>& a, vector<dou
 	}
 }
 
+//-----------------------------------------------------------------------------
+//! Same as ObjFun, but the model is solved for a and all perturbed parameter sets
+//! at the same time on independent copies of the model. The parameter sets and
+//! the differences are the same as in the serial evaluation.
+void FELMOptimizeMethod::ConcurrentObjFun(vector<double>& a, vector<double>& y, matrix& dyda, double dir)
+{
+	FEOptimizeData& opt = *m_pOpt;
+	int ma = (int)a.size();
+
+	// set up the parameter sets
+	vector< vector<double> > A(ma + 1, a), Y;
+	for (int i = 0; i<ma; ++i)
+	{
+		FEInputParameter& var = *opt.GetInputParameter(i);
+		double b = var.ScaleFactor();
+		A[i + 1][i] = a[i] + dir*m_fdiff*(fabs(b) + fabs(a[i]));
+		assert(A[i + 1][i] != a[i]);
+	}
+
+	// split the threads over the models
+	int nthreads = m_nthreads;
+	if (nthreads <= 0)
+	{
+		nthreads = omp_get_max_threads() / m_nmodels;
+		if (nthreads < 1) nthreads = 1;
+	}
+
+	// solve all sets
+	if (opt.FESolve(A, Y, m_nmodels, nthreads) == false) throw FEErrorTermination();
+
+	y = Y[0];
+	m_yopt = y;
+
+	// calculate the derivatives using forward differences
+	int ndata = (int)y.size();
+	for (int i = 0; i<ma; ++i)
+	{
+		for (int j = 0; j<ndata; ++j) dyda[j][i] = (Y[i + 1][j] - y[j]) / (A[i + 1][i] - a[i]);
+	}
+}
+
 //-----------------------------------------------------------------------------
 void mrqmin(vector<double>& x, 
 			vector<double>& y, 
@@ -45,6 +45,8 @@ protected:
 
 	void ObjFun(vector<double>& x, vector<double>& a, vector<double>& y, matrix& dyda);
 
+	void ConcurrentObjFun(vector<double>& a, vector<double>& y, matrix& dyda, double dir);
+
 	static FELMOptimizeMethod* m_pThis;
 	static void objfun(vector<double>& x, vector<double>& a, vector<double>& y, matrix& dyda) { return m_pThis->ObjFun(x, a, y, dyda); }
 
@@ -53,6 +55,8 @@ public:
 	double			m_fdiff;	// forward difference step size
 	int				m_nmax;		// maximum number of iterations
 	bool			m_bcov;		// flag to print covariant matrix
+	int				m_nmodels;	// number of models that are solved concurrently for the derivatives
+	int				m_nthreads;	// number of OpenMP threads per model (0 = divide available threads)
 
 protected:
 	vector<double>	m_yopt;	// optimal y-values
@@ -146,6 +146,18 @@ void FEDataFitObjective::Reset()
 	m_src->Reset();
 }
 
+//----------------------------------------------------------------------------
+void FEDataFitObjective::SaveState()
+{
+	m_src->SaveState();
+}
+
+//----------------------------------------------------------------------------
+void FEDataFitObjective::RestoreState()
+{
+	m_src->RestoreState();
+}
+
 //----------------------------------------------------------------------------
 // return the number of measurements. I.e. the size of the measurement vector
 int FEDataFitObjective::Measurements()
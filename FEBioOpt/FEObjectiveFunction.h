@@ -70,6 +70,13 @@ public:
 	// evaluate objective function
 	double Evaluate();
 
+	// Store the data that was collected during the solve so far. This is used when 
+	// later solves continue from a stored model state.
+	virtual void SaveState() {}
+
+	// restore the data that was stored with SaveState
+	virtual void RestoreState() {}
+
 	// print output to screen or not
 	void SetVerbose(bool b) { m_verbose = b; }
 
@@ -113,6 +120,10 @@ public:
 	// set the data source
 	void SetDataSource(FEDataSource* src);
 
+	// store/restore the data of the data source
+	void SaveState() override;
+	void RestoreState() override;
+
 	// set the data measurements
 	void SetMeasurements(const vector<pair<double, double> >& data);
 
@@ -33,7 +33,12 @@ SOFTWARE.*/
 #include <FECore/FECoreKernel.h>
 #include <FECore/FEModel.h>
 #include <FECore/FEAnalysis.h>
+#include <FECore/FENewtonSolver.h>
 #include <FECore/log.h>
+#include <FECore/sys.h>
+#include <FEBioLib/FEBioModel.h>
+#include <thread>
+#include <atomic>
 //=============================================================================
 
 //-----------------------------------------------------------------------------
@@ -109,12 +114,23 @@ FEOptimizeData::FEOptimizeData(FEModel* fem) : m_fem(fem)
 	m_pTask = 0;
 	m_niter = 0;
 	m_obj = 0;
+
+	m_bwarmStart = false;
+	m_breuseStiffness = false;
+	m_breusePrefix = false;
+
+	m_prefixStep = 0;
+	m_prefixTime = 0.0;
+	m_prefix = nullptr;
+	m_bprefix = false;
 }
 
 //-----------------------------------------------------------------------------
 FEOptimizeData::~FEOptimizeData(void)
 {
+	ClearWorkers();
 	delete m_pSolver;
+	delete m_prefix;
 }
 
 //-----------------------------------------------------------------------------
@@ -151,6 +167,88 @@ bool FEOptimizeData::Init()
 	if (m_obj == 0) return false;
 	if (m_obj->Init() == false) return false;
 
+	// let the Newton solvers start from the solution of the previous solve
+	if (m_bwarmStart)
+	{
+		for (int i = 0; i < m_fem->Steps(); ++i)
+		{
+			FENewtonSolver* solver = dynamic_cast<FENewtonSolver*>(m_fem->GetStep(i)->GetFESolver());
+			if (solver)
+			{
+				solver->m_bwarmStart = true;
+				if (m_breuseStiffness) solver->m_breuseStiffness = true;
+			}
+		}
+	}
+
+	// The steps before the first step that depends on the input parameters give 
+	// the same result for each solve. We store the model state at the start of that
+	// step during the first solve and continue from there in all later solves.
+	if (m_breusePrefix)
+	{
+		m_prefixStep = FirstDependentStep();
+		if (m_prefixStep > 0)
+		{
+			if (m_prefix == nullptr) m_prefix = new FECheckpoint(m_fem);
+			m_fem->AddCallback(prefix_cb, CB_STEP_SOLVED | CB_STEP_ACTIVE, (void*) this);
+			feLog("Steps 1 - %d do not depend on the input parameters and will be solved only once.\n", m_prefixStep);
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Returns the index of the first step with a model component that owns one of the 
+//! input parameters. Parameters that are not owned by a step component (e.g. material
+//! parameters) affect all steps, in which case zero is returned.
+int FEOptimizeData::FirstDependentStep()
+{
+	FEModel& fem = *m_fem;
+	int nstep = fem.Steps();
+	int kmin = nstep;
+	for (int i = 0; i < (int)m_Var.size(); ++i)
+	{
+		FEModelParameter* var = dynamic_cast<FEModelParameter*>(m_Var[i]);
+		if (var == nullptr) return 0;
+		double* pd = var->GetDataPointer();
+
+		int k = nstep;
+		for (int n = 0; (n < nstep) && (k == nstep); ++n)
+		{
+			// the step data itself is part of the stored state, so it can't be optimized
+			FEAnalysis* step = fem.GetStep(n);
+			if (step->FindParameterOwner(pd)) return 0;
+			for (int j = 0; (j < step->ModelComponents()) && (k == nstep); ++j)
+			{
+				if (step->GetModelComponent(j)->FindParameterOwner(pd)) k = n;
+			}
+		}
+		if (k == nstep) return 0;
+		if (k < kmin) kmin = k;
+	}
+	return (kmin < nstep ? kmin : 0);
+}
+
+//-----------------------------------------------------------------------------
+bool FEOptimizeData::prefix_cb(FEModel* fem, unsigned int nwhen, void* pd)
+{
+	FEOptimizeData* opt = (FEOptimizeData*)pd;
+	if (opt->m_bprefix) return true;
+
+	int nstep = fem->GetCurrentStepIndex();
+	if ((nwhen == CB_STEP_SOLVED) && (nstep == opt->m_prefixStep - 1))
+	{
+		// store the state at the end of the last independent step
+		opt->m_prefix->Save();
+		opt->GetObjective().SaveState();
+	}
+	else if ((nwhen == CB_STEP_ACTIVE) && (nstep == opt->m_prefixStep) && opt->m_prefix->IsValid())
+	{
+		// we only get here when the previous step converged
+		opt->m_prefixTime = fem->GetStartTime();
+		opt->m_bprefix = true;
+	}
 	return true;
 }
 
@@ -196,6 +294,9 @@ bool FEOptimizeData::Input(const char *szfile)
 {
 	FEOptimizeInput in;
 	if (in.Input(szfile, this) == false) return false;
+
+	// store the file name so that we can create workers later
+	m_szfile = szfile;
 	return true;
 }
 
@@ -241,6 +342,15 @@ bool FEOptimizeData::FESolve(const vector<double>& a)
 	fem.Reset();
 	fem.UnBlockLog();
 
+	// continue from the first step that depends on the input parameters
+	if (m_bprefix)
+	{
+		m_prefix->Restore();
+		fem.SetStartTime(m_prefixTime);
+		fem.SetCurrentStepIndex(m_prefixStep);
+		obj.RestoreState();
+	}
+
 	// solve the FE problem
 	fem.BlockLog();
 	bool bret = RunTask();
@@ -248,3 +358,120 @@ bool FEOptimizeData::FESolve(const vector<double>& a)
 
 	return bret;
 }
+
+//-----------------------------------------------------------------------------
+//! Create an independent copy of this optimization problem. The model is imported
+//! again from its input file, so the copy does not share any data with this model.
+FEOptimizeData* FEOptimizeData::CreateWorker()
+{
+	FEBioModel* fem = dynamic_cast<FEBioModel*>(m_fem);
+	if ((fem == nullptr) || m_szfile.empty()) return nullptr;
+
+	// the worker models don't write any output
+	FEBioModel* wfem = new FEBioModel;
+	wfem->SetLogLevel(0);
+	wfem->BlockLog();
+	if (wfem->Input(fem->GetInputFileName().c_str()) == false)
+	{
+		delete wfem;
+		return nullptr;
+	}
+	wfem->GetDataStore().Clear();
+
+	FEOptimizeData* opt = new FEOptimizeData(wfem);
+	if ((opt->Input(m_szfile.c_str()) == false) || (opt->Init() == false))
+	{
+		delete opt->m_pTask;
+		delete opt;
+		delete wfem;
+		return nullptr;
+	}
+
+	return opt;
+}
+
+//-----------------------------------------------------------------------------
+void FEOptimizeData::ClearWorkers()
+{
+	for (FEOptimizeData* opt : m_workers)
+	{
+		FEModel* fem = opt->GetFEModel();
+		delete opt->m_pTask;
+		delete opt;
+		delete fem;
+	}
+	m_workers.clear();
+}
+
+//-----------------------------------------------------------------------------
+//! Solve the FE problem for several sets of parameters concurrently. 
+bool FEOptimizeData::FESolve(const vector< vector<double> >& a, vector< vector<double> >& y, int nmodels, int nthreads)
+{
+	int nsets = (int)a.size();
+	y.resize(nsets);
+	if (nsets == 0) return true;
+
+	// there is no point in having more models than parameter sets
+	if (nmodels > nsets) nmodels = nsets;
+	if (nmodels < 1) nmodels = 1;
+
+	// create the workers (this is done only once)
+	while ((int)m_workers.size() < nmodels - 1)
+	{
+		FEOptimizeData* opt = CreateWorker();
+		if (opt == nullptr)
+		{
+			feLogWarning("Failed to create a model copy for concurrent solves.\nSolving %d models concurrently.", (int)m_workers.size() + 1);
+			break;
+		}
+		m_workers.push_back(opt);
+	}
+	nmodels = (int)m_workers.size() + 1;
+
+	// The parameter sets are distributed dynamically over the models. Each set is
+	// solved with a reset model, so the result does not depend on which model solved it
+	// (up to the convergence tolerance when the solves are warm-started).
+	// Exceptions are caught per set and reported after all threads are done.
+	std::atomic<int> next(0);
+	vector<char> ok(nsets, 0);
+	vector<string> err(nsets);
+	auto solveSets = [&](FEOptimizeData* opt) {
+		omp_set_num_threads(nthreads);
+		int i;
+		while ((i = next++) < nsets)
+		{
+			try {
+				if (opt->FESolve(a[i]))
+				{
+					opt->GetObjective().Evaluate(y[i]);
+					ok[i] = 1;
+				}
+			}
+			catch (std::exception& e) { err[i] = e.what(); }
+			catch (...) { err[i] = "unknown exception"; }
+		}
+	};
+
+	// the calling thread works with this model
+	int nthreads0 = omp_get_max_threads();
+	vector<std::thread> threads;
+	for (int i = 0; i < nmodels - 1; ++i) threads.push_back(std::thread(solveSets, m_workers[i]));
+	solveSets(this);
+	for (std::thread& t : threads) t.join();
+	omp_set_num_threads(nthreads0);
+
+	// update the iteration counter
+	for (FEOptimizeData* opt : m_workers) { m_niter += opt->m_niter; opt->m_niter = 0; }
+
+	bool bok = true;
+	for (int i = 0; i < nsets; ++i)
+	{
+		if (ok[i] == 0)
+		{
+			if (err[i].empty()) feLogError("Failed solving parameter set %d.", i);
+			else feLogError("Failed solving parameter set %d:\n%s", i, err[i].c_str());
+			bok = false;
+		}
+	}
+	return bok;
+}
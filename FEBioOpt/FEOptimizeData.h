@@ -30,6 +30,7 @@ SOFTWARE.*/
 #include <FEBioXML/XMLReader.h>
 #include <FECore/FEModel.h>
 #include <FECore/FECoreTask.h>
+#include <FECore/FECheckpoint.h>
 #include "FEObjectiveFunction.h"
 #include <vector>
 #include <string>
@@ -105,6 +106,9 @@ public:
 	//! should return false is the passed value is invalid
 	bool SetValue(double newValue);
 
+	//! return the pointer to the model parameter
+	double* GetDataPointer() { return m_pd; }
+
 private:
 	string	m_name;		//!< variable name
 	double*	m_pd;		//!< pointer to variable data
@@ -144,6 +148,12 @@ public:
 	//! solve the FE problem with a new set of parameters
 	bool FESolve(const vector<double>& a);
 
+	//! Solve the FE problem for several sets of parameters concurrently and return the 
+	//! function values of set i in y[i]. Up to nmodels models are solved at the same time,
+	//! each with nthreads OpenMP threads. The sets are handed out dynamically to this
+	//! model and to independent copies that are imported from the same input files.
+	bool FESolve(const vector< vector<double> >& a, vector< vector<double> >& y, int nmodels, int nthreads);
+
 public:
 	// return the number of input parameters
 	int InputParameters() { return (int)m_Var.size(); }
@@ -179,6 +189,13 @@ public:
 
 	FECoreTask* m_pTask;	// the task that will solve the FE model
 
+	bool	m_bwarmStart;		//!< start the Newton iterations from the solution of the previous solve
+	bool	m_breuseStiffness;	//!< start the next solve with the stiffness matrix of the previous solve
+								//!< (This keeps the factored matrix of the last step in memory between solves. It is the
+								//!< last factorization of the previous solve, so it is only an approximation at the start of the
+								//!< step. The usual reformation checks apply when it does not converge well.)
+	bool	m_breusePrefix;		//!< solve the steps that don't depend on the input parameters only once
+
 protected:
 	FEModel*	m_fem;
 
@@ -188,4 +205,26 @@ protected:
 
 	std::vector<FEInputParameter*>	    m_Var;
 	std::vector<OPT_LIN_CONSTRAINT>		m_LinCon;
+
+private:
+	//! create an independent copy of this optimization problem
+	FEOptimizeData* CreateWorker();
+
+	//! delete all workers and their models
+	void ClearWorkers();
+
+	//! find the first step that depends on the input parameters
+	int FirstDependentStep();
+
+	//! model callback that stores the state at the start of the first dependent step
+	static bool prefix_cb(FEModel* fem, unsigned int nwhen, void* pd);
+
+private:
+	string						m_szfile;	//!< optimization input file
+	vector<FEOptimizeData*>		m_workers;	//!< copies used for concurrent solves
+
+	int				m_prefixStep;	//!< first step that depends on the input parameters
+	double			m_prefixTime;	//!< start time of this step
+	FECheckpoint*	m_prefix;		//!< model state at the start of this step
+	bool			m_bprefix;		//!< the stored model state is valid
 };
@@ -137,6 +137,9 @@ void FEOptionsSection::Parse(XMLTag& tag)
 						else throw XMLReader::InvalidValue(tag);
 					}
 				}
+				else if (tag == "warm_start"     ) tag.value(m_opt->m_bwarmStart);
+				else if (tag == "reuse_stiffness") tag.value(m_opt->m_breuseStiffness);
+				else if (tag == "reuse_prefix"   ) tag.value(m_opt->m_breusePrefix);
 				else throw XMLReader::InvalidTag(tag);
 			}
 			++tag;
@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include <FECore/FESurface.h>
 #include <FECore/FEPlotDataStore.h>
 #include <FECore/log.h>
+#include <FECore/sys.h>
 
 FEBioPlotFile::DICTIONARY_ITEM::DICTIONARY_ITEM()
 {
@@ -712,6 +713,18 @@ void FEBioPlotFile::Close()
 	m_ar.Close();
 }
 
+//-----------------------------------------------------------------------------
+void FEBioPlotFile::Flush()
+{
+	m_ar.Sync();
+}
+
+//-----------------------------------------------------------------------------
+size_t FEBioPlotFile::MemoryUsage()
+{
+	return m_ar.MemoryUsage();
+}
+
 //-----------------------------------------------------------------------------
 bool FEBioPlotFile::Open(const char *szfile)
 {
@@ -724,6 +737,9 @@ bool FEBioPlotFile::Open(const char *szfile)
 	FEPlotDataStore& pltData = fem->GetPlotDataStore();
 	SetCompression(pltData.GetPlotCompression());
 
+	// set the write mode
+	m_ar.SetAsyncWrite(pltData.GetPlotAsync());
+
 	// add plot variables
 	for (int n = 0; n < pltData.PlotVariables(); ++n)
 	{
@@ -1506,8 +1522,30 @@ void FEBioPlotFile::WriteGlobalData(FEModel& fem)
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteNodeData(FEModel& fem)
 {
+	// right now there is only one node set, namely the node set of all mesh nodes
+	int N = fem.GetMesh().Nodes();
+
+	// collect the fields
+	vector<FieldTask> tasks;
 	list<DICTIONARY_ITEM>::iterator it = m_dic.m_Node.begin();
-	for (int i=0; i<(int) m_dic.m_Node.size(); ++i, ++it)
+	for (int i = 0; i < (int)m_dic.m_Node.size(); ++i, ++it)
+	{
+		FEPlotData* pd = it->m_psave;
+		if (pd == nullptr) continue;
+
+		FieldTask task;
+		task.pd = pd;
+		task.nvar = i;
+		task.nregion = 0;
+		task.nsize = pd->VarSize(pd->DataType())*N;
+		task.bok = false;
+		task.bdone = false;
+		tasks.push_back(task);
+	}
+
+	// evaluate and write them in dictionary order
+	int n = 0;
+	for (int i=0; i<(int) m_dic.m_Node.size(); ++i)
 	{
 		m_ar.BeginChunk(PLT_STATE_VARIABLE);
 		{
@@ -1515,7 +1553,19 @@ void FEBioPlotFile::WriteNodeData(FEModel& fem)
 			m_ar.WriteChunk(PLT_STATE_VAR_ID, nid);
 			m_ar.BeginChunk(PLT_STATE_VAR_DATA);
 			{
-				if (it->m_psave) WriteNodeDataField(fem, it->m_psave);
+				for (; (n < (int)tasks.size()) && (tasks[n].nvar == i); ++n)
+				{
+					FieldTask& task = tasks[n];
+					if (task.bdone == false) EvaluateFields(fem, tasks, n);
+					if (task.bok)
+					{
+						// pad mismatches
+						assert(task.a.size() == task.nsize);
+						if (task.a.size() != task.nsize) task.a.resize(task.nsize, 0.f);
+						m_ar.WriteData(0, task.a.data());
+					}
+					task.a = FEDataStream();
+				}
 			}
 			m_ar.EndChunk();
 		}
@@ -1526,8 +1576,49 @@ void FEBioPlotFile::WriteNodeData(FEModel& fem)
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteDomainData(FEModel& fem)
 {
+	FEMesh& m = fem.GetMesh();
+	int ND = m.Domains();
+
+	// collect the fields
+	vector<FieldTask> tasks;
 	list<DICTIONARY_ITEM>::iterator it = m_dic.m_Elem.begin();
-	for (int i=0; i<(int) m_dic.m_Elem.size(); ++i, ++it)
+	for (int i = 0; i < (int)m_dic.m_Elem.size(); ++i, ++it)
+	{
+		FEPlotData* pd = it->m_psave;
+		if (pd == nullptr) continue;
+
+		// if the item list is empty, store all domains
+		vector<int> item = pd->GetItemList();
+		if (item.empty())
+		{
+			for (int j = 0; j < ND; ++j) item.push_back(j);
+		}
+
+		// allow plot data to prepare for save
+		// (this is always done serially, before any data is evaluated)
+		if (pd->PreSave() == false)
+		{
+			assert(false);
+			continue;
+		}
+
+		for (int j = 0; j < (int)item.size(); ++j)
+		{
+			FieldTask task;
+			task.pd = pd;
+			task.nvar = i;
+			task.nregion = item[j];
+			task.nsize = DomainDataSize(pd, m.Domain(item[j]));
+			task.bok = false;
+			task.bdone = false;
+			assert(task.nsize > 0);
+			tasks.push_back(task);
+		}
+	}
+
+	// evaluate and write them in dictionary order
+	int n = 0;
+	for (int i=0; i<(int) m_dic.m_Elem.size(); ++i)
 	{
 		m_ar.BeginChunk(PLT_STATE_VARIABLE);
 		{
@@ -1535,7 +1626,17 @@ void FEBioPlotFile::WriteDomainData(FEModel& fem)
 			m_ar.WriteChunk(PLT_STATE_VAR_ID, nid);
 			m_ar.BeginChunk(PLT_STATE_VAR_DATA);
 			{
-				if (it->m_psave) WriteDomainDataField(fem, it->m_psave);
+				for (; (n < (int)tasks.size()) && (tasks[n].nvar == i); ++n)
+				{
+					FieldTask& task = tasks[n];
+					if (task.bdone == false) EvaluateFields(fem, tasks, n);
+					if (task.bok)
+					{
+						assert(task.a.size() == task.nsize);
+						m_ar.WriteData(task.nregion + 1, task.a.data());
+					}
+					task.a = FEDataStream();
+				}
 			}
 			m_ar.EndChunk();
 		}
@@ -1546,8 +1647,35 @@ void FEBioPlotFile::WriteDomainData(FEModel& fem)
 //-----------------------------------------------------------------------------
 void FEBioPlotFile::WriteSurfaceData(FEModel& fem)
 {
+	FEMesh& m = fem.GetMesh();
+	int NS = m.Surfaces();
+
+	// collect the fields
+	vector<FieldTask> tasks;
 	list<DICTIONARY_ITEM>::iterator it = m_dic.m_Face.begin();
-	for (int i=0; i<(int) m_dic.m_Face.size(); ++i, ++it)
+	for (int i = 0; i < (int)m_dic.m_Face.size(); ++i, ++it)
+	{
+		FEPlotData* pd = it->m_psave;
+		if (pd == nullptr) continue;
+
+		for (int j = 0; j < NS; ++j)
+		{
+			assert(m_Surf[j].surf == &m.Surface(j));
+
+			FieldTask task;
+			task.pd = pd;
+			task.nvar = i;
+			task.nregion = j;
+			task.nsize = SurfaceDataSize(pd, j);
+			task.bok = false;
+			task.bdone = false;
+			tasks.push_back(task);
+		}
+	}
+
+	// evaluate and write them in dictionary order
+	int n = 0;
+	for (int i=0; i<(int) m_dic.m_Face.size(); ++i)
 	{
 		m_ar.BeginChunk(PLT_STATE_VARIABLE);
 		{
@@ -1555,7 +1683,19 @@ void FEBioPlotFile::WriteSurfaceData(FEModel& fem)
 			m_ar.WriteChunk(PLT_STATE_VAR_ID, nid);
 			m_ar.BeginChunk(PLT_STATE_VAR_DATA);
 			{
-				if (it->m_psave) WriteSurfaceDataField(fem, it->m_psave);
+				for (; (n < (int)tasks.size()) && (tasks[n].nvar == i); ++n)
+				{
+					FieldTask& task = tasks[n];
+					if (task.bdone == false) EvaluateFields(fem, tasks, n);
+					if (task.bok)
+					{
+						// in FEBio 3.0, the data streams are assumed to have no padding, but for now we still need to pad 
+						// the data stream before we write it to the file
+						if (task.a.size() != task.nsize) PadSurfaceData(task);
+						m_ar.WriteData(task.nregion + 1, task.a.data());
+					}
+					task.a = FEDataStream();
+				}
 			}
 			m_ar.EndChunk();
 		}
@@ -1564,155 +1704,200 @@ void FEBioPlotFile::WriteSurfaceData(FEModel& fem)
 }
 
 //-----------------------------------------------------------------------------
-void FEBioPlotFile::WriteNodeDataField(FEModel &fem, FEPlotData* pd)
+//! Evaluate the field task n. If its plot variable is flagged as concurrent, the
+//! following concurrent tasks are evaluated with it in parallel. The batch is limited
+//! to the number of threads, so that only a few data buffers are alive at once.
+//! Large domains of splittable variables are divided into element ranges, so that
+//! a single domain can be evaluated by several threads as well.
+void FEBioPlotFile::EvaluateFields(FEModel& fem, vector<FieldTask>& tasks, int n)
 {
-	// loop over all node sets
-	// right now there is only one, namely the node set of all mesh nodes
-	// so we just pass the mesh
-	int ndata = pd->VarSize(pd->DataType());
-
-	int N = fem.GetMesh().Nodes();
-	FEDataStream a; a.reserve(ndata*N);
-	if (pd->Save(fem.GetMesh(), a))
+	if (tasks[n].pd->IsConcurrent() == false)
 	{
-		// pad mismatches
-		assert(a.size() == N*ndata);
-		if (a.size() != N * ndata) a.resize(N*ndata, 0.f);
-		m_ar.WriteData(0, a.data());
+		EvaluateField(fem, tasks[n]);
+		return;
 	}
-}
 
-//-----------------------------------------------------------------------------
-void FEBioPlotFile::WriteSurfaceDataField(FEModel& fem, FEPlotData* pd)
-{
-	// loop over all surfaces
+	int NT = omp_get_max_threads();
+	int NP = 0;
+	while ((NP < NT) && (n + NP < (int)tasks.size()) && tasks[n + NP].pd->IsConcurrent()) NP++;
+
+	// split the tasks into slices
+	// (a domain is only split when each range has at least this many elements)
+	const int MIN_RANGE_SIZE = 1024;
 	FEMesh& m = fem.GetMesh();
-	int NS = m.Surfaces();
-	for (int i = 0; i<NS; ++i)
-	{
-		FESurface& S = m.Surface(i);
-
-		Surface& surf = m_Surf[i];
-		assert(surf.surf == &S);
-
-		// Determine data size.
-		// Note that for the FMT_MULT case we are 
-		// assuming 9 data entries per facet
-		// regardless of the nr of nodes a facet really has
-		// this is because for surfaces, all elements are not
-		// necessarily of the same type
-		// TODO: Fix the assumption of the FMT_MULT
-		int datasize = pd->VarSize(pd->DataType());
-		int nsize = datasize;
-		switch (pd->StorageFormat())
-		{
-		case FMT_NODE: nsize *= S.Nodes(); break;
-		case FMT_ITEM: nsize *= S.Elements(); break;
-		case FMT_MULT: nsize *= surf.maxNodes * S.Elements(); break;
-		case FMT_REGION:
-			// one value per surface so nsize remains unchanged
-			break;
-		default:
-			assert(false);
-		}
+	vector<FieldSlice> slices;
+	for (int i = 0; i < NP; ++i)
+	{
+		FieldTask& task = tasks[n + i];
+		FEPlotData* pd = task.pd;
+
+		int NE = 0;
+		if (pd->IsSplittable() && (pd->RegionType() == FE_REGION_DOMAIN) && (pd->StorageFormat() == FMT_ITEM))
+			NE = m.Domain(task.nregion).Elements();
 
-		// save data
-		FEDataStream a; a.reserve(nsize);
-		if (pd->Save(S, a))
+		int NR = (NT > 1 ? NE / MIN_RANGE_SIZE : 0);
+		if (NR > NT) NR = NT;
+
+		FieldSlice slice;
+		slice.ntask = n + i;
+		slice.bok = false;
+		if (NR < 2)
+		{
+			slice.n0 = slice.n1 = -1;
+			slices.push_back(slice);
+		}
+		else
 		{
-			// in FEBio 3.0, the data streams are assumed to have no padding, but for now we still need to pad 
-			// the data stream before we write it to the file
-			if (a.size() == nsize)
+			for (int j = 0; j < NR; ++j)
 			{
-				// assumed padding is already there, or not needed
-				m_ar.WriteData(i + 1, a.data());
+				slice.n0 = (j*NE) / NR;
+				slice.n1 = ((j + 1)*NE) / NR;
+				slices.push_back(slice);
 			}
-			else
-			{
-				// this is only needed for FMT_MULT storage
-				assert(pd->StorageFormat() == FMT_MULT);
-
-				// add padding
-				const int M = surf.maxNodes;
-				int m = 0;
-				FEDataStream b; b.assign(nsize, 0.f);
-				for (int n = 0; n < S.Elements(); ++n)
-				{
-					FESurfaceElement& el = S.Element(n);
-					int ne = el.Nodes();
-					for (int j = 0; j < ne; ++j)
-					{
-						for (int k = 0; k < datasize; ++k) b[n*M*datasize + j*datasize + k] = a[m++];
-					}
-				}
+		}
+	}
 
-				// write the padded data
-				m_ar.WriteData(i + 1, b.data());
-			}
+	int NS = (int)slices.size();
+	if (NS == 1)
+	{
+		EvaluateField(fem, tasks[n]);
+		return;
+	}
+
+#pragma omp parallel for schedule(dynamic, 1)
+	for (int i = 0; i < NS; ++i)
+	{
+		FieldSlice& slice = slices[i];
+		FieldTask& task = tasks[slice.ntask];
+		if (slice.n0 < 0) EvaluateField(fem, task);
+		else
+		{
+			FEPlotData* pd = task.pd;
+			slice.a.reserve((slice.n1 - slice.n0)*pd->VarSize(pd->DataType()));
+			slice.bok = pd->Save(m.Domain(task.nregion), slice.n0, slice.n1, slice.a);
 		}
 	}
+
+	// concatenate the ranges in element order
+	for (int i = 0; i < NS; ++i)
+	{
+		FieldSlice& slice = slices[i];
+		if (slice.n0 < 0) continue;
+
+		FieldTask& task = tasks[slice.ntask];
+		if (slice.n0 == 0)
+		{
+			task.bdone = true;
+			task.bok = true;
+			task.a.reserve(task.nsize);
+		}
+		task.bok = (task.bok && slice.bok);
+
+		vector<float>& d = task.a.data();
+		vector<float>& ds = slice.a.data();
+		d.insert(d.end(), ds.begin(), ds.end());
+		slice.a = FEDataStream();
+	}
 }
 
 //-----------------------------------------------------------------------------
-void FEBioPlotFile::WriteDomainDataField(FEModel &fem, FEPlotData* pd)
+void FEBioPlotFile::EvaluateField(FEModel& fem, FieldTask& task)
 {
 	FEMesh& m = fem.GetMesh();
-	int ND = m.Domains();
-
-	// if the item list is empty, store all domains
-	vector<int> item = pd->GetItemList();
-	if (item.empty())
+	FEPlotData* pd = task.pd;
+	task.bdone = true;
+	task.a.reserve(task.nsize);
+	switch (pd->RegionType())
 	{
-		for (int i = 0; i<ND; ++i) item.push_back(i);
+	case FE_REGION_NODE   : task.bok = pd->Save(m, task.a); break;
+	case FE_REGION_DOMAIN : task.bok = pd->Save(m.Domain(task.nregion), task.a); break;
+	case FE_REGION_SURFACE: task.bok = pd->Save(m.Surface(task.nregion), task.a); break;
+	default:
+		assert(false);
+		task.bok = false;
 	}
+}
 
-	// allow plot data to prepare for save
-	if (pd->PreSave() == false)
+//-----------------------------------------------------------------------------
+//! calculate the size of the data vector of a domain
+int FEBioPlotFile::DomainDataSize(FEPlotData* pd, FEDomain& D)
+{
+	int nsize = pd->VarSize(pd->DataType());
+	switch (pd->StorageFormat())
 	{
+	case FMT_NODE: nsize *= D.Nodes(); break;
+	case FMT_ITEM: nsize *= D.Elements(); break;
+	case FMT_MULT:
+	{
+		// since all elements have the same type within a domain
+		// we just grab the number of nodes of the first element 
+		// to figure out how much storage we need
+		FEElement& e = D.ElementRef(0);
+		int n = e.Nodes();
+		nsize *= n*D.Elements();
+	}
+	break;
+	case FMT_REGION:
+		// one value for this domain so nsize remains unchanged
+		break;
+	default:
 		assert(false);
-		return;
 	}
+	return nsize;
+}
 
-	// loop over all domains in the item list
-	int N = (int)item.size();
-	for (int i = 0; i<ND; ++i)
+//-----------------------------------------------------------------------------
+//! calculate the size of the data vector of a surface
+int FEBioPlotFile::SurfaceDataSize(FEPlotData* pd, int nsurf)
+{
+	FESurface& S = *m_Surf[nsurf].surf;
+
+	// Note that for the FMT_MULT case we are 
+	// assuming 9 data entries per facet
+	// regardless of the nr of nodes a facet really has
+	// this is because for surfaces, all elements are not
+	// necessarily of the same type
+	// TODO: Fix the assumption of the FMT_MULT
+	int nsize = pd->VarSize(pd->DataType());
+	switch (pd->StorageFormat())
 	{
-		// get the domain
-		FEDomain& D = m.Domain(item[i]);
-
-		// calculate the size of the data vector
-		int nsize = pd->VarSize(pd->DataType());
-		switch (pd->StorageFormat())
-		{
-		case FMT_NODE: nsize *= D.Nodes(); break;
-		case FMT_ITEM: nsize *= D.Elements(); break;
-		case FMT_MULT:
-		{
-			// since all elements have the same type within a domain
-			// we just grab the number of nodes of the first element 
-			// to figure out how much storage we need
-			FEElement& e = D.ElementRef(0);
-			int n = e.Nodes();
-			nsize *= n*D.Elements();
-		}
+	case FMT_NODE: nsize *= S.Nodes(); break;
+	case FMT_ITEM: nsize *= S.Elements(); break;
+	case FMT_MULT: nsize *= m_Surf[nsurf].maxNodes * S.Elements(); break;
+	case FMT_REGION:
+		// one value per surface so nsize remains unchanged
 		break;
-		case FMT_REGION:
-			// one value for this domain so nsize remains unchanged
-			break;
-		default:
-			assert(false);
-		}
-		assert(nsize > 0);
+	default:
+		assert(false);
+	}
+	return nsize;
+}
 
-		// fill data vector and save
-		FEDataStream a;
-		a.reserve(nsize);
-		if (pd->Save(D, a))
+//-----------------------------------------------------------------------------
+//! pad the surface data so that each facet stores maxNodes values
+void FEBioPlotFile::PadSurfaceData(FieldTask& task)
+{
+	// this is only needed for FMT_MULT storage
+	FEPlotData* pd = task.pd;
+	assert(pd->StorageFormat() == FMT_MULT);
+
+	Surface& surf = m_Surf[task.nregion];
+	FESurface& S = *surf.surf;
+	const int M = surf.maxNodes;
+	int datasize = pd->VarSize(pd->DataType());
+
+	int m = 0;
+	FEDataStream b; b.assign(task.nsize, 0.f);
+	for (int n = 0; n < S.Elements(); ++n)
+	{
+		FESurfaceElement& el = S.Element(n);
+		int ne = el.Nodes();
+		for (int j = 0; j < ne; ++j)
 		{
-			assert(a.size() == nsize);
-			m_ar.WriteData(item[i] + 1, a.data());
+			for (int k = 0; k < datasize; ++k) b[n*M*datasize + j*datasize + k] = task.a[m++];
 		}
 	}
+	task.a = b;
 }
 
 //-----------------------------------------------------------------------------
@@ -1769,7 +1954,12 @@ bool FEBioPlotFile::Append(const char *szfile)
 	BuildSurfaceTable();
 
 	// ... and open for appending
-	if (bok) return m_ar.Append(szfile);
+	if (bok)
+	{
+		if (m_ar.Append(szfile) == false) return false;
+		m_ar.SetAsyncWrite(pltData.GetPlotAsync());
+		return true;
+	}
 
 	return false;
 }
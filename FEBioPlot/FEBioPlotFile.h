@@ -277,6 +277,9 @@ public:
 	//! Close the plot database
 	void Close() override;
 
+	//! wait until all pending states are written
+	void Flush() override;
+
 	//! Open for appending
 	bool Append(const char* szfile) override;
 
@@ -286,6 +289,8 @@ public:
 	//! see if the plot file is valid
 	bool IsValid() const override;
 
+	size_t MemoryUsage() override;
+
 public:
 	//! Add a variable to the dictionary
 	bool AddVariable(FEPlotData* ps, const char* szname);
@@ -342,9 +347,36 @@ protected:
 	void WriteObjectsState();
 	void WriteObjectData(PlotObject* po);
 
-	void WriteNodeDataField(FEModel& fem, FEPlotData* pd);
-	void WriteDomainDataField(FEModel& fem, FEPlotData* pd);
-	void WriteSurfaceDataField(FEModel& fem, FEPlotData* pd);
+	// A field task is the evaluation of one plot variable on one region (the mesh,
+	// a domain, or a surface). The tasks are evaluated when they are written, except
+	// that the tasks of concurrent plot variables are evaluated in parallel batches.
+	struct FieldTask
+	{
+		FEPlotData*		pd;			//!< the plot variable
+		int				nvar;		//!< index of variable in the dictionary list
+		int				nregion;	//!< domain or surface index (unused for node data)
+		int				nsize;		//!< expected size of data stream
+		FEDataStream	a;			//!< the evaluated data
+		bool			bok;		//!< return value of FEPlotData::Save
+		bool			bdone;		//!< the task was evaluated
+	};
+
+	//! A range of elements of a domain field task. These are evaluated separately
+	//! and concatenated in element order afterwards.
+	struct FieldSlice
+	{
+		int				ntask;		//!< index of the field task
+		int				n0, n1;		//!< element range [n0, n1) (or -1 to evaluate the whole task)
+		FEDataStream	a;			//!< the evaluated data of this range
+		bool			bok;		//!< return value of FEPlotData::Save
+	};
+
+	void EvaluateFields(FEModel& fem, vector<FieldTask>& tasks, int n);
+	void EvaluateField (FEModel& fem, FieldTask& task);
+
+	int DomainDataSize (FEPlotData* pd, FEDomain& dom);
+	int SurfaceDataSize(FEPlotData* pd, int nsurf);
+	void PadSurfaceData(FieldTask& task);
 
 	void WriteMeshState(FEMesh& mesh);
 
@@ -57,9 +57,15 @@ public:
 	//! Write current FE state to plot database
 	virtual bool Write(float ftime, int flag = 0) = 0;
 
+	//! make sure all data was written to the plot database
+	virtual void Flush() {}
+
 	//! see if the plot file is valid
 	virtual bool IsValid() const = 0;
 
+	//! memory (in bytes) used by the plot file buffers
+	virtual size_t MemoryUsage() { return 0; }
+
 protected:
 	FEModel* GetFEModel() { return m_pfem; }
 
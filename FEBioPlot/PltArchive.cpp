@@ -32,7 +32,6 @@ SOFTWARE.*/
 
 #ifdef HAVE_ZLIB
 #include "zlib.h"
-static z_stream strm;
 #endif
 
 //=============================================================================
@@ -45,6 +44,13 @@ FileStream::FileStream()
 	m_buf  = new unsigned char[m_bufsize];
 	m_pout = new unsigned char[m_bufsize];
 	m_ncompress = 0;
+	m_fp = 0;
+
+#ifdef HAVE_ZLIB
+	m_pz = new z_stream;
+#else
+	m_pz = 0;
+#endif
 }
 
 FileStream::~FileStream()
@@ -54,6 +60,11 @@ FileStream::~FileStream()
 	delete [] m_pout;
 	m_buf = 0;
 	m_pout = 0;
+
+#ifdef HAVE_ZLIB
+	delete (z_stream*)m_pz;
+#endif
+	m_pz = 0;
 }
 
 bool FileStream::Open(const char* szfile)
@@ -86,6 +97,7 @@ void FileStream::BeginStreaming()
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
+		z_stream& strm = *((z_stream*)m_pz);
 		strm.zalloc = Z_NULL;
 		strm.zfree = Z_NULL;
 		strm.opaque = Z_NULL;
@@ -100,6 +112,7 @@ void FileStream::EndStreaming()
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
+		z_stream& strm = *((z_stream*)m_pz);
 		strm.avail_in = 0;
 		strm.next_in = 0;
 
@@ -151,6 +164,7 @@ void FileStream::Flush()
 #ifdef HAVE_ZLIB
 	if (m_ncompress)
 	{
+		z_stream& strm = *((z_stream*)m_pz);
 		strm.avail_in = m_current;
 		strm.next_in = m_buf;
 
@@ -197,6 +211,44 @@ void FileStream::seek(long noff, int norigin)
 }
 
 
+//=============================================================================
+// PltArchive
+//=============================================================================
+
+//=============================================================================
+// OBufferPool
+//=============================================================================
+
+OBufferPool::~OBufferPool()
+{
+	for (size_t i = 0; i < m_free.size(); ++i) delete m_free[i];
+	m_free.clear();
+}
+
+vector<float>* OBufferPool::Get()
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	if (m_free.empty()) return new vector<float>;
+	vector<float>* p = m_free.back();
+	m_free.pop_back();
+	return p;
+}
+
+void OBufferPool::Release(vector<float>* p)
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	p->clear();
+	m_free.push_back(p);
+}
+
+size_t OBufferPool::MemoryUsage()
+{
+	std::lock_guard<std::mutex> lock(m_mtx);
+	size_t bytes = 0;
+	for (size_t i = 0; i < m_free.size(); ++i) bytes += m_free[i]->capacity() * sizeof(float);
+	return bytes;
+}
+
 //=============================================================================
 // PltArchive
 //=============================================================================
@@ -207,6 +259,12 @@ PltArchive::PltArchive()
 	m_pRoot = 0;
 	m_pChunk = 0;
 	m_bSaving = true;
+	m_ncompress = 0;
+
+	m_basync = false;
+	m_maxQueue = 2;
+	m_bquit = false;
+	m_bbusy = false;
 }
 
 PltArchive::~PltArchive()
@@ -214,11 +272,108 @@ PltArchive::~PltArchive()
 	Close();
 }
 
+//-----------------------------------------------------------------------------
+// In asynchronous mode the chunk trees are written to file by a background 
+// thread. The data of the tree is owned by the tree, so the caller can continue
+// as soon as the tree is queued. At most maxQueue trees are queued at any time.
+void PltArchive::SetAsyncWrite(bool b, int maxQueue)
+{
+	if (maxQueue < 1) maxQueue = 1;
+
+	// make sure all pending writes are done
+	StopWriter();
+
+	m_basync = b;
+	m_maxQueue = maxQueue;
+
+	if (m_basync)
+	{
+		m_bquit = false;
+		m_writer = std::thread(&PltArchive::WriterLoop, this);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// wait until all queued trees are written
+void PltArchive::Sync()
+{
+	if (m_basync == false) return;
+	std::unique_lock<std::mutex> lock(m_mtx);
+	m_cvDone.wait(lock, [this]() { return (m_queue.empty() && (m_bbusy == false)); });
+}
+
+//-----------------------------------------------------------------------------
+size_t PltArchive::MemoryUsage()
+{
+	size_t bytes = m_pool.MemoryUsage();
+	if (m_fp) bytes += m_fp->MemoryUsage();
+	return bytes;
+}
+
+//-----------------------------------------------------------------------------
+void PltArchive::StopWriter()
+{
+	if (m_writer.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mtx);
+			m_bquit = true;
+		}
+		m_cvWork.notify_all();
+		m_writer.join();
+	}
+	m_bquit = false;
+}
+
+//-----------------------------------------------------------------------------
+void PltArchive::WriterLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mtx);
+	while (true)
+	{
+		m_cvWork.wait(lock, [this]() { return (m_bquit || (m_queue.empty() == false)); });
+
+		// we only quit when all the work is done
+		if (m_queue.empty()) break;
+
+		PendingTree tree = m_queue.front();
+		m_queue.pop_front();
+		m_bbusy = true;
+		lock.unlock();
+
+		// producers can continue now
+		m_cvDone.notify_all();
+
+		WriteTree(tree.pRoot, tree.ncompress);
+
+		lock.lock();
+		m_bbusy = false;
+		m_cvDone.notify_all();
+	}
+}
+
+//-----------------------------------------------------------------------------
+void PltArchive::WriteTree(OBranch* root, int ncompress)
+{
+	if (m_fp && root)
+	{
+		m_fp->SetCompression(ncompress);
+		m_fp->BeginStreaming();
+		root->Write(m_fp);
+		m_fp->EndStreaming();
+	}
+	delete root;
+}
+
 void PltArchive::Close()
 {
 	if (m_bSaving)
 	{
 		if (m_pRoot) Flush();
+
+		// wait for the writer to finish
+		StopWriter();
+		m_basync = false;
 	}
 	else 
 	{
@@ -237,18 +392,28 @@ void PltArchive::Close()
 
 void PltArchive::SetCompression(int n)
 {
-	if (m_fp) m_fp->SetCompression(n);
+	m_ncompress = n;
+	if (m_fp && (m_basync == false)) m_fp->SetCompression(n);
 }
 
 void PltArchive::Flush()
 {
-	if (m_fp && m_pRoot)
+	if (m_basync && m_writer.joinable())
 	{
-		m_fp->BeginStreaming();
-		m_pRoot->Write(m_fp);
-		m_fp->EndStreaming();
+		if (m_pRoot)
+		{
+			PendingTree tree = { m_pRoot, m_ncompress };
+
+			// wait for room in the queue
+			std::unique_lock<std::mutex> lock(m_mtx);
+			m_cvDone.wait(lock, [this]() { return ((int)m_queue.size() < m_maxQueue); });
+			m_queue.push_back(tree);
+			lock.unlock();
+			m_cvWork.notify_one();
+		}
 	}
-	delete m_pRoot;
+	else WriteTree(m_pRoot, m_ncompress);
+
 	m_pRoot = 0;
 	m_pChunk = 0;
 }
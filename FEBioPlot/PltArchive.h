@@ -35,6 +35,10 @@ SOFTWARE.*/
 #include <list>
 #include <vector>
 #include <stack>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 using namespace std;
 
 //-----------------------------------------------------------------------------
@@ -64,6 +68,9 @@ public:
 
 	void SetCompression(int n) { m_ncompress = n; }
 
+	// memory used by the buffers
+	size_t MemoryUsage() const { return (m_buf ? 2*m_bufsize : 0); }
+
 private:
 	FILE*	m_fp;
 	size_t	m_bufsize;		//!< buffer size
@@ -71,6 +78,7 @@ private:
 	unsigned char*	m_buf;	//!< buffer
 	unsigned char*	m_pout;	//!< temp buffer when writing
 	int		m_ncompress;	//!< compression level
+	void*	m_pz;			//!< compression stream
 };
 
 class OBranch;
@@ -231,6 +239,56 @@ protected:
 	int		m_nsize;
 };
 
+//-----------------------------------------------------------------------------
+//! Pool of float buffers that are reused for staging the plot data.
+//! Buffers can be released from a different thread than they were taken from.
+class OBufferPool
+{
+public:
+	OBufferPool() {}
+	~OBufferPool();
+
+	vector<float>* Get();
+	void Release(vector<float>* p);
+
+	// memory used by the free buffers
+	size_t MemoryUsage();
+
+private:
+	OBufferPool(const OBufferPool&);
+	void operator = (const OBufferPool&);
+
+private:
+	std::mutex				m_mtx;
+	vector<vector<float>*>	m_free;
+};
+
+//-----------------------------------------------------------------------------
+//! Leaf that stores its data in a buffer taken from a buffer pool.
+class ODataLeaf : public OChunk
+{
+public:
+	ODataLeaf(unsigned int nid, const vector<float>& a, OBufferPool& pool) : OChunk(nid), m_pool(pool)
+	{
+		m_pd = pool.Get();
+		m_pd->assign(a.begin(), a.end());
+	}
+	~ODataLeaf() { m_pool.Release(m_pd); }
+
+	int Size() { return (int)(sizeof(float)*m_pd->size()); }
+	void Write(FileStream* fp)
+	{
+		fp->Write(&m_nID , sizeof(unsigned int), 1);
+		unsigned int nsize = Size();
+		fp->Write(&nsize , sizeof(unsigned int), 1);
+		if (nsize > 0) fp->Write(&(*m_pd)[0], sizeof(float), m_pd->size());
+	}
+
+protected:
+	vector<float>*	m_pd;
+	OBufferPool&	m_pool;
+};
+
 //-----------------------------------------------------------------------------
 //! Implementation of an archiving class. Will be used by the FEBioPlotFile class.
 class PltArchive : public Archive
@@ -257,6 +315,16 @@ public:
 	// flush data to file
 	void Flush();
 
+	// Set asynchronous write mode. In this mode, completed chunk trees are
+	// written by a background thread. At most maxQueue trees can be pending.
+	void SetAsyncWrite(bool b, int maxQueue = 2);
+
+	// wait until all pending data is written
+	void Sync();
+
+	// memory used by the file buffers and the staging buffers
+	size_t MemoryUsage();
+
 public:
 	// --- Writing ---
 
@@ -297,7 +365,7 @@ public:
 	// (overridden from Archive)
 	virtual void WriteData(int nid, std::vector<float>& data)
 	{
-		WriteChunk(nid, data);
+		m_pChunk->AddChild(new ODataLeaf(nid, data, m_pool));
 	}
 
 
@@ -357,4 +425,29 @@ protected:
 	// read data
 	bool			m_bend;		// chunk end flag
 	stack<CHUNK*>	m_Chunk;
+
+private:
+	struct PendingTree
+	{
+		OBranch*	pRoot;		// root of chunk tree
+		int			ncompress;	// compression level
+	};
+
+	void WriteTree(OBranch* root, int ncompress);
+	void WriterLoop();
+	void StopWriter();
+
+	int		m_ncompress;	// compression level for next chunk tree
+
+	// asynchronous writing
+	bool					m_basync;		// asynchronous write flag
+	int						m_maxQueue;		// max nr of pending trees
+	std::thread				m_writer;		// writer thread
+	std::mutex				m_mtx;
+	std::condition_variable	m_cvWork;		// signals the writer thread
+	std::condition_variable	m_cvDone;		// signals the solver thread
+	deque<PendingTree>		m_queue;		// pending chunk trees
+	bool					m_bquit;		// stop the writer thread
+	bool					m_bbusy;		// writer thread is writing
+	OBufferPool				m_pool;			// staging buffers
 };
@@ -186,7 +186,7 @@ void FE2OMicroConstraint::UnpackLM(FEElement& el, vector<int>& lm)
 	{
 		int n = el.m_node[i];
 		FENode& node = mesh.Node(n);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 
 		lm[3*i  ] = id[m_dofU[0]];
 		lm[3*i+1] = id[m_dofU[1]];
@@ -255,7 +255,7 @@ void FE2OMicroConstraint::LoadVector(FEGlobalVector& R, const FETimeInfo& tp)
 		lm.resize(3*neln);
 		for (int j=0; j<neln; ++j)
 		{
-			vector<int>& id = mesh.Node(el.m_node[j]).m_ID;
+			FENodeDofArray<int>& id = mesh.Node(el.m_node[j]).m_ID;
 			lm[3*j  ] = id[m_dofU[0]];
 			lm[3*j+1] = id[m_dofU[1]];
 			lm[3*j+2] = id[m_dofU[2]];
@@ -353,7 +353,7 @@ void FE2OMicroConstraint::StiffnessMatrix(FELinearSystem& LS, const FETimeInfo&
 		lm.resize(3*neln);
 		for (int j=0; j<neln; ++j)
 		{
-			vector<int>& id = mesh.Node(el.m_node[j]).m_ID;
+			FENodeDofArray<int>& id = mesh.Node(el.m_node[j]).m_ID;
 			lm[3*j  ] = id[m_dofU[0]];
 			lm[3*j+1] = id[m_dofU[1]];
 			lm[3*j+2] = id[m_dofU[2]];
@@ -65,4 +65,6 @@ void FEBioRVE::InitModule()
 	REGISTER_FECORE_CLASS(FEPlotElementPK1norm, "PK1 norm");
 	REGISTER_FECORE_CLASS(FEPlotElementQK1norm, "QK1 norm");
 	REGISTER_FECORE_CLASS(FEPlotElementMicroEnergy, "micro energy");
+	REGISTER_FECORE_CLASS(FEPlotElementRVEIterations, "RVE iterations");
+	REGISTER_FECORE_CLASS(FEPlotElementRVETime, "RVE time");
 }
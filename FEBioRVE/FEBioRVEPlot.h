@@ -54,6 +54,24 @@ public:
 	bool Save(FEDomain& dom, FEDataStream& a);
 };
 
+//-----------------------------------------------------------------------------
+//! Element average of the number of iterations of the last RVE solve
+class FEPlotElementRVEIterations : public FEPlotDomainData
+{
+public:
+	FEPlotElementRVEIterations(FEModel* pfem) : FEPlotDomainData(pfem, PLT_FLOAT, FMT_ITEM) {}
+	bool Save(FEDomain& dom, FEDataStream& a);
+};
+
+//-----------------------------------------------------------------------------
+//! Element average of the wall time of the last RVE solve
+class FEPlotElementRVETime : public FEPlotDomainData
+{
+public:
+	FEPlotElementRVETime(FEModel* pfem) : FEPlotDomainData(pfem, PLT_FLOAT, FMT_ITEM) {}
+	bool Save(FEDomain& dom, FEDataStream& a);
+};
+
 //-----------------------------------------------------------------------------
 //! Element micro energy
 class FEPlotElementMicroEnergy : public FEPlotDomainData
@@ -46,14 +46,12 @@ bool FEElasticMultiscaleDomain1O::Init()
 	if (FEElasticSolidDomain::Init() == false) return false;
 
 	// get the material
-	FEModel& fem = *GetFEModel();
 	FEMicroMaterial* pmat = dynamic_cast<FEMicroMaterial*>(m_pMat);
-	if (m_pMat == 0) return false;
-
-	// get the parent RVE
-	FERVEModel& rve = pmat->m_mrve;
+	if (pmat == 0) return false;
 
 	// loop over all elements
+	// NOTE: The material points only store the state of their RVE. The RVE
+	// instances that are used to solve them are managed by the material.
 	for (size_t i=0; i<m_Elem.size(); ++i)
 	{
 		FESolidElement& el = m_Elem[i];
@@ -64,15 +62,51 @@ bool FEElasticMultiscaleDomain1O::Init()
 			FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 			FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
 
-			// create the material point RVEs
 			mmpt.m_F_prev = pt.m_F;	// TODO: I think I can remove this line
-			mmpt.m_rve.CopyFrom(rve);
-			if (mmpt.m_rve.Init() == false) return false;
 
-			// initialize RCI solve
-			if (mmpt.m_rve.RCI_Init() == false) return false;
+			// start from the initial RVE state
+			mmpt.m_state.Clear();
+			mmpt.m_trial.Clear();
 		}
 	}
 
 	return true;
 }
+
+//-----------------------------------------------------------------------------
+//! The element loop of the base class only updates the kinematics. The RVEs of
+//! all the material points are solved afterwards by the material, which can 
+//! balance the (very uneven) cost of the RVE solves over the threads.
+void FEElasticMultiscaleDomain1O::Update(const FETimeInfo& tp)
+{
+	FEMicroMaterial* pmat = dynamic_cast<FEMicroMaterial*>(m_pMat);
+	assert(pmat);
+
+	// update the kinematics
+	pmat->DeferRVESolves(true);
+	try
+	{
+		FEElasticSolidDomain::Update(tp);
+	}
+	catch (...)
+	{
+		pmat->DeferRVESolves(false);
+		throw;
+	}
+	pmat->DeferRVESolves(false);
+
+	// collect the material points
+	m_points.clear();
+	for (size_t i=0; i<m_Elem.size(); ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		if (el.isActive())
+		{
+			int nint = el.GaussPoints();
+			for (int j=0; j<nint; ++j) m_points.push_back(el.GetMaterialPoint(j));
+		}
+	}
+
+	// solve all the RVEs
+	pmat->SolveRVEs(m_points);
+}
@@ -39,4 +39,10 @@ public:
 
 	//! initialize class
 	bool Init();
+
+	//! update the domain (this solves the RVEs)
+	void Update(const FETimeInfo& tp) override;
+
+private:
+	std::vector<FEMaterialPoint*>	m_points;	//!< material points of active elements
 };
@@ -325,14 +325,14 @@ void FEElasticSolidDomain2O::BuildMatrixProfile(FEGlobalMatrix& M)
 		lm.resize(ndof);
 		for (int i=0; i<nelna; ++i)
 		{
-			vector<int>& id = mesh.Node(ela.m_node[i]).m_ID;
+			FENodeDofArray<int>& id = mesh.Node(ela.m_node[i]).m_ID;
 			lm[3*i  ] = id[0];
 			lm[3*i+1] = id[1];
 			lm[3*i+2] = id[2];
 		}
 		for (int i=0; i<nelnb; ++i)
 		{
-			vector<int>& id = mesh.Node(elb.m_node[i]).m_ID;
+			FENodeDofArray<int>& id = mesh.Node(elb.m_node[i]).m_ID;
 			lm[3*(nelna+i)  ] = id[0];
 			lm[3*(nelna+i)+1] = id[1];
 			lm[3*(nelna+i)+2] = id[2];
@@ -1092,14 +1092,14 @@ void FEElasticSolidDomain2O::StiffnessMatrixDG(FELinearSystem& LS)
 		lm.resize(ndof);
 		for (int i=0; i<nelna; ++i)
 		{
-			vector<int>& id = mesh.Node(ela.m_node[i]).m_ID;
+			FENodeDofArray<int>& id = mesh.Node(ela.m_node[i]).m_ID;
 			lm[3*i  ] = id[0];
 			lm[3*i+1] = id[1];
 			lm[3*i+2] = id[2];
 		}
 		for (int i=0; i<nelnb; ++i)
 		{
-			vector<int>& id = mesh.Node(elb.m_node[i]).m_ID;
+			FENodeDofArray<int>& id = mesh.Node(elb.m_node[i]).m_ID;
 			lm[3*(nelna+i)  ] = id[0];
 			lm[3*(nelna+i)+1] = id[1];
 			lm[3*(nelna+i)+2] = id[2];
@@ -34,6 +34,10 @@ SOFTWARE.*/
 #include <FECore/mat6d.h>
 #include "FEBioMech/FEBCPrescribedDeformation.h"
 #include "FERVEProbe.h"
+#include <FECore/FENewtonSolver.h>
+#include <FECore/sys.h>
+#include <FECore/Timer.h>
+#include <algorithm>
 #include <sstream>
 
 //=============================================================================
@@ -45,6 +49,12 @@ FEMicroMaterialPoint::FEMicroMaterialPoint(FEMaterialPoint* mp) : FEMaterialPoin
 	
 	m_macro_energy_inc = 0.;
 	m_micro_energy_inc = 0.;
+
+	m_C.zero();
+	m_PK1.zero();
+
+	m_rve_iters = 0;
+	m_rve_time = 0.0;
 }
 
 //-----------------------------------------------------------------------------
@@ -63,8 +73,13 @@ void FEMicroMaterialPoint::Update(const FETimeInfo& timeInfo)
 	FEElasticMaterialPoint& pt = *ExtractData<FEElasticMaterialPoint>();
 	m_F_prev = pt.m_F;
 
-	// clear rewind stack so the next rewind won't overwrite current state
-	m_rve.RCI_ClearRewindStack();
+	// The last RVE solve belongs to the converged time step, unless the 
+	// time step is being retried, in which case the trial state is discarded.
+	if ((m_trial.IsEmpty() == false) && (m_trial.GetTime() <= timeInfo.currentTime - 0.5*timeInfo.timeIncrement))
+	{
+		m_state.Swap(m_trial);
+	}
+	m_trial.Clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -86,6 +101,11 @@ void FEMicroMaterialPoint::Serialize(DumpStream& ar)
 	ar & m_energy_diff;
 	ar & m_macro_energy_inc;
 	ar & m_micro_energy_inc;
+	ar & m_PK1;
+
+	// the RVE state is only needed for restarts, since it is not modified
+	// until a time step converges.
+	if (ar.IsShallow() == false) m_state.Serialize(ar);
 }
 
 //=============================================================================
@@ -97,6 +117,7 @@ BEGIN_FECORE_CLASS(FEMicroMaterial, FEElasticMaterial)
 	ADD_PARAMETER(m_szbc     , "bc_set"  );
 	ADD_PARAMETER(m_bctype   , "rve_type" );
 	ADD_PARAMETER(m_scale	 , "scale"   ); 
+	ADD_PARAMETER(m_rveStats , "rve_stats");
 
 	ADD_PROPERTY(m_probe, "probe", false);
 
@@ -110,11 +131,15 @@ FEMicroMaterial::FEMicroMaterial(FEModel* pfem) : FEElasticMaterial(pfem)
 	m_szbc[0] = 0;
 	m_bctype = FERVEModel::DISPLACEMENT;	// use displacement BCs by default
 	m_scale = 1.0;
+	m_rveStats = false;
+	m_bdefer = false;
 }
 
 //-----------------------------------------------------------------------------
 FEMicroMaterial::~FEMicroMaterial(void)
 {
+	for (size_t i = 0; i < m_rveScratch.size(); ++i) delete m_rveScratch[i];
+	m_rveScratch.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -156,27 +181,214 @@ bool FEMicroMaterial::Init()
 		feLogError("An error occurred preparing RVE model"); return false;
 	}
 
+	// create the RVE instances used for solving the material point RVEs
+	if (InitScratchRVEs() == false)
+	{
+		feLogError("An error occurred initializing the RVE instances"); return false;
+	}
+
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! Creates one copy of the parent RVE for each thread. The mesh, the linear 
+//! system and its sparsity profile of each copy are reused by all material 
+//! points that are evaluated on that thread.
+bool FEMicroMaterial::InitScratchRVEs()
+{
+	for (size_t i = 0; i < m_rveScratch.size(); ++i) delete m_rveScratch[i];
+	m_rveScratch.clear();
+
+	if (ReserveScratchRVEs(omp_get_max_threads()) == false) return false;
+
+	// store the initial state, which is used by the material points
+	// until their first time step has converged.
+	m_rveScratch[0]->SaveState(m_rveInit);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Makes sure there are at least nt RVE instances. The number of threads can
+//! be raised after initialization, so this is called before the RVEs are solved.
+//! This must not be called from inside a parallel region.
+bool FEMicroMaterial::ReserveScratchRVEs(int nt)
+{
+	if (nt < 1) nt = 1;
+	while ((int)m_rveScratch.size() < nt)
+	{
+		FERVEModel* rve = new FERVEModel;
+		m_rveScratch.push_back(rve);
+
+		rve->CopyFrom(m_mrve);
+		rve->BlockLog();
+
+		// Since consecutive solves can belong to different material points
+		// the stiffness matrix must be reformed at the start of each solve.
+		FENewtonSolver* solver = dynamic_cast<FENewtonSolver*>(rve->GetStep(0)->GetFESolver());
+		if (solver) solver->m_breformtimestep = true;
+
+		if (rve->Init() == false) return false;
+
+		// initialize RCI solve
+		if (rve->RCI_Init() == false) return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+FERVEModel& FEMicroMaterial::ScratchRVE()
+{
+	// Instances cannot be added while other threads are using them, so a thread 
+	// without an instance is treated as a failed RVE solve.
+	int n = omp_get_thread_num();
+	if ((n < 0) || (n >= (int)m_rveScratch.size())) throw FEMultiScaleException(-1, -1);
+	return *m_rveScratch[n];
+}
+
+//-----------------------------------------------------------------------------
+FERVEModel& FEMicroMaterial::MaterializeRVE(FEMaterialPoint& mp)
+{
+	FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
+	FERVEModel& rve = ScratchRVE();
+	if (rve.RestoreState(mmpt.m_trial) == false)
+	{
+		if (rve.RestoreState(mmpt.m_state) == false) rve.RestoreState(m_rveInit);
+	}
+	return rve;
+}
+
 //-----------------------------------------------------------------------------
 // Note that this function is not used in the first-order implemenetation
 mat3ds FEMicroMaterial::Stress(FEMaterialPoint &mp)
 {
+	// If the RVE solves are scheduled by the domain, we just return the current 
+	// stress. The new stress is evaluated in SolveRVEs.
+	if (m_bdefer) return mp.ExtractData<FEElasticMaterialPoint>()->m_s;
+
+	return SolveRVE(mp);
+}
+
+//-----------------------------------------------------------------------------
+mat3ds FEMicroMaterial::SolveRVE(FEMaterialPoint &mp)
+{
+	Timer timer;
+	timer.start();
+
 	// get the deformation gradient
 	FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
 	FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
 	mat3d F = pt.m_F;
 
+	// load the converged state of this point's RVE
+	FERVEModel& rve = ScratchRVE();
+	if (rve.RestoreState(mmpt.m_state) == false) rve.RestoreState(m_rveInit);
+
 	// calculate the averaged Cauchy stress
-	mat3ds sa = mmpt.m_rve.StressAverage(F, mp);
+	mat3ds sa = rve.StressAverage(F, mp);
 	
 	// calculate the difference between the macro and micro energy for Hill-Mandel condition
-	mmpt.m_micro_energy = micro_energy(mmpt.m_rve);	
+	mmpt.m_micro_energy = micro_energy(rve);	
+
+	// The RVE instance is shared with other material points, so we evaluate
+	// the averaged tangent and PK1 stress while we have the solution.
+	mmpt.m_C = rve.StiffnessAverage(mp);
+	mmpt.m_PK1 = AveragedStressPK1(rve, mp);
+
+	// store the new RVE state
+	rve.SaveState(mmpt.m_trial);
+
+	// collect statistics
+	timer.stop();
+	mmpt.m_rve_iters = rve.GetCurrentStep()->GetFESolver()->m_niter;
+	mmpt.m_rve_time = timer.GetTime();
 	
 	return sa;
 }
 
+//-----------------------------------------------------------------------------
+//! Solves the RVEs of all the material points. Since the cost of an RVE solve
+//! can vary greatly, the RVEs are solved with a dynamic schedule, starting with
+//! the ones that were most expensive in the previous solve.
+void FEMicroMaterial::SolveRVEs(const std::vector<FEMaterialPoint*>& points)
+{
+	const int N = (int)points.size();
+	if (N == 0) return;
+
+	// sort the points by the time of their last solve
+	m_order.resize(N);
+	for (int i = 0; i < N; ++i) m_order[i] = i;
+	std::stable_sort(m_order.begin(), m_order.end(), [&](int a, int b) {
+		return (points[a]->ExtractData<FEMicroMaterialPoint>()->m_rve_time > points[b]->ExtractData<FEMicroMaterialPoint>()->m_rve_time);
+	});
+
+	// make sure each thread has its own RVE instance
+	if (ReserveScratchRVEs(omp_get_max_threads()) == false)
+	{
+		feLogError("An error occurred initializing the RVE instances");
+		throw FEMultiScaleException(-1, -1);
+	}
+
+	int nt = (int)m_rveScratch.size();
+	std::vector<double> threadTime(nt, 0.0);
+
+	Timer timer;
+	timer.start();
+
+	bool berr = false;
+	#pragma omp parallel for schedule(dynamic, 1) shared(berr)
+	for (int i = 0; i < N; ++i)
+	{
+		if (berr) continue;
+
+		FEMaterialPoint& mp = *points[m_order[i]];
+		try
+		{
+			FEElasticMaterialPoint& pt = *mp.ExtractData<FEElasticMaterialPoint>();
+			pt.m_s = SolveRVE(mp);
+		}
+		catch (FEMultiScaleException)
+		{
+			#pragma omp critical
+			berr = true;
+		}
+		int n = omp_get_thread_num();
+		if (n < nt) threadTime[n] += mp.ExtractData<FEMicroMaterialPoint>()->m_rve_time;
+	}
+
+	timer.stop();
+
+	// rethrow outside the parallel region
+	if (berr) throw FEMultiScaleException(-1, -1);
+
+	if (m_rveStats)
+	{
+		int minIter = 0, maxIter = 0, totIter = 0;
+		double minTime = 0.0, maxTime = 0.0, totTime = 0.0;
+		for (int i = 0; i < N; ++i)
+		{
+			FEMicroMaterialPoint& mmpt = *points[i]->ExtractData<FEMicroMaterialPoint>();
+			if ((i == 0) || (mmpt.m_rve_iters < minIter)) minIter = mmpt.m_rve_iters;
+			if ((i == 0) || (mmpt.m_rve_iters > maxIter)) maxIter = mmpt.m_rve_iters;
+			if ((i == 0) || (mmpt.m_rve_time  < minTime)) minTime = mmpt.m_rve_time;
+			if ((i == 0) || (mmpt.m_rve_time  > maxTime)) maxTime = mmpt.m_rve_time;
+			totIter += mmpt.m_rve_iters;
+			totTime += mmpt.m_rve_time;
+		}
+
+		double maxThread = 0.0;
+		for (int i = 0; i < nt; ++i) if (threadTime[i] > maxThread) maxThread = threadTime[i];
+		double imbalance = (totTime > 0.0 ? maxThread*nt / totTime : 1.0);
+
+		feLog("RVE solves (%s): %d\n", GetName().c_str(), N);
+		feLog("\titerations (min/avg/max) ........ : %d / %lg / %d\n", minIter, (double)totIter / N, maxIter);
+		feLog("\ttime (min/avg/max) .............. : %lg / %lg / %lg\n", minTime, totTime / N, maxTime);
+		feLog("\twall time ........................ : %lg\n", timer.GetTime());
+		feLog("\tthread load imbalance (max/avg) .. : %lg\n", imbalance);
+	}
+}
+
 //-----------------------------------------------------------------------------
 // The stiffness is evaluated at the same time the stress is evaluated so we 
 // can just return it here. Note that this assumes that the stress function 
@@ -184,7 +396,7 @@ mat3ds FEMicroMaterial::Stress(FEMaterialPoint &mp)
 tens4ds FEMicroMaterial::Tangent(FEMaterialPoint &mp)
 {
 	FEMicroMaterialPoint& mmpt = *mp.ExtractData<FEMicroMaterialPoint>();
-	return mmpt.m_rve.StiffnessAverage(mp);
+	return mmpt.m_C;
 }
 
 //-----------------------------------------------------------------------------
@@ -64,7 +64,14 @@ public:
 	double	   m_macro_energy_inc;	// Macroscopic strain energy increment
 	double	   m_micro_energy_inc;	// Microscopic strain energy increment
 
-	FERVEModel	m_rve;				// Local copy of the parent rve
+	tens4ds		m_C;				// averaged tangent of last RVE solve
+	mat3d		m_PK1;				// averaged PK1 stress of last RVE solve
+
+	int			m_rve_iters;		// nr of iterations of last RVE solve
+	double		m_rve_time;			// wall time of last RVE solve (in seconds)
+
+	FERVEState	m_state;			// RVE state at last converged time step
+	FERVEState	m_trial;			// RVE state of last RVE solve
 };
 
 //-----------------------------------------------------------------------------
@@ -83,6 +90,7 @@ public:
 	std::string	m_szbc;		//!< name of nodeset defining boundary
 	int			m_bctype;		//!< periodic bc flag
 	double		m_scale;		//!< RVE scale factor
+	bool		m_rveStats;		//!< report statistics of the RVE solves
 	FERVEModel	m_mrve;			//!< the parent RVE (Representive Volume Element)
 
 public:
@@ -107,6 +115,30 @@ public:
 	// average RVE energy
 	double micro_energy(FEModel& rve);
 
+	//! Load the most recent RVE state of a material point into the RVE 
+	//! instance of the calling thread and return that instance.
+	FERVEModel& MaterializeRVE(FEMaterialPoint& mp);
+
+	//! When set, Stress does not solve the RVE, but returns the current stress.
+	//! The RVEs must then be solved by calling SolveRVEs.
+	void DeferRVESolves(bool b) { m_bdefer = b; }
+
+	//! Solve the RVEs of the material points and update their stress
+	void SolveRVEs(const std::vector<FEMaterialPoint*>& points);
+
+protected:
+	//! solve the RVE of a material point and return the averaged Cauchy stress
+	mat3ds SolveRVE(FEMaterialPoint& mp);
+
+	//! returns the RVE instance of the calling thread
+	FERVEModel& ScratchRVE();
+
+	//! create the RVE instances that are shared by all material points
+	bool InitScratchRVEs();
+
+	//! make sure there are at least nt RVE instances
+	bool ReserveScratchRVEs(int nt);
+
 public:
 	int Probes() { return (int) m_probe.size(); }
 	FERVEProbe& Probe(int i) { return *m_probe[i]; }
@@ -114,6 +146,13 @@ public:
 protected:
 	std::vector<FERVEProbe*>	m_probe;
 
+	// The material points only store the state of their RVE. The state is
+	// loaded into one of these RVE instances (one per thread) when needed.
+	std::vector<FERVEModel*>	m_rveScratch;	//!< per-thread RVE instances
+	FERVEState					m_rveInit;		//!< initial state of the RVE
+	bool						m_bdefer;		//!< defer RVE solves to SolveRVEs
+	std::vector<int>			m_order;		//!< order in which RVEs are solved
+
 public:
 	// declare the parameter list
 	DECLARE_FECORE_CLASS();
@@ -146,7 +146,7 @@ void FEPeriodicBoundary2O::BuildMatrixProfile(FEGlobalMatrix& K)
 
 		for (int k=0; k<n; ++k)
 		{
-			vector<int>& id = mesh.Node(en[k]).m_ID;
+			FENodeDofArray<int>& id = mesh.Node(en[k]).m_ID;
 			lm[6*(k+1)  ] = id[dof_X];
 			lm[6*(k+1)+1] = id[dof_Y];
 			lm[6*(k+1)+2] = id[dof_Z];
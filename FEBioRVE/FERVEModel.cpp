@@ -41,6 +41,60 @@ SOFTWARE.*/
 #include <FECore/FECube.h>
 #include <FECore/FEPointFunction.h>
 #include <FECore/FECoreKernel.h>
+#include <FECore/DumpStream.h>
+#include <string.h>
+
+//-----------------------------------------------------------------------------
+// Dump stream that writes to (or reads from) an RVE state buffer.
+class FERVEStateStream : public DumpStream
+{
+public:
+	FERVEStateStream(FEModel& fem, std::vector<char>& buf) : DumpStream(fem), m_buf(buf), m_pos(0) {}
+
+	size_t write(const void* pd, size_t size, size_t count) override
+	{
+		size_t nsize = size*count;
+		const char* pc = (const char*)pd;
+		m_buf.insert(m_buf.end(), pc, pc + nsize);
+		return nsize;
+	}
+
+	size_t read(void* pd, size_t size, size_t count) override
+	{
+		size_t nsize = size*count;
+		assert(m_pos + nsize <= m_buf.size());
+		memcpy(pd, &m_buf[m_pos], nsize);
+		m_pos += nsize;
+		return nsize;
+	}
+
+	bool EndOfStream() const override { return (m_pos >= m_buf.size()); }
+
+	void clear() override { m_buf.clear(); m_pos = 0; }
+
+private:
+	std::vector<char>&	m_buf;
+	size_t				m_pos;
+};
+
+//-----------------------------------------------------------------------------
+void FERVEState::Serialize(DumpStream& ar)
+{
+	ar & m_time;
+	if (ar.IsSaving())
+	{
+		int n = (int)m_buf.size();
+		ar << n;
+		if (n > 0) ar.write(&m_buf[0], sizeof(char), n);
+	}
+	else
+	{
+		int n = 0;
+		ar >> n;
+		m_buf.resize(n);
+		if (n > 0) ar.read(&m_buf[0], sizeof(char), n);
+	}
+}
 
 //-----------------------------------------------------------------------------
 FERVEModel::FERVEModel()
@@ -59,6 +113,29 @@ void FERVEModel::SetParentModel(FEModel* fem)
 	m_parentfem = fem;
 }
 
+//-----------------------------------------------------------------------------
+//! Store the current state of the RVE. This uses the shallow serialization of
+//! the model, which is also used for the running restarts.
+void FERVEModel::SaveState(FERVEState& state)
+{
+	state.m_buf.clear();
+	state.m_time = GetCurrentTime();
+	FERVEStateStream ar(*this, state.m_buf);
+	ar.Open(true, true);
+	Serialize(ar);
+}
+
+//-----------------------------------------------------------------------------
+//! Restore a previously stored state.
+bool FERVEModel::RestoreState(FERVEState& state)
+{
+	if (state.IsEmpty()) return false;
+	FERVEStateStream ar(*this, state.m_buf);
+	ar.Open(false, true);
+	Serialize(ar);
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 // copy from the parent RVE
 void FERVEModel::CopyFrom(FERVEModel& rve)
@@ -463,11 +540,10 @@ double FERVEModel::CurrentVolume()
 }
 
 //-----------------------------------------------------------------------------
+// NOTE: The RVE must be in the state of the last converged time step, e.g.
+// by calling RestoreState.
 mat3ds FERVEModel::StressAverage(mat3d& F, FEMaterialPoint& mp)
 {
-	// rewind the RCI
-	RCI_Rewind();
-
 	// update the BC's
 	Update(F);
 
@@ -29,6 +29,41 @@ SOFTWARE.*/
 #pragma once
 #include "FECore/FEModel.h"
 #include <FECore/tens4d.h>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Stores the state of an RVE model, i.e. its nodal values, material point
+//! history and solver state, as a compact byte buffer. A state can be restored
+//! into any RVE model that was copied from the same parent RVE. 
+class FERVEState
+{
+public:
+	FERVEState() : m_time(0.0) {}
+
+	//! see if a state was stored
+	bool IsEmpty() const { return m_buf.empty(); }
+
+	//! size of stored state (in bytes)
+	size_t Size() const { return m_buf.size(); }
+
+	//! time at which the state was stored
+	double GetTime() const { return m_time; }
+
+	//! remove the stored state (but keep the memory for reuse)
+	void Clear() { m_buf.clear(); }
+
+	//! swap states
+	void Swap(FERVEState& s) { m_buf.swap(s.m_buf); std::swap(m_time, s.m_time); }
+
+	//! serialize the stored data
+	void Serialize(DumpStream& ar);
+
+private:
+	std::vector<char>	m_buf;
+	double				m_time;
+
+	friend class FERVEModel;
+};
 
 //-----------------------------------------------------------------------------
 // Class describing the RVE model.
@@ -74,6 +109,12 @@ public:
 	// set the parent FEModel
 	void SetParentModel(FEModel* fem);
 
+	//! store the current state of the RVE
+	void SaveState(FERVEState& state);
+
+	//! restore a previously stored state
+	bool RestoreState(FERVEState& state);
+
 	//! Calculate the stress average
 	mat3ds StressAverage(mat3d& F, FEMaterialPoint& mp);
 	mat3ds StressAverage(FEMaterialPoint& mp);
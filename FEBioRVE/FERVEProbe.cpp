@@ -106,6 +106,9 @@ FEMicroProbe::FEMicroProbe(FEModel* fem) : FERVEProbe(fem)
 {
 	m_neid = -1;	// invalid element - this must be defined by user
 	m_ngp = -1;		// invalid gauss point
+
+	m_mat = nullptr;
+	m_mp = nullptr;
 }
 
 bool FEMicroProbe::Init()
@@ -145,7 +148,8 @@ bool FEMicroProbe::Init()
 		FEMaterialPoint* mp = pel->GetMaterialPoint(m_ngp);
 		FEMicroMaterialPoint* mmp = mp->ExtractData<FEMicroMaterialPoint>();
 		if (mmp == nullptr) return false;
-		SetRVEModel(&mmp->m_rve);
+		m_mat = mat;
+		m_mp = mp;
 	}
 	else
 	{
@@ -153,6 +157,15 @@ bool FEMicroProbe::Init()
 		return false;
 	}
 
+	// NOTE: The RVE model is assigned in Execute, since the material's RVE
+	// instances may not have been created yet.
+	return FECallBack::Init();
+}
 
-	return FERVEProbe::Init();
+bool FEMicroProbe::Execute(FEModel& fem, int nwhen)
+{
+	// The material point only stores the state of its RVE, 
+	// so we need to load it into an RVE instance first. 
+	if (m_mat && m_mp) SetRVEModel(&m_mat->MaterializeRVE(*m_mp));
+	return FERVEProbe::Execute(fem, nwhen);
 }
@@ -30,6 +30,7 @@ SOFTWARE.*/
 //-----------------------------------------------------------------------------
 class FEBioPlotFile;
 class FEMaterialPoint;
+class FEMicroMaterial;
 
 //-----------------------------------------------------------------------------
 // Base class for RVE probes
@@ -69,9 +70,14 @@ public:
 
 	bool Init() override;
 
+	bool Execute(FEModel& fem, int nwhen) override;
+
 private:
 	int			m_neid;			//!< element Id
 	int			m_ngp;			//!< Gauss-point (one-based!)
 
+	FEMicroMaterial*	m_mat;	//!< the micro-material
+	FEMaterialPoint*	m_mp;	//!< the probed material point
+
 	DECLARE_FECORE_CLASS();
 };
@@ -0,0 +1,574 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+
+#include "stdafx.h"
+#include "FEBenchmark.h"
+#include <FEBioLib/FEBox.h>
+#include <FECore/FEModel.h>
+#include <FECore/FEAnalysis.h>
+#include <FECore/FECoreKernel.h>
+#include <FECore/FEMaterial.h>
+#include <FECore/FESolidDomain.h>
+#include <FECore/FESurface.h>
+#include <FECore/FEFacetSet.h>
+#include <FECore/FENodeSet.h>
+#include <FECore/FEFixedBC.h>
+#include <FECore/FEPrescribedDOF.h>
+#include <FECore/FELoadCurve.h>
+#include <FECore/FESurfacePairConstraint.h>
+#include <FECore/FENewtonSolver.h>
+#include <FECore/FEGlobalMatrix.h>
+#include <FECore/LinearSolver.h>
+#include <FECore/FEModelParam.h>
+#include <FECore/Timer.h>
+#include <FECore/sys.h>
+#include <FECore/log.h>
+#include <FEBioXML/XMLReader.h>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+// A global matrix that discards all element matrices. This is used to time the
+// calculation of the element matrices without the assembly.
+class FENullAssemblyMatrix : public FEGlobalMatrix
+{
+public:
+	FENullAssemblyMatrix(FEGlobalMatrix& K) : FEGlobalMatrix(K.GetSparseMatrixPtr(), false)
+	{
+		SetColoredAssembly(K.ColoredAssembly());
+	}
+
+	void Assemble(const FEElementMatrix& ke) override {}
+};
+
+//-----------------------------------------------------------------------------
+// set a (scalar) material parameter
+static bool set_parameter(FECoreBase* pc, const char* szname, double v)
+{
+	FEParam* p = pc->FindParameter(szname);
+	if (p == nullptr) return false;
+	switch (p->type())
+	{
+	case FE_PARAM_DOUBLE       : p->value<double>() = v; break;
+	case FE_PARAM_DOUBLE_MAPPED: p->value<FEParamDouble>() = v; break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+static const char* szphase[FEBenchmark::PHASES] = { "residual", "stiffness", "assembly", "factorization", "back-solve" };
+
+//-----------------------------------------------------------------------------
+FEBenchmark::FEBenchmark(FEModel* fem) : FECoreTask(fem)
+{
+	m_nx = m_ny = m_nz = 10;
+	m_elemType = "hex8";
+	m_matType = "neo-Hookean";
+	m_bcontact = false;
+	m_niter = 3;
+	m_maxThreads = 0;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBenchmark::Init(const char* szfile)
+{
+	// read the control file, if any
+	if (szfile && szfile[0])
+	{
+		if (ReadControlFile(szfile) == false) return false;
+	}
+
+	// the default output file is derived from the control file
+	if (m_outFile.empty())
+	{
+		if (szfile && szfile[0])
+		{
+			m_outFile = szfile;
+			size_t n = m_outFile.rfind('.');
+			if (n != std::string::npos) m_outFile.erase(n);
+			m_outFile += "_benchmark.txt";
+		}
+		else m_outFile = "benchmark.txt";
+	}
+
+	if (BuildModel() == false)
+	{
+		fprintf(stderr, "Failed building benchmark model.\n");
+		return false;
+	}
+
+	// do the FE initialization
+	return GetFEModel()->Init();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBenchmark::ReadControlFile(const char* szfile)
+{
+	XMLReader xml;
+	if (xml.Open(szfile) == false)
+	{
+		fprintf(stderr, "FATAL ERROR: Failed opening benchmark file %s\n", szfile);
+		fprintf(stderr, "(The file must exist and start with an <?xml ... ?> header.)\n\n");
+		return false;
+	}
+
+	try
+	{
+		XMLTag tag;
+		if (xml.FindTag("febio_benchmark", tag) == false) return false;
+
+		++tag;
+		while (!tag.isend())
+		{
+			if (tag == "size")
+			{
+				int n[3] = { m_nx, m_ny, m_nz };
+				tag.value(n, 3);
+				m_nx = n[0]; m_ny = n[1]; m_nz = n[2];
+				if ((m_nx <= 0) || (m_ny <= 0) || (m_nz <= 0)) throw XMLReader::InvalidValue(tag);
+			}
+			else if (tag == "element_type") m_elemType = tag.szvalue();
+			else if (tag == "material"    ) m_matType = tag.szvalue();
+			else if (tag == "contact"     ) tag.value(m_bcontact);
+			else if (tag == "iterations"  ) { tag.value(m_niter); if (m_niter <= 0) throw XMLReader::InvalidValue(tag); }
+			else if (tag == "max_threads" ) tag.value(m_maxThreads);
+			else if (tag == "output"      ) m_outFile = tag.szvalue();
+			else throw XMLReader::InvalidTag(tag);
+
+			++tag;
+		}
+	}
+	catch (XMLReader::Error& e)
+	{
+		fprintf(stderr, "FATAL ERROR: %s\n", e.what());
+		return false;
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterial* FEBenchmark::CreateMaterial()
+{
+	FEModel& fem = *GetFEModel();
+
+	if (m_matType == "neo-Hookean")
+	{
+		FEMaterial* pm = fecore_new<FEMaterial>("neo-Hookean", &fem);
+		if (pm == nullptr) return nullptr;
+		set_parameter(pm, "E", 1.0);
+		set_parameter(pm, "v", 0.3);
+		return pm;
+	}
+	else if (m_matType == "fiber")
+	{
+		// the fiber direction defaults to the x-axis
+		FEMaterial* pm = fecore_new<FEMaterial>("trans iso Mooney-Rivlin", &fem);
+		if (pm == nullptr) return nullptr;
+		set_parameter(pm, "c1", 1.0);
+		set_parameter(pm, "c2", 0.0);
+		set_parameter(pm, "c3", 0.1);
+		set_parameter(pm, "c4", 10.0);
+		set_parameter(pm, "c5", 10.0);
+		set_parameter(pm, "lam_max", 1.1);
+		set_parameter(pm, "k", 100.0);
+		return pm;
+	}
+	else if (m_matType == "biphasic")
+	{
+		FEMaterial* pm = fecore_new<FEMaterial>("biphasic", &fem);
+		FEMaterial* solid = fecore_new<FEMaterial>("neo-Hookean", &fem);
+		FEMaterial* perm = fecore_new<FEMaterial>("perm-const-iso", &fem);
+		if ((pm == nullptr) || (solid == nullptr) || (perm == nullptr)) return nullptr;
+		set_parameter(solid, "E", 1.0);
+		set_parameter(solid, "v", 0.3);
+		set_parameter(perm, "perm", 1e-3);
+		set_parameter(pm, "phi0", 0.2);
+		pm->SetProperty("solid", solid);
+		pm->SetProperty("permeability", perm);
+		return pm;
+	}
+
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+// The model is a unit cube that is fixed at the bottom and compressed at the top.
+// With contact, a second (coarser) box is stacked on top of the cube and the 
+// compression is applied to the top of that box instead.
+bool FEBenchmark::BuildModel()
+{
+	FEModel& fem = *GetFEModel();
+
+	// find the element type
+	FE_Element_Type etype;
+	if      (m_elemType == "hex8" ) etype = FE_HEX8G8;
+	else if (m_elemType == "hex20") etype = FE_HEX20G27;
+	else if (m_elemType == "tet4" ) etype = FE_TET4G1;
+	else if (m_elemType == "tet10") etype = FE_TET10G8;
+	else
+	{
+		fprintf(stderr, "Unknown element type: %s\n", m_elemType.c_str());
+		return false;
+	}
+
+	// set the module
+	bool bbiphasic = (m_matType == "biphasic");
+	const char* szmod = (bbiphasic ? "biphasic" : "solid");
+	FECoreKernel::GetInstance().SetActiveModule(szmod);
+	fem.SetModuleName(szmod);
+
+	// create an analysis step
+	// (Creating the solver also defines the degrees of freedom.)
+	FEAnalysis* pstep = new FEAnalysis(&fem);
+	FESolver* psolver = fecore_new<FESolver>(szmod, &fem);
+	if (psolver == nullptr) return false;
+	pstep->SetFESolver(psolver);
+	pstep->m_ntime = 10;
+	pstep->m_dt0 = 0.1;
+	pstep->SetPlotLevel(FE_PLOT_NEVER);
+	pstep->SetOutputLevel(FE_OUTPUT_NEVER);
+	fem.AddStep(pstep);
+	fem.SetCurrentStep(pstep);
+
+	// create the material
+	FEMaterial* pmat = CreateMaterial();
+	if (pmat == nullptr)
+	{
+		fprintf(stderr, "Unknown material: %s\n", m_matType.c_str());
+		return false;
+	}
+	fem.AddMaterial(pmat);
+
+	// create the mesh
+	FEMesh& mesh = fem.GetMesh();
+	FESolidDomain* lower = FEBoxMesh::AddBox(mesh, m_nx, m_ny, m_nz, vec3d(0, 0, 0), vec3d(1, 1, 1), etype, pmat);
+	if (lower == nullptr) return false;
+	lower->SetMatID(0);
+	lower->CreateMaterialPointData();
+
+	double ztop = 1.0;
+	if (m_bcontact)
+	{
+		// the upper box does not match the lower one
+		int nz = (m_nz > 1 ? m_nz / 2 : 1);
+		FESolidDomain* upper = FEBoxMesh::AddBox(mesh, m_nx + 1, m_ny + 1, nz, vec3d(0, 0, 1), vec3d(1, 1, 1.5), etype, pmat);
+		if (upper == nullptr) return false;
+		upper->SetMatID(0);
+		upper->CreateMaterialPointData();
+
+		if (AddContact(*lower, *upper, 1.0) == false) return false;
+		ztop = 1.5;
+	}
+
+	// find the bottom and top nodes
+	FENodeSet* bottom = new FENodeSet(&fem);
+	FENodeSet* top = new FENodeSet(&fem);
+	const double eps = 1e-9;
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		const vec3d& r = mesh.Node(i).m_r0;
+		if (fabs(r.z) < eps) bottom->Add(i);
+		if (fabs(r.z - ztop) < eps) top->Add(i);
+	}
+	mesh.AddNodeSet(bottom);
+	mesh.AddNodeSet(top);
+
+	// get the degrees of freedom
+	const int dof_x = fem.GetDOFIndex("x");
+	const int dof_y = fem.GetDOFIndex("y");
+	const int dof_z = fem.GetDOFIndex("z");
+
+	fem.AddBoundaryCondition(new FEFixedBC(&fem, dof_x, bottom));
+	fem.AddBoundaryCondition(new FEFixedBC(&fem, dof_y, bottom));
+	fem.AddBoundaryCondition(new FEFixedBC(&fem, dof_z, bottom));
+	fem.AddBoundaryCondition(new FEFixedBC(&fem, dof_x, top));
+	fem.AddBoundaryCondition(new FEFixedBC(&fem, dof_y, top));
+
+	// the top is free-draining
+	if (bbiphasic)
+	{
+		const int dof_p = fem.GetDOFIndex("p");
+		fem.AddBoundaryCondition(new FEFixedBC(&fem, dof_p, top));
+	}
+
+	// Add a loadcurve
+	FELoadCurve* plc = new FELoadCurve(&fem);
+	plc->Add(0.0, 0.0);
+	plc->Add(1.0, 1.0);
+	fem.AddLoadController(plc);
+
+	// compress the top
+	FEPrescribedDOF* pdc = new FEPrescribedDOF(&fem, dof_z, top);
+	pdc->SetScale(-0.1, 0);
+	fem.AddBoundaryCondition(pdc);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// collect the faces of the domain that lie in the plane at height z
+static FEFacetSet* find_faces(FEModel& fem, FESolidDomain& dom, double z)
+{
+	FEMesh& mesh = fem.GetMesh();
+	FEFacetSet* fs = new FEFacetSet(&fem);
+
+	std::vector<FEFacetSet::FACET> faces;
+	int fn[FEElement::MAX_NODES];
+	for (int i = 0; i < dom.Elements(); ++i)
+	{
+		FESolidElement& el = dom.Element(i);
+		for (int j = 0; j < el.Faces(); ++j)
+		{
+			int nf = el.GetFace(j, fn);
+			bool bplane = true;
+			for (int k = 0; (k < nf) && bplane; ++k)
+			{
+				if (fabs(mesh.Node(fn[k]).m_r0.z - z) > 1e-9) bplane = false;
+			}
+
+			if (bplane)
+			{
+				FEFacetSet::FACET f;
+				f.ntype = nf;
+				for (int k = 0; k < nf; ++k) f.node[k] = fn[k];
+				faces.push_back(f);
+			}
+		}
+	}
+
+	fs->Create((int)faces.size());
+	for (int i = 0; i < (int)faces.size(); ++i) fs->Face(i) = faces[i];
+	mesh.AddFacetSet(fs);
+
+	return fs;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBenchmark::AddContact(FESolidDomain& lower, FESolidDomain& upper, double z)
+{
+	FEModel& fem = *GetFEModel();
+	FEMesh& mesh = fem.GetMesh();
+
+	FESurfacePairConstraint* pci = fecore_new<FESurfacePairConstraint>("sliding-elastic", &fem);
+	if (pci == nullptr) return false;
+
+	FEFacetSet* primary = find_faces(fem, upper, z);
+	FEFacetSet* secondary = find_faces(fem, lower, z);
+	if ((primary->Faces() == 0) || (secondary->Faces() == 0)) return false;
+
+	FESurface* ss = pci->GetPrimarySurface();
+	FESurface* ms = pci->GetSecondarySurface();
+	ss->Create(*primary); ss->InitSurface();
+	ms->Create(*secondary); ms->InitSurface();
+	mesh.AddSurface(ss);
+	mesh.AddSurface(ms);
+
+	fem.AddSurfacePairConstraint(pci);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Do a fixed number of Newton iterations and add the time spent in each phase to sec.
+bool FEBenchmark::RunIterations(FENewtonSolver& solver, double time, double* sec)
+{
+	if (solver.InitStep(time) == false) return false;
+	solver.PrepStep();
+
+	FEGlobalMatrix& K = *solver.m_pK;
+	LinearSolver& ls = *solver.m_plinsolve;
+	FENullAssemblyMatrix K0(K);
+
+	Timer timer;
+	for (int i = 0; i < m_niter; ++i)
+	{
+		// with contact, the matrix profile can change in every iteration
+		if ((i == 0) || m_bcontact)
+		{
+			if (solver.CreateStiffness(i == 0) == false) return false;
+		}
+
+		timer.reset(); timer.start();
+		if (solver.Residual(solver.m_R0) == false) return false;
+		timer.stop(); sec[RESIDUAL] += timer.GetTime();
+
+		// element matrices only
+		timer.reset(); timer.start();
+		zero(solver.m_Fd);
+		solver.m_pK = &K0;
+		bool bret = solver.StiffnessMatrix();
+		solver.m_pK = &K;
+		timer.stop(); sec[STIFFNESS] += timer.GetTime();
+		if (bret == false) return false;
+
+		// element matrices and assembly
+		timer.reset(); timer.start();
+		K.Zero();
+		zero(solver.m_Fd);
+		if (solver.StiffnessMatrix() == false) return false;
+		timer.stop(); sec[ASSEMBLY] += timer.GetTime();
+
+		timer.reset(); timer.start();
+		if (ls.Factor() == false) return false;
+		timer.stop(); sec[FACTORIZATION] += timer.GetTime();
+
+		timer.reset(); timer.start();
+		solver.m_R0 += solver.m_Fd;
+		if (ls.BackSolve(solver.m_ui, solver.m_R0) == false) return false;
+		timer.stop(); sec[BACK_SOLVE] += timer.GetTime();
+
+		// update the solution
+		solver.Update(solver.m_ui);
+		for (int j = 0; j < solver.m_neq; ++j) solver.m_Ui[j] += solver.m_ui[j];
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBenchmark::Run()
+{
+	FEModel& fem = *GetFEModel();
+	FEAnalysis* pstep = fem.GetCurrentStep();
+
+	// the thread counts we'll test
+	const int ompThreads = omp_get_max_threads();
+	int maxThreads = (m_maxThreads > 0 ? m_maxThreads : ompThreads);
+	std::vector<int> threads;
+	for (int n = 1; n < maxThreads; n *= 2) threads.push_back(n);
+	threads.push_back(maxThreads);
+
+	const int NT = (int)threads.size();
+	std::vector<double> sec(NT*PHASES, 0.0);
+
+	bool bret = true;
+	std::string err;
+	try
+	{
+		if ((pstep->Activate() == false) || (pstep->InitSolver() == false)) bret = false;
+
+		FENewtonSolver* solver = dynamic_cast<FENewtonSolver*>(pstep->GetFESolver());
+		if (solver == nullptr) bret = false;
+
+		// the solver's output is not needed while timing
+		fem.BlockLog();
+
+		// Each thread count gets its own time step
+		FETimeInfo& tp = fem.GetTime();
+		for (int i = 0; (i < NT) && bret; ++i)
+		{
+			omp_set_num_threads(threads[i]);
+
+			tp.currentTime += pstep->m_dt0;
+			tp.timeIncrement = pstep->m_dt0;
+			bret = RunIterations(*solver, tp.currentTime, &sec[i*PHASES]);
+		}
+	}
+	catch (std::exception& e)
+	{
+		err = e.what();
+		bret = false;
+	}
+	catch (...)
+	{
+		err = "unknown exception";
+		bret = false;
+	}
+	fem.UnBlockLog();
+	omp_set_num_threads(ompThreads);
+
+	if (err.empty() == false) feLogError("Exception thrown: %s\nAborting benchmark.\n", err.c_str());
+
+	if (bret == false)
+	{
+		feLogError("Benchmark failed.\n");
+		return false;
+	}
+
+	WriteResults(threads, sec);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEBenchmark::WriteResults(const std::vector<int>& threads, const std::vector<double>& sec)
+{
+	FEModel& fem = *GetFEModel();
+	FEMesh& mesh = fem.GetMesh();
+	int NE = mesh.Elements();
+	int neq = fem.GetCurrentStep()->GetFESolver()->m_neq;
+	const int NT = (int)threads.size();
+
+	feLog("\nBenchmark results\n");
+	feLog("\tElement type ............................... : %s\n", m_elemType.c_str());
+	feLog("\tMaterial ................................... : %s\n", m_matType.c_str());
+	feLog("\tContact .................................... : %s\n", (m_bcontact ? "yes" : "no"));
+	feLog("\tNumber of elements ......................... : %d\n", NE);
+	feLog("\tNumber of equations ........................ : %d\n", neq);
+	feLog("\tIterations per thread count ................ : %d\n\n", m_niter);
+	feLog("\t%8s  %-16s%14s%16s\n", "threads", "phase", "time (s)", "elements/s");
+	for (int i = 0; i < NT; ++i)
+	{
+		for (int j = 0; j < PHASES; ++j)
+		{
+			// the assembly time includes the element matrices
+			double t = sec[i*PHASES + j];
+			if (j == ASSEMBLY) t = fmax(t - sec[i*PHASES + STIFFNESS], 0.0);
+			double rate = (t > 0.0 ? (double)NE * m_niter / t : 0.0);
+			feLog("\t%8d  %-16s%14.4lg%16.4lg\n", threads[i], szphase[j], t / m_niter, rate);
+		}
+	}
+
+	FILE* fp = fopen(m_outFile.c_str(), "wt");
+	if (fp == nullptr)
+	{
+		feLogError("Failed writing benchmark results to %s", m_outFile.c_str());
+		return;
+	}
+
+	fprintf(fp, "# element_type=%s material=%s contact=%d elements=%d equations=%d iterations=%d\n", m_elemType.c_str(), m_matType.c_str(), (m_bcontact ? 1 : 0), NE, neq, m_niter);
+	fprintf(fp, "threads\tphase\tcalls\tseconds_per_call\telements_per_second\n");
+	for (int i = 0; i < NT; ++i)
+	{
+		for (int j = 0; j < PHASES; ++j)
+		{
+			double t = sec[i*PHASES + j];
+			if (j == ASSEMBLY) t = fmax(t - sec[i*PHASES + STIFFNESS], 0.0);
+			double rate = (t > 0.0 ? (double)NE * m_niter / t : 0.0);
+			fprintf(fp, "%d\t%s\t%d\t%lg\t%lg\n", threads[i], szphase[j], m_niter, t / m_niter, rate);
+		}
+	}
+	fclose(fp);
+
+	feLog("\nBenchmark results written to %s\n", m_outFile.c_str());
+}
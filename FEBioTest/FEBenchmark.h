@@ -0,0 +1,101 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+
+#pragma once
+#include <FECore/FECoreTask.h>
+#include <string>
+#include <vector>
+
+class FEMaterial;
+class FESolidDomain;
+class FENewtonSolver;
+
+//-----------------------------------------------------------------------------
+//! This task measures the throughput of the main phases of a Newton iteration
+//! (residual, element stiffness, assembly, factorization, back-solve) on a 
+//! generated box model. The iterations are repeated for an increasing number of
+//! threads and the results are written as a tab-separated table. 
+//! The (optional) control file has the following format. As with all FEBio
+//! input files, the first line must be the XML header.
+//!
+//! <?xml version="1.0" encoding="ISO-8859-1"?>
+//! <febio_benchmark>
+//!   <size>10,10,10</size>
+//!   <element_type>hex8</element_type>        (hex8, hex20, tet4, tet10)
+//!   <material>neo-Hookean</material>         (neo-Hookean, fiber, biphasic)
+//!   <contact>0</contact>
+//!   <iterations>3</iterations>
+//!   <max_threads>8</max_threads>
+//!   <output>benchmark.txt</output>
+//! </febio_benchmark>
+class FEBenchmark : public FECoreTask
+{
+public:
+	enum Phase {
+		RESIDUAL,
+		STIFFNESS,
+		ASSEMBLY,
+		FACTORIZATION,
+		BACK_SOLVE,
+		PHASES
+	};
+
+public:
+	FEBenchmark(FEModel* fem);
+
+	//! read the control file and build the model
+	bool Init(const char* szfile) override;
+
+	//! run the benchmark
+	bool Run() override;
+
+private:
+	bool ReadControlFile(const char* szfile);
+
+	bool BuildModel();
+
+	FEMaterial* CreateMaterial();
+
+	bool AddContact(FESolidDomain& lower, FESolidDomain& upper, double z);
+
+	bool RunIterations(FENewtonSolver& solver, double time, double* sec);
+
+	void WriteResults(const std::vector<int>& threads, const std::vector<double>& sec);
+
+private:
+	int			m_nx, m_ny, m_nz;	//!< number of cells in each direction
+	std::string	m_elemType;			//!< element type (hex8, hex20, tet4, tet10)
+	std::string	m_matType;			//!< material (neo-Hookean, fiber, biphasic)
+	bool		m_bcontact;			//!< add a second box in contact with the first one
+	int			m_niter;			//!< number of Newton iterations per thread count
+	int			m_maxThreads;		//!< max number of threads (0 = all available)
+	std::string	m_outFile;			//!< output file for the results table
+};
@@ -35,6 +35,7 @@ SOFTWARE.*/
 #include "FEJFNKTangentDiagnostic.h"
 #include "FEBioEigenSolver.h"
 #include "FEResetTest.h"
+#include "FEBenchmark.h"
 
 namespace FEBioTest
 {
@@ -46,5 +47,6 @@ void InitModule()
 	REGISTER_FECORE_CLASS(FEJFNKTangentDiagnostic, "jfnk tangent test");
 	REGISTER_FECORE_CLASS(FEBioEigenSolver, "eigen");
 	REGISTER_FECORE_CLASS(FEResetTest, "reset_test");
+	REGISTER_FECORE_CLASS(FEBenchmark, "benchmark");
 }
 }
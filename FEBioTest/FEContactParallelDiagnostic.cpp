@@ -0,0 +1,183 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+#include "stdafx.h"
+#include "FEContactParallelDiagnostic.h"
+#include <FEBioMech/FEContactInterface.h>
+#include <FEBioMech/FEResidualVector.h>
+#include <FECore/FENewtonSolver.h>
+#include <FECore/FEGlobalMatrix.h>
+#include <FECore/FELinearSystem.h>
+#include <FECore/log.h>
+#include <FECore/sys.h>
+#include <NumCore/CompactSymmMatrix.h>
+#include <NumCore/CompactUnSymmMatrix.h>
+#include <NumCore/MatrixTools.h>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+// The analysis step is defined by the input model, so unlike the other
+// diagnostics we don't create one here.
+FEContactParallelDiagnostic::FEContactParallelDiagnostic(FEModel& fem) : FEDiagnostic(fem)
+{
+}
+
+//-----------------------------------------------------------------------------
+FEContactParallelDiagnostic::~FEContactParallelDiagnostic()
+{
+}
+
+//-----------------------------------------------------------------------------
+bool FEContactParallelDiagnostic::ParseSection(XMLTag& tag)
+{
+	if (tag == "input")
+	{
+		// get the input file name
+		const char* szfile = tag.szvalue();
+
+		// try to read the file
+		FEBioImport im;
+		FEModel& fem = *GetFEModel();
+		if (im.Load(fem, szfile) == false)
+		{
+			char szerr[256];
+			im.GetErrorMessage(szerr);
+			fprintf(stderr, "%s", szerr);
+
+			return false;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool FEContactParallelDiagnostic::Run()
+{
+	// get and initialize the first step
+	FEModel& fem = *GetFEModel();
+	FEAnalysis* pstep = fem.GetStep(0);
+	pstep->Init();
+	pstep->Activate();
+
+	// get and initialize the solver
+	FENewtonSolver* solver = dynamic_cast<FENewtonSolver*>(pstep->GetFESolver());
+	if ((solver == nullptr) || (pstep->InitSolver() == false)) return false;
+
+	// make sure the contact data is up to date
+	fem.Update();
+
+	// build the matrix profile
+	if (!solver->CreateStiffness(true)) return false;
+	SparseMatrixProfile* MP = solver->GetStiffnessMatrix()->GetSparseMatrixProfile();
+	if (MP == nullptr) return false;
+
+	// we assemble in a compact matrix so that the values can be compared directly
+	bool bsymm = (solver->MatrixType() == REAL_SYMMETRIC);
+	CompactMatrix* pA = (bsymm ? (CompactMatrix*) new CompactSymmMatrix(0) : (CompactMatrix*) new CRSSparseMatrix(0));
+	pA->Create(*MP);
+	FEGlobalMatrix K(pA);
+
+	int neq = solver->m_neq;
+	int nnz = pA->NonZeroes();
+	vector<double> Fd(neq, 0.0), ui(neq, 0.0);
+	FELinearSystem LS(solver, K, Fd, ui, bsymm);
+
+	const FETimeInfo& tp = fem.GetTime();
+
+	feLog("\nParallel contact assembly check\n");
+	feLog("\tNumber of equations ........................ : %d\n", neq);
+	feLog("\tNumber of nonzeroes ........................ : %d\n\n", nnz);
+	feLog("\t%-32s%14s%14s%14s\n", "interface", "|R|", "max. diff R", "max. diff K");
+
+	bool bok = true;
+	int ntested = 0;
+	for (int i = 0; i < fem.SurfacePairConstraints(); ++i)
+	{
+		FEContactInterface* pci = dynamic_cast<FEContactInterface*>(fem.SurfacePairConstraint(i));
+		if ((pci == nullptr) || !pci->IsActive()) continue;
+
+		// only interfaces that expose the switch support parallel assembly
+		if (pci->FindParameterFromData(&pci->m_bparallel) == nullptr) continue;
+		bool bparallel = pci->m_bparallel;
+
+		// evaluate residual and stiffness, first serial then parallel
+		// (the parallel pass uses at least two threads, otherwise it would be serial as well)
+		const int nthreads = omp_get_max_threads();
+		vector<double> R[2], Kv[2];
+		for (int n = 0; n < 2; ++n)
+		{
+			pci->m_bparallel = (n == 1);
+			if (n == 1) omp_set_num_threads(nthreads < 2 ? 2 : nthreads);
+
+			R[n].assign(neq, 0.0);
+			vector<double> Fr(neq, 0.0);
+			FEResidualVector RHS(fem, R[n], Fr);
+			pci->LoadVector(RHS, tp);
+
+			pA->Zero();
+			pci->StiffnessMatrix(LS, tp);
+			Kv[n].assign(pA->Values(), pA->Values() + nnz);
+		}
+		pci->m_bparallel = bparallel;
+		omp_set_num_threads(nthreads);
+
+		double Rnorm = NumCore::infNorm(R[0]);
+		double Knorm = NumCore::infNorm(Kv[0]);
+		double dR = 0.0, dK = 0.0;
+		for (int j = 0; j < neq; ++j) dR = fmax(dR, fabs(R[1][j] - R[0][j]));
+		for (int j = 0; j < nnz; ++j) dK = fmax(dK, fabs(Kv[1][j] - Kv[0][j]));
+
+		// assembly order differs between threads, so we only expect agreement up to round-off
+		if (dR > 1e-10*(1.0 + Rnorm)) bok = false;
+		if (dK > 1e-10*(1.0 + Knorm)) bok = false;
+
+		const char* szname = pci->GetName().c_str();
+		if (szname[0] == 0) szname = pci->GetTypeStr();
+		feLog("\t%-32s%14.4lg%14.4lg%14.4lg\n", szname, Rnorm, dR, dK);
+
+		// if there is no contact, nothing was tested
+		if (Rnorm == 0.0)
+		{
+			feLogWarning("Interface %s has no contact forces in the initial configuration.", szname);
+			bok = false;
+		}
+		ntested++;
+	}
+
+	if (ntested == 0)
+	{
+		feLogError("No contact interfaces that support parallel assembly were found.");
+		bok = false;
+	}
+
+	return bok;
+}
@@ -40,6 +40,8 @@ SOFTWARE.*/
 #include "FEFluidTangentDiagnostic.h"
 #include "FEFluidFSITangentDiagnostic.h"
 #include "FEContactDiagnosticBiphasic.h"
+#include "FESpMVDiagnostic.h"
+#include "FEContactParallelDiagnostic.h"
 #include "FECore/log.h"
 #include "FEBioXML/FEBioControlSection.h"
 #include "FEBioXML/FEBioMaterialSection.h"
@@ -115,6 +117,8 @@ FEDiagnostic* FEDiagnosticImport::LoadFile(FEModel& fem, const char* szfile)
         else if (att == "multiphasic tangent test") { fecore.SetActiveModule("multiphasic"); m_pdia = new FEMultiphasicTangentDiagnostic(fem); }
         else if (att == "fluid tangent test"      ) { fecore.SetActiveModule("fluid"      ); m_pdia = new FEFluidTangentDiagnostic      (fem); }
         else if (att == "fluid-FSI tangent test"  ) { fecore.SetActiveModule("fluid-FSI"  ); m_pdia = new FEFluidFSITangentDiagnostic   (fem); }
+        else if (att == "spmv benchmark"          ) { fecore.SetActiveModule("solid"      ); m_pdia = new FESpMVDiagnostic              (fem); }
+        else if (att == "contact parallel test"   ) { fecore.SetActiveModule("multiphasic"); m_pdia = new FEContactParallelDiagnostic   (fem); }
 		else
 		{
 			feLog("\nERROR: unknown diagnostic\n\n");
@@ -126,7 +130,16 @@ FEDiagnostic* FEDiagnosticImport::LoadFile(FEModel& fem, const char* szfile)
 		fem.SetCurrentStepIndex(0);
         
 		// parse the file
-		if (ParseFile(tag) == false) return nullptr;
+		// tags that are not one of the standard sections are passed on to the diagnostic
+		++tag;
+		while (!tag.isend())
+		{
+			FEFileSectionMap::iterator is = m_map.find(tag.Name());
+			if (is != m_map.end()) is->second->Parse(tag);
+			else if (m_pdia->ParseSection(tag) == false) throw XMLReader::InvalidTag(tag);
+
+			++tag;
+		}
 	}
 	catch (XMLReader::Error& e)
 	{
@@ -0,0 +1,184 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FESpMVDiagnostic.h"
+#include <FECore/FENewtonSolver.h>
+#include <FECore/FEGlobalMatrix.h>
+#include <FECore/Timer.h>
+#include <FECore/log.h>
+#include <NumCore/CompactSymmMatrix.h>
+#include <NumCore/CompactUnSymmMatrix.h>
+#include <NumCore/MatrixTools.h>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+// The values that are used to fill the matrices. This defines a symmetric matrix
+// so that all formats represent the same matrix.
+static double spmv_value(int i, int j)
+{
+	if (i > j) { int t = i; i = j; j = t; }
+	return (i == j ? 10.0 : 1.0 / (1.0 + (j - i) % 17) + 1e-3*(i % 7));
+}
+
+//-----------------------------------------------------------------------------
+// fill a compact matrix with the values from spmv_value
+static void spmv_fill(CompactMatrix& A)
+{
+	int N = (A.isRowBased() ? A.Rows() : A.Columns());
+	int* pp = A.Pointers();
+	int* pi = A.Indices();
+	double* pv = A.Values();
+	int offset = A.Offset();
+	for (int k = 0; k < N; ++k)
+	{
+		for (int n = pp[k] - offset; n < pp[k + 1] - offset; ++n)
+		{
+			pv[n] = spmv_value(k, pi[n] - offset);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+FESpMVDiagnostic::FESpMVDiagnostic(FEModel& fem) : FEDiagnostic(fem)
+{
+	m_nrepeat = 100;
+}
+
+//-----------------------------------------------------------------------------
+FESpMVDiagnostic::~FESpMVDiagnostic()
+{
+}
+
+//-----------------------------------------------------------------------------
+bool FESpMVDiagnostic::ParseSection(XMLTag& tag)
+{
+	if (tag == "input")
+	{
+		// get the input file name
+		const char* szfile = tag.szvalue();
+
+		// try to read the file
+		FEBioImport im;
+		FEModel& fem = *GetFEModel();
+		if (im.Load(fem, szfile) == false)
+		{
+			char szerr[256];
+			im.GetErrorMessage(szerr);
+			fprintf(stderr, "%s", szerr);
+
+			return false;
+		}
+
+		return true;
+	}
+	else if (tag == "repeat")
+	{
+		tag.value(m_nrepeat);
+		return true;
+	}
+
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool FESpMVDiagnostic::Run()
+{
+	// get and initialize the first step
+	FEModel& fem = *GetFEModel();
+	FEAnalysis* pstep = fem.GetStep(0);
+	pstep->Init();
+	pstep->Activate();
+
+	// get and initialize the solver
+	FENewtonSolver* solver = dynamic_cast<FENewtonSolver*>(pstep->GetFESolver());
+	if ((solver == nullptr) || (pstep->InitSolver() == false)) return false;
+
+	// build the matrix profile
+	fem.Update();
+	if (!solver->CreateStiffness(true)) return false;
+	SparseMatrixProfile* MP = solver->GetStiffnessMatrix()->GetSparseMatrixProfile();
+	if (MP == nullptr) return false;
+
+	// the formats we'll test
+	const int NFORMATS = 5;
+	CompactMatrix* formats[NFORMATS] = {
+		new CRSSparseMatrix(0),
+		new CRSSparseMatrix(1),
+		new CCSSparseMatrix(0),
+		new CompactSymmMatrix(0),
+		new CompactSymmMatrix(1)
+	};
+	const char* szformat[NFORMATS] = { "CRS (offset 0)", "CRS (offset 1)", "CCS (offset 0)", "symmetric (offset 0)", "symmetric (offset 1)" };
+
+	// random input vector
+	int neq = MP->Rows();
+	vector<double> x(neq), r(neq), r0(neq);
+	NumCore::randomVector(x, -1.0, 1.0);
+
+	feLog("\nSparse matrix-vector product benchmark\n");
+	feLog("\tNumber of equations ........................ : %d\n", neq);
+	feLog("\tNumber of products per format .............. : %d\n\n", m_nrepeat);
+	feLog("\t%-24s%14s%12s%12s%14s\n", "format", "nonzeros", "time (s)", "GFLOP/s", "max. diff");
+
+	bool bok = true;
+	for (int n = 0; n < NFORMATS; ++n)
+	{
+		CompactMatrix& A = *formats[n];
+		A.Create(*MP);
+		spmv_fill(A);
+
+		// number of nonzeros of the full matrix
+		double nnz = (A.isSymmetric() ? 2.0*A.NonZeroes() - neq : (double)A.NonZeroes());
+
+		// the first product is not timed since it may setup some data
+		if (A.mult_vector(&x[0], &r[0]) == false)
+		{
+			feLog("\t%-24s%14s\n", szformat[n], "not supported");
+			continue;
+		}
+
+		Timer timer;
+		timer.start();
+		for (int i = 0; i < m_nrepeat; ++i) A.mult_vector(&x[0], &r[0]);
+		timer.stop();
+		double sec = timer.GetTime();
+		double gflops = (sec > 0.0 ? 2.0*nnz*m_nrepeat / sec * 1e-9 : 0.0);
+
+		// compare to the result of the first format
+		if (n == 0) r0 = r;
+		double diff = 0.0;
+		for (int i = 0; i < neq; ++i) diff = fmax(diff, fabs(r[i] - r0[i]));
+		if (diff > 1e-10*(1.0 + NumCore::infNorm(r0))) bok = false;
+
+		feLog("\t%-24s%14.0lf%12.4lg%12.4lg%14.4lg\n", szformat[n], nnz, sec, gflops, diff);
+	}
+
+	for (int n = 0; n < NFORMATS; ++n) delete formats[n];
+
+	return bok;
+}
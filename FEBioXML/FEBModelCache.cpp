@@ -0,0 +1,786 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEBModelCache.h"
+#include <FECore/version.h>
+#include <stdio.h>
+#include <string.h>
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// Increment this when the layout of the cache file changes
+#define FEB_CACHE_VERSION	2
+
+//-----------------------------------------------------------------------------
+// The header of the cache file. The sizes of the data structures are stored 
+// so that a cache that was created by an incompatible build is rejected.
+struct FEB_CACHE_HEADER
+{
+	char		magic[4];
+	int			nversion;
+	int			nsdk;
+	int			nodeSize;
+	int			elemSize;
+	int			faceSize;
+	int			specSize;
+	uint64_t	key;
+	double		parseTime;
+};
+
+//-----------------------------------------------------------------------------
+// helper class for writing the cache, either to a file or to a memory buffer
+class CacheWriter
+{
+public:
+	CacheWriter(FILE* fp) : m_fp(fp), m_buf(nullptr), m_ok(true) {}
+	CacheWriter(std::vector<char>& buf) : m_fp(nullptr), m_buf(&buf), m_ok(true) {}
+
+	void write(const void* pd, size_t size, size_t count = 1)
+	{
+		if ((m_ok == false) || (count == 0)) return;
+		if (m_fp) m_ok = (fwrite(pd, size, count, m_fp) == count);
+		else
+		{
+			const char* c = (const char*)pd;
+			m_buf->insert(m_buf->end(), c, c + size*count);
+		}
+	}
+
+	void write(int n) { write(&n, sizeof(int)); }
+
+	void write(const std::string& s)
+	{
+		write((int)s.size());
+		write(s.c_str(), 1, s.size());
+	}
+
+	template <typename T> void write(const std::vector<T>& v)
+	{
+		write((int)v.size());
+		if (v.empty() == false) write(&v[0], sizeof(T), v.size());
+	}
+
+	bool ok() const { return m_ok; }
+
+private:
+	FILE*				m_fp;
+	std::vector<char>*	m_buf;
+	bool				m_ok;
+};
+
+//-----------------------------------------------------------------------------
+// helper class for reading the cache from memory
+class CacheReader
+{
+public:
+	CacheReader(const char* pd, size_t size) : m_pd(pd), m_size(size), m_pos(0), m_ok(true) {}
+
+	void read(void* pd, size_t size, size_t count = 1)
+	{
+		if ((m_ok == false) || (count == 0)) return;
+		size_t n = size*count;
+		if (m_size - m_pos < n) { m_ok = false; return; }
+		memcpy(pd, m_pd + m_pos, n);
+		m_pos += n;
+	}
+
+	int read_int() { int n = 0; read(&n, sizeof(int)); return (m_ok && (n >= 0) ? n : 0); }
+
+	std::string read_string()
+	{
+		int n = read_int();
+		std::string s(n, ' ');
+		if (n > 0) read(&s[0], 1, n);
+		return s;
+	}
+
+	template <typename T> void read(std::vector<T>& v)
+	{
+		int n = read_int();
+
+		// don't trust the size if it is larger than what is left
+		if ((size_t)n*sizeof(T) > m_size - m_pos) { m_ok = false; n = 0; }
+		v.resize(n);
+		if (n > 0) read(&v[0], sizeof(T), n);
+	}
+
+	bool ok() const { return m_ok; }
+
+private:
+	const char*	m_pd;
+	size_t		m_size;
+	size_t		m_pos;
+	bool		m_ok;
+};
+
+//-----------------------------------------------------------------------------
+// helper class that maps a file into memory. On systems that don't support
+// mmap, the file is read into a buffer instead.
+class CacheFileMap
+{
+public:
+	CacheFileMap() : m_pd(nullptr), m_size(0), m_bmmap(false) {}
+	~CacheFileMap() { Unmap(); }
+
+	bool Map(const char* szfile)
+	{
+		Unmap();
+#ifndef WIN32
+		int fd = open(szfile, O_RDONLY);
+		if (fd < 0) return false;
+
+		struct stat st;
+		if ((fstat(fd, &st) != 0) || (st.st_size <= 0)) { close(fd); return false; }
+
+		void* pd = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (pd == MAP_FAILED) return false;
+
+		m_pd = (char*)pd;
+		m_size = (size_t)st.st_size;
+		m_bmmap = true;
+#else
+		FILE* fp = fopen(szfile, "rb");
+		if (fp == nullptr) return false;
+		_fseeki64(fp, 0, SEEK_END);
+		int64_t size = _ftelli64(fp);
+		_fseeki64(fp, 0, SEEK_SET);
+		if (size <= 0) { fclose(fp); return false; }
+
+		m_pd = new char[size];
+		if (fread(m_pd, 1, (size_t)size, fp) != (size_t)size)
+		{
+			delete [] m_pd; m_pd = nullptr;
+			fclose(fp);
+			return false;
+		}
+		fclose(fp);
+		m_size = (size_t)size;
+		m_bmmap = false;
+#endif
+		return true;
+	}
+
+	void Unmap()
+	{
+		if (m_pd)
+		{
+#ifndef WIN32
+			if (m_bmmap) munmap(m_pd, m_size);
+			else delete [] m_pd;
+#else
+			delete [] m_pd;
+#endif
+		}
+		m_pd = nullptr;
+		m_size = 0;
+		m_bmmap = false;
+	}
+
+	const char* data() const { return m_pd; }
+	size_t size() const { return m_size; }
+
+private:
+	char*	m_pd;
+	size_t	m_size;
+	bool	m_bmmap;
+};
+
+//-----------------------------------------------------------------------------
+// FNV-1a hash
+static uint64_t hash_bytes(uint64_t h, const char* pd, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		h ^= (unsigned char) pd[i];
+		h *= 1099511628211ULL;
+	}
+	return h;
+}
+
+//-----------------------------------------------------------------------------
+FEBModelCache::FEBModelCache()
+{
+	m_key = 0;
+	m_parseTime = 0.0;
+	m_nused = 0;
+	m_bmodified = false;
+}
+
+//-----------------------------------------------------------------------------
+FEBModelCache::~FEBModelCache()
+{
+	Clear();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBModelCache::IsMeshSection(const char* szsection)
+{
+	return ((strcmp(szsection, "Mesh"    ) == 0) ||
+			(strcmp(szsection, "Geometry") == 0) ||
+			(strcmp(szsection, "MeshData") == 0));
+}
+
+//-----------------------------------------------------------------------------
+// The cache key is the FNV-1a hash of the febio_spec version and the contents of 
+// the mesh sections. Changes to any of the other sections (e.g. materials, loads, 
+// or control parameters) therefore don't invalidate the cache.
+bool FEBModelCache::SetInputFile(const char* szfile)
+{
+	m_cacheFile = std::string(szfile) + ".cache";
+	m_key = 0;
+	Clear();
+
+	// find the mesh sections
+	struct RANGE
+	{
+		std::string	name;
+		int64_t		pos0, pos1;
+	};
+	std::vector<RANGE> sections;
+	std::string version;
+
+	XMLReader xml;
+	if (xml.Open(szfile) == false) return false;
+	try
+	{
+		XMLTag tag;
+		if (xml.FindTag("febio_spec", tag) == false) return false;
+
+		const char* szversion = tag.AttributeValue("version", true);
+		if (szversion) version = szversion;
+
+		++tag;
+		do
+		{
+			// Included sections (i.e. with the "from" attribute) are leaves and are not cached.
+			if (IsMeshSection(tag.Name()) && (tag.isleaf() == false))
+			{
+				RANGE r;
+				r.name = tag.Name();
+				r.pos0 = tag.m_fpos;
+
+				++tag;
+				while (!tag.isend()) xml.SkipTag(tag);
+
+				r.pos1 = tag.m_fpos;
+				sections.push_back(r);
+				++tag;
+			}
+			else xml.SkipTag(tag);
+		}
+		while (!tag.isend());
+	}
+	catch (...)
+	{
+		return false;
+	}
+	xml.Close();
+
+	// hash the mesh sections
+	uint64_t h = 14695981039346656037ULL;
+	h = hash_bytes(h, version.c_str(), version.size() + 1);
+	if (sections.empty() == false)
+	{
+		CacheFileMap file;
+		if (file.Map(szfile) == false) return false;
+
+		for (size_t i = 0; i < sections.size(); ++i)
+		{
+			RANGE& r = sections[i];
+			if ((r.pos0 < 0) || (r.pos1 < r.pos0) || (r.pos1 > (int64_t)file.size())) return false;
+
+			h = hash_bytes(h, r.name.c_str(), r.name.size() + 1);
+			h = hash_bytes(h, file.data() + r.pos0, (size_t)(r.pos1 - r.pos0));
+		}
+	}
+
+	m_key = h;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEBModelCache::Clear()
+{
+	for (size_t i = 0; i < m_blocks.size(); ++i) delete m_blocks[i];
+	m_blocks.clear();
+	m_blockMap.clear();
+	std::vector<char>().swap(m_parts);
+	m_nused = 0;
+	m_bmodified = false;
+}
+
+//-----------------------------------------------------------------------------
+// The cache is written to a temporary file first, which then replaces the cache file.
+// This way, a run that reads the cache never sees a partially written cache.
+bool FEBModelCache::Write(double parseTime)
+{
+	if (m_cacheFile.empty()) return false;
+
+	// the temporary file name includes the process ID, since several 
+	// processes may be writing the cache of the same file.
+	char szpid[32] = { 0 };
+#ifndef WIN32
+	sprintf(szpid, ".%d.tmp", (int)getpid());
+#else
+	sprintf(szpid, ".%d.tmp", (int)_getpid());
+#endif
+	std::string tmpFile = m_cacheFile + szpid;
+
+	FILE* fp = fopen(tmpFile.c_str(), "wb");
+	if (fp == nullptr) return false;
+
+	CacheWriter ar(fp);
+
+	// write the header
+	FEB_CACHE_HEADER hdr;
+	memcpy(hdr.magic, "FEBC", 4);
+	hdr.nversion = FEB_CACHE_VERSION;
+	hdr.nsdk = FE_SDK_VERSION;
+	hdr.nodeSize = sizeof(FEBModel::NODE);
+	hdr.elemSize = sizeof(FEBModel::ELEMENT);
+	hdr.faceSize = sizeof(FEBModel::FACET);
+	hdr.specSize = sizeof(FE_Element_Spec);
+	hdr.key = m_key;
+	hdr.parseTime = parseTime;
+	ar.write(&hdr, sizeof(hdr));
+
+	// write the parts
+	ar.write(m_parts);
+
+	// write the blocks that were used
+	int nblocks = 0;
+	for (size_t i = 0; i < m_blocks.size(); ++i) if (m_blocks[i]->bused) nblocks++;
+	ar.write(nblocks);
+	for (size_t i = 0; i < m_blocks.size(); ++i)
+	{
+		BLOCK& b = *m_blocks[i];
+		if (b.bused == false) continue;
+
+		ar.write(b.section);
+		ar.write(&b.offset, sizeof(int64_t));
+		ar.write(b.child);
+		ar.write(b.att);
+		ar.write(b.ntype);
+		ar.write(b.nmax);
+		ar.write(&b.nbytes, sizeof(int64_t));
+		ar.write(b.nlines);
+		ar.write(b.id);
+		ar.write(b.count);
+		if (b.ntype == 0) ar.write(b.ival);
+		else ar.write(b.dval);
+	}
+
+	bool bok = ar.ok();
+	if (fclose(fp) != 0) bok = false;
+
+	// don't leave a corrupt file behind
+	if (bok == false)
+	{
+		remove(tmpFile.c_str());
+		return false;
+	}
+
+	// replace the cache file
+#ifdef WIN32
+	remove(m_cacheFile.c_str());
+#endif
+	if (rename(tmpFile.c_str(), m_cacheFile.c_str()) != 0)
+	{
+		remove(tmpFile.c_str());
+		return false;
+	}
+
+	m_parseTime = parseTime;
+	m_bmodified = false;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// The cache file is mapped into memory and the parts and blocks are copied from it.
+// The parts are only converted to an FEBModel when they are needed (see GetParts).
+bool FEBModelCache::Read()
+{
+	Clear();
+	if (m_cacheFile.empty()) return false;
+
+	CacheFileMap file;
+	if (file.Map(m_cacheFile.c_str()) == false) return false;
+
+	CacheReader ar(file.data(), file.size());
+
+	// read and check the header
+	FEB_CACHE_HEADER hdr;
+	ar.read(&hdr, sizeof(hdr));
+	if ((ar.ok() == false) ||
+		(strncmp(hdr.magic, "FEBC", 4) != 0) ||
+		(hdr.nversion != FEB_CACHE_VERSION) ||
+		(hdr.nsdk != FE_SDK_VERSION) ||
+		(hdr.nodeSize != sizeof(FEBModel::NODE)) ||
+		(hdr.elemSize != sizeof(FEBModel::ELEMENT)) ||
+		(hdr.faceSize != sizeof(FEBModel::FACET)) ||
+		(hdr.specSize != sizeof(FE_Element_Spec)) ||
+		(hdr.key != m_key))
+	{
+		return false;
+	}
+
+	// read the parts
+	ar.read(m_parts);
+
+	// read the blocks
+	bool bok = true;
+	int nblocks = ar.read_int();
+	for (int i = 0; (i < nblocks) && ar.ok() && bok; ++i)
+	{
+		std::string section = ar.read_string();
+		int64_t offset = 0;
+		ar.read(&offset, sizeof(int64_t));
+		std::string child = ar.read_string();
+		std::string att = ar.read_string();
+		int ntype = ar.read_int();
+		int nmax = ar.read_int();
+
+		BLOCK* b = AddBlock(section, offset, child.c_str(), att.c_str(), ntype, nmax);
+		b->bused = false;
+		ar.read(&b->nbytes, sizeof(int64_t));
+		b->nlines = ar.read_int();
+		ar.read(b->id);
+		ar.read(b->count);
+		if (ntype == 0) ar.read(b->ival);
+		else ar.read(b->dval);
+
+		// make sure the block is consistent
+		size_t N = b->id.size();
+		size_t nval = (ntype == 0 ? b->ival.size() : b->dval.size());
+		if ((b->count.size() != N) || (nval != N*nmax)) bok = false;
+	}
+
+	if ((ar.ok() == false) || (bok == false))
+	{
+		Clear();
+		return false;
+	}
+
+	m_parseTime = hdr.parseTime;
+	m_bmodified = false;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEBModelCache::SetParts(FEBModel& feb)
+{
+	m_parts.clear();
+	CacheWriter ar(m_parts);
+
+	int nparts = (int)feb.Parts();
+	ar.write(nparts);
+	for (int i = 0; i < nparts; ++i)
+	{
+		FEBModel::Part& part = *feb.GetPart(i);
+		ar.write(part.Name());
+
+		// nodes
+		int nodes = part.Nodes();
+		ar.write(nodes);
+		if (nodes > 0) ar.write(&part.GetNode(0), sizeof(FEBModel::NODE), nodes);
+
+		// domains
+		ar.write(part.Domains());
+		for (int j = 0; j < part.Domains(); ++j)
+		{
+			const FEBModel::Domain& dom = part.GetDomain(j);
+			FE_Element_Spec spec = dom.ElementSpec();
+			ar.write(&spec, sizeof(FE_Element_Spec));
+			ar.write(dom.Name());
+			ar.write(dom.MaterialName());
+			ar.write(&dom.m_defaultShellThickness, sizeof(double));
+			ar.write(dom.ElementList());
+		}
+
+		// surfaces
+		ar.write(part.Surfaces());
+		for (int j = 0; j < part.Surfaces(); ++j)
+		{
+			FEBModel::Surface& surf = *part.GetSurface(j);
+			ar.write(surf.Name());
+			ar.write(surf.FacetList());
+		}
+
+		// node sets
+		ar.write(part.NodeSets());
+		for (int j = 0; j < part.NodeSets(); ++j)
+		{
+			FEBModel::NodeSet& set = *part.GetNodeSet(j);
+			ar.write(set.Name());
+			ar.write(set.NodeList());
+		}
+
+		// element sets
+		ar.write(part.ElementSets());
+		for (int j = 0; j < part.ElementSets(); ++j)
+		{
+			FEBModel::ElementSet& set = *part.GetElementSet(j);
+			ar.write(set.Name());
+			ar.write(set.ElementList());
+		}
+
+		// surface pairs
+		ar.write(part.SurfacePairs());
+		for (int j = 0; j < part.SurfacePairs(); ++j)
+		{
+			FEBModel::SurfacePair& sp = *part.GetSurfacePair(j);
+			ar.write(sp.m_name);
+			ar.write(sp.m_primary);
+			ar.write(sp.m_secondary);
+		}
+
+		// discrete sets
+		ar.write(part.DiscreteSets());
+		for (int j = 0; j < part.DiscreteSets(); ++j)
+		{
+			FEBModel::DiscreteSet& set = *part.GetDiscreteSet(j);
+			ar.write(set.Name());
+			ar.write(set.ElementList());
+		}
+	}
+
+	m_bmodified = true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBModelCache::GetParts(FEBModel& feb)
+{
+	if (m_parts.empty()) return false;
+
+	CacheReader ar(&m_parts[0], m_parts.size());
+
+	// read the parts
+	// (The parts are only added to the model when all parts were read successfully.)
+	std::vector<FEBModel::Part*> partList;
+	int nparts = ar.read_int();
+	for (int i = 0; (i < nparts) && ar.ok(); ++i)
+	{
+		FEBModel::Part* part = new FEBModel::Part(ar.read_string());
+		partList.push_back(part);
+
+		// nodes
+		std::vector<FEBModel::NODE> nodes;
+		ar.read(nodes);
+		part->AddNodes(nodes);
+
+		// domains
+		int ndom = ar.read_int();
+		for (int j = 0; (j < ndom) && ar.ok(); ++j)
+		{
+			FE_Element_Spec spec;
+			ar.read(&spec, sizeof(FE_Element_Spec));
+
+			FEBModel::Domain* dom = new FEBModel::Domain(spec);
+			part->AddDomain(dom);
+			dom->SetName(ar.read_string());
+			dom->SetMaterialName(ar.read_string());
+			ar.read(&dom->m_defaultShellThickness, sizeof(double));
+
+			std::vector<FEBModel::ELEMENT> elemList;
+			ar.read(elemList);
+			dom->SetElementList(elemList);
+		}
+
+		// surfaces
+		int nsurf = ar.read_int();
+		for (int j = 0; (j < nsurf) && ar.ok(); ++j)
+		{
+			FEBModel::Surface* surf = new FEBModel::Surface(ar.read_string());
+			part->AddSurface(surf);
+
+			std::vector<FEBModel::FACET> faceList;
+			ar.read(faceList);
+			surf->SetFacetList(faceList);
+		}
+
+		// node sets
+		int nset = ar.read_int();
+		for (int j = 0; (j < nset) && ar.ok(); ++j)
+		{
+			FEBModel::NodeSet* set = new FEBModel::NodeSet(ar.read_string());
+			part->AddNodeSet(set);
+
+			std::vector<int> nodeList;
+			ar.read(nodeList);
+			set->SetNodeList(nodeList);
+		}
+
+		// element sets
+		int eset = ar.read_int();
+		for (int j = 0; (j < eset) && ar.ok(); ++j)
+		{
+			FEBModel::ElementSet* set = new FEBModel::ElementSet(ar.read_string());
+			part->AddElementSet(set);
+
+			std::vector<int> elemList;
+			ar.read(elemList);
+			set->SetElementList(elemList);
+		}
+
+		// surface pairs
+		int nsp = ar.read_int();
+		for (int j = 0; (j < nsp) && ar.ok(); ++j)
+		{
+			FEBModel::SurfacePair* sp = new FEBModel::SurfacePair;
+			part->AddSurfacePair(sp);
+			sp->m_name = ar.read_string();
+			sp->m_primary = ar.read_string();
+			sp->m_secondary = ar.read_string();
+		}
+
+		// discrete sets
+		int nds = ar.read_int();
+		for (int j = 0; (j < nds) && ar.ok(); ++j)
+		{
+			FEBModel::DiscreteSet* set = new FEBModel::DiscreteSet;
+			part->AddDiscreteSet(set);
+			set->SetName(ar.read_string());
+
+			std::vector<FEBModel::DiscreteSet::ELEM> elemList;
+			ar.read(elemList);
+			for (size_t k = 0; k < elemList.size(); ++k) set->AddElement(elemList[k].node[0], elemList[k].node[1]);
+		}
+	}
+
+	if (ar.ok() == false)
+	{
+		for (size_t i = 0; i < partList.size(); ++i) delete partList[i];
+		return false;
+	}
+
+	for (size_t i = 0; i < partList.size(); ++i) feb.AddPart(partList[i]);
+	m_nused++;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+FEBModelCache::BLOCK* FEBModelCache::FindBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, int ntype, int nmax)
+{
+	std::map<std::pair<std::string, int64_t>, BLOCK*>::iterator it = m_blockMap.find(std::make_pair(section, offset));
+	if (it == m_blockMap.end()) return nullptr;
+
+	BLOCK* b = it->second;
+	if ((b->child != szchild) || (b->att != szatt) || (b->ntype != ntype) || (b->nmax != nmax)) return nullptr;
+
+	return b;
+}
+
+//-----------------------------------------------------------------------------
+FEBModelCache::BLOCK* FEBModelCache::AddBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, int ntype, int nmax)
+{
+	// replace the block if it already exists
+	BLOCK*& b = m_blockMap[std::make_pair(section, offset)];
+	if (b == nullptr)
+	{
+		b = new BLOCK;
+		m_blocks.push_back(b);
+	}
+
+	b->section = section;
+	b->offset = offset;
+	b->child = szchild;
+	b->att = szatt;
+	b->ntype = ntype;
+	b->nmax = nmax;
+	b->nbytes = 0;
+	b->nlines = 0;
+	b->bused = true;
+	return b;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBModelCache::GetBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, XMLBlock<double>& block)
+{
+	BLOCK* b = FindBlock(section, offset, szchild, szatt, 1, block.nmax);
+	if (b == nullptr) return false;
+
+	block.id = b->id;
+	block.count = b->count;
+	block.val = b->dval;
+	block.nbytes = b->nbytes;
+	block.nlines = b->nlines;
+	b->bused = true;
+	m_nused++;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool FEBModelCache::GetBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, XMLBlock<int>& block)
+{
+	BLOCK* b = FindBlock(section, offset, szchild, szatt, 0, block.nmax);
+	if (b == nullptr) return false;
+
+	block.id = b->id;
+	block.count = b->count;
+	block.val = b->ival;
+	block.nbytes = b->nbytes;
+	block.nlines = b->nlines;
+	b->bused = true;
+	m_nused++;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEBModelCache::SetBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, const XMLBlock<double>& block)
+{
+	BLOCK* b = AddBlock(section, offset, szchild, szatt, 1, block.nmax);
+	b->id = block.id;
+	b->count = block.count;
+	b->dval = block.val;
+	b->nbytes = block.nbytes;
+	b->nlines = block.nlines;
+	m_bmodified = true;
+}
+
+//-----------------------------------------------------------------------------
+void FEBModelCache::SetBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, const XMLBlock<int>& block)
+{
+	BLOCK* b = AddBlock(section, offset, szchild, szatt, 0, block.nmax);
+	b->id = block.id;
+	b->count = block.count;
+	b->ival = block.val;
+	b->nbytes = block.nbytes;
+	b->nlines = block.nlines;
+	m_bmodified = true;
+}
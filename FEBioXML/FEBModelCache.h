@@ -0,0 +1,135 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "FEBModel.h"
+#include "XMLReader.h"
+#include "febioxml_api.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+//-----------------------------------------------------------------------------
+// This class manages a binary cache of the mesh sections of an FEBio input file
+// (Mesh, Geometry and MeshData). The cache stores two kinds of data:
+// - the parts of the FEBModel (nodes, domains, surfaces, and sets) as they are 
+//   read from the Mesh section, so that the Mesh section does not need to be parsed again.
+// - the blocks of nodes, elements and data values that are read with XMLReader::ReadBlock
+//   in the other mesh sections (e.g. the Geometry section of 2.5 files). A block is 
+//   identified by its section and its position in that section.
+// The cache is stored next to the input file and is only used when its key matches the 
+// hash of the mesh sections of the input file and the FEBio version.
+class FEBIOXML_API FEBModelCache
+{
+public:
+	// cache modes
+	enum Mode {
+		IGNORE_CACHE,	// don't use the cache
+		USE_CACHE,		// use the cache if valid, otherwise create it
+		CREATE_CACHE	// always (re)create the cache
+	};
+
+public:
+	FEBModelCache();
+	~FEBModelCache();
+
+	//! set the input file. This calculates the cache key from the mesh sections.
+	bool SetInputFile(const char* szfile);
+
+	//! see if this section of the input file is stored in the cache
+	static bool IsMeshSection(const char* szsection);
+
+	//! name of the cache file
+	const std::string& CacheFile() const { return m_cacheFile; }
+
+	//! try to read the cache. Returns false if the cache does not exist or is out of date
+	bool Read();
+
+	//! write the cache. Only the data that was used since the last call to Read is written.
+	bool Write(double parseTime);
+
+	//! release all cached data
+	void Clear();
+
+	//! copy the cached parts to the model. Returns false if no parts were cached.
+	bool GetParts(FEBModel& feb);
+
+	//! store the parts of the model in the cache
+	void SetParts(FEBModel& feb);
+
+	//! find a block in the cache
+	bool GetBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, XMLBlock<double>& block);
+	bool GetBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, XMLBlock<int>& block);
+
+	//! store a block in the cache
+	void SetBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, const XMLBlock<double>& block);
+	void SetBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, const XMLBlock<int>& block);
+
+	//! was any data taken from the cache
+	bool IsUsed() const { return (m_nused > 0); }
+
+	//! was any data added to the cache (i.e. does the cache need to be written)
+	bool IsModified() const { return m_bmodified; }
+
+	//! the time it took to parse the original mesh sections (as stored in the cache)
+	double ParseTime() const { return m_parseTime; }
+
+private:
+	// a block of tags (see XMLBlock)
+	struct BLOCK
+	{
+		std::string		section;	// section name
+		int64_t			offset;		// position in section
+		std::string		child;		// name of child tags
+		std::string		att;		// name of ID attribute
+		int				ntype;		// 0 = int, 1 = double
+		int				nmax;		// max nr of values per tag
+		int64_t			nbytes;		// size of the block in the input file
+		int				nlines;		// nr of lines in the input file
+		std::vector<int>	id;
+		std::vector<int>	count;
+		std::vector<int>	ival;
+		std::vector<double>	dval;
+		bool			bused;		// was this block used
+	};
+
+	BLOCK* FindBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, int ntype, int nmax);
+	BLOCK* AddBlock(const std::string& section, int64_t offset, const char* szchild, const char* szatt, int ntype, int nmax);
+
+private:
+	std::string	m_cacheFile;
+	uint64_t	m_key;
+	double		m_parseTime;
+
+	std::vector<char>	m_parts;	// the parts in binary form
+	std::vector<BLOCK*>	m_blocks;	// the blocks
+	std::map<std::pair<std::string, int64_t>, BLOCK*>	m_blockMap;	// lookup table for blocks
+
+	int		m_nused;		// nr of parts and blocks taken from the cache
+	bool	m_bmodified;	// was data added to the cache
+};
@@ -56,5 +56,18 @@ void FEBioControlSection3::Parse(XMLTag& tag)
 	}
 
 	// read the step parameters
-	ReadParameterList(tag, pstep);
+	// Model parameters (e.g. cache_reference_geometry) can be defined here as well.
+	FEParameterList& modelParams = GetFEModel()->GetParameterList();
+	ReadAttributes(tag, pstep);
+	if (tag.isleaf()) return;
+	++tag;
+	do
+	{
+		if (ReadParameter(tag, pstep) == false)
+		{
+			if (ReadParameter(tag, modelParams) == false) throw XMLReader::InvalidTag(tag);
+		}
+		++tag;
+	}
+	while (!tag.isend());
 }
@@ -111,26 +111,49 @@ void FEBioGeometrySection1x::ParseNodeSection(XMLTag& tag)
 	mesh.AddNodes(nodes);
 
 	// read nodal coordinates
-	++tag;
-	for (int i = 0; i<nodes; ++i)
+	XMLBlock<double> block(3);
+	if (GetFEBioImport()->ReadBlock(tag, "node", "id", block))
+	{
+		assert(block.size() == nodes);
+		for (int i = 0; i<nodes; ++i)
+		{
+			FENode& node = mesh.Node(N0 + i);
+			const double* v = block.values(i);
+			node.m_r0 = vec3d(v[0], v[1], v[2]);
+			node.m_rt = node.m_r0;
+
+			// Make sure the ID is valid
+			int nid = block.id[i];
+			if (nid <= max_id) throw XMLReader::InvalidAttributeValue(tag, "id");
+
+			// set the ID
+			node.SetID(nid);
+			max_id = nid;
+		}
+	}
+	else
 	{
-		FENode& node = mesh.Node(N0 + i);
-		value(tag, node.m_r0);
-		node.m_rt = node.m_r0;
+		++tag;
+		for (int i = 0; i<nodes; ++i)
+		{
+			FENode& node = mesh.Node(N0 + i);
+			value(tag, node.m_r0);
+			node.m_rt = node.m_r0;
 
-		// get the nodal ID
-		int nid = -1;
-		tag.AttributeValue("id", nid);
+			// get the nodal ID
+			int nid = -1;
+			tag.AttributeValue("id", nid);
 
-		// Make sure it is valid
-		if (nid <= max_id) throw XMLReader::InvalidAttributeValue(tag, "id");
+			// Make sure it is valid
+			if (nid <= max_id) throw XMLReader::InvalidAttributeValue(tag, "id");
 
-		// set the ID
-		node.SetID(nid);
-		max_id = nid;
+			// set the ID
+			node.SetID(nid);
+			max_id = nid;
 
-		// go on to the next node
-		++tag;
+			// go on to the next node
+			++tag;
+		}
 	}
 
 	// If a node set is defined add these nodes to the node-set
@@ -547,26 +570,49 @@ void FEBioGeometrySection2::ParseNodeSection(XMLTag& tag)
 	mesh.AddNodes(nodes);
 
 	// read nodal coordinates
-	++tag;
-	for (int i = 0; i<nodes; ++i)
+	XMLBlock<double> block(3);
+	if (GetFEBioImport()->ReadBlock(tag, "node", "id", block))
 	{
-		FENode& node = mesh.Node(N0 + i);
-		value(tag, node.m_r0);
-		node.m_rt = node.m_r0;
+		assert(block.size() == nodes);
+		for (int i = 0; i<nodes; ++i)
+		{
+			FENode& node = mesh.Node(N0 + i);
+			const double* v = block.values(i);
+			node.m_r0 = vec3d(v[0], v[1], v[2]);
+			node.m_rt = node.m_r0;
+
+			// Make sure the ID is valid
+			int nid = block.id[i];
+			if (nid <= max_id) throw XMLReader::InvalidAttributeValue(tag, "id");
+
+			// set the ID
+			node.SetID(nid);
+			max_id = nid;
+		}
+	}
+	else
+	{
+		++tag;
+		for (int i = 0; i<nodes; ++i)
+		{
+			FENode& node = mesh.Node(N0 + i);
+			value(tag, node.m_r0);
+			node.m_rt = node.m_r0;
 
-		// get the nodal ID
-		int nid = -1;
-		tag.AttributeValue("id", nid);
+			// get the nodal ID
+			int nid = -1;
+			tag.AttributeValue("id", nid);
 
-		// Make sure it is valid
-		if (nid <= max_id) throw XMLReader::InvalidAttributeValue(tag, "id");
+			// Make sure it is valid
+			if (nid <= max_id) throw XMLReader::InvalidAttributeValue(tag, "id");
 
-		// set the ID
-		node.SetID(nid);
-		max_id = nid;
+			// set the ID
+			node.SetID(nid);
+			max_id = nid;
 
-		// go on to the next node
-		++tag;
+			// go on to the next node
+			++tag;
+		}
 	}
 
 	// If a node set is defined add these nodes to the node-set
@@ -1202,26 +1248,49 @@ void FEBioGeometrySection25::ParseNodeSection(XMLTag& tag)
 	mesh.AddNodes(nodes);
 
 	// read nodal coordinates
-	++tag;
-	for (int i = 0; i<nodes; ++i)
+	XMLBlock<double> block(3);
+	if (GetFEBioImport()->ReadBlock(tag, "node", "id", block))
+	{
+		assert(block.size() == nodes);
+		for (int i = 0; i<nodes; ++i)
+		{
+			FENode& node = mesh.Node(N0 + i);
+			const double* v = block.values(i);
+			node.m_r0 = vec3d(v[0], v[1], v[2]);
+			node.m_rt = node.m_r0;
+
+			// Make sure the ID is valid
+			int nid = block.id[i];
+			if (nid <= max_id) throw XMLReader::InvalidAttributeValue(tag, "id");
+
+			// set the ID
+			node.SetID(nid);
+			max_id = nid;
+		}
+	}
+	else
 	{
-		FENode& node = mesh.Node(N0 + i);
-		value(tag, node.m_r0);
-		node.m_rt = node.m_r0;
+		++tag;
+		for (int i = 0; i<nodes; ++i)
+		{
+			FENode& node = mesh.Node(N0 + i);
+			value(tag, node.m_r0);
+			node.m_rt = node.m_r0;
 
-		// get the nodal ID
-		int nid = -1;
-		tag.AttributeValue("id", nid);
+			// get the nodal ID
+			int nid = -1;
+			tag.AttributeValue("id", nid);
 
-		// Make sure it is valid
-		if (nid <= max_id) throw XMLReader::InvalidAttributeValue(tag, "id");
+			// Make sure it is valid
+			if (nid <= max_id) throw XMLReader::InvalidAttributeValue(tag, "id");
 
-		// set the ID
-		node.SetID(nid);
-		max_id = nid;
+			// set the ID
+			node.SetID(nid);
+			max_id = nid;
 
-		// go on to the next node
-		++tag;
+			// go on to the next node
+			++tag;
+		}
 	}
 
 	// If a node set is defined add these nodes to the node-set
@@ -1260,18 +1329,35 @@ void FEBioGeometrySection25::ParsePartNodeSection(XMLTag& tag, FEBModel::Part* p
 	vector<int> nodeList(nodes);
 
 	// read nodal coordinates
-	++tag;
-	for (int i = 0; i<nodes; ++i)
+	XMLBlock<double> block(3);
+	if (GetFEBioImport()->ReadBlock(tag, "node", "id", block))
+	{
+		assert(block.size() == nodes);
+		for (int i = 0; i<nodes; ++i)
+		{
+			if (block.count[i] != 3) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
+			const double* v = block.values(i);
+			FEBModel::NODE& nd = node[i];
+			nd.r = vec3d(v[0], v[1], v[2]);
+			nd.id = block.id[i];
+			nodeList[i] = nd.id;
+		}
+	}
+	else
 	{
-		FEBModel::NODE& nd = node[i];
-		value(tag, nd.r);
+		++tag;
+		for (int i = 0; i<nodes; ++i)
+		{
+			FEBModel::NODE& nd = node[i];
+			value(tag, nd.r);
 
-		// get the nodal ID
-		tag.AttributeValue("id", nd.id);
-		nodeList[i] = nd.id;
+			// get the nodal ID
+			tag.AttributeValue("id", nd.id);
+			nodeList[i] = nd.id;
 
-		// go on to the next node
-		++tag;
+			// go on to the next node
+			++tag;
+		}
 	}
 
 	// add nodes to the part
@@ -1334,21 +1420,38 @@ void FEBioGeometrySection25::ParseElementSection(XMLTag& tag)
 	}
 
 	// count elements
-	vector<FEModelBuilder::ELEMENT> elemList; elemList.reserve(512000);
-	++tag;
-	do
+	vector<FEModelBuilder::ELEMENT> elemList;
+	XMLBlock<int> block(FEElement::MAX_NODES);
+	if (GetFEBioImport()->ReadBlock(tag, "elem", "id", block))
 	{
-		if ((tag == "elem") == false) throw XMLReader::InvalidTag(tag);
+		elemList.resize(block.size());
+		for (int i = 0; i < block.size(); ++i)
+		{
+			FEModelBuilder::ELEMENT& el = elemList[i];
+			el.nid = block.id[i];
+			el.nodes = block.count[i];
+			const int* n = block.values(i);
+			for (int j = 0; j < el.nodes; ++j) el.node[j] = n[j];
+		}
+	}
+	else
+	{
+		elemList.reserve(512000);
+		++tag;
+		do
+		{
+			if ((tag == "elem") == false) throw XMLReader::InvalidTag(tag);
 
-		// get the element ID
-		FEModelBuilder::ELEMENT el;
-		tag.AttributeValue("id", el.nid);
+			// get the element ID
+			FEModelBuilder::ELEMENT el;
+			tag.AttributeValue("id", el.nid);
 
-		el.nodes = tag.value(el.node, FEElement::MAX_NODES);
-		elemList.push_back(el);
-		++tag;
+			el.nodes = tag.value(el.node, FEElement::MAX_NODES);
+			elemList.push_back(el);
+			++tag;
+		}
+		while (!tag.isend());
 	}
-	while (!tag.isend());
 
 	int elems = (int) elemList.size();
 	assert(elems);
@@ -1443,22 +1546,39 @@ void FEBioGeometrySection25::ParsePartElementSection(XMLTag& tag, FEBModel::Part
 	vector<int> elemList(elems);
 
 	// read element data
-	++tag;
-	for (int i = 0; i<elems; ++i)
+	XMLBlock<int> block(FEElement::MAX_NODES);
+	if (GetFEBioImport()->ReadBlock(tag, "elem", "id", block))
 	{
-		if ((tag == "elem") == false) throw XMLReader::InvalidTag(tag);
+		assert(block.size() == elems);
+		for (int i = 0; i<elems; ++i)
+		{
+			FEBModel::ELEMENT& el = dom->GetElement(i);
+			el.id = block.id[i];
+			elemList[i] = el.id;
+
+			const int* n = block.values(i);
+			for (int j = 0; j < block.count[i]; ++j) el.node[j] = n[j];
+		}
+	}
+	else
+	{
+		++tag;
+		for (int i = 0; i<elems; ++i)
+		{
+			if ((tag == "elem") == false) throw XMLReader::InvalidTag(tag);
 
-		FEBModel::ELEMENT& el = dom->GetElement(i);
+			FEBModel::ELEMENT& el = dom->GetElement(i);
 
-		// get the element ID
-		tag.AttributeValue("id", el.id);
-		elemList[i] = el.id;
+			// get the element ID
+			tag.AttributeValue("id", el.id);
+			elemList[i] = el.id;
 
-		// read the element data
-		tag.value(el.node, FEElement::MAX_NODES);
+			// read the element data
+			tag.value(el.node, FEElement::MAX_NODES);
 
-		// go to next tag
-		++tag;
+			// go to next tag
+			++tag;
+		}
 	}
 
 	// set the element list
@@ -352,18 +352,35 @@ void FEBioGeometrySection3::ParsePartNodeSection(XMLTag& tag, FEBModel::Part* pa
 	vector<int> nodeList(nodes);
 
 	// read nodal coordinates
-	++tag;
-	for (int i = 0; i<nodes; ++i)
+	XMLBlock<double> block(3);
+	if (GetFEBioImport()->ReadBlock(tag, "node", "id", block))
+	{
+		assert(block.size() == nodes);
+		for (int i = 0; i<nodes; ++i)
+		{
+			if (block.count[i] != 3) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
+			const double* v = block.values(i);
+			FEBModel::NODE& nd = node[i];
+			nd.r = vec3d(v[0], v[1], v[2]);
+			nd.id = block.id[i];
+			nodeList[i] = nd.id;
+		}
+	}
+	else
 	{
-		FEBModel::NODE& nd = node[i];
-		value(tag, nd.r);
+		++tag;
+		for (int i = 0; i<nodes; ++i)
+		{
+			FEBModel::NODE& nd = node[i];
+			value(tag, nd.r);
 
-		// get the nodal ID
-		tag.AttributeValue("id", nd.id);
-		nodeList[i] = nd.id;
+			// get the nodal ID
+			tag.AttributeValue("id", nd.id);
+			nodeList[i] = nd.id;
 
-		// go on to the next node
-		++tag;
+			// go on to the next node
+			++tag;
+		}
 	}
 
 	// add nodes to the part
@@ -514,20 +531,37 @@ void FEBioGeometrySection3::ParsePartElementSection(XMLTag& tag, FEBModel::Part*
 	vector<int> elemList(elems);
 
 	// read element data
-	++tag;
-	for (int i = 0; i<elems; ++i)
+	XMLBlock<int> block(FEElement::MAX_NODES);
+	if (GetFEBioImport()->ReadBlock(tag, "elem", "id", block))
 	{
-		FEBModel::ELEMENT& el = dom->GetElement(i);
+		assert(block.size() == elems);
+		for (int i = 0; i<elems; ++i)
+		{
+			FEBModel::ELEMENT& el = dom->GetElement(i);
+			el.id = block.id[i];
+			elemList[i] = el.id;
 
-		// get the element ID
-		tag.AttributeValue("id", el.id);
-		elemList[i] = el.id;
+			const int* n = block.values(i);
+			for (int j = 0; j < block.count[i]; ++j) el.node[j] = n[j];
+		}
+	}
+	else
+	{
+		++tag;
+		for (int i = 0; i<elems; ++i)
+		{
+			FEBModel::ELEMENT& el = dom->GetElement(i);
 
-		// read the element data
-		tag.value(el.node, FEElement::MAX_NODES);
+			// get the element ID
+			tag.AttributeValue("id", el.id);
+			elemList[i] = el.id;
 
-		// go to next tag
-		++tag;
+			// read the element data
+			tag.value(el.node, FEElement::MAX_NODES);
+
+			// go to next tag
+			++tag;
+		}
 	}
 
 	// set the element list
@@ -63,6 +63,7 @@ SOFTWARE.*/
 #include <string.h>
 #include <stdarg.h>
 #include "xmltool.h"
+#include <FECore/Timer.h>
 
 FEBioFileSection::FEBioFileSection(FEBioImport* feb) : FEFileSection(feb) {}
 
@@ -149,6 +150,12 @@ FEBioImport::MeshDataError::MeshDataError()
 //-----------------------------------------------------------------------------
 FEBioImport::FEBioImport()
 {
+	m_cacheMode = FEBModelCache::IGNORE_CACHE;
+	m_bmeshFromCache = false;
+	m_bcacheCreated = false;
+	m_meshTime = 0.0;
+	m_cacheSectionPos = 0;
+	m_cacheReader = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -265,8 +272,35 @@ bool FEBioImport::Load(FEModel& fem, const char* szfile)
 	// clean up
 	fem.GetMesh().ClearDataMaps();
 
+	// calculate the cache key
+	m_bmeshFromCache = false;
+	m_bcacheCreated = false;
+	m_meshTime = 0.0;
+	m_cacheSection.clear();
+	m_cacheReader = nullptr;
+	if (m_cacheMode != FEBModelCache::IGNORE_CACHE)
+	{
+		if (m_cache.SetInputFile(szfile) == false) m_cacheMode = FEBModelCache::IGNORE_CACHE;
+		else if (m_cacheMode == FEBModelCache::USE_CACHE) m_cache.Read();
+	}
+
 	// read the file
-	if (ReadFile(szfile) == false) return false;
+	if (ReadFile(szfile) == false) { m_cache.Clear(); return false; }
+
+	// update the cache if anything new was read from the mesh sections
+	if (m_cacheMode != FEBModelCache::IGNORE_CACHE)
+	{
+		m_bmeshFromCache = m_cache.IsUsed();
+		if (m_cache.IsModified())
+		{
+			// if part of the mesh was read from the cache, we keep the original parse time
+			double parseTime = (m_bmeshFromCache ? m_cache.ParseTime() : m_meshTime);
+			m_bcacheCreated = m_cache.Write(parseTime);
+		}
+
+		// we no longer need the cached data
+		m_cache.Clear();
+	}
 
 	// finish building
 	try {
@@ -399,6 +433,7 @@ bool FEBioImport::ReadFile(const char* szfile, bool broot)
 					// parse the section
 					is->second->Parse(tag2);
 				}
+				else if (broot && (m_cacheMode != FEBModelCache::IGNORE_CACHE) && FEBModelCache::IsMeshSection(tag.Name())) ParseMeshSection(tag, is->second);
 				else is->second->Parse(tag);
 			}
 			else
@@ -448,6 +483,87 @@ bool FEBioImport::ReadFile(const char* szfile, bool broot)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// Parse one of the mesh sections using the model cache (see FEBModelCache). 
+// If the cache is valid, the parts of the Mesh section are read from the cache and 
+// the Mesh section is skipped. In the other mesh sections, the blocks of nodes, 
+// elements, and data that are read with ReadBlock are taken from the cache.
+// Everything that is not found in the cache is added to it.
+void FEBioImport::ParseMeshSection(XMLTag& tag, FEFileSection* ps)
+{
+	FEModelBuilder* builder = GetBuilder();
+	FEBModel& feb = builder->GetFEBModel();
+
+	Timer timer;
+	timer.start();
+
+	bool bmesh = (tag == "Mesh");
+	if (bmesh && (feb.Parts() == 0) && m_cache.GetParts(feb))
+	{
+		builder->m_maxid = 0;
+
+		// skip the Mesh section
+		if (tag.isleaf() == false)
+		{
+			++tag;
+			while (!tag.isend()) tag.m_preader->SkipTag(tag);
+		}
+	}
+	else
+	{
+		// parse the section
+		m_cacheSection = tag.Name();
+		m_cacheSectionPos = tag.m_fpos;
+		m_cacheReader = tag.m_preader;
+		ps->Parse(tag);
+		m_cacheSection.clear();
+		m_cacheReader = nullptr;
+
+		// store the parts in the cache
+		if (bmesh) m_cache.SetParts(feb);
+	}
+
+	timer.stop();
+	m_meshTime += timer.GetTime();
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioImport::ReadBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<double>& block)
+{
+	return ReadCachedBlock(tag, szchild, szatt, block);
+}
+
+//-----------------------------------------------------------------------------
+bool FEBioImport::ReadBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<int>& block)
+{
+	return ReadCachedBlock(tag, szchild, szatt, block);
+}
+
+//-----------------------------------------------------------------------------
+// Blocks are identified by the mesh section and their position relative to the 
+// start of that section. Since the cache key is the hash of the mesh sections, 
+// a block that is found this way has the same contents as in the input file.
+template <typename T> bool FEBioImport::ReadCachedBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<T>& block)
+{
+	XMLReader& xml = *tag.m_preader;
+	if (m_cacheSection.empty() || (tag.m_preader != m_cacheReader)) return xml.ReadBlock(tag, szchild, szatt, block);
+
+	int64_t offset = tag.m_fpos - m_cacheSectionPos;
+	if (m_cache.GetBlock(m_cacheSection, offset, szchild, szatt, block))
+	{
+		xml.SkipBlock(tag, block.nbytes, block.nlines);
+		return true;
+	}
+
+	if (xml.ReadBlock(tag, szchild, szatt, block) == false) return false;
+
+	m_cache.SetBlock(m_cacheSection, offset, szchild, szatt, block);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEBioImport::SetModelCacheMode(int mode) { m_cacheMode = mode; }
+
 //-----------------------------------------------------------------------------
 //! This function parses the febio_spec tag for the version number
 void FEBioImport::ParseVersion(XMLTag &tag)
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #pragma once
 #include "FileImport.h"
 #include "XMLReader.h"
+#include "FEBModelCache.h"
 #include "FECore/FEAnalysis.h"
 #include "FECore/FESolver.h"
 #include "FECore/DataStore.h"
@@ -159,16 +160,41 @@ public:
 
 	void AddDataRecord(DataRecord* pd);
 
+public:
+	//! set the mode of the model cache (see FEBModelCache::Mode)
+	void SetModelCacheMode(int mode);
+
+	//! was the mesh read from the cache
+	bool MeshFromCache() const { return m_bmeshFromCache; }
+
+	//! was the cache (re)created
+	bool CacheCreated() const { return m_bcacheCreated; }
+
+	//! the model cache
+	const FEBModelCache& ModelCache() const { return m_cache; }
+
+	//! time spent reading the mesh (either from the file or from the cache)
+	double MeshReadTime() const { return m_meshTime; }
+
 public:
 	// Helper functions for reading node sets, surfaces, etc.
 	FENodeSet* ParseNodeSet(XMLTag& tag, const char* szatt = "set");
 	FESurface* ParseSurface(XMLTag& tag, const char* szatt = "surf");
 
+	//! Read a block of child tags (see XMLReader::ReadBlock). In the mesh sections, 
+	//! the block is taken from the model cache when possible.
+	bool ReadBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<double>& block);
+	bool ReadBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<int>& block);
+
 protected:
 	void ParseVersion(XMLTag& tag);
 
 	void BuildFileSectionMap(int nversion);
 
+	void ParseMeshSection(XMLTag& tag, FEFileSection* ps);
+
+	template <typename T> bool ReadCachedBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<T>& block);
+
 public:
 	char	m_szdmp[512];
 	char	m_szlog[512];
@@ -176,4 +202,15 @@ public:
 
 public:
 	vector<DataRecord*>		m_data;
+
+private:
+	FEBModelCache	m_cache;
+	int				m_cacheMode;
+	bool			m_bmeshFromCache;
+	bool			m_bcacheCreated;
+	double			m_meshTime;
+
+	std::string		m_cacheSection;		// mesh section that is being read
+	int64_t			m_cacheSectionPos;	// file position of this section
+	XMLReader*		m_cacheReader;		// the reader of this section
 };
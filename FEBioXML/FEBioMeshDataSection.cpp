@@ -495,6 +495,8 @@ void FEBioMeshDataSection::ParseMaterialAxes(XMLTag& tag, FEElementSet& set)
 	map->SetName(mapName);
 	map->Create(&set);
 
+	// The elements have child tags (a and d), so they are read one at a time
+	// instead of with ReadBlock.
 	++tag;
 	do
 	{
@@ -654,29 +656,47 @@ void FEBioMeshDataSection::ParseMaterialData(XMLTag& tag, FEElementSet& set, con
 			map->Create(&set);
 			val->setDataMap(map);
 
-			// read values
-			++tag;
-			do
+			// try to read all values at once
+			XMLBlock<double> block(6);
+			if (GetFEBioImport()->ReadBlock(tag, "node", "id", block))
 			{
-				if (tag == "node")
+				for (int i = 0; i < block.size(); ++i)
 				{
-					const char* szid = tag.AttributeValue("id");
-					int nid = atoi(szid) - 1;
-
 					// convert global ID into local one
-					int lid = nodeList.GlobalToLocalID(nid);
-					if (lid < 0) throw XMLReader::InvalidAttributeValue(tag, "id", szid);
+					int lid = nodeList.GlobalToLocalID(block.id[i] - 1);
+					if ((lid < 0) || (block.count[i] != 6)) throw XMLReader::InvalidValue(tag);
 
-					// read the value
-					double d[6];
-					tag.value(d, 6);
+					const double* d = block.values(i);
 					mat3ds m(d[0], d[1], d[2], d[3], d[4], d[5]);
 					map->set<mat3ds>(lid, m*scale);
 				}
-				else throw XMLReader::InvalidTag(tag);
+			}
+			else
+			{
+				// read values
 				++tag;
-			} 
-			while (!tag.isend());
+				do
+				{
+					if (tag == "node")
+					{
+						const char* szid = tag.AttributeValue("id");
+						int nid = atoi(szid) - 1;
+
+						// convert global ID into local one
+						int lid = nodeList.GlobalToLocalID(nid);
+						if (lid < 0) throw XMLReader::InvalidAttributeValue(tag, "id", szid);
+
+						// read the value
+						double d[6];
+						tag.value(d, 6);
+						mat3ds m(d[0], d[1], d[2], d[3], d[4], d[5]);
+						map->set<mat3ds>(lid, m*scale);
+					}
+					else throw XMLReader::InvalidTag(tag);
+					++tag;
+				} 
+				while (!tag.isend());
+			}
 
 			param.setValuator(val);
 		}
@@ -692,14 +712,29 @@ void FEBioMeshDataSection::ParseMaterialData(XMLTag& tag, FEElementSet& set, con
 void FEBioMeshDataSection::ParseElementData(XMLTag& tag, FEElementSet& set, vector<ELEMENT_DATA>& values, int nvalues)
 {
 	// get the total nr of elements
-	FEModel& fem = *GetFEModel();
-	FEMesh& mesh = fem.GetMesh();
 	int nelems = set.Elements();
 
 	// resize the array
 	values.resize(nelems);
 	for (int i = 0; i<nelems; ++i) values[i].nval = 0;
 
+	// try to read all values at once
+	XMLBlock<double> block(nvalues);
+	if (GetFEBioImport()->ReadBlock(tag, "elem", "lid", block))
+	{
+		for (int i = 0; i < block.size(); ++i)
+		{
+			int n = block.id[i] - 1;
+			if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidValue(tag);
+
+			ELEMENT_DATA& data = values[n];
+			data.nval = block.count[i];
+			const double* v = block.values(i);
+			for (int j = 0; j < data.nval; ++j) data.val[j] = v[j];
+		}
+		return;
+	}
+
 	++tag;
 	do
 	{
@@ -720,6 +755,45 @@ void FEBioMeshDataSection::ParseElementData(XMLTag& tag, FEElementSet& set, vect
 	} while (!tag.isend());
 }
 
+//-----------------------------------------------------------------------------
+// helper function for assigning the values that were read for one element. 
+// Returns false if the number of values is not valid.
+static bool set_element_value(FEDomainMap& map, int n, const double* v, int nread)
+{
+	FEDataType dataType = map.DataType();
+	int dataSize = map.DataSize();
+	int m = map.MaxNodes();
+	if (nread == dataSize)
+	{
+		switch (dataType)
+		{
+		case FE_DOUBLE:	map.setValue(n, v[0]); break;
+		case FE_VEC2D:	map.setValue(n, vec2d(v[0], v[1])); break;
+		case FE_VEC3D:	map.setValue(n, vec3d(v[0], v[1], v[2])); break;
+		case FE_MAT3D:  map.setValue(n, mat3d(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8])); break;
+		case FE_MAT3DS: map.setValue(n, mat3ds(v[0], v[1], v[2], v[3], v[4], v[5])); break;
+		default:
+			assert(false);
+		}
+	}
+	else if (nread == m * dataSize)
+	{
+		for (int i = 0; i < m; ++i, v += dataSize)
+		{
+			switch (dataType)
+			{
+			case FE_DOUBLE:	map.setValue(n, i, v[0]); break;
+			case FE_VEC2D:	map.setValue(n, i, vec2d(v[0], v[1])); break;
+			case FE_VEC3D:	map.setValue(n, i, vec3d(v[0], v[1], v[2])); break;
+			default:
+				assert(false);
+			}
+		}
+	}
+	else return false;
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 void FEBioMeshDataSection::ParseElementData(XMLTag& tag, FEDomainMap& map)
 {
@@ -727,17 +801,29 @@ void FEBioMeshDataSection::ParseElementData(XMLTag& tag, FEDomainMap& map)
 	if (set == nullptr) throw XMLReader::InvalidTag(tag);
 
 	// get the total nr of elements
-	FEModel& fem = *GetFEModel();
-	FEMesh& mesh = fem.GetMesh();
 	int nelems = set->Elements();
 
-	FEDataType dataType = map.DataType();
 	int dataSize = map.DataSize();
 	int m = map.MaxNodes();
-	double data[3 * FEElement::MAX_NODES]; // make sure this array is large enough to store any data map type (current 3 for FE_VEC3D)
 
 	// TODO: For vec3d values, I sometimes need to normalize the vectors (e.g. for fibers). How can I do this?
 
+	// try to read all values at once
+	XMLBlock<double> block(m*dataSize);
+	if (GetFEBioImport()->ReadBlock(tag, "elem", "lid", block))
+	{
+		for (int i = 0; i < block.size(); ++i)
+		{
+			int n = block.id[i] - 1;
+			if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidValue(tag);
+			if (set_element_value(map, n, block.values(i), block.count[i]) == false) throw XMLReader::InvalidValue(tag);
+		}
+		if (block.size() != nelems) throw FEBioImport::MeshDataError();
+		return;
+	}
+
+	double data[3 * FEElement::MAX_NODES]; // make sure this array is large enough to store any data map type (current 3 for FE_VEC3D)
+
 	int ncount = 0;
 	++tag;
 	do
@@ -750,36 +836,7 @@ void FEBioMeshDataSection::ParseElementData(XMLTag& tag, FEDomainMap& map)
 		if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
 
 		int nread = tag.value(data, m*dataSize);
-		if (nread == dataSize)
-		{
-			double* v = data;
-			switch (dataType)
-			{
-			case FE_DOUBLE:	map.setValue(n, v[0]); break;
-			case FE_VEC2D:	map.setValue(n, vec2d(v[0], v[1])); break;
-			case FE_VEC3D:	map.setValue(n, vec3d(v[0], v[1], v[2])); break;
-			case FE_MAT3D:  map.setValue(n, mat3d(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8])); break;
-            case FE_MAT3DS: map.setValue(n, mat3ds(v[0], v[1], v[2], v[3], v[4], v[5])); break;
-			default:
-				assert(false);
-			}
-		}
-		else if (nread == m * dataSize)
-		{
-			double* v = data;
-			for (int i = 0; i < m; ++i, v += dataSize)
-			{
-				switch (dataType)
-				{
-				case FE_DOUBLE:	map.setValue(n, i, v[0]); break;
-				case FE_VEC2D:	map.setValue(n, i, vec2d(v[0], v[1])); break;
-				case FE_VEC3D:	map.setValue(n, i, vec3d(v[0], v[1], v[2])); break;
-				default:
-					assert(false);
-				}
-			}
-		}
-		else throw XMLReader::InvalidValue(tag);
+		if (set_element_value(map, n, data, nread) == false) throw XMLReader::InvalidValue(tag);
 		++tag;
 
 		ncount++;
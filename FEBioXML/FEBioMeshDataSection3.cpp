@@ -863,6 +863,8 @@ void FEBioMeshDataSection3::ParseMaterialAxes(XMLTag& tag, FEElementSet& set)
 		map->SetName(mapName);
 		map->Create(&set);
 
+		// The elements have child tags (a and d), so they are read one at a time
+		// instead of with ReadBlock.
 		++tag;
 		do
 		{
@@ -931,16 +933,113 @@ void FEBioMeshDataSection3::ParseMaterialAxes(XMLTag& tag, FEElementSet& set)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// helper functions for assigning the values that were read for one item of a data map.
+// These return false if the number of values is not valid.
+static bool set_node_value(FENodeDataMap& map, int n, const double* v, int nread)
+{
+	if (nread != map.DataSize()) return false;
+	switch (map.DataType())
+	{
+	case FE_DOUBLE:	map.setValue(n, v[0]); break;
+	case FE_VEC2D:	map.setValue(n, vec2d(v[0], v[1])); break;
+	case FE_VEC3D:	map.setValue(n, vec3d(v[0], v[1], v[2])); break;
+	default:
+		assert(false);
+	}
+	return true;
+}
+
+static bool set_face_value(FESurfaceMap& map, int n, const double* v, int nread)
+{
+	FEDataType dataType = map.DataType();
+	int dataSize = map.DataSize();
+	int m = map.MaxNodes();
+	if (nread == dataSize)
+	{
+		switch (dataType)
+		{
+		case FE_DOUBLE:	map.setValue(n, v[0]); break;
+		case FE_VEC2D:	map.setValue(n, vec2d(v[0], v[1])); break;
+		case FE_VEC3D:	map.setValue(n, vec3d(v[0], v[1], v[2])); break;
+		default:
+			assert(false);
+		}
+	}
+	else if (nread == m*dataSize)
+	{
+		for (int i = 0; i < m; ++i, v += dataSize)
+		{
+			switch (dataType)
+			{
+			case FE_DOUBLE:	map.setValue(n, i, v[0]); break;
+			case FE_VEC2D:	map.setValue(n, i, vec2d(v[0], v[1])); break;
+			case FE_VEC3D:	map.setValue(n, i, vec3d(v[0], v[1], v[2])); break;
+			default:
+				assert(false);
+			}
+		}
+	}
+	else return false;
+	return true;
+}
+
+static bool set_element_value(FEDomainMap& map, int n, const double* v, int nread)
+{
+	FEDataType dataType = map.DataType();
+	int dataSize = map.DataSize();
+	int m = map.MaxNodes();
+	if (nread == dataSize)
+	{
+		switch (dataType)
+		{
+		case FE_DOUBLE:	map.setValue(n, v[0]); break;
+		case FE_VEC2D :	map.setValue(n, vec2d(v[0], v[1])); break;
+		case FE_VEC3D :	map.setValue(n, vec3d(v[0], v[1], v[2])); break;
+		case FE_MAT3D : map.setValue(n, mat3d(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8])); break;
+		case FE_MAT3DS: map.setValue(n, mat3ds(v[0], v[1], v[2], v[3], v[4], v[5])); break;
+		default:
+			assert(false);
+		}
+	}
+	else if (nread == m*dataSize)
+	{
+		for (int i = 0; i < m; ++i, v += dataSize)
+		{
+			switch (dataType)
+			{
+			case FE_DOUBLE:	map.setValue(n, i, v[0]); break;
+			case FE_VEC2D:	map.setValue(n, i, vec2d(v[0], v[1])); break;
+			case FE_VEC3D:	map.setValue(n, i, vec3d(v[0], v[1], v[2])); break;
+			default:
+				assert(false);
+			}
+		}
+	}
+	else return false;
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 void FEBioMeshDataSection3::ParseNodeData(XMLTag& tag, FENodeDataMap& map)
 {
 	// get the total nr of nodes
-	FEModel& fem = *GetFEModel();
-	FEMesh& mesh = fem.GetMesh();
 	int nodes = map.DataCount();
-
-	FEDataType dataType = map.DataType();
 	int dataSize = map.DataSize();
+
+	// try to read all values at once
+	XMLBlock<double> block(dataSize);
+	if (GetFEBioImport()->ReadBlock(tag, "node", "lid", block))
+	{
+		for (int i = 0; i < block.size(); ++i)
+		{
+			int n = block.id[i] - 1;
+			if ((n < 0) || (n >= nodes)) throw XMLReader::InvalidValue(tag);
+			if (set_node_value(map, n, block.values(i), block.count[i]) == false) throw XMLReader::InvalidValue(tag);
+		}
+		return;
+	}
+
 	double data[3]; // make sure this array is large enough to store any data map type (current 3 for FE_VEC3D)
 
 	++tag;
@@ -954,18 +1053,7 @@ void FEBioMeshDataSection3::ParseNodeData(XMLTag& tag, FENodeDataMap& map)
 		if ((n < 0) || (n >= nodes)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
 
 		int nread = tag.value(data, dataSize);
-		if (nread == dataSize)
-		{
-			switch (dataType)
-			{
-			case FE_DOUBLE:	map.setValue(n, data[0]); break;
-			case FE_VEC2D:	map.setValue(n, vec2d(data[0], data[1])); break;
-			case FE_VEC3D:	map.setValue(n, vec3d(data[0], data[1], data[2])); break;
-			default:
-				assert(false);
-			}
-		}
-		else throw XMLReader::InvalidValue(tag);
+		if (set_node_value(map, n, data, nread) == false) throw XMLReader::InvalidValue(tag);
 		++tag;
 	}
 	while (!tag.isend());
@@ -978,13 +1066,24 @@ void FEBioMeshDataSection3::ParseSurfaceData(XMLTag& tag, FESurfaceMap& map)
 	if (set == nullptr) throw XMLReader::InvalidTag(tag);
 
 	// get the total nr of elements
-	FEModel& fem = *GetFEModel();
-	FEMesh& mesh = fem.GetMesh();
 	int nelems = set->Faces();
 
-	FEDataType dataType = map.DataType();
 	int dataSize = map.DataSize();
 	int m = map.MaxNodes();
+
+	// try to read all values at once
+	XMLBlock<double> block(m*dataSize);
+	if (GetFEBioImport()->ReadBlock(tag, "face", "lid", block))
+	{
+		for (int i = 0; i < block.size(); ++i)
+		{
+			int n = block.id[i] - 1;
+			if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidValue(tag);
+			if (set_face_value(map, n, block.values(i), block.count[i]) == false) throw XMLReader::InvalidValue(tag);
+		}
+		return;
+	}
+
 	double data[3 * FEElement::MAX_NODES]; // make sure this array is large enough to store any data map type (current 3 for FE_VEC3D)
 
 	++tag;
@@ -998,33 +1097,7 @@ void FEBioMeshDataSection3::ParseSurfaceData(XMLTag& tag, FESurfaceMap& map)
 		if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
 
 		int nread = tag.value(data, m*dataSize);
-		if (nread == dataSize)
-		{
-			switch (dataType)
-			{
-			case FE_DOUBLE:	map.setValue(n, data[0]); break;
-			case FE_VEC2D:	map.setValue(n, vec2d(data[0], data[1])); break;
-			case FE_VEC3D:	map.setValue(n, vec3d(data[0], data[1], data[2])); break;
-			default:
-				assert(false);
-			}
-		}
-		else if (nread == m*dataSize)
-		{
-			double* pd = data;
-			for (int i = 0; i < m; ++i, pd += dataSize)
-			{
-				switch (dataType)
-				{
-				case FE_DOUBLE:	map.setValue(n, i, pd[0]); break;
-				case FE_VEC2D:	map.setValue(n, i, vec2d(pd[0], pd[1])); break;
-				case FE_VEC3D:	map.setValue(n, i, vec3d(pd[0], pd[1], pd[2])); break;
-				default:
-					assert(false);
-				}
-			}
-		}
-		else throw XMLReader::InvalidValue(tag);
+		if (set_face_value(map, n, data, nread) == false) throw XMLReader::InvalidValue(tag);
 		++tag;
 	}
 	while (!tag.isend());
@@ -1037,17 +1110,29 @@ void FEBioMeshDataSection3::ParseElementData(XMLTag& tag, FEDomainMap& map)
 	if (set == nullptr) throw XMLReader::InvalidTag(tag);
 
 	// get the total nr of elements
-	FEModel& fem = *GetFEModel();
-	FEMesh& mesh = fem.GetMesh();
 	int nelems = set->Elements();
 
-	FEDataType dataType = map.DataType();
 	int dataSize = map.DataSize();
 	int m = map.MaxNodes();
-	double data[3 * FEElement::MAX_NODES]; // make sure this array is large enough to store any data map type (current 3 for FE_VEC3D)
 
 	// TODO: For vec3d values, I sometimes need to normalize the vectors (e.g. for fibers). How can I do this?
 
+	// try to read all values at once
+	XMLBlock<double> block(m*dataSize);
+	if (GetFEBioImport()->ReadBlock(tag, "elem", "lid", block))
+	{
+		for (int i = 0; i < block.size(); ++i)
+		{
+			int n = block.id[i] - 1;
+			if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidValue(tag);
+			if (set_element_value(map, n, block.values(i), block.count[i]) == false) throw XMLReader::InvalidValue(tag);
+		}
+		if (block.size() != nelems) throw FEBioImport::MeshDataError();
+		return;
+	}
+
+	double data[3 * FEElement::MAX_NODES]; // make sure this array is large enough to store any data map type (current 3 for FE_VEC3D)
+
 	int ncount = 0;
 	++tag;
 	do
@@ -1060,36 +1145,7 @@ void FEBioMeshDataSection3::ParseElementData(XMLTag& tag, FEDomainMap& map)
 		if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidAttributeValue(tag, "lid", szlid);
 
 		int nread = tag.value(data, m*dataSize);
-		if (nread == dataSize)
-		{
-			double* v = data;
-			switch (dataType)
-			{
-			case FE_DOUBLE:	map.setValue(n, v[0]); break;
-			case FE_VEC2D :	map.setValue(n, vec2d(v[0], v[1])); break;
-			case FE_VEC3D :	map.setValue(n, vec3d(v[0], v[1], v[2])); break;
-			case FE_MAT3D : map.setValue(n, mat3d(v[0], v[1], v[2], v[3], v[4], v[5], v[6], v[7], v[8])); break;
-            case FE_MAT3DS: map.setValue(n, mat3ds(v[0], v[1], v[2], v[3], v[4], v[5])); break;
-			default:
-				assert(false);
-			}
-		}
-		else if (nread == m*dataSize)
-		{
-			double* v = data;
-			for (int i = 0; i < m; ++i, v += dataSize)
-			{
-				switch (dataType)
-				{
-				case FE_DOUBLE:	map.setValue(n, i, v[0]); break;
-				case FE_VEC2D:	map.setValue(n, i, vec2d(v[0], v[1])); break;
-				case FE_VEC3D:	map.setValue(n, i, vec3d(v[0], v[1], v[2])); break;
-				default:
-					assert(false);
-				}
-			}
-		}
-		else throw XMLReader::InvalidValue(tag);
+		if (set_element_value(map, n, data, nread) == false) throw XMLReader::InvalidValue(tag);
 		++tag;
 
 		ncount++;
@@ -1103,14 +1159,29 @@ void FEBioMeshDataSection3::ParseElementData(XMLTag& tag, FEDomainMap& map)
 void FEBioMeshDataSection3::ParseElementData(XMLTag& tag, FEElementSet& set, vector<ELEMENT_DATA>& values, int nvalues)
 {
 	// get the total nr of elements
-	FEModel& fem = *GetFEModel();
-	FEMesh& mesh = fem.GetMesh();
 	int nelems = set.Elements();
 
 	// resize the array
 	values.resize(nelems);
 	for (int i=0; i<nelems; ++i) values[i].nval = 0;
 
+	// try to read all values at once
+	XMLBlock<double> block(nvalues);
+	if (GetFEBioImport()->ReadBlock(tag, "elem", "lid", block))
+	{
+		for (int i = 0; i < block.size(); ++i)
+		{
+			int n = block.id[i] - 1;
+			if ((n < 0) || (n >= nelems)) throw XMLReader::InvalidValue(tag);
+
+			ELEMENT_DATA& data = values[n];
+			data.nval = block.count[i];
+			const double* v = block.values(i);
+			for (int j = 0; j < data.nval; ++j) data.val[j] = v[j];
+		}
+		return;
+	}
+
 	++tag;
 	do
 	{
@@ -95,22 +95,41 @@ void FEBioMeshSection::ParseNodeSection(XMLTag& tag, FEBModel::Part* part)
 	vector<int> nodeList; nodeList.reserve(10000);
 
 	// read nodal coordinates
-	++tag;
-	do {
-		// nodal coordinates
-		FEBModel::NODE nd;
-		value(tag, nd.r);
+	XMLBlock<double> block(3);
+	if (tag.m_preader->ReadBlock(tag, "node", "id", block))
+	{
+		int nodes = block.size();
+		node.resize(nodes);
+		nodeList.resize(nodes);
+		for (int i = 0; i < nodes; ++i)
+		{
+			if (block.count[i] != 3) throw XMLReader::XMLSyntaxError(tag.m_nstart_line);
+			const double* v = block.values(i);
+			FEBModel::NODE& nd = node[i];
+			nd.r = vec3d(v[0], v[1], v[2]);
+			nd.id = block.id[i];
+			nodeList[i] = nd.id;
+		}
+	}
+	else
+	{
+		++tag;
+		do {
+			// nodal coordinates
+			FEBModel::NODE nd;
+			value(tag, nd.r);
 
-		// get the nodal ID
-		tag.AttributeValue("id", nd.id);
+			// get the nodal ID
+			tag.AttributeValue("id", nd.id);
 
-		// add it to the pile
-		node.push_back(nd);
-		nodeList.push_back(nd.id);
+			// add it to the pile
+			node.push_back(nd);
+			nodeList.push_back(nd.id);
 
-		// go on to the next node
-		++tag;
-	} while (!tag.isend());
+			// go on to the next node
+			++tag;
+		} while (!tag.isend());
+	}
 
 	// add nodes to the part
 	part->AddNodes(node);
@@ -166,23 +185,44 @@ void FEBioMeshSection::ParseElementSection(XMLTag& tag, FEBModel::Part* part)
 	vector<int> elemList; elemList.reserve(10000);
 
 	// read element data
-	++tag;
-	do
+	XMLBlock<int> block(FEElement::MAX_NODES);
+	if (tag.m_preader->ReadBlock(tag, "elem", "id", block))
 	{
-		FEBModel::ELEMENT el;
+		int elems = block.size();
+		dom->Reserve(elems);
+		elemList.resize(elems);
+		for (int i = 0; i < elems; ++i)
+		{
+			FEBModel::ELEMENT el;
+			el.id = block.id[i];
+
+			const int* n = block.values(i);
+			for (int j = 0; j < block.count[i]; ++j) el.node[j] = n[j];
+
+			dom->AddElement(el);
+			elemList[i] = el.id;
+		}
+	}
+	else
+	{
+		++tag;
+		do
+		{
+			FEBModel::ELEMENT el;
 
-		// get the element ID
-		tag.AttributeValue("id", el.id);
+			// get the element ID
+			tag.AttributeValue("id", el.id);
 
-		// read the element data
-		tag.value(el.node, FEElement::MAX_NODES);
+			// read the element data
+			tag.value(el.node, FEElement::MAX_NODES);
 
-		dom->AddElement(el);
-		elemList.push_back(el.id);
+			dom->AddElement(el);
+			elemList.push_back(el.id);
 
-		// go to next tag
-		++tag;
-	} while (!tag.isend());
+			// go to next tag
+			++tag;
+		} while (!tag.isend());
+	}
 
 	// set the element list
 	if (pg) pg->SetElementList(elemList);
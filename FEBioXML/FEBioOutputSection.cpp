@@ -448,6 +448,12 @@ void FEBioOutputSection::ParsePlotfile(XMLTag &tag)
 				tag.value(ncomp);
 				plotData.SetPlotCompression(ncomp);
 			}
+			else if (tag=="async")
+			{
+				bool b;
+				tag.value(b);
+				plotData.SetPlotAsync(b);
+			}
 			++tag;
 		}
 		while (!tag.isend());
@@ -30,6 +30,15 @@ SOFTWARE.*/
 #include "XMLReader.h"
 #include <assert.h>
 #include <stdarg.h>
+#include <algorithm>
+#include <sstream>
+#include <locale>
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 //=============================================================================
 // XMLAtt
@@ -413,6 +422,9 @@ XMLReader::XMLReader()
 	m_bufSize = 0;
 	m_eof = false;
 	m_currentPos = 0;
+	m_map = 0;
+	m_mapSize = 0;
+	m_bmmap = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -428,6 +440,7 @@ void XMLReader::Close()
 	{
 		fclose(m_fp);
 	}
+	UnmapFile();
 
 	m_fp = 0;
 	m_nline = 0;
@@ -438,7 +451,7 @@ void XMLReader::Close()
 }
 
 //-----------------------------------------------------------------------------
-bool XMLReader::Open(const char* szfile)
+bool XMLReader::Open(const char* szfile, bool bmap)
 {
 	// make sure this reader has not been attached to a file yet
 	if (m_fp != 0) return false;
@@ -460,10 +473,77 @@ bool XMLReader::Open(const char* szfile)
 
 	m_currentPos = 0;
 
+	// try to hold the file in memory
+	if (bmap) MapFile(szfile);
+
 	// This file is ready to be processed
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//! Map the file into memory. On systems that don't support mmap the file is 
+//! read into a buffer instead.
+bool XMLReader::MapFile(const char* szfile)
+{
+	UnmapFile();
+
+#ifndef WIN32
+	int fd = open(szfile, O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat st;
+	if ((fstat(fd, &st) != 0) || (st.st_size <= 0)) { close(fd); return false; }
+
+	void* pd = mmap(0, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (pd == MAP_FAILED) return false;
+
+	// we'll read the file sequentially
+	madvise(pd, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+	m_map = (char*)pd;
+	m_mapSize = (int64_t)st.st_size;
+	m_bmmap = true;
+#else
+	FILE* fp = fopen(szfile, "rb");
+	if (fp == 0) return false;
+	_fseeki64(fp, 0, SEEK_END);
+	int64_t size = _ftelli64(fp);
+	_fseeki64(fp, 0, SEEK_SET);
+	if (size <= 0) { fclose(fp); return false; }
+
+	m_map = new char[size];
+	if (fread(m_map, 1, (size_t)size, fp) != (size_t)size)
+	{
+		delete [] m_map; m_map = 0;
+		fclose(fp);
+		return false;
+	}
+	fclose(fp);
+	m_mapSize = size;
+	m_bmmap = false;
+#endif
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void XMLReader::UnmapFile()
+{
+	if (m_map)
+	{
+#ifndef WIN32
+		if (m_bmmap) munmap(m_map, (size_t)m_mapSize);
+		else delete [] m_map;
+#else
+		delete [] m_map;
+#endif
+	}
+	m_map = 0;
+	m_mapSize = 0;
+	m_bmmap = false;
+}
+
 //-----------------------------------------------------------------------------
 
 class XMLPath
@@ -578,7 +658,7 @@ private:
 bool XMLReader::FindTag(const char* xpath, XMLTag& tag)
 {
 	// go to the beginning of the file
-	fseek(m_fp, 0, SEEK_SET);
+	if (m_map == 0) fseek(m_fp, 0, SEEK_SET);
 	m_bufIndex = m_bufSize = 0;
 	m_currentPos = 0;
 	m_eof = false;
@@ -631,7 +711,8 @@ void XMLReader::NextTag(XMLTag& tag)
 	m_nline = tag.m_ncurrent_line;
 
 	// set the current file position
-	if (m_currentPos != tag.m_fpos)
+	if (m_map) m_currentPos = tag.m_fpos;
+	else if (m_currentPos != tag.m_fpos)
 	{
 		fseek(m_fp, tag.m_fpos, SEEK_SET);
 		m_currentPos = tag.m_fpos;
@@ -794,6 +875,27 @@ void XMLReader::ReadTag(XMLTag& tag)
 void XMLReader::ReadValue(XMLTag& tag)
 {
 	char ch;
+	if (!tag.isend() && m_map)
+	{
+		// When the file is in memory, we can find the end of the value directly. 
+		// We only do this when there are no entity references in the value.
+		const char* p0 = m_map + m_currentPos;
+		const char* p1 = (const char*) memchr(p0, '<', (size_t)(m_mapSize - m_currentPos));
+		if (p1 && (memchr(p0, '&', p1 - p0) == 0))
+		{
+			tag.m_szval.clear();
+			tag.m_szval.reserve((p1 - p0) + 1);
+			for (const char* p = p0; p != p1; ++p)
+			{
+				if (*p == '\n') ++m_nline;
+				else tag.m_szval.push_back(*p);
+			}
+			tag.m_szval.push_back(0);
+			m_currentPos += (p1 - p0) + 1;
+			return;
+		}
+	}
+
 	if (!tag.isend())
 	{
 		tag.m_szval.clear();
@@ -868,6 +970,12 @@ void XMLReader::ReadEndTag(XMLTag& tag)
 //-----------------------------------------------------------------------------
 char XMLReader::readNextChar()
 {
+	if (m_map)
+	{
+		if (m_currentPos >= m_mapSize) throw EndOfFile();
+		return m_map[m_currentPos++];
+	}
+
 	if (m_bufIndex >= m_bufSize)
 	{
 		if (m_eof) throw EndOfFile();
@@ -890,6 +998,12 @@ int64_t XMLReader::currentPos()
 //! move the file pointer
 void XMLReader::rewind(int64_t nstep)
 {
+	if (m_map)
+	{
+		m_currentPos -= nstep;
+		return;
+	}
+
 	m_bufIndex -= nstep;
 	m_currentPos -= nstep;
 
@@ -939,6 +1053,56 @@ void XMLReader::SkipTag(XMLTag& tag)
 	// if this tag is a leaf we just return
 	if (tag.isleaf()) { ++tag; return; }
 
+	// For mapped files, we can search for the matching end tag directly.
+	if (m_map)
+	{
+		const char* sztag = tag.m_sztag;
+		int l = (int)strlen(sztag);
+		const char* pe = m_map + m_mapSize;
+		const char* p = m_map + tag.m_fpos;
+		int depth = 1;
+		while (true)
+		{
+			p = (const char*)memchr(p, '<', pe - p);
+			if (p == 0) throw UnexpectedEOF();
+
+			// skip comments
+			if ((pe - p > 4) && (strncmp(p, "<!--", 4) == 0))
+			{
+				const char* pc = p + 4;
+				while ((pc = (const char*)memchr(pc, '-', pe - pc)) && (pe - pc > 2) && (strncmp(pc, "-->", 3) != 0)) ++pc;
+				if ((pc == 0) || (pe - pc <= 2)) throw UnexpectedEOF();
+				p = pc + 3;
+				continue;
+			}
+
+			// check for a start or end tag with the same name
+			bool bend = (p[1] == '/');
+			const char* q = p + (bend ? 2 : 1);
+			if ((pe - q > l) && (strncmp(q, sztag, l) == 0) && (isspace((unsigned char)q[l]) || (q[l] == '>') || (q[l] == '/')))
+			{
+				if (bend)
+				{
+					if (--depth == 0) break;
+				}
+				else
+				{
+					const char* pt = (const char*)memchr(q, '>', pe - q);
+					if (pt == 0) throw UnexpectedEOF();
+					if (pt[-1] != '/') depth++;
+				}
+			}
+			++p;
+		}
+
+		// read the end tag
+		tag.m_ncurrent_line += (int)std::count((const char*)m_map + tag.m_fpos, p, '\n');
+		tag.m_fpos = p - m_map;
+		NextTag(tag);
+		++tag;
+		return;
+	}
+
 	// if it is not a leaf we have to loop over all 
 	// the children, skipping each child in turn
 	NextTag(tag);
@@ -950,3 +1114,219 @@ void XMLReader::SkipTag(XMLTag& tag)
 
 	++tag;
 }
+
+//=============================================================================
+// Fast block reading
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+// Locale-independent conversion of a string to a number. Like atof and atoi,
+// leading whitespace is skipped and parsing stops at the first invalid character.
+static void xml_parse(const char* sz, int& v)
+{
+	while (isspace((unsigned char)*sz)) ++sz;
+	bool bneg = false;
+	if ((*sz == '-') || (*sz == '+')) bneg = (*sz++ == '-');
+	int n = 0;
+	while ((*sz >= '0') && (*sz <= '9')) n = 10*n + (*sz++ - '0');
+	v = (bneg ? -n : n);
+}
+
+static void xml_parse(const char* sz, double& v)
+{
+	// powers of ten that can be represented exactly
+	static const double p10[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	while (isspace((unsigned char)*sz)) ++sz;
+	const char* sz0 = sz;
+
+	bool bneg = false;
+	if ((*sz == '-') || (*sz == '+')) bneg = (*sz++ == '-');
+
+	// read the mantissa as an integer
+	unsigned long long m = 0;
+	int nd = 0, e = 0;
+	while ((*sz >= '0') && (*sz <= '9')) { m = 10*m + (*sz++ - '0'); nd++; }
+	if (*sz == '.')
+	{
+		++sz;
+		while ((*sz >= '0') && (*sz <= '9')) { m = 10*m + (*sz++ - '0'); nd++; e--; }
+	}
+	if (nd == 0) { v = 0.0; return; }
+
+	// read the exponent
+	if ((*sz == 'e') || (*sz == 'E'))
+	{
+		int ne = 0;
+		xml_parse(sz + 1, ne);
+		e += ne;
+	}
+
+	// If the mantissa and the power of ten are exact, the result is correctly rounded.
+	// Otherwise, we let the standard library do the work. (Note that strtod 
+	// depends on the locale, so we use a stream with the classic locale instead.)
+	if ((nd <= 15) && (e >= -22) && (e <= 22))
+	{
+		double d = (double)m;
+		d = (e < 0 ? d / p10[-e] : d * p10[e]);
+		v = (bneg ? -d : d);
+	}
+	else
+	{
+		const char* sz1 = sz0;
+		while (((*sz1 >= '0') && (*sz1 <= '9')) || (*sz1 == '.') || (*sz1 == '-') || (*sz1 == '+') || (*sz1 == 'e') || (*sz1 == 'E')) ++sz1;
+		std::istringstream ss(std::string(sz0, sz1));
+		ss.imbue(std::locale::classic());
+		v = 0.0;
+		ss >> v;
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool XMLReader::ReadBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<double>& block)
+{
+	return ReadBlockImp(tag, szchild, szatt, block);
+}
+
+//-----------------------------------------------------------------------------
+bool XMLReader::ReadBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<int>& block)
+{
+	return ReadBlockImp(tag, szchild, szatt, block);
+}
+
+//-----------------------------------------------------------------------------
+// This first finds the boundaries of all the child tags, which is done serially, 
+// and then parses the attributes and values of the children in parallel.
+template <typename T> bool XMLReader::ReadBlockImp(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<T>& block)
+{
+	if ((m_map == 0) || tag.isleaf() || tag.isend()) return false;
+
+	struct CHILD
+	{
+		int64_t	att;	// start of attribute list
+		int64_t	val;	// start of value
+	};
+	std::vector<CHILD> child;
+
+	int lc = (int)strlen(szchild);
+	int lp = (int)strlen(tag.m_sztag);
+	const char* pe = m_map + m_mapSize;
+	const char* p = m_map + tag.m_fpos;
+	const char* pend = 0;
+	while (pend == 0)
+	{
+		// find the next tag
+		while ((p < pe) && isspace((unsigned char)*p)) ++p;
+		if ((p >= pe) || (*p != '<')) return false;
+
+		if (p[1] == '/')
+		{
+			// this should be the end tag of the parent
+			if ((pe - p < lp + 2) || (strncmp(p + 2, tag.m_sztag, lp) != 0)) return false;
+			pend = p;
+			break;
+		}
+
+		// make sure this is a child tag
+		if ((pe - p < lc + 2) || (strncmp(p + 1, szchild, lc) != 0)) return false;
+		char ch = p[lc + 1];
+		if ((ch != '>') && !isspace((unsigned char)ch)) return false;
+
+		CHILD c;
+		c.att = (p + lc + 1) - m_map;
+
+		// find the end of the start tag
+		const char* pt = (const char*)memchr(p, '>', pe - p);
+		if ((pt == 0) || (pt[-1] == '/')) return false;
+		c.val = (pt + 1) - m_map;
+
+		// find the end of the value
+		const char* pv = (const char*)memchr(pt, '<', pe - pt);
+		if ((pv == 0) || (memchr(pt, '&', pv - pt))) return false;
+
+		// read the end tag
+		if ((pe - pv < lc + 3) || (pv[1] != '/') || (strncmp(pv + 2, szchild, lc) != 0)) return false;
+		p = pv + lc + 2;
+		while ((p < pe) && isspace((unsigned char)*p)) ++p;
+		if ((p >= pe) || (*p != '>')) return false;
+		++p;
+
+		child.push_back(c);
+	}
+
+	// parse the children
+	int N = (int)child.size();
+	int nmax = block.nmax;
+	int la = (int)strlen(szatt);
+	block.id.assign(N, 0);
+	block.count.assign(N, 0);
+	block.val.assign((size_t)N*nmax, T(0));
+	int nerr = 0;
+#pragma omp parallel for reduction(+:nerr)
+	for (int i = 0; i < N; ++i)
+	{
+		// find the attribute
+		bool bfound = false;
+		const char* sz = m_map + child[i].att;
+		const char* sze = m_map + child[i].val - 1;
+		while (sz < sze)
+		{
+			while ((sz < sze) && isspace((unsigned char)*sz)) ++sz;
+			const char* szn = sz;
+			while ((sz < sze) && isvalid(*sz)) ++sz;
+			int ln = (int)(sz - szn);
+			while ((sz < sze) && isspace((unsigned char)*sz)) ++sz;
+			if ((sz >= sze) || (*sz != '=')) break;
+			++sz;
+			while ((sz < sze) && isspace((unsigned char)*sz)) ++sz;
+			if ((sz >= sze) || ((*sz != '"') && (*sz != '\''))) break;
+			char quot = *sz++;
+			if ((ln == la) && (strncmp(szn, szatt, la) == 0))
+			{
+				xml_parse(sz, block.id[i]);
+				bfound = true;
+				break;
+			}
+			const char* q = (const char*)memchr(sz, quot, sze - sz);
+			if (q == 0) break;
+			sz = q + 1;
+		}
+		if (bfound == false) { nerr++; continue; }
+
+		// read the comma-separated values (same as XMLTag::value)
+		const char* szv = m_map + child[i].val;
+		const char* szve = (const char*)memchr(szv, '<', pe - szv);
+		T* v = &block.val[(size_t)i*nmax];
+		int nr = 0;
+		for (int j = 0; j < nmax; ++j)
+		{
+			xml_parse(szv, v[j]);
+			nr++;
+
+			const char* c = (const char*)memchr(szv, ',', szve - szv);
+			if (c) szv = c + 1;
+			else break;
+		}
+		block.count[i] = nr;
+	}
+
+	// if an attribute was missing, let the regular reader report the error
+	if (nerr > 0) return false;
+
+	// read the end tag of the parent
+	block.nbytes = (pend - m_map) - tag.m_fpos;
+	block.nlines = (int)std::count((const char*)m_map + tag.m_fpos, pend, '\n');
+	SkipBlock(tag, block.nbytes, block.nlines);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void XMLReader::SkipBlock(XMLTag& tag, int64_t nbytes, int nlines)
+{
+	tag.m_ncurrent_line += nlines;
+	tag.m_fpos += nbytes;
+	NextTag(tag);
+}
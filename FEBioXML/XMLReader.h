@@ -141,6 +141,30 @@ public:
 	const char* szvalue() { return m_szval.c_str(); }
 };
 
+//-----------------------------------------------------------------------------
+//! This class stores the values of a block of leaf tags that was read with 
+//! XMLReader::ReadBlock. Each tag has an ID (read from an attribute) and up to
+//! nmax comma-separated values.
+template <typename T> class XMLBlock
+{
+public:
+	XMLBlock(int n = 1) : nmax(n), nbytes(0), nlines(0) {}
+
+	//! number of tags that were read
+	int size() const { return (int)id.size(); }
+
+	//! the values of tag i
+	const T* values(int i) const { return &val[i*nmax]; }
+
+public:
+	int					nmax;	//!< max nr of values per tag
+	std::vector<int>	id;		//!< ID attribute of each tag
+	std::vector<int>	count;	//!< nr of values of each tag
+	std::vector<T>		val;	//!< the values (nmax per tag)
+	int64_t				nbytes;	//!< size of the children in the file (in bytes)
+	int					nlines;	//!< nr of lines spanned by the children
+};
+
 //-----------------------------------------------------------------------------
 //! This class implements a reader for XML files
 class FEBIOXML_API XMLReader
@@ -226,8 +250,12 @@ public:
 	XMLReader();
 	virtual ~XMLReader();
 
-	//! Open the xml file
-	bool Open(const char* szfile);
+	//! Open the xml file. If bmap is true, the file is mapped into memory
+	//! (or read into memory if mapping is not supported). 
+	bool Open(const char* szfile, bool bmap = true);
+
+	//! see if the file is held in memory
+	bool IsMapped() const { return (m_map != 0); }
 
 	//! Close the xml file
 	void Close();
@@ -244,6 +272,19 @@ public:
 	//! Skip a tag
 	void SkipTag(XMLTag& tag);
 
+	//! Read all child tags of tag in one pass. This only works for files that are held in memory and 
+	//! when all children are leaves with the name szchild. The attribute szatt (e.g. "id") and the 
+	//! comma-separated values of the children are parsed in parallel. On return, tag is the end tag 
+	//! of the parent, as if the children had been read one by one. If the block cannot be read this way
+	//! (e.g. it contains comments), false is returned and tag is not modified.
+	bool ReadBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<double>& block);
+	bool ReadBlock(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<int>& block);
+
+	//! Skip the children of tag, when the size of the children is already known from a previous
+	//! call to ReadBlock (see XMLBlock::nbytes and XMLBlock::nlines). On return, tag is the end tag
+	//! of the parent, as with ReadBlock.
+	void SkipBlock(XMLTag& tag, int64_t nbytes, int nlines);
+
 protected: // helper functions
 
 	//! Get the next character in the file
@@ -267,6 +308,15 @@ protected: // helper functions
 	//! move the file pointer
     void rewind(int64_t nstep);
 
+	//! map the file into memory
+	bool MapFile(const char* szfile);
+
+	//! release the mapped file
+	void UnmapFile();
+
+	//! implementation of ReadBlock
+	template <typename T> bool ReadBlockImp(XMLTag& tag, const char* szchild, const char* szatt, XMLBlock<T>& block);
+
 protected:
 	FILE*	m_fp;			//!< the file pointer
 	int		m_nline;		//!< current line (used only as temp storage)
@@ -275,6 +325,10 @@ protected:
 	char	m_buf[BUF_SIZE];
     int64_t    m_bufIndex, m_bufSize;
 	bool	m_eof;
+
+	char*	m_map;			//!< file contents, when the file is held in memory
+	int64_t	m_mapSize;		//!< size of mapped file
+	bool	m_bmmap;		//!< m_map was created with mmap
 };
 
 //-----------------------------------------------------------------------------
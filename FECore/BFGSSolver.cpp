@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FESolver.h"
 #include "FEException.h"
 #include "FENewtonSolver.h"
+#include "FEMemoryReport.h"
 
 //-----------------------------------------------------------------------------
 // BFGSSolver
@@ -73,6 +74,15 @@ bool BFGSSolver::Init()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+size_t BFGSSolver::MemoryUsage()
+{
+	size_t bytes = (size_t)m_V.rows()*m_V.columns()*sizeof(double);
+	bytes += (size_t)m_W.rows()*m_W.columns()*sizeof(double);
+	bytes += fecore_memory_size(m_D) + fecore_memory_size(m_G) + fecore_memory_size(m_H) + fecore_memory_size(tmp);
+	return bytes;
+}
+
 //-----------------------------------------------------------------------------
 //! This function performs a BFGS stiffness update.
 //! The last line search step is input to this function.
@@ -72,6 +72,10 @@ void CompactMatrix::Clear()
 	m_pindices = 0;
 	m_ppointers = 0;
 
+	m_tptr.clear();
+	m_tpos.clear();
+	m_tind.clear();
+
 	SparseMatrix::Clear();
 }
 
@@ -92,6 +96,35 @@ void CompactMatrix::alloc(int nr, int nc, int nz, double* pv, int* pi, int* pp,
 	int nn = (isRowBased() ? nr : nc) + 1;
 }
 
+//-----------------------------------------------------------------------------
+void CompactMatrix::buildTransposeIndex()
+{
+	// number of stored rows (or columns) and of the opposite orientation
+	int N = (isRowBased() ? m_nrow : m_ncol);
+	int M = (isRowBased() ? m_ncol : m_nrow);
+
+	// count the entries of each transposed row (or column)
+	m_tptr.assign(M + 1, 0);
+	for (int i = 0; i < m_nsize; ++i) m_tptr[m_pindices[i] - m_offset + 1]++;
+	for (int i = 0; i < M; ++i) m_tptr[i + 1] += m_tptr[i];
+
+	// fill the index. Since we loop over the stored orientation in order, 
+	// the transposed indices will be sorted as well.
+	m_tpos.resize(m_nsize);
+	m_tind.resize(m_nsize);
+	std::vector<int> pos(m_tptr.begin(), m_tptr.end() - 1);
+	for (int j = 0; j < N; ++j)
+	{
+		for (int k = m_ppointers[j] - m_offset; k < m_ppointers[j + 1] - m_offset; ++k)
+		{
+			int i = m_pindices[k] - m_offset;
+			int l = pos[i]++;
+			m_tpos[l] = k;
+			m_tind[l] = j;
+		}
+	}
+}
+
 //-----------------------------------------------------------------------------
 //! calculate bandwidth of matrix
 int CompactMatrix::bandWidth()
@@ -83,6 +83,13 @@ public:
 	//! calculate bandwidth of matrix
 	int bandWidth();
 
+protected:
+	//! Build the transposed index of the stored entries. This maps the storage
+	//! to the opposite orientation (i.e. rows for column based formats) so that products
+	//! can be evaluated as a race-free gather. The index only depends on the structure
+	//! and is cleared in Clear().
+	void buildTransposeIndex();
+
 protected:
 	double*	m_pd;			//!< matrix values
 	int*	m_pindices;		//!< indices
@@ -92,4 +99,8 @@ protected:
 
 protected:
 	std::vector<int>	P;
+
+	std::vector<int>	m_tptr;		//!< pointers into transposed index
+	std::vector<int>	m_tpos;		//!< position of entry in value array
+	std::vector<int>	m_tind;		//!< (zero-based) index of entry in opposite orientation
 };
@@ -63,6 +63,15 @@ void DumpMemStream::Open(bool bsave, bool bshallow)
 	if (m_pb) set_position(0);
 }
 
+//-----------------------------------------------------------------------------
+// This is useful when the stream is written repeatedly (e.g. for running restarts)
+// since it avoids reallocating the buffer each time.
+void DumpMemStream::reset(bool bsave, bool bshallow)
+{
+	m_nsize = 0;
+	Open(bsave, bshallow);
+}
+
 //-----------------------------------------------------------------------------
 bool DumpMemStream::EndOfStream() const
 {
@@ -45,6 +45,9 @@ public: // overloaded from base class
 	void clear();
 	void Open(bool bsave, bool bshallow);
 
+	//! empty the stream and reopen it, but hold on to the allocated buffer
+	void reset(bool bsave, bool bshallow);
+
 	size_t size() const { return m_nsize; }
 	size_t reserved() const { return m_nreserved; }
 	bool EndOfStream() const;
@@ -34,7 +34,7 @@ SOFTWARE.*/
 #include "DOFS.h"
 #include "MatrixProfile.h"
 #include "FEBoundaryCondition.h"
-#include "DumpMemStream.h"
+#include "FECheckpoint.h"
 #include "FELinearConstraintManager.h"
 #include "FEShellDomain.h"
 #include "FEMeshAdaptor.h"
@@ -380,8 +380,8 @@ bool FEAnalysis::Solve()
 		if (m_timeController) m_timeController->AutoTimeStep(0);
 	}
 
-	// dump stream for running restarts
-	DumpMemStream dmp(fem);
+	// checkpoint for running restarts
+	FECheckpoint chk(&fem);
 
 	// repeat for all timesteps
 	if (m_timeController) m_timeController->m_nretries = 0;
@@ -391,8 +391,7 @@ bool FEAnalysis::Solve()
 		// we need to retry this time step
 		if (m_timeController && (m_timeController->m_maxretries > 0))
 		{ 
-			dmp.clear();
-			fem.Serialize(dmp); 
+			chk.Save();
 		}
 
 		// Inform that the time is about to change. (Plugins can use 
@@ -474,8 +473,7 @@ bool FEAnalysis::Solve()
 			if (m_timeController && (m_timeController->m_nretries < m_timeController->m_maxretries))
 			{
 				// restore the previous state
-				dmp.Open(false, true);
-				fem.Serialize(dmp);
+				chk.Restore();
 				
 				// let's try again
 				m_timeController->Retry();
@@ -556,6 +554,9 @@ int FEAnalysis::SolveTimeStep()
 						// reinitialize it
 						InitSolver();
 
+						// the reference geometry of the adapted mesh changed
+						fem.GetMesh().UpdateReferenceCache();
+
 						// inform listeners that the mesh was remeshed
 						fem.DoCallback(CB_REMESH);
 					}
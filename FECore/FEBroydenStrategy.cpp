@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "LinearSolver.h"
 #include "FEException.h"
 #include "FENewtonSolver.h"
+#include "FEMemoryReport.h"
 
 //-----------------------------------------------------------------------------
 //! constructor
@@ -72,6 +73,15 @@ void FEBroydenStrategy::PreSolveUpdate()
 	m_bnewStep = true;
 }
 
+//-----------------------------------------------------------------------------
+size_t FEBroydenStrategy::MemoryUsage()
+{
+	size_t bytes = (size_t)m_R.rows()*m_R.columns()*sizeof(double);
+	bytes += (size_t)m_D.rows()*m_D.columns()*sizeof(double);
+	bytes += fecore_memory_size(m_rho) + fecore_memory_size(m_q);
+	return bytes;
+}
+
 //-----------------------------------------------------------------------------
 //! perform a quasi-Newton udpate
 bool FEBroydenStrategy::Update(double s, vector<double>& ui, vector<double>& R0, vector<double>& R1)
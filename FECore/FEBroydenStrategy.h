@@ -47,6 +47,9 @@ public:
 	//! solve the equations
 	void SolveEquations(vector<double>& x, vector<double>& b) override;
 
+	//! memory used by the update vectors
+	size_t MemoryUsage() override;
+
 	//! Presolve update
 	virtual void PreSolveUpdate() override;
 
@@ -0,0 +1,229 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FECheckpoint.h"
+#include "FEModel.h"
+#include "FEMesh.h"
+#include "FEDomain.h"
+#include "DumpMemStream.h"
+
+//-----------------------------------------------------------------------------
+// number of vec3d values stored per node
+const int NODE_VECS = 7;
+
+//-----------------------------------------------------------------------------
+FECheckpoint::FECheckpoint(FEModel* fem) : m_fem(fem)
+{
+	m_bvalid = false;
+	m_model = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+FECheckpoint::~FECheckpoint()
+{
+	Clear();
+}
+
+//-----------------------------------------------------------------------------
+void FECheckpoint::Clear()
+{
+	for (size_t i = 0; i < m_dom.size(); ++i) delete m_dom[i];
+	m_dom.clear();
+	m_active.clear();
+	delete m_model; m_model = nullptr;
+	m_nodeID.clear();
+	m_nodeVec.clear();
+	m_nodeVal.clear();
+	m_nodeOffset.clear();
+	m_bvalid = false;
+}
+
+//-----------------------------------------------------------------------------
+void FECheckpoint::Save()
+{
+	TRACK_TIME(TimerID::Timer_Update);
+
+	// store the mesh data
+	SaveNodes();
+	SaveDomains();
+
+	// store all other model data
+	if (m_model == nullptr) m_model = new DumpMemStream(*m_fem);
+	m_model->reset(true, true);
+	m_fem->SerializeState(*m_model);
+
+	m_bvalid = true;
+}
+
+//-----------------------------------------------------------------------------
+void FECheckpoint::Restore()
+{
+	assert(m_bvalid);
+	if (m_bvalid == false) return;
+
+	TRACK_TIME(TimerID::Timer_Update);
+
+	// The data is restored in the same order as FEModel::Serialize does
+	// for shallow archives.
+	RestoreNodes();
+	RestoreDomains();
+
+	m_model->Open(false, true);
+	m_fem->SerializeState(*m_model);
+}
+
+//-----------------------------------------------------------------------------
+// Copy the nodal data to the contiguous arrays. 
+void FECheckpoint::SaveNodes()
+{
+	FEMesh& mesh = m_fem->GetMesh();
+	int NN = mesh.Nodes();
+
+	// calculate offsets into value array
+	m_nodeOffset.resize(NN + 1);
+	m_nodeOffset[0] = 0;
+	for (int i = 0; i < NN; ++i) m_nodeOffset[i + 1] = m_nodeOffset[i] + 3*mesh.Node(i).dofs();
+
+	m_nodeID.resize(NN);
+	m_nodeVec.resize(NODE_VECS*NN);
+	m_nodeVal.resize(m_nodeOffset[NN]);
+
+#pragma omp parallel for
+	for (int i = 0; i < NN; ++i)
+	{
+		const FENode& node = mesh.Node(i);
+		m_nodeID[i] = node.GetID();
+
+		vec3d* v = &m_nodeVec[NODE_VECS*i];
+		v[0] = node.m_rt;
+		v[1] = node.m_at;
+		v[2] = node.m_rp;
+		v[3] = node.m_vp;
+		v[4] = node.m_ap;
+		v[5] = node.m_dt;
+		v[6] = node.m_dp;
+
+		int n = node.dofs();
+		if (n > 0)
+		{
+			double* d = &m_nodeVal[m_nodeOffset[i]];
+			std::copy(node.m_val_t.begin(), node.m_val_t.end(), d);
+			std::copy(node.m_val_p.begin(), node.m_val_p.end(), d + n);
+			std::copy(node.m_Fr.begin()   , node.m_Fr.end()   , d + 2*n);
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FECheckpoint::RestoreNodes()
+{
+	FEMesh& mesh = m_fem->GetMesh();
+	int NN = mesh.Nodes();
+	assert(NN == (int)m_nodeID.size());
+	if (NN != (int)m_nodeID.size()) return;
+
+#pragma omp parallel for
+	for (int i = 0; i < NN; ++i)
+	{
+		FENode& node = mesh.Node(i);
+		node.SetID(m_nodeID[i]);
+
+		const vec3d* v = &m_nodeVec[NODE_VECS*i];
+		node.m_rt = v[0];
+		node.m_at = v[1];
+		node.m_rp = v[2];
+		node.m_vp = v[3];
+		node.m_ap = v[4];
+		node.m_dt = v[5];
+		node.m_dp = v[6];
+
+		int n = (m_nodeOffset[i + 1] - m_nodeOffset[i]) / 3;
+		assert(n == node.dofs());
+		if ((n > 0) && (n == node.dofs()))
+		{
+			const double* d = &m_nodeVal[m_nodeOffset[i]];
+			std::copy(d        , d +   n, node.m_val_t.begin());
+			std::copy(d + n    , d + 2*n, node.m_val_p.begin());
+			std::copy(d + 2*n  , d + 3*n, node.m_Fr.begin());
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Each domain is written to its own stream, so that this can be done in parallel.
+// A domain that was inactive at the last save and is still inactive did not
+// change, so its stream does not need to be written again.
+void FECheckpoint::SaveDomains()
+{
+	FEMesh& mesh = m_fem->GetMesh();
+	int ND = mesh.Domains();
+
+	// if the domains changed, we start over
+	if ((int)m_dom.size() != ND)
+	{
+		for (size_t i = 0; i < m_dom.size(); ++i) delete m_dom[i];
+		m_dom.assign(ND, nullptr);
+		m_active.assign(ND, true);
+	}
+
+	std::vector<int> dirty;
+	for (int i = 0; i < ND; ++i)
+	{
+		bool bactive = mesh.Domain(i).IsActive();
+		if ((m_dom[i] == nullptr) || bactive || m_active[i]) dirty.push_back(i);
+		m_active[i] = bactive;
+		if (m_dom[i] == nullptr) m_dom[i] = new DumpMemStream(*m_fem);
+	}
+
+	int N = (int)dirty.size();
+#pragma omp parallel for schedule(dynamic, 1)
+	for (int n = 0; n < N; ++n)
+	{
+		int i = dirty[n];
+		DumpMemStream& ar = *m_dom[i];
+		ar.reset(true, true);
+		mesh.Domain(i).Serialize(ar);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FECheckpoint::RestoreDomains()
+{
+	FEMesh& mesh = m_fem->GetMesh();
+	int ND = mesh.Domains();
+	assert(ND == (int)m_dom.size());
+	if (ND != (int)m_dom.size()) return;
+
+#pragma omp parallel for schedule(dynamic, 1)
+	for (int i = 0; i < ND; ++i)
+	{
+		DumpMemStream& ar = *m_dom[i];
+		ar.Open(false, true);
+		mesh.Domain(i).Serialize(ar);
+	}
+}
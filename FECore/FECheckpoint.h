@@ -0,0 +1,86 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "vec3d.h"
+#include "fecore_api.h"
+#include <vector>
+
+class FEModel;
+class DumpMemStream;
+
+//-----------------------------------------------------------------------------
+//! This class stores the state of a model in memory so that it can be restored
+//! when a time step needs to be retried. It stores the same data as a shallow
+//! serialization of the model, but the nodal data is copied into contiguous 
+//! arrays and each domain is written to its own stream, which is done in parallel.
+//! Domains that remained inactive since the last checkpoint are not copied again.
+class FECORE_API FECheckpoint
+{
+public:
+	FECheckpoint(FEModel* fem);
+	~FECheckpoint();
+
+	//! store the current state of the model
+	void Save();
+
+	//! restore the model to the last stored state
+	void Restore();
+
+	//! clear all stored data
+	void Clear();
+
+	//! see if a state was stored
+	bool IsValid() const { return m_bvalid; }
+
+	//! get the model
+	FEModel* GetFEModel() { return m_fem; }
+
+private:
+	void SaveNodes();
+	void RestoreNodes();
+
+	void SaveDomains();
+	void RestoreDomains();
+
+private:
+	FEModel*	m_fem;
+	bool		m_bvalid;
+
+	// nodal data
+	std::vector<int>	m_nodeID;		//!< node IDs
+	std::vector<vec3d>	m_nodeVec;		//!< vector data of nodes
+	std::vector<double>	m_nodeVal;		//!< dof values and nodal forces
+	std::vector<int>	m_nodeOffset;	//!< offset of each node in m_nodeVal
+
+	// domain data
+	std::vector<DumpMemStream*>	m_dom;		//!< one stream per domain
+	std::vector<bool>			m_active;	//!< active flag of domain at last save
+
+	// remaining model data (contact, constraints, steps, etc.)
+	DumpMemStream*	m_model;
+};
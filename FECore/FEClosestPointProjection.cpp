@@ -57,6 +57,15 @@ bool FEClosestPointProjection::Init()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+bool FEClosestPointProjection::Update()
+{
+	m_SNQ.Attach(&m_surf);
+	m_SNQ.Update();
+
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 // helper function for projecting a point onto an edge
 bool Project2Edge(const vec3d& p0, const vec3d& p1, const vec3d& x, vec3d& q)
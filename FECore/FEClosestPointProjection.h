@@ -44,6 +44,10 @@ public:
 	//! Initialization
 	bool Init();
 
+	//! Update search structures after the surface moved. The node-element
+	//! and element neighbor lists only depend on the topology so they are kept.
+	bool Update();
+
 	//! Project a point onto surface
 	FESurfaceElement* Project(const vec3d& x, vec3d& q, vec2d& r);
 
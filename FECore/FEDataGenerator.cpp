@@ -50,6 +50,27 @@ bool FEDataGenerator::Init()
 	return true;
 }
 
+void FEDataGenerator::value(int n, const vec3d* r, double* data)
+{
+	for (int i = 0; i < n; ++i) value(r[i], data[i]);
+}
+
+void FEDataGenerator::value(int n, const vec3d* r, vec3d* data)
+{
+	for (int i = 0; i < n; ++i) value(r[i], data[i]);
+}
+
+// Evaluate the generator at all points r with one call and pass
+// the value of point k to set(k, value).
+template <typename T, class F> static void generate_batch(FEDataGenerator& gen, const vector<vec3d>& r, F set)
+{
+	int n = (int)r.size();
+	if (n == 0) return;
+	vector<T> data(n);
+	gen.value(n, &r[0], &data[0]);
+	for (int k = 0; k < n; ++k) set(k, data[k]);
+}
+
 // generate the data array for the given node set
 bool FEDataGenerator::Generate(FENodeDataMap& map)
 {
@@ -59,6 +80,17 @@ bool FEDataGenerator::Generate(FENodeDataMap& map)
 	vector<double> p(3, 0.0);
 
 	FEDataType dataType = map.DataType();
+
+	// scalar and vector data are evaluated for all nodes at once
+	if ((dataType == FE_DOUBLE) || (dataType == FE_VEC3D))
+	{
+		vector<vec3d> r(N);
+		for (int i = 0; i < N; ++i) r[i] = set.Node(i)->m_r0;
+		if (dataType == FE_DOUBLE) generate_batch<double>(*this, r, [&](int k, double d) { map.setValue(k, d); });
+		else generate_batch<vec3d>(*this, r, [&](int k, const vec3d& v) { map.setValue(k, v); });
+		return true;
+	}
+
 	for (int i = 0; i<N; ++i)
 	{
 		const FENode* ni = set.Node(i);
@@ -88,6 +120,26 @@ bool FEDataGenerator::Generate(FESurfaceMap& map)
 	int N = surf.Faces();
 	map.Create(&surf);
     Init();
+
+	// scalar and vector data are evaluated for all facet nodes at once
+	if ((dataType == FE_DOUBLE) || (dataType == FE_VEC3D))
+	{
+		vector<vec3d> r;
+		vector<pair<int, int> > slot;
+		for (int i = 0; i < N; ++i)
+		{
+			const FEFacetSet::FACET& face = surf.Face(i);
+			for (int j = 0; j < face.ntype; ++j)
+			{
+				r.push_back(mesh.Node(face.node[j]).m_r0);
+				slot.push_back(pair<int, int>(i, j));
+			}
+		}
+		if (dataType == FE_DOUBLE) generate_batch<double>(*this, r, [&](int k, double d) { map.setValue(slot[k].first, slot[k].second, d); });
+		else generate_batch<vec3d>(*this, r, [&](int k, const vec3d& v) { map.setValue(slot[k].first, slot[k].second, v); });
+		return true;
+	}
+
 	for (int i = 0; i<N; ++i)
 	{
 		const FEFacetSet::FACET& face = surf.Face(i);
@@ -118,6 +170,63 @@ bool FEDataGenerator::Generate(FEDomainMap& map)
 
 	FEDataType dataType = map.DataType();
 	int N = set.Elements();
+
+	// Scalar and vector data are evaluated for all points at once. The slot of
+	// each point is (element, local index), with index -1 for per-element data.
+	if ((dataType == FE_DOUBLE) || (dataType == FE_VEC3D))
+	{
+		vector<vec3d> r;
+		vector<pair<int, int> > slot;
+		for (int i = 0; i < N; ++i)
+		{
+			FEElement& el = *mesh.FindElementFromID(set[i]);
+			int ne = el.Nodes();
+			switch (map.StorageFormat())
+			{
+			case FMT_MULT:
+				for (int j = 0; j < ne; ++j)
+				{
+					r.push_back(mesh.Node(el.m_node[j]).m_r0);
+					slot.push_back(pair<int, int>(i, j));
+				}
+				break;
+			case FMT_ITEM:
+			{
+				// element center
+				vec3d c(0, 0, 0);
+				for (int j = 0; j < ne; ++j) c += mesh.Node(el.m_node[j]).m_r0;
+				c /= ne;
+				r.push_back(c);
+				slot.push_back(pair<int, int>(i, -1));
+			}
+			break;
+			case FMT_MATPOINTS:
+				for (int j = 0; j < el.GaussPoints(); ++j)
+				{
+					r.push_back(el.GetMaterialPoint(j)->m_r0);
+					slot.push_back(pair<int, int>(i, j));
+				}
+				break;
+			}
+		}
+
+		if (dataType == FE_DOUBLE)
+		{
+			generate_batch<double>(*this, r, [&](int k, double d) {
+				if (slot[k].second < 0) map.setValue(slot[k].first, d);
+				else map.setValue(slot[k].first, slot[k].second, d);
+			});
+		}
+		else
+		{
+			generate_batch<vec3d>(*this, r, [&](int k, const vec3d& v) {
+				if (slot[k].second < 0) map.setValue(slot[k].first, v);
+				else map.setValue(slot[k].first, slot[k].second, v);
+			});
+		}
+		return true;
+	}
+
 	for (int i = 0; i<N; ++i)
 	{
 		FEElement& el = *mesh.FindElementFromID(set[i]);
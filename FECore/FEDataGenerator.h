@@ -68,4 +68,10 @@ public:
 	virtual void value(const vec3d& r, vec3d& data) {}
 	virtual void value(const vec3d& r, mat3d& data) {}
     virtual void value(const vec3d& r, mat3ds& data) {}
+
+	// Evaluate scalar or vector data at n points at once. The default implementation
+	// calls the function above for each point. Overload these when the data can be
+	// evaluated more efficiently for many points together.
+	virtual void value(int n, const vec3d* r, double* data);
+	virtual void value(int n, const vec3d* r, vec3d* data);
 };
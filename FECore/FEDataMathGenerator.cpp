@@ -92,3 +92,34 @@ void FEDataMathGenerator::value(const vec3d& r, vec3d& data)
 	data.y = m_val[1].value_s(p);
 	data.z = m_val[2].value_s(p);
 }
+
+// the expressions are evaluated for all points with the batched (compiled) evaluation
+void FEDataMathGenerator::value(int n, const vec3d* r, double* data)
+{
+	vector<double> p(3 * n);
+	for (int k = 0; k < n; ++k)
+	{
+		p[k        ] = r[k].x;
+		p[k +     n] = r[k].y;
+		p[k + 2 * n] = r[k].z;
+	}
+	assert(m_val.size() == 1);
+	m_val[0].value_s(n, &p[0], data);
+}
+
+void FEDataMathGenerator::value(int n, const vec3d* r, vec3d* data)
+{
+	vector<double> p(3 * n);
+	for (int k = 0; k < n; ++k)
+	{
+		p[k        ] = r[k].x;
+		p[k +     n] = r[k].y;
+		p[k + 2 * n] = r[k].z;
+	}
+	assert(m_val.size() <= 3);
+	vector<double> x(n), y(n), z(n);
+	m_val[0].value_s(n, &p[0], &x[0]);
+	m_val[1].value_s(n, &p[0], &y[0]);
+	m_val[2].value_s(n, &p[0], &z[0]);
+	for (int k = 0; k < n; ++k) data[k] = vec3d(x[k], y[k], z[k]);
+}
@@ -48,6 +48,8 @@ public:
 private:
 	void value(const vec3d& r, double& data) override;
 	void value(const vec3d& r, vec3d& data) override;
+	void value(int n, const vec3d* r, double* data) override;
+	void value(int n, const vec3d* r, vec3d* data) override;
 
 private:
 	std::string			m_math;
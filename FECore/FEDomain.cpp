@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "DumpStream.h"
 #include "FEMesh.h"
 #include "FEGlobalMatrix.h"
+#include "FELinearSystem.h"
 
 //-----------------------------------------------------------------------------
 FEDomain::FEDomain(int nclass, FEModel* fem) : FEMeshPartition(nclass, fem)
@@ -57,6 +58,10 @@ void FEDomain::CreateMaterialPointData()
 {
 	FEMaterial* pmat = GetMaterial();
 	FEMesh* mesh = GetMesh();
+
+	// allocate the material points from the pool, so that they are stored
+	// contiguously in element order
+	FEMaterialPointPool::Scope scope(m_mpPool);
 	if (pmat) ForEachElement([=](FEElement& el) {
 
 		vec3d r[FEElement::MAX_NODES];
@@ -118,6 +123,8 @@ void FEDomain::Serialize(DumpStream& ar)
 			int NEL = 0;
 			ar >> NEL;
 			Create(NEL, espec);
+
+			FEMaterialPointPool::Scope scope(m_mpPool);
 			for (int i = 0; i < NEL; ++i)
 			{
 				FEElement& el = ElementRef(i);
@@ -161,7 +168,7 @@ void FEDomain::UnpackLM(FEElement& el, const FEDofList& dof, vector<int>& lm)
 	{
 		int n = el.m_node[i];
 		FENode& node = mesh->Node(n);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 		for (int j = 0; j<ndofs; ++j) lm[i*ndofs + j] = id[dof[j]];
 	}
 }
@@ -196,3 +203,126 @@ void FEDomain::Activate(const FEDofList& dof)
 		}
 	}
 }
+
+//-----------------------------------------------------------------------------
+// Greedy coloring of the element-node graph. Each element gets the lowest color
+// that is not used yet by any of the elements that share a node with it.
+void FEDomain::ColorElements()
+{
+	m_colorElem.clear();
+	m_colorStart.clear();
+
+	const int NE = Elements();
+	if (NE == 0) return;
+
+	// colors that are already used by the elements attached to each node
+	FEMesh& mesh = *GetMesh();
+	vector< vector<int> > nodeColors(mesh.Nodes());
+
+	vector<int> elemColor(NE, -1);
+	vector<int> tag;
+	int ncolors = 0;
+	for (int i = 0; i < NE; ++i)
+	{
+		FEElement& el = ElementRef(i);
+		int ne = el.Nodes();
+
+		// tag the colors used by the neighbors
+		for (int j = 0; j < ne; ++j)
+		{
+			const vector<int>& nc = nodeColors[el.m_node[j]];
+			for (int k = 0; k < (int)nc.size(); ++k) tag[nc[k]] = i;
+		}
+
+		// find the first available color
+		int c = 0;
+		while ((c < ncolors) && (tag[c] == i)) c++;
+		if (c == ncolors) { ncolors++; tag.push_back(-1); }
+		elemColor[i] = c;
+
+		for (int j = 0; j < ne; ++j) nodeColors[el.m_node[j]].push_back(c);
+	}
+
+	// sort the elements by color (preserving element order within each color)
+	m_colorStart.assign(ncolors + 1, 0);
+	for (int i = 0; i < NE; ++i) m_colorStart[elemColor[i] + 1]++;
+	for (int c = 0; c < ncolors; ++c) m_colorStart[c + 1] += m_colorStart[c];
+
+	m_colorElem.resize(NE);
+	vector<int> pos(m_colorStart.begin(), m_colorStart.end() - 1);
+	for (int i = 0; i < NE; ++i) m_colorElem[pos[elemColor[i]]++] = i;
+}
+
+//-----------------------------------------------------------------------------
+int FEDomain::ElementColors() const
+{
+	return (m_colorStart.empty() ? 0 : (int)m_colorStart.size() - 1);
+}
+
+//-----------------------------------------------------------------------------
+void FEDomain::ParallelElementLoop(FELinearSystem& LS, std::function<void(int iel)> f)
+{
+	const int NE = Elements();
+
+	// we can only use the coloring if it is still up to date
+	if (LS.ColoredAssembly() && (ElementColors() > 0) && ((int)m_colorElem.size() == NE))
+	{
+		LS.BeginColoredAssembly();
+		const int ncolors = ElementColors();
+		for (int c = 0; c < ncolors; ++c)
+		{
+			const int n0 = m_colorStart[c];
+			const int n1 = m_colorStart[c + 1];
+			#pragma omp parallel for
+			for (int i = n0; i < n1; ++i) f(m_colorElem[i]);
+		}
+		LS.EndColoredAssembly();
+	}
+	else
+	{
+		#pragma omp parallel for
+		for (int i = 0; i < NE; ++i) f(i);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FEDomain::ParallelElementBatchLoop(FELinearSystem& LS, int nbatch, std::function<void(const int* iel, int n)> f)
+{
+	const int MAX_BATCH = 64;
+	assert((nbatch > 0) && (nbatch <= MAX_BATCH));
+	const int NE = Elements();
+
+	// we can only use the coloring if it is still up to date
+	if (LS.ColoredAssembly() && (ElementColors() > 0) && ((int)m_colorElem.size() == NE))
+	{
+		LS.BeginColoredAssembly();
+		const int ncolors = ElementColors();
+		for (int c = 0; c < ncolors; ++c)
+		{
+			const int n0 = m_colorStart[c];
+			const int n1 = m_colorStart[c + 1];
+			const int nb = (n1 - n0 + nbatch - 1) / nbatch;
+			#pragma omp parallel for
+			for (int b = 0; b < nb; ++b)
+			{
+				int i0 = n0 + b*nbatch;
+				int n = (i0 + nbatch <= n1 ? nbatch : n1 - i0);
+				f(&m_colorElem[i0], n);
+			}
+		}
+		LS.EndColoredAssembly();
+	}
+	else
+	{
+		const int nb = (NE + nbatch - 1) / nbatch;
+		#pragma omp parallel for
+		for (int b = 0; b < nb; ++b)
+		{
+			int iel[MAX_BATCH];
+			int i0 = b*nbatch;
+			int n = (i0 + nbatch <= NE ? nbatch : NE - i0);
+			for (int i = 0; i < n; ++i) iel[i] = i0 + i;
+			f(iel, n);
+		}
+	}
+}
@@ -28,9 +28,12 @@ SOFTWARE.*/
 
 #pragma once
 #include "FEMeshPartition.h"
+#include "FEMaterialPointPool.h"
+#include <functional>
 
 // forward declaration of material class
 class FEMaterial;
+class FELinearSystem;
 
 // Base class for solid and shell parts. Domains can also have materials assigned.
 class FECORE_API FEDomain : public FEMeshPartition
@@ -50,6 +53,7 @@ public:
 	//! Allocate material point data for the elements
 	//! This is called after elements get read in from the input file.
 	//! And must be called before material point data can be accessed.
+	//! The data is allocated from the domain's material point pool.
 	//! \todo Perhaps I can make this part of the "creation" routine
 	void CreateMaterialPointData();
 
@@ -77,10 +81,35 @@ public:
 	//! Activate the domain
 	virtual void Activate();
 
+public:
+	//! Color the elements such that elements of the same color do not share nodes.
+	//! This is called by FEGlobalMatrix::Create when colored assembly is requested.
+	void ColorElements();
+
+	//! return the number of element colors (zero if the domain was not colored)
+	int ElementColors() const;
+
+	//! Loop over all elements in parallel and call f with the element index. 
+	//! If the linear system uses colored assembly, the elements of each color are
+	//! processed concurrently and f can assemble into LS without atomics or locks.
+	void ParallelElementLoop(FELinearSystem& LS, std::function<void(int iel)> f);
+
+	//! Same as ParallelElementLoop, but f is called with batches of up to nbatch element
+	//! indices. All elements of a batch have the same color when colored assembly is used.
+	void ParallelElementBatchLoop(FELinearSystem& LS, int nbatch, std::function<void(const int* iel, int n)> f);
+
 protected:
 	// helper function for activating dof lists
 	void Activate(const FEDofList& dof);
 
 	// helper function for unpacking element dofs
 	void UnpackLM(FEElement& el, const FEDofList& dof, vector<int>& lm);
+
+private:
+	// NOTE: The elements are members of the derived classes, so their material
+	// points are deleted before the pool is destroyed.
+	FEMaterialPointPool	m_mpPool;	//!< storage for the material point data
+
+	vector<int>	m_colorElem;	//!< element indices, sorted by color
+	vector<int>	m_colorStart;	//!< start index of each color in m_colorElem
 };
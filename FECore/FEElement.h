@@ -59,6 +59,9 @@ public:
 	//! create 
 	void Create(int n) { m_data.assign(n, static_cast<FEMaterialPoint*>(0) ); }
 
+	//! nr of material points
+	int size() const { return (int) m_data.size(); }
+
 	//! operator for easy access to element data
 	FEMaterialPoint*& operator [] (int n) { return m_data[n]; }
 
@@ -155,6 +158,9 @@ public:
 	//! Get the material point data
 	FEMaterialPoint* GetMaterialPoint(int n) { return m_State[n]; }
 
+	//! number of material points that were allocated
+	int MaterialPoints() const { return m_State.size(); }
+
 	//! set the material point data
 	void SetMaterialPointData(FEMaterialPoint* pmp, int n)
 	{ 
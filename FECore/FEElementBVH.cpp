@@ -0,0 +1,270 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEElementBVH.h"
+#include "FEMesh.h"
+#include "FESolidDomain.h"
+#include <algorithm>
+
+//-----------------------------------------------------------------------------
+FEElementBVH::FEElementBVH(FEMesh* mesh, Configuration cfg) : m_mesh(mesh), m_cfg(cfg)
+{
+}
+
+//-----------------------------------------------------------------------------
+// calculate the (slightly inflated) bounding box of element i
+void FEElementBVH::ElementBox(int i, vec3d& bmin, vec3d& bmax) const
+{
+	const FESolidElement& el = *m_elem[i];
+	int neln = el.Nodes();
+	for (int j = 0; j < neln; ++j)
+	{
+		const FENode& node = m_mesh->Node(el.m_node[j]);
+		const vec3d& x = (m_cfg == REFERENCE ? node.m_r0 : node.m_rt);
+		if (j == 0) { bmin = bmax = x; }
+		else
+		{
+			if (x.x < bmin.x) bmin.x = x.x; if (x.x > bmax.x) bmax.x = x.x;
+			if (x.y < bmin.y) bmin.y = x.y; if (x.y > bmax.y) bmax.y = x.y;
+			if (x.z < bmin.z) bmin.z = x.z; if (x.z > bmax.z) bmax.z = x.z;
+		}
+	}
+
+	// inflate the box a little so that points on element faces are not missed
+	double R = (bmax - bmin).norm();
+	double eps = (R > 0 ? R*1e-6 : 1e-12);
+	bmin -= vec3d(eps, eps, eps);
+	bmax += vec3d(eps, eps, eps);
+}
+
+//-----------------------------------------------------------------------------
+void FEElementBVH::Build()
+{
+	m_elem.clear();
+	m_node.clear();
+	m_index.clear();
+
+	// collect all solid elements
+	for (int i = 0; i < m_mesh->Domains(); ++i)
+	{
+		FESolidDomain* dom = dynamic_cast<FESolidDomain*>(&m_mesh->Domain(i));
+		if (dom)
+		{
+			int NE = dom->Elements();
+			for (int j = 0; j < NE; ++j) m_elem.push_back(&dom->Element(j));
+		}
+	}
+
+	int NE = (int)m_elem.size();
+	if (NE == 0) return;
+
+	m_emin.resize(NE);
+	m_emax.resize(NE);
+#pragma omp parallel for
+	for (int i = 0; i < NE; ++i) ElementBox(i, m_emin[i], m_emax[i]);
+
+	m_index.resize(NE);
+	for (int i = 0; i < NE; ++i) m_index[i] = i;
+
+	// a balanced binary tree has at most 2*NE - 1 nodes
+	m_node.reserve(2 * NE);
+	BuildNode(0, NE);
+}
+
+//-----------------------------------------------------------------------------
+// Build the node that contains the elements m_index[first, first + count).
+// Nodes are stored such that children always come after their parent.
+int FEElementBVH::BuildNode(int first, int count)
+{
+	const int MAX_LEAF_SIZE = 8;
+
+	int nid = (int)m_node.size();
+	m_node.push_back(Node());
+
+	// calculate bounding box and the box of the element centroids
+	vec3d bmin = m_emin[m_index[first]], bmax = m_emax[m_index[first]];
+	vec3d cmin = (bmin + bmax)*0.5, cmax = cmin;
+	for (int i = first; i < first + count; ++i)
+	{
+		const vec3d& a = m_emin[m_index[i]];
+		const vec3d& b = m_emax[m_index[i]];
+		bmin.x = std::min(bmin.x, a.x); bmax.x = std::max(bmax.x, b.x);
+		bmin.y = std::min(bmin.y, a.y); bmax.y = std::max(bmax.y, b.y);
+		bmin.z = std::min(bmin.z, a.z); bmax.z = std::max(bmax.z, b.z);
+
+		vec3d c = (a + b)*0.5;
+		cmin.x = std::min(cmin.x, c.x); cmax.x = std::max(cmax.x, c.x);
+		cmin.y = std::min(cmin.y, c.y); cmax.y = std::max(cmax.y, c.y);
+		cmin.z = std::min(cmin.z, c.z); cmax.z = std::max(cmax.z, c.z);
+	}
+
+	Node node;
+	node.bmin = bmin;
+	node.bmax = bmax;
+	node.left = node.right = -1;
+	node.first = first;
+	node.count = count;
+
+	vec3d d = cmax - cmin;
+	if ((count > MAX_LEAF_SIZE) && (d.norm() > 0))
+	{
+		// split at the median of the longest axis
+		int axis = 0;
+		if ((d.y >= d.x) && (d.y >= d.z)) axis = 1;
+		else if ((d.z >= d.x) && (d.z >= d.y)) axis = 2;
+
+		const std::vector<vec3d>& emin = m_emin;
+		const std::vector<vec3d>& emax = m_emax;
+		int mid = first + count / 2;
+		std::nth_element(m_index.begin() + first, m_index.begin() + mid, m_index.begin() + first + count, [&](int a, int b) {
+			vec3d ca = emin[a] + emax[a];
+			vec3d cb = emin[b] + emax[b];
+			if (axis == 0) return ca.x < cb.x;
+			else if (axis == 1) return ca.y < cb.y;
+			return ca.z < cb.z;
+		});
+
+		node.count = 0;
+		node.left = BuildNode(first, mid - first);
+		node.right = BuildNode(mid, first + count - mid);
+	}
+
+	m_node[nid] = node;
+	return nid;
+}
+
+//-----------------------------------------------------------------------------
+void FEElementBVH::Refit()
+{
+	int NE = (int)m_elem.size();
+	if (NE == 0) return;
+
+#pragma omp parallel for
+	for (int i = 0; i < NE; ++i) ElementBox(i, m_emin[i], m_emax[i]);
+
+	// children are stored after their parents, so a reverse sweep
+	// updates the children before their parents.
+	for (int n = (int)m_node.size() - 1; n >= 0; --n)
+	{
+		Node& node = m_node[n];
+		if (node.left == -1)
+		{
+			node.bmin = m_emin[m_index[node.first]];
+			node.bmax = m_emax[m_index[node.first]];
+			for (int i = node.first + 1; i < node.first + node.count; ++i)
+			{
+				const vec3d& a = m_emin[m_index[i]];
+				const vec3d& b = m_emax[m_index[i]];
+				node.bmin.x = std::min(node.bmin.x, a.x); node.bmax.x = std::max(node.bmax.x, b.x);
+				node.bmin.y = std::min(node.bmin.y, a.y); node.bmax.y = std::max(node.bmax.y, b.y);
+				node.bmin.z = std::min(node.bmin.z, a.z); node.bmax.z = std::max(node.bmax.z, b.z);
+			}
+		}
+		else
+		{
+			const Node& l = m_node[node.left];
+			const Node& r = m_node[node.right];
+			node.bmin = vec3d(std::min(l.bmin.x, r.bmin.x), std::min(l.bmin.y, r.bmin.y), std::min(l.bmin.z, r.bmin.z));
+			node.bmax = vec3d(std::max(l.bmax.x, r.bmax.x), std::max(l.bmax.y, r.bmax.y), std::max(l.bmax.z, r.bmax.z));
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// do the exact test for an element
+bool FEElementBVH::IsInside(const FESolidElement& el, const vec3d& y, double r[3]) const
+{
+	FESolidDomain* dom = dynamic_cast<FESolidDomain*>(el.GetMeshPartition());
+	if (dom == nullptr) return false;
+
+	FESolidElement& e = const_cast<FESolidElement&>(el);
+	if (m_cfg == REFERENCE) return dom->ProjectToReferenceElement(e, y, r);
+
+	dom->ProjectToElement(e, y, r);
+	return FESolidDomain::IsInsideElement(el, r);
+}
+
+//-----------------------------------------------------------------------------
+FESolidElement* FEElementBVH::FindElement(const vec3d& y, double r[3], const FEMeshPartition* dom) const
+{
+	if (m_node.empty()) return nullptr;
+
+	// traverse the tree
+	int stack[128];
+	int ns = 0;
+	stack[ns++] = 0;
+	while (ns > 0)
+	{
+		const Node& node = m_node[stack[--ns]];
+		if ((y.x < node.bmin.x) || (y.x > node.bmax.x) ||
+			(y.y < node.bmin.y) || (y.y > node.bmax.y) ||
+			(y.z < node.bmin.z) || (y.z > node.bmax.z)) continue;
+
+		if (node.left == -1)
+		{
+			for (int i = node.first; i < node.first + node.count; ++i)
+			{
+				int n = m_index[i];
+				const vec3d& a = m_emin[n];
+				const vec3d& b = m_emax[n];
+				if ((y.x < a.x) || (y.x > b.x) ||
+					(y.y < a.y) || (y.y > b.y) ||
+					(y.z < a.z) || (y.z > b.z)) continue;
+
+				FESolidElement* pe = m_elem[n];
+				if (dom && (pe->GetMeshPartition() != dom)) continue;
+
+				if (IsInside(*pe, y, r)) return pe;
+			}
+		}
+		else
+		{
+			assert(ns + 2 <= 128);
+			stack[ns++] = node.right;
+			stack[ns++] = node.left;
+		}
+	}
+
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void FEElementBVH::FindElements(const std::vector<vec3d>& y, std::vector<FESolidElement*>& el, std::vector<vec3d>& r, const FEMeshPartition* dom) const
+{
+	int N = (int)y.size();
+	el.assign(N, nullptr);
+	r.assign(N, vec3d(0, 0, 0));
+
+#pragma omp parallel for schedule(dynamic, 64)
+	for (int i = 0; i < N; ++i)
+	{
+		double q[3] = { 0, 0, 0 };
+		el[i] = FindElement(y[i], q, dom);
+		r[i] = vec3d(q[0], q[1], q[2]);
+	}
+}
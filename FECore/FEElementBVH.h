@@ -0,0 +1,94 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "vec3d.h"
+#include "fecore_api.h"
+#include <vector>
+
+class FEMesh;
+class FEMeshPartition;
+class FESolidElement;
+
+//-----------------------------------------------------------------------------
+//! Bounding volume hierarchy over the solid elements of a mesh. This is used to 
+//! find the element that contains a point. The hierarchy can be built in the 
+//! reference or the current configuration. When the mesh deforms, the tree can be 
+//! refitted, which updates the bounding boxes but keeps the tree topology.
+class FECORE_API FEElementBVH
+{
+public:
+	enum Configuration {
+		REFERENCE,		//!< use reference nodal coordinates
+		CURRENT			//!< use current nodal coordinates
+	};
+
+public:
+	FEElementBVH(FEMesh* mesh, Configuration cfg);
+
+	//! build the tree over all solid elements of the mesh
+	void Build();
+
+	//! update the bounding boxes after the nodes moved
+	void Refit();
+
+	//! number of elements in the tree
+	int Elements() const { return (int)m_elem.size(); }
+
+	//! configuration this tree was built for
+	Configuration GetConfiguration() const { return m_cfg; }
+
+	//! find the element that contains point y and return its natural coordinates in r.
+	//! If dom is not null, only elements of that domain are considered.
+	FESolidElement* FindElement(const vec3d& y, double r[3], const FEMeshPartition* dom = nullptr) const;
+
+	//! Locate a batch of points. This is done in parallel. 
+	//! On return, el[i] is the element containing y[i] (or null) and r[i] its natural coordinates.
+	void FindElements(const std::vector<vec3d>& y, std::vector<FESolidElement*>& el, std::vector<vec3d>& r, const FEMeshPartition* dom = nullptr) const;
+
+private:
+	struct Node
+	{
+		vec3d	bmin, bmax;		//!< bounding box
+		int		left, right;	//!< child nodes (-1 for leaves)
+		int		first, count;	//!< range of elements (in m_index) of a leaf
+	};
+
+	void ElementBox(int i, vec3d& bmin, vec3d& bmax) const;
+	int BuildNode(int first, int count);
+	bool IsInside(const FESolidElement& el, const vec3d& y, double r[3]) const;
+
+private:
+	FEMesh*			m_mesh;
+	Configuration	m_cfg;
+
+	std::vector<FESolidElement*>	m_elem;		//!< the elements
+	std::vector<vec3d>				m_emin;		//!< element box (min corner)
+	std::vector<vec3d>				m_emax;		//!< element box (max corner)
+	std::vector<int>				m_index;	//!< element order used by the leaves
+	std::vector<Node>				m_node;		//!< tree nodes (m_node[0] is the root)
+};
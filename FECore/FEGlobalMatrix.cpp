@@ -90,6 +90,9 @@ FEGlobalMatrix::FEGlobalMatrix(SparseMatrix* pK, bool del)
 	m_pMP = 0;
 	m_nlm = 0;
 	m_delA = del;
+	m_bcolored = false;
+	m_benvelope = false;
+	m_pMPd = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -99,6 +102,7 @@ FEGlobalMatrix::~FEGlobalMatrix()
 	if (m_delA) delete m_pA;
 	m_pA = 0;
 	if (m_pMP) delete m_pMP;
+	if (m_pMPd) delete m_pMPd;
 }
 
 //-----------------------------------------------------------------------------
@@ -182,9 +186,27 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 	// reconstructing it every time we come here saves us a lot of time. The 
 	// static profile is stored in the variable m_MPs.
 
-	// begin building the profile
-	build_begin(neq);
+	// When building an envelope, we hold on to the old profile
+	SparseMatrixProfile* pMPold = 0;
+	if ((breset == false) && m_benvelope && m_pMP && (m_pMP->Rows() == neq))
+	{
+		pMPold = m_pMP;
+		m_pMP = 0;
+	}
+
+	if ((breset == false) && m_pMPd && (m_pMPd->Rows() == neq))
+	{
+		// The profile was already built in ProfileFits, so we just use that one.
+		if (m_pMP) delete m_pMP;
+		m_pMP = m_pMPd;
+		m_pMPd = 0;
+		m_nlm = 0;
+	}
+	else
 	{
+		// begin building the profile
+		build_begin(neq);
+
 		// The first time we are here we construct the "static"
 		// profile. This profile contains the contribution from
 		// all static elements. A static element is defined as
@@ -203,6 +225,14 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 			// Make sure the LM buffer is flushed first.
 			build_flush();
 			m_MPs = *m_pMP;
+
+			// The element connectivity only changes when the static profile
+			// is rebuilt, so this is a good time to (re)color the domains.
+			if (m_bcolored)
+			{
+				FEMesh& mesh = pfem->GetMesh();
+				for (int i = 0; i < mesh.Domains(); ++i) mesh.Domain(i).ColorElements();
+			}
 		}
 		else
 		{
@@ -213,6 +243,16 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 		// Add the "dynamic" profile
 		pfem->BuildMatrixProfile(*this, false);
 	}
+	if (m_pMPd) { delete m_pMPd; m_pMPd = 0; }
+
+	// add the entries of the old profile
+	if (pMPold)
+	{
+		if (m_nlm > 0) build_flush();
+		m_pMP->Merge(*pMPold);
+		delete pMPold;
+	}
+
 	// All done! We can now finish building the profile and create 
 	// the actual sparse matrix. This is done in the following function
 	build_end();
@@ -220,6 +260,33 @@ bool FEGlobalMatrix::Create(FEModel* pfem, int neq, bool breset)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+bool FEGlobalMatrix::ProfileFits(FEModel* pfem, int neq)
+{
+	if (m_pMPd) { delete m_pMPd; m_pMPd = 0; }
+
+	// we need a matrix and a static profile to start from
+	if ((m_pMP == 0) || (m_pMP->Rows() != neq) || (m_MPs.Rows() != neq)) return false;
+	if (m_pA->NonZeroes() == 0) return false;
+
+	// build the new profile from the static profile and the "dynamic" profile
+	SparseMatrixProfile* pMPold = m_pMP;
+	m_pMP = new SparseMatrixProfile(m_MPs);
+	m_nlm = 0;
+	pfem->BuildMatrixProfile(*this, false);
+	if (m_nlm > 0) build_flush();
+
+	// see if the new profile is contained in the current one
+	bool bfit = m_pMP->IsSubsetOf(*pMPold);
+
+	// if it does not fit, keep the new profile so Create doesn't have to rebuild it.
+	if (bfit) delete m_pMP;
+	else m_pMPd = m_pMP;
+	m_pMP = pMPold;
+
+	return bfit;
+}
+
 //-----------------------------------------------------------------------------
 //! Constructs the stiffness matrix from a FEMesh object. 
 bool FEGlobalMatrix::Create(FEMesh& mesh, int neq)
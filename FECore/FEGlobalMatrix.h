@@ -153,6 +153,23 @@ public:
 	//! get the sparse matrix profile
 	SparseMatrixProfile* GetSparseMatrixProfile() { return m_pMP; }
 
+	//! Turn graph-colored element assembly on or off. When on, the domains are colored
+	//! when the matrix profile is (re)built in Create.
+	void SetColoredAssembly(bool b) { m_bcolored = b; }
+
+	//! see if colored element assembly is used
+	bool ColoredAssembly() const { return m_bcolored; }
+
+	//! Build the profile of the model and see if it fits in the structure of the 
+	//! current sparse matrix. Only the dynamic profile is rebuilt. If the profile
+	//! does not fit, the new profile is kept and used by the next call to Create.
+	bool ProfileFits(FEModel* pfem, int neq);
+
+	//! When on, the entries of the previous profile are kept when only the dynamic 
+	//! profile is rebuilt. This way the profile grows into an envelope of all 
+	//! contact pairings seen so far.
+	void SetProfileEnvelope(bool b) { m_benvelope = b; }
+
 public:
 	void build_begin(int neq);
 	void build_add(std::vector<int>& lm);
@@ -162,12 +179,15 @@ public:
 protected:
 	SparseMatrix*	m_pA;	//!< the actual global stiffness matrix
 	bool			m_delA;	//!< delete A in destructor
+	bool			m_bcolored;	//!< use graph-colored element assembly
+	bool			m_benvelope;	//!< keep previous profile entries when rebuilding the dynamic profile
 
 	// The following data structures are used to incrementally
 	// build the profile of the sparse matrix
 
 	SparseMatrixProfile*	m_pMP;		//!< profile of sparse matrix
 	SparseMatrixProfile		m_MPs;		//!< the "static" part of the matrix profile
+	SparseMatrixProfile*	m_pMPd;		//!< new profile that was built by ProfileFits
 	vector< vector<int> >	m_LM;		//!< used for building the stiffness matrix
 	int	m_nlm;				//!< nr of elements in m_LM array
 };
@@ -206,6 +206,7 @@ bool FELinearSolver::SolveStep()
 	vector<double> u(m_neq);
 	{
 		TRACK_TIME(TimerID::Timer_LinSolve);
+		FE_PROFILE_SCOPE(GetFEModel(), "back solve");
 		if (m_pls->BackSolve(u, m_R) == false)
 			throw LinearSolverFailed();
 	}
@@ -262,6 +263,7 @@ bool FELinearSolver::ReformStiffness()
 	// factorize the stiffness matrix
 	{
 		TRACK_TIME(TimerID::Timer_LinSolve);
+		FE_PROFILE_SCOPE(GetFEModel(), "numeric factorization");
 		m_pls->Factor();
 	}
 
@@ -300,6 +302,7 @@ bool FELinearSolver::CreateStiffness()
 	// Do the preprocessing of the solver
 	{
 		TRACK_TIME(TimerID::Timer_LinSolve);
+		FE_PROFILE_SCOPE(GetFEModel(), "symbolic factorization");
 		if (!m_pls->PreProcess()) throw FatalError();
 	}
 
@@ -35,6 +35,7 @@ SOFTWARE.*/
 FELinearSystem::FELinearSystem(FESolver* solver, FEGlobalMatrix& K, vector<double>& F, vector<double>& u, bool bsymm) : m_K(K), m_F(F), m_u(u), m_solver(solver)
 {
 	m_bsymm = bsymm;
+	m_bcolored = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -57,6 +58,35 @@ FESolver* FELinearSystem::GetSolver()
 	return m_solver;
 }
 
+//-----------------------------------------------------------------------------
+// see if the global matrix was set up for colored element assembly
+// NOTE: Linear constraints can couple nodes of elements of the same color, so
+// colored assembly cannot be used when there are linear constraints.
+bool FELinearSystem::ColoredAssembly() const
+{
+	if (m_K.ColoredAssembly() == false) return false;
+	FEModel* fem = m_solver->GetFEModel();
+	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
+	return (LCM.LinearConstraints() == 0);
+}
+
+//-----------------------------------------------------------------------------
+// Elements of the same color don't share any nodes, so they write to different
+// matrix entries and different entries of m_F. We can therefore turn off the
+// atomic updates in the sparse matrix.
+void FELinearSystem::BeginColoredAssembly()
+{
+	m_bcolored = true;
+	m_K.GetSparseMatrixPtr()->SetAtomicAssembly(false);
+}
+
+//-----------------------------------------------------------------------------
+void FELinearSystem::EndColoredAssembly()
+{
+	m_K.GetSparseMatrixPtr()->SetAtomicAssembly(true);
+	m_bcolored = false;
+}
+
 //-----------------------------------------------------------------------------
 //! assemble global stiffness matrix
 void FELinearSystem::Assemble(const FEElementMatrix& ke)
@@ -88,8 +118,12 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 				if (I >= 0)
 				{
 					// dof i is not a prescribed degree of freedom
+					if (m_bcolored) m_F[I] -= ke[i][j] * m_u[J];
+					else
+					{
 #pragma omp atomic
-					m_F[I] -= ke[i][j] * m_u[J];
+						m_F[I] -= ke[i][j] * m_u[J];
+					}
 				}
 			}
 
@@ -98,16 +132,16 @@ void FELinearSystem::Assemble(const FEElementMatrix& ke)
 		}
 	}
 
-#pragma omp critical
-	{
+	// The linear constraints can couple to any equation, so this still needs to be
+	// done in a critical section, but only when there are constraints. 
 	FEModel* fem = m_solver->GetFEModel();
 	FELinearConstraintManager& LCM = fem->GetLinearConstraintManager();
 	if (LCM.LinearConstraints())
 	{
 		const vector<int>& en = ke.Nodes();
+		#pragma omp critical
 		LCM.AssembleStiffness(m_K, m_F, m_u, en, lmi, lmj, ke);
 	}
-	} // omp critical
 }
 
 //-----------------------------------------------------------------------------
@@ -56,6 +56,14 @@ public:
 	// Get the solver that is using this linear system
 	FESolver* GetSolver();
 
+	// see if the global matrix was set up for colored element assembly
+	bool ColoredAssembly() const;
+
+	// Call these before and after a loop over elements of the same color.
+	// In between, Assemble is not thread-safe for elements that share nodes!
+	void BeginColoredAssembly();
+	void EndColoredAssembly();
+
 public:
 	// Assembly routine
 	// This assembles the element stiffness matrix ke into the global matrix.
@@ -71,6 +79,7 @@ public:
 
 protected:
 	bool			m_bsymm;	//!< symmetry flag
+	bool			m_bcolored;	//!< inside a colored assembly loop
 	FESolver*		m_solver;
 	FEGlobalMatrix& m_K;	//!< The global stiffness matrix
 	vector<double>&	m_F;	//!< Contributions from prescribed degrees of freedom
@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FEMaterialPoint.h"
 #include "DumpStream.h"
+#include "FEMaterialPointPool.h"
 #include <string.h>
 
 FEMaterialPoint::FEMaterialPoint(FEMaterialPoint* ppt)
@@ -45,6 +46,16 @@ FEMaterialPoint::~FEMaterialPoint()
 	m_pNext = m_pPrev = 0;
 }
 
+void* FEMaterialPoint::operator new(size_t size)
+{
+	return FEMaterialPointPool::Allocate(size);
+}
+
+void FEMaterialPoint::operator delete(void* p)
+{
+	FEMaterialPointPool::Release(p);
+}
+
 void FEMaterialPoint::SetPrev(FEMaterialPoint* pt)
 {
 	m_pPrev = pt;
@@ -50,6 +50,10 @@ public:
 	FEMaterialPoint(FEMaterialPoint* ppt = 0);
 	virtual ~FEMaterialPoint();
 
+	//! Material point data is allocated from the active FEMaterialPointPool (if any)
+	static void* operator new(size_t size);
+	static void operator delete(void* p);
+
 public:
 	//! The init function is used to intialize data
 	virtual void Init();
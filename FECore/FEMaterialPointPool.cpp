@@ -0,0 +1,148 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "FEMaterialPointPool.h"
+#include <new>
+#include <assert.h>
+
+// Each allocation is preceded by a header that stores the pool it came from
+// (or null for heap allocations) and the size of the allocation.
+// The header size keeps the data aligned.
+struct ALLOC_HEADER
+{
+	FEMaterialPointPool*	pool;
+	size_t					size;
+};
+static const size_t HEADER_SIZE = 16;
+static_assert(sizeof(ALLOC_HEADER) <= HEADER_SIZE, "material point header too large");
+
+// size of the first block of a pool
+static const size_t MIN_BLOCK_SIZE = 64 * 1024;
+
+// blocks do not grow beyond this size
+static const size_t MAX_BLOCK_SIZE = 16 * 1024 * 1024;
+
+// the active pool of this thread
+static thread_local FEMaterialPointPool* s_activePool = nullptr;
+
+//-----------------------------------------------------------------------------
+FEMaterialPointPool::Scope::Scope(FEMaterialPointPool& pool)
+{
+	m_prev = s_activePool;
+	s_activePool = &pool;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointPool::Scope::~Scope()
+{
+	s_activePool = m_prev;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointPool::FEMaterialPointPool() : m_count(0)
+{
+	m_blockSize = 0;
+	m_used = 0;
+}
+
+//-----------------------------------------------------------------------------
+FEMaterialPointPool::~FEMaterialPointPool()
+{
+	// All material points should have been deleted by now (the domain deletes
+	// its elements before the pool).
+	assert(m_count == 0);
+	Clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointPool::Clear()
+{
+	for (size_t i = 0; i < m_block.size(); ++i) delete [] m_block[i];
+	m_block.clear();
+	m_blockSize = 0;
+	m_used = 0;
+}
+
+//-----------------------------------------------------------------------------
+void* FEMaterialPointPool::alloc(size_t size)
+{
+	if (m_block.empty() || (m_used + size > m_blockSize))
+	{
+		size_t blockSize = (m_blockSize == 0 ? MIN_BLOCK_SIZE : 2 * m_blockSize);
+		if (blockSize > MAX_BLOCK_SIZE) blockSize = MAX_BLOCK_SIZE;
+		if (blockSize < size) blockSize = size;
+
+		m_block.push_back(new char[blockSize]);
+		m_blockSize = blockSize;
+		m_used = 0;
+	}
+
+	char* p = m_block.back() + m_used;
+	m_used += size;
+	m_count++;
+	return p;
+}
+
+//-----------------------------------------------------------------------------
+void* FEMaterialPointPool::Allocate(size_t size)
+{
+	// round up so that the next allocation is aligned as well
+	size_t n = HEADER_SIZE + ((size + HEADER_SIZE - 1) / HEADER_SIZE) * HEADER_SIZE;
+
+	FEMaterialPointPool* pool = s_activePool;
+	char* p = (char*)(pool ? pool->alloc(n) : ::operator new(n));
+	ALLOC_HEADER* h = (ALLOC_HEADER*)p;
+	h->pool = pool;
+	h->size = n;
+	return p + HEADER_SIZE;
+}
+
+//-----------------------------------------------------------------------------
+void FEMaterialPointPool::Release(void* p)
+{
+	if (p == nullptr) return;
+
+	char* pc = (char*)p - HEADER_SIZE;
+	FEMaterialPointPool* pool = ((ALLOC_HEADER*)pc)->pool;
+	if (pool == nullptr) ::operator delete(pc);
+	else
+	{
+		// The memory is not reused until all material points of the pool are gone.
+		assert(pool->m_count > 0);
+		if (--pool->m_count == 0) pool->Clear();
+	}
+}
+
+//-----------------------------------------------------------------------------
+size_t FEMaterialPointPool::AllocationSize(const void* p)
+{
+	if (p == nullptr) return 0;
+	const char* pc = (const char*)p - HEADER_SIZE;
+	return ((const ALLOC_HEADER*)pc)->size;
+}
@@ -0,0 +1,82 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <atomic>
+#include <stddef.h>
+
+//-----------------------------------------------------------------------------
+//! Arena for the material point data of a domain.
+//! While a pool is active (see FEMaterialPointPool::Scope), all material points
+//! that are created on that thread are allocated from it. Since domains create
+//! the material point chains element by element, the chains of a domain end up
+//! next to each other in memory in element order. Deleting a material point
+//! only runs its destructor. The memory is released in bulk when the last
+//! material point of the pool is deleted, or when the pool is destroyed.
+class FECORE_API FEMaterialPointPool
+{
+public:
+	//! Makes a pool the active pool for the lifetime of this object.
+	class FECORE_API Scope
+	{
+	public:
+		Scope(FEMaterialPointPool& pool);
+		~Scope();
+
+	private:
+		FEMaterialPointPool*	m_prev;
+	};
+
+public:
+	FEMaterialPointPool();
+	~FEMaterialPointPool();
+
+	//! allocate memory from the active pool, or from the heap if no pool is active
+	static void* Allocate(size_t size);
+
+	//! release memory that was returned by Allocate
+	static void Release(void* p);
+
+	//! number of bytes (including the header) that Allocate reserved for p
+	static size_t AllocationSize(const void* p);
+
+private:
+	void* alloc(size_t size);
+	void Clear();
+
+	FEMaterialPointPool(const FEMaterialPointPool&) = delete;
+	void operator = (const FEMaterialPointPool&) = delete;
+
+private:
+	std::vector<char*>	m_block;	//!< allocated memory blocks
+	size_t				m_blockSize;	//!< size of the last block
+	size_t				m_used;		//!< bytes used in the last block
+	std::atomic<int>	m_count;	//!< number of live allocations
+};
@@ -0,0 +1,172 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "FEMemoryReport.h"
+#include "FEMaterialPoint.h"
+#include "FEMaterialPointPool.h"
+#include <stdio.h>
+#include <string.h>
+#ifdef WIN32
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <sys/resource.h>
+#include <mach/mach.h>
+#endif
+
+//-----------------------------------------------------------------------------
+FEMemoryReport::FEMemoryReport()
+{
+}
+
+//-----------------------------------------------------------------------------
+void FEMemoryReport::Clear()
+{
+	m_items.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FEMemoryReport::Add(const std::string& category, const std::string& name, size_t bytes)
+{
+	ITEM it;
+	it.category = category;
+	it.name = name;
+	it.bytes = bytes;
+	m_items.push_back(it);
+}
+
+//-----------------------------------------------------------------------------
+size_t FEMemoryReport::Total() const
+{
+	size_t total = 0;
+	for (size_t i = 0; i < m_items.size(); ++i) total += m_items[i].bytes;
+	return total;
+}
+
+//-----------------------------------------------------------------------------
+size_t FEMemoryReport::Total(const std::string& category) const
+{
+	size_t total = 0;
+	for (size_t i = 0; i < m_items.size(); ++i)
+	{
+		if (m_items[i].category == category) total += m_items[i].bytes;
+	}
+	return total;
+}
+
+#ifdef LINUX
+//-----------------------------------------------------------------------------
+// read a value (in kB) from /proc/self/status
+static size_t read_proc_status(const char* szkey)
+{
+	FILE* fp = fopen("/proc/self/status", "rt");
+	if (fp == nullptr) return 0;
+
+	size_t l = strlen(szkey);
+	size_t kb = 0;
+	char szline[256];
+	while (fgets(szline, sizeof(szline), fp))
+	{
+		if ((strncmp(szline, szkey, l) == 0) && (szline[l] == ':'))
+		{
+			unsigned long long n = 0;
+			if (sscanf(szline + l + 1, "%llu", &n) == 1) kb = (size_t)n;
+			break;
+		}
+	}
+	fclose(fp);
+
+	return kb * 1024;
+}
+#endif
+
+//-----------------------------------------------------------------------------
+size_t FEMemoryReport::CurrentMemory()
+{
+#ifdef WIN32
+	PROCESS_MEMORY_COUNTERS memCounters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &memCounters, sizeof(memCounters));
+	return (size_t)memCounters.WorkingSetSize;
+#elif defined(__APPLE__)
+	mach_task_basic_info info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) return 0;
+	return (size_t)info.resident_size;
+#elif defined(LINUX)
+	return read_proc_status("VmRSS");
+#else
+	return 0;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+size_t FEMemoryReport::PeakMemory()
+{
+#ifdef WIN32
+	PROCESS_MEMORY_COUNTERS memCounters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &memCounters, sizeof(memCounters));
+	return (size_t)memCounters.PeakWorkingSetSize;
+#elif defined(__APPLE__)
+	// on macOS, ru_maxrss is in bytes
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru) != 0) return 0;
+	return (size_t)ru.ru_maxrss;
+#elif defined(LINUX)
+	return read_proc_status("VmHWM");
+#else
+	return 0;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+//! Calculates the size of the material point data, including all the data that
+//! is linked to it. Since material point data is allocated by the materials, the 
+//! actual size of the allocated objects is obtained from the material point
+//! allocator (see FEMaterialPointPool).
+size_t fecore_memory_size(FEMaterialPoint* mp)
+{
+	size_t bytes = 0;
+	while (mp)
+	{
+		bytes += FEMaterialPointPool::AllocationSize(dynamic_cast<void*>(mp));
+
+		// mixtures store the data of their components
+		int nc = mp->Components();
+		if (nc > 1)
+		{
+			for (int i = 0; i < nc; ++i)
+			{
+				FEMaterialPoint* pi = mp->GetPointData(i);
+				if (pi && (pi != mp)) bytes += fecore_memory_size(pi);
+			}
+		}
+
+		mp = mp->Next();
+	}
+	return bytes;
+}
@@ -0,0 +1,87 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "fecore_api.h"
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! This class collects the memory footprint (in bytes) of the different parts
+//! of a model (domains, stiffness matrix, linear solver, contact, etc.). It is
+//! filled by FEModel::MemoryReport, which can also be called from plugins or callbacks.
+//! Note that the reported numbers are estimates of the main data structures and
+//! don't include all the memory that is allocated by a model.
+class FECORE_API FEMemoryReport
+{
+public:
+	struct ITEM
+	{
+		std::string	category;	//!< category (e.g. "domain", "contact", ...)
+		std::string	name;		//!< name of the component
+		size_t		bytes;		//!< size in bytes
+	};
+
+public:
+	FEMemoryReport();
+
+	//! clear the report
+	void Clear();
+
+	//! add an item to the report
+	void Add(const std::string& category, const std::string& name, size_t bytes);
+
+	//! number of items
+	int Items() const { return (int)m_items.size(); }
+
+	//! get an item
+	const ITEM& GetItem(int i) const { return m_items[i]; }
+
+	//! total size of all items
+	size_t Total() const;
+
+	//! total size of all items of a category
+	size_t Total(const std::string& category) const;
+
+public:
+	//! current resident memory of the process (returns 0 when not available)
+	static size_t CurrentMemory();
+
+	//! peak resident memory of the process (returns 0 when not available)
+	static size_t PeakMemory();
+
+private:
+	std::vector<ITEM>	m_items;
+};
+
+//-----------------------------------------------------------------------------
+// helper functions for calculating the memory size of data structures
+template <typename T> size_t fecore_memory_size(const std::vector<T>& v) { return v.capacity() * sizeof(T); }
+
+class FEMaterialPoint;
+FECORE_API size_t fecore_memory_size(FEMaterialPoint* mp);
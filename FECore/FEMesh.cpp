@@ -43,6 +43,9 @@ SOFTWARE.*/
 #include "FESurfaceMap.h"
 #include "FENodeDataMap.h"
 #include "DumpStream.h"
+#include "FEElementBVH.h"
+#include "FEModel.h"
+#include "FEProfiler.h"
 #include <algorithm>
 
 //-----------------------------------------------------------------------------
@@ -67,6 +70,9 @@ FEDataMap* CreateDataMap(int mapType)
 FEMesh::FEMesh(FEModel* fem) : m_fem(fem)
 {
 	m_LUT = 0;
+	m_refSearch = 0;
+	m_curSearch = 0;
+	m_curDirty = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -97,6 +103,14 @@ void FEMesh::Serialize(DumpStream& ar)
 	}
 	ar.UnlockPointerTable();
 
+	// the loaded nodes have their own dof storage, so move it to the mesh
+	if ((ar.IsShallow() == false) && ar.IsLoading())
+	{
+		int dofs = (Nodes() > 0 ? m_Node[0].dofs() : 0);
+		m_dofData.Create(Nodes(), dofs);
+		AttachNodeDofs(true);
+	}
+
 	// stream domain data
 	ar & m_Domain;
 
@@ -214,6 +228,13 @@ void FEMesh::CreateNodes(int nodes)
 	assert(nodes);
 	m_Node.resize(nodes);
 
+	// resize the dof storage if it was already allocated
+	if (m_dofData.Dofs() > 0)
+	{
+		m_dofData.Resize(nodes);
+		AttachNodeDofs();
+	}
+
 	// set the default node IDs
 	for (int i=0; i<nodes; ++i) Node(i).SetID(i+1);
 
@@ -235,13 +256,28 @@ void FEMesh::AddNodes(int nodes)
 
 	m_Node.resize(N0 + nodes);
 	for (int i=0; i<nodes; ++i) m_Node[i+N0].SetID(n0+i);
+
+	// make room for the dofs of the new nodes
+	if (m_dofData.Dofs() > 0)
+	{
+		m_dofData.Resize(N0 + nodes);
+		AttachNodeDofs();
+	}
 }
 
 //-----------------------------------------------------------------------------
 void FEMesh::SetDOFS(int n)
 {
+	m_dofData.Create(Nodes(), n);
+	AttachNodeDofs();
+}
+
+//-----------------------------------------------------------------------------
+void FEMesh::AttachNodeDofs(bool copyValues)
+{
+	assert(m_dofData.Nodes() == Nodes());
 	int NN = Nodes();
-	for (int i=0; i<NN; ++i) m_Node[i].SetDOFS(n);
+	for (int i=0; i<NN; ++i) m_Node[i].Attach(m_dofData, i, copyValues);
 }
 
 //-----------------------------------------------------------------------------
@@ -274,6 +310,19 @@ int FEMesh::Elements(int ndom_type) const
 FENode& FEMesh::Node(int i) { return m_Node[i]; }
 const FENode& FEMesh::Node(int i) const { return m_Node[i]; }
 
+//-----------------------------------------------------------------------------
+void FEMesh::UpdateReferenceCache()
+{
+	for (int i = 0; i < Domains(); ++i)
+	{
+		FESolidDomain* dom = dynamic_cast<FESolidDomain*>(&Domain(i));
+		if (dom) dom->UpdateReferenceCache();
+	}
+
+	// the reference configuration changed, so the spatial index is no longer valid
+	ClearSearchIndex();
+}
+
 //-----------------------------------------------------------------------------
 //  Updates the bounding box of the mesh (using current coordinates)
 //
@@ -341,6 +390,7 @@ void FEMesh::InitMaterialPoints()
 void FEMesh::Clear()
 {
 	m_Node.clear();
+	m_dofData.Clear();
 	for (size_t i=0; i<m_Domain.size (); ++i) delete m_Domain [i];
 
 	// TODO: Surfaces are currently managed by the classes that use them so don't delete them
@@ -364,6 +414,7 @@ void FEMesh::Clear()
 
 	m_NEL.Clear();
 	if (m_LUT) delete m_LUT; m_LUT = 0;
+	ClearSearchIndex();
 }
 
 //-----------------------------------------------------------------------------
@@ -372,6 +423,9 @@ void FEMesh::Clear()
 
 void FEMesh::Reset()
 {
+	// reset the dof data of all nodes at once
+	m_dofData.Reset();
+
 	// reset nodal data
 	for (int i=0; i<Nodes(); ++i) 
 	{
@@ -382,8 +436,9 @@ void FEMesh::Reset()
 		node.m_ap = node.m_at = vec3d(0,0,0);
         node.m_dp = node.m_dt = node.m_d0;
 
-		// reset ID arrays
+		// reset ID arrays of nodes that are not stored in the mesh's dof storage
 		int ndof = (int)node.dofs();
+		if (ndof == m_dofData.Dofs()) continue;
 		for (int i=0; i<ndof; ++i) 
 		{
 			node.set_inactive(i);
@@ -398,6 +453,9 @@ void FEMesh::Reset()
 
 	// reset domain data
 	for (int n=0; n<(int) m_Domain.size(); ++n) m_Domain[n]->Reset();
+
+	// nodes were moved back to their initial position
+	m_curDirty = true;
 }
 
 //-----------------------------------------------------------------------------
@@ -538,6 +596,7 @@ void FEMesh::AddDomain(FEDomain* pd)
 	pd->SetID(N);
 	m_Domain.push_back(pd); 
 	if (m_LUT) delete m_LUT; m_LUT = 0;
+	ClearSearchIndex();
 }
 
 //-----------------------------------------------------------------------------
@@ -629,20 +688,74 @@ bool FEMesh::IsType(FE_Element_Shape eshape)
 }
 
 //-----------------------------------------------------------------------------
-// Find the element in which point y lies
-FESolidElement* FEMesh::FindSolidElement(vec3d y, double r[3])
+// Find the element in which point y lies (current configuration)
+FESolidElement* FEMesh::FindSolidElement(const vec3d& y, double r[3], const FEMeshPartition* dom)
+{
+	FEElementBVH* bvh = SearchIndex(false);
+	return (bvh ? bvh->FindElement(y, r, dom) : nullptr);
+}
+
+//-----------------------------------------------------------------------------
+// Find the element in which point y lies (reference configuration)
+FESolidElement* FEMesh::FindReferenceSolidElement(const vec3d& y, double r[3], const FEMeshPartition* dom)
 {
-	int ND = (int) m_Domain.size();
-	for (int i=0; i<ND; ++i)
+	FEElementBVH* bvh = SearchIndex(true);
+	return (bvh ? bvh->FindElement(y, r, dom) : nullptr);
+}
+
+//-----------------------------------------------------------------------------
+void FEMesh::FindSolidElements(const std::vector<vec3d>& y, std::vector<FESolidElement*>& el, std::vector<vec3d>& r, bool bref)
+{
+	FEElementBVH* bvh = SearchIndex(bref);
+	if (bvh) bvh->FindElements(y, el, r);
+	else
+	{
+		el.assign(y.size(), nullptr);
+		r.assign(y.size(), vec3d(0, 0, 0));
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Return the spatial index of the solid elements. The index is built the first
+// time it is needed. The current configuration index is refitted after the mesh
+// was updated.
+FEElementBVH* FEMesh::SearchIndex(bool bref)
+{
+	// count the solid elements
+	int NE = 0;
+	for (int i = 0; i < Domains(); ++i)
 	{
-		if (m_Domain[i]->Class() == FE_DOMAIN_SOLID)
+		if (m_Domain[i]->Class() == FE_DOMAIN_SOLID) NE += m_Domain[i]->Elements();
+	}
+	if (NE == 0) return nullptr;
+
+	FEElementBVH* bvh = nullptr;
+#pragma omp critical (FEMesh_SearchIndex)
+	{
+		FEElementBVH*& pi = (bref ? m_refSearch : m_curSearch);
+		if ((pi == nullptr) || (pi->Elements() != NE))
 		{
-			FESolidDomain& bd = static_cast<FESolidDomain&>(*m_Domain[i]);
-			FESolidElement* pe = bd.FindElement(y, r);
-			if (pe) return pe;
+			if (pi) delete pi;
+			pi = new FEElementBVH(this, (bref ? FEElementBVH::REFERENCE : FEElementBVH::CURRENT));
+			pi->Build();
+			if (bref == false) m_curDirty = false;
 		}
+		else if ((bref == false) && m_curDirty)
+		{
+			pi->Refit();
+			m_curDirty = false;
+		}
+		bvh = pi;
 	}
-	return 0;
+	return bvh;
+}
+
+//-----------------------------------------------------------------------------
+void FEMesh::ClearSearchIndex()
+{
+	if (m_refSearch) delete m_refSearch; m_refSearch = 0;
+	if (m_curSearch) delete m_curSearch; m_curSearch = 0;
+	m_curDirty = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -652,6 +765,7 @@ void FEMesh::ClearDomains()
 	for (int i = 0; i < N; ++i) delete m_Domain[i];
 	m_Domain.clear();
 	if (m_LUT) delete m_LUT; m_LUT = 0;
+	ClearSearchIndex();
 }
 
 //-----------------------------------------------------------------------------
@@ -896,11 +1010,19 @@ FEElement* FEElementLUT::Find(int nid)
 // update the domains of the mesh
 void FEMesh::Update(const FETimeInfo& tp)
 {
+	FEProfiler* prof = (m_fem ? m_fem->GetProfiler() : nullptr);
 	for (int i = 0; i<Domains(); ++i)
 	{
 		FEDomain& dom = Domain(i);
-		if (dom.IsActive()) dom.Update(tp);
+		if (dom.IsActive())
+		{
+			FEProfileScope scope(prof, "domain", &dom);
+			dom.Update(tp);
+		}
 	}
+
+	// nodes may have moved, so the current configuration index must be refitted
+	m_curDirty = true;
 }
 
 
@@ -1032,6 +1154,7 @@ void FEMesh::CopyFrom(FEMesh& mesh)
 
 	int N0 = mesh.Nodes();
 	CreateNodes(N0);
+	SetDOFS(mesh.m_dofData.Dofs());
 	for (int i = 0; i < N0; ++i)
 	{
 		Node(i) = mesh.Node(i);
@@ -46,6 +46,7 @@ class FEDomain;
 class FEModel;
 class FETimeInfo;
 class FEDataMap;
+class FEElementBVH;
 class DumpStream;
 
 //---------------------------------------------------------------------------------------
@@ -103,12 +104,20 @@ public:
 	//! Set the number of degrees of freedom on this mesh
 	void SetDOFS(int n);
 
+	//! return the (structure-of-arrays) storage of the nodal dofs
+	FENodeDofData& NodeDofData() { return m_dofData; }
+	const FENodeDofData& NodeDofData() const { return m_dofData; }
+
 	//! update bounding box
 	void UpdateBox();
 
 	//! retrieve the bounding box
 	FEBoundingBox& GetBoundingBox() { return m_box; }
 
+	//! rebuild the reference geometry caches of the solid domains
+	//! (call this after the reference configuration has changed)
+	void UpdateReferenceCache();
+
 	//! remove isolated vertices
 	int RemoveIsolatedVertices();
 
@@ -130,8 +139,19 @@ public:
 	//! Finds an element from a given ID
 	FEElement* FindElementFromID(int nid);
 
-	//! Finds the solid element in which y lies
-	FESolidElement* FindSolidElement(vec3d y, double r[3]);
+	//! Finds the solid element in which y lies (current configuration).
+	//! If dom is not null, only elements of that domain are considered.
+	FESolidElement* FindSolidElement(const vec3d& y, double r[3], const FEMeshPartition* dom = nullptr);
+
+	//! Finds the solid element in which y lies (reference configuration)
+	FESolidElement* FindReferenceSolidElement(const vec3d& y, double r[3], const FEMeshPartition* dom = nullptr);
+
+	//! Find the solid elements for a batch of points. The points are located in parallel.
+	//! Set bref to search in the reference configuration.
+	void FindSolidElements(const std::vector<vec3d>& y, std::vector<FESolidElement*>& el, std::vector<vec3d>& r, bool bref = false);
+
+	//! delete the spatial search structures (they will be rebuilt on the next search)
+	void ClearSearchIndex();
 
 	FENodeElemList& NodeElementList()
 	{
@@ -260,8 +280,13 @@ public: // data maps
 	int DataMaps() const;
 	FEDataMap* GetDataMap(int i);
 
+private:
+	//! point the dof arrays of all nodes to the mesh's dof storage
+	void AttachNodeDofs(bool copyValues = false);
+
 private:
 	vector<FENode>		m_Node;		//!< nodes
+	FENodeDofData		m_dofData;	//!< nodal dof storage
 	vector<FEDomain*>	m_Domain;	//!< list of domains
 	vector<FESurface*>	m_Surf;		//!< surfaces
 	vector<FEEdge*>		m_Edge;		//!< Edges
@@ -280,8 +305,15 @@ private:
 	FENodeElemList	m_NEL;
 	FEElementLUT*	m_LUT;
 
+	FEElementBVH*	m_refSearch;	//!< spatial index of solid elements (reference configuration)
+	FEElementBVH*	m_curSearch;	//!< spatial index of solid elements (current configuration)
+	bool			m_curDirty;		//!< current index needs to be refitted
+
 	FEModel*	m_fem;
 private:
+	//! get the spatial index (builds or refits it when needed)
+	FEElementBVH* SearchIndex(bool bref);
+
 	//! hide the copy constructor
 	FEMesh(FEMesh& m){}
 
@@ -32,6 +32,7 @@ SOFTWARE.*/
 #include <string.h>
 #include "FEModel.h"
 #include "DumpStream.h"
+#include "FEMemoryReport.h"
 
 REGISTER_SUPER_CLASS(FEMeshPartition, FEDOMAIN_ID);
 
@@ -73,6 +74,20 @@ FEElement* FEMeshPartition::FindElementFromID(int nid)
 	return 0;
 }
 
+//-----------------------------------------------------------------------------
+size_t FEMeshPartition::MemoryUsage()
+{
+	size_t bytes = fecore_memory_size(m_Node);
+	for (int i = 0; i<Elements(); ++i)
+	{
+		FEElement& el = ElementRef(i);
+		int nint = el.MaterialPoints();
+		bytes += sizeof(FEElement) + 2 * el.Nodes() * sizeof(int) + nint * sizeof(FEMaterialPoint*);
+		for (int n = 0; n < nint; ++n) bytes += fecore_memory_size(el.GetMaterialPoint(n));
+	}
+	return bytes;
+}
+
 //-----------------------------------------------------------------------------
 void FEMeshPartition::Serialize(DumpStream& ar)
 {
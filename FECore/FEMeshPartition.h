@@ -119,6 +119,9 @@ public:
 	//! Initialize material points in the domain (optional)
 	virtual void InitMaterialPoints() {}
 
+	//! Estimate of the memory (in bytes) used by the elements and their material point data
+	virtual size_t MemoryUsage();
+
 	// Loop over all material points
 	void ForEachMaterialPoint(std::function<void(FEMaterialPoint& mp)> f);
 
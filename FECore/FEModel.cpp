@@ -57,8 +57,10 @@ SOFTWARE.*/
 #include "LinearSolver.h"
 #include "FETimeStepController.h"
 #include "Timer.h"
+#include "FEProfiler.h"
 #include "DumpMemStream.h"
 #include "FEPlotDataStore.h"
+#include "FEMemoryReport.h"
 #include <stdarg.h>
 using namespace std;
 
@@ -109,6 +111,8 @@ public:
 
 		m_meshUpdate = false;
 
+		m_bcacheRefGeom = false;
+
 		// create the linear constraint manager
 		m_LCM = new FELinearConstraintManager(fem);
 
@@ -169,11 +173,13 @@ public:
 
 	std::vector<LoadParam>		m_Param;	//!< list of parameters controller by load controllers
 	std::vector<Timer>			m_timers;	// list of timers
+	FEProfiler					m_profiler;	// hierarchical profiler
 
 public:
 	FEAnalysis*		m_pStep;	//!< pointer to current analysis step
 	int				m_nStep;	//!< current index of analysis step
 	bool			m_printParams;	//!< print parameters
+	bool			m_bcacheRefGeom;	//!< cache reference geometry of solid domains
 	bool			m_meshUpdate;	//!< mesh update flag
 
 public:
@@ -212,6 +218,7 @@ BEGIN_FECORE_CLASS(FEModel, FECoreBase)
 
 	// model parameters
 	ADD_PARAMETER(m_imp->m_timeInfo.currentTime, "time");
+	ADD_PARAMETER(m_imp->m_bcacheRefGeom, "cache_reference_geometry");
 
 	// model properties
 	ADD_PROPERTY(m_imp->m_MAT , "material"       );
@@ -274,6 +281,20 @@ void FEModel::SetMeshUpdateFlag(bool b)
 	m_imp->m_meshUpdate = b;
 }
 
+//-----------------------------------------------------------------------------
+//! Set whether solid domains cache the reference geometry of their integration
+//! points. This trades memory for speed.
+void FEModel::SetCacheReferenceGeometry(bool b)
+{
+	m_imp->m_bcacheRefGeom = b;
+}
+
+//-----------------------------------------------------------------------------
+bool FEModel::CacheReferenceGeometry() const
+{
+	return m_imp->m_bcacheRefGeom;
+}
+
 //-----------------------------------------------------------------------------
 void FEModel::Clear()
 {
@@ -649,7 +670,11 @@ void FEModel::Update()
 	for (int i = 0; i < SurfacePairConstraints(); ++i)
 	{
 		FESurfacePairConstraint* psc = SurfacePairConstraint(i);
-		if (psc && psc->IsActive()) psc->Update();
+		if (psc && psc->IsActive())
+		{
+			FE_PROFILE_SCOPE(this, "contact", psc);
+			psc->Update();
+		}
 	}
 
 	// update all constraints
@@ -1939,6 +1964,7 @@ void FEModel::CopyFrom(FEModel& fem)
 	FEMesh& mesh = GetMesh();
 	int N = sourceMesh.Nodes();
 	mesh.CreateNodes(N);
+	mesh.SetDOFS(sourceMesh.NodeDofData().Dofs());
 	for (int i=0; i<N; ++i)
 	{
 		mesh.Node(i) = sourceMesh.Node(i);
@@ -2149,6 +2175,54 @@ void FEModel::Implementation::Serialize(DumpStream& ar)
 void FEModel::SerializeGeometry(DumpStream& ar)
 {
 	ar & m_imp->m_mesh;
+	SerializeAuxGeometry(ar);
+}
+
+//-----------------------------------------------------------------------------
+// This stores the same data as a shallow serialization of the model, 
+// except for the mesh.
+void FEModel::SerializeState(DumpStream& ar)
+{
+	assert(ar.IsShallow());
+	ar & m_imp->m_timeInfo;
+	SerializeAuxGeometry(ar);
+	ar & m_imp->m_CI;
+	ar & m_imp->m_NLC;
+	ar & m_imp->m_Step;
+}
+
+//-----------------------------------------------------------------------------
+void FEModel::MemoryReport(FEMemoryReport& report)
+{
+	FEMesh& mesh = GetMesh();
+
+	// nodes
+	size_t bytes = 0;
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		FENode& node = mesh.Node(i);
+		bytes += sizeof(FENode) + node.dofs()*(3*sizeof(double) + 2*sizeof(int));
+	}
+	report.Add("mesh", "nodes", bytes);
+
+	// domains
+	for (int i = 0; i < mesh.Domains(); ++i)
+	{
+		FEDomain& dom = mesh.Domain(i);
+		report.Add("domain", dom.GetName(), dom.MemoryUsage());
+	}
+
+	// contact interfaces
+	for (int i = 0; i < SurfacePairConstraints(); ++i)
+	{
+		FESurfacePairConstraint* pc = SurfacePairConstraint(i);
+		report.Add("contact", pc->GetName(), pc->MemoryUsage());
+	}
+
+	// solver
+	FEAnalysis* step = GetCurrentStep();
+	FESolver* solver = (step ? step->GetFESolver() : nullptr);
+	if (solver) solver->MemoryReport(report);
 }
 
 //-----------------------------------------------------------------------------
@@ -2219,6 +2293,21 @@ Timer* FEModel::GetTimer(int i)
 	return &(m_imp->m_timers[i]);
 }
 
+//-----------------------------------------------------------------------------
+const char* FEModel::GetTimerName(int i)
+{
+	// Make sure this list matches the TimerIds!
+	static const char* szname[] = { "update", "linear solve", "reform", "residual", "stiffness", "QN update", "model solve" };
+	assert((i >= 0) && (i < (int)(sizeof(szname) / sizeof(szname[0]))));
+	return szname[i];
+}
+
+//-----------------------------------------------------------------------------
+FEProfiler* FEModel::GetProfiler()
+{
+	return &(m_imp->m_profiler);
+}
+
 //-----------------------------------------------------------------------------
 //! return number of mesh adaptors
 int FEModel::MeshAdaptors()
@@ -39,6 +39,7 @@ SOFTWARE.*/
 //-----------------------------------------------------------------------------
 // forward declarations
 class FELoadController;
+class FEMemoryReport;
 class FEMaterial;
 class FEModelLoad;
 class FENodalLoad;
@@ -57,6 +58,7 @@ class FEModelData;
 class FEDataArray;
 class FEMeshAdaptor;
 class Timer;
+class FEProfiler;
 class FEPlotDataStore;
 
 //-----------------------------------------------------------------------------
@@ -157,6 +159,10 @@ public:
 	// call this function to set the mesh's update flag
 	void SetMeshUpdateFlag(bool b);
 
+	// set/get the flag that lets solid domains cache their reference geometry
+	void SetCacheReferenceGeometry(bool b);
+	bool CacheReferenceGeometry() const;
+
 public:	// --- Load controller functions ----
 
 	//! Add a load controller to the model
@@ -384,6 +390,18 @@ public:	// --- Miscellaneous routines ---
 	//! Derived classes can override this
 	virtual void SerializeGeometry(DumpStream& ar);
 
+	//! This is called by SerializeGeometry to serialize geometry data 
+	//! that is not stored in the mesh (e.g. rigid bodies).
+	virtual void SerializeAuxGeometry(DumpStream& ar) {}
+
+	//! Serialize the state of the model, except the mesh, to a shallow archive.
+	//! This is used by FECheckpoint, which stores the mesh data itself.
+	void SerializeState(DumpStream& ar);
+
+	//! Collect the memory usage of the model's main data structures 
+	//! (mesh, domains, contact interfaces, solver, etc.)
+	virtual void MemoryReport(FEMemoryReport& report);
+
 	//! set the module name
 	void SetModuleName(const std::string& moduleName);
 
@@ -436,6 +454,12 @@ public:
 	// return a timer by index
 	Timer* GetTimer(int i);
 
+	// return the name of a timer
+	const char* GetTimerName(int i);
+
+	// return the profiler
+	FEProfiler* GetProfiler();
+
 	// get the number of calls to Update()
 	int UpdateCounter() const;
 
@@ -113,6 +113,52 @@ void FENNQuery::Init()
 	m_imin = 0;
 }
 
+//-----------------------------------------------------------------------------
+//! Update the node positions after the surface moved. The pivots are kept (any
+//! point can serve as a pivot), so the node list is usually still close to sorted
+//! and an insertion sort is much cheaper than sorting from scratch.
+
+void FENNQuery::Update()
+{
+	assert(m_ps);
+
+	int N = m_ps->Nodes();
+	if ((N == 0) || ((int)m_bk.size() != N)) { Init(); return; }
+
+	for (int i=0; i<N; ++i)
+	{
+		NODE& n = m_bk[i];
+		n.r = m_ps->Node(n.i).m_rt;
+		n.d1 = (m_q1 - n.r)*(m_q1 - n.r);
+		n.d2 = (m_q2 - n.r)*(m_q2 - n.r);
+	}
+
+	// insertion sort, but fall back to qsort if the list got too scrambled
+	int nmoves = 0;
+	const int maxMoves = 8*N;
+	for (int i=1; i<N; ++i)
+	{
+		NODE n = m_bk[i];
+		int j = i - 1;
+		while ((j >= 0) && (m_bk[j].d1 > n.d1))
+		{
+			m_bk[j+1] = m_bk[j];
+			--j;
+			++nmoves;
+		}
+		m_bk[j+1] = n;
+
+		if (nmoves > maxMoves)
+		{
+			qsort(&m_bk[0], N, sizeof(NODE), cmp_node);
+			break;
+		}
+	}
+
+	// the last found item may no longer be valid
+	if (m_imin >= N) m_imin = 0;
+}
+
 //-----------------------------------------------------------------------------
 
 void FENNQuery::InitReference()
@@ -55,6 +55,9 @@ public:
 	void Init();
 	void InitReference();
 
+	//! update search structures after the surface moved
+	void Update();
+
 	//! attach to a surface
 	void Attach(FESurface* ps) { m_ps = ps; }
 
@@ -39,6 +39,7 @@ SOFTWARE.*/
 #include "FEDomain.h"
 #include "DumpStream.h"
 #include "FELinearSystem.h"
+#include "FEMemoryReport.h"
 
 //-----------------------------------------------------------------------------
 // define the parameter list
@@ -58,6 +59,12 @@ BEGIN_FECORE_CLASS(FENewtonSolver, FESolver)
 	ADD_PARAMETER(m_Rtol                , "rtol"        );
 	ADD_PARAMETER(m_Rmin, FE_RANGE_GREATER_OR_EQUAL(0.0), "min_residual");
 	ADD_PARAMETER(m_Rmax, FE_RANGE_GREATER_OR_EQUAL(0.0), "max_residual");
+	ADD_PARAMETER(m_bcolored            , "colored_assembly");
+	ADD_PARAMETER(m_breuseProfile       , "reuse_contact_profile");
+	ADD_PARAMETER(m_bprofileEnvelope    , "contact_profile_envelope");
+	ADD_PARAMETER(m_memBudget, FE_RANGE_GREATER_OR_EQUAL(0.0), "memory_budget");
+	ADD_PARAMETER(m_bwarmStart          , "warm_start");
+	ADD_PARAMETER(m_breuseStiffness     , "reuse_stiffness");
 
 	// obsolete parameters (Should be set via the qn_method)
 	ADD_PARAMETER(m_qndefault           , "qnmethod", 0, "BFGS\0BROYDEN\0JFNK\0");
@@ -108,6 +115,19 @@ FENewtonSolver::FENewtonSolver(FEModel* pfem) : FESolver(pfem)
 	m_force_partition = 0;
 	m_breformtimestep = true;
 	m_breformAugment = false;
+	m_bcolored = false;
+	m_breuseProfile = false;
+	m_bprofileEnvelope = false;
+	m_memBudget = 0.0;
+	m_solverMem = 0;
+	m_solverNNZ = 0;
+
+	m_bwarmStart = false;
+	m_breuseStiffness = false;
+	m_bfactored = false;
+	m_bnewRun = false;
+	m_bretainedK = false;
+	m_bkeepStiffness = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -129,6 +149,7 @@ void FENewtonSolver::SetSolutionStrategy(FENewtonStrategy* pstrategy)
 FENewtonSolver::~FENewtonSolver()
 {
 	Clean();
+	ClearLinearSystem();
 }
 
 //-----------------------------------------------------------------------------
@@ -181,8 +202,21 @@ bool FENewtonSolver::ReformStiffness()
     // recalculate the shape of the stiffness matrix if necessary
     if (m_breshape)
     {
+		bool breset = (m_niter == 0);
+
+		// With contact, the profile often does not change between reformations. 
+		// If the new profile fits in the current matrix, we keep the matrix structure
+		// and the symbolic factorization of the linear solver.
+		bool bfit = false;
+		if ((breset == false) && m_breuseProfile)
+		{
+			TRACK_TIME(TimerID::Timer_Reform);
+			bfit = m_pK->ProfileFits(&fem, m_neq);
+			if (bfit) feLog("===== reusing stiffness matrix profile\n");
+		}
+
         // reshape the stiffness matrix
-        if (!CreateStiffness(m_niter == 0)) return false;
+        if ((bfit == false) && !CreateStiffness(breset)) return false;
         
         // reset reshape flag, except for contact
 		m_breshape = (((fem.SurfacePairConstraints() > 0) || (fem.NonlinearConstraints() > 0)) ? true : false);
@@ -228,11 +262,13 @@ bool FENewtonSolver::ReformStiffness()
     {
         {
 			TRACK_TIME(TimerID::Timer_LinSolve);
+			FE_PROFILE_SCOPE(GetFEModel(), "numeric factorization");
 			// factorize the stiffness matrix
 			if (m_plinsolve->Factor() == false)
 			{
 				throw FactorizationError();
 			}
+			m_bfactored = true;
         }
 
         // increase total nr of reformations
@@ -267,8 +303,18 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 {
 	{
 		TRACK_TIME(TimerID::Timer_Reform);
+
+		// remember the memory of the current factorization so we can project the next one
+		size_t solverMem = m_plinsolve->MemoryUsage();
+		if (solverMem > 0)
+		{
+			m_solverMem = solverMem;
+			m_solverNNZ = m_pK->NonZeroes();
+		}
+
 		// clean up the solver
 		m_plinsolve->Destroy();
+		m_bfactored = false;
 
 		// clean up the stiffness matrix
 		m_pK->Clear();
@@ -288,6 +334,9 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 			feLog("\tNr of equations ........................... : %d\n", neq);
 			feLog("\tNr of nonzeroes in stiffness matrix ....... : %d\n", nnz);
 
+			// check the projected memory usage against the budget
+			if (m_memBudget > 0.0) CheckMemoryBudget();
+
 			int parts = m_plinsolve->Partitions();
 			if (parts > 1)
 			{
@@ -303,6 +352,7 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 	// Do the preprocessing of the solver
 	{
 		TRACK_TIME(TimerID::Timer_LinSolve);
+		FE_PROFILE_SCOPE(GetFEModel(), "symbolic factorization");
 		if (!m_plinsolve->PreProcess())
 		{
 			feLogError("An error occurred during preprocessing of linear solver");
@@ -314,6 +364,49 @@ bool FENewtonSolver::CreateStiffness(bool breset)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+// The matrix was just created, so the current memory includes the matrix. The memory 
+// for the factorization is projected from the last factorization (scaled by the 
+// change in nonzeroes). If no factorization is known yet, the matrix size is used 
+// as a (low) estimate.
+void FENewtonSolver::CheckMemoryBudget()
+{
+	size_t current = FEMemoryReport::CurrentMemory();
+	if (current == 0) return;
+
+	double nnz = (double)m_pK->NonZeroes();
+	double solverMem = 0.0;
+	if ((m_solverMem > 0) && (m_solverNNZ > 0)) solverMem = (double)m_solverMem * (nnz / (double)m_solverNNZ);
+	else
+	{
+		SparseMatrix* K = m_pK->GetSparseMatrixPtr();
+		if (K) solverMem = (double)K->MemoryUsage();
+	}
+
+	double projected = ((double)current + solverMem) / 1048576.0;
+	if (projected > m_memBudget)
+	{
+		feLogWarning("Projected memory usage for stiffness reformation (%.1lf MB) exceeds the memory budget (%.1lf MB).", projected, m_memBudget);
+	}
+}
+
+//-----------------------------------------------------------------------------
+void FENewtonSolver::MemoryReport(FEMemoryReport& report)
+{
+	std::string name = GetTypeStr();
+
+	SparseMatrix* K = (m_pK ? m_pK->GetSparseMatrixPtr() : nullptr);
+	if (K) report.Add("stiffness matrix", name, K->MemoryUsage());
+
+	if (m_plinsolve) report.Add("linear solver", m_plinsolve->GetTypeStr(), m_plinsolve->MemoryUsage());
+
+	if (m_qnstrategy) report.Add("quasi-Newton", m_qnstrategy->GetTypeStr(), m_qnstrategy->MemoryUsage());
+
+	size_t bytes = fecore_memory_size(m_R0) + fecore_memory_size(m_R1) + fecore_memory_size(m_ui) + fecore_memory_size(m_Ut);
+	bytes += fecore_memory_size(m_Ui) + fecore_memory_size(m_up) + fecore_memory_size(m_Fd);
+	report.Add("solver", name, bytes);
+}
+
 //-----------------------------------------------------------------------------
 //! return the linear solver
 LinearSolver* FENewtonSolver::GetLinearSolver()
@@ -394,6 +487,8 @@ bool FENewtonSolver::AllocateLinearSystem()
 		feLogError("Failed allocating stiffness matrix.");
 		return false;
 	}
+	m_pK->SetColoredAssembly(m_bcolored);
+	m_pK->SetProfileEnvelope(m_bprofileEnvelope);
 
 	return true;
 }
@@ -434,9 +529,28 @@ bool FENewtonSolver::Init()
 	m_Ut.assign(m_neq, 0);
 	m_Fd.assign(m_neq, 0);
 
-	// allocate storage for the sparse matrix that will hold the stiffness matrix data
-	// we let the linear solver allocate the correct type of matrix format
-	if (AllocateLinearSystem() == false) return false;
+	// A new run can hold on to the linear system of the previous run, but only if 
+	// the equations did not change. In all other cases, we start from scratch.
+	bool bretain = m_bnewRun && m_bfactored && m_pK && (m_pK->Rows() == m_neq);
+	m_bnewRun = false;
+	m_bretainedK = bretain;
+	m_bkeepStiffness = false;
+	if (bretain == false)
+	{
+		// discard a linear system that was kept from the previous run
+		if (m_bfactored) ClearLinearSystem();
+
+		// allocate storage for the sparse matrix that will hold the stiffness matrix data
+		// we let the linear solver allocate the correct type of matrix format
+		if (AllocateLinearSystem() == false) return false;
+	}
+
+	// the converged solutions are only valid for the same equations
+	if (m_warmPrev.empty() == false)
+	{
+		const vector<double>& U = m_warmPrev.begin()->second;
+		if ((int)U.size() != m_neq) m_warmPrev.clear();
+	}
 
 	// Base class initialization and validation
 	if (FESolver::Init() == false) return false;
@@ -450,12 +564,112 @@ bool FENewtonSolver::Init()
 //-----------------------------------------------------------------------------
 //! Clean
 void FENewtonSolver::Clean()
+{
+	// With warm starts, the factored stiffness matrix can be kept for the next run.
+	// Since every step has its own solver, only the solver of the last step keeps it,
+	// so that a model holds on to at most one factorization between runs.
+	bool bkeep = (m_bwarmStart && m_breuseStiffness && m_bfactored);
+	if (bkeep)
+	{
+		FEModel* fem = GetFEModel();
+		int nsteps = fem->Steps();
+		bkeep = ((nsteps > 0) && (fem->GetStep(nsteps - 1)->GetFESolver() == this));
+	}
+	if (bkeep == false) ClearLinearSystem();
+	if (m_qnstrategy) delete m_qnstrategy; m_qnstrategy = nullptr;
+	m_Var.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FENewtonSolver::ClearLinearSystem()
 {
 	if (m_plinsolve) delete m_plinsolve; 
 	m_plinsolve = nullptr;
 	if (m_pK) delete m_pK; m_pK = nullptr;
-	if (m_qnstrategy) delete m_qnstrategy; m_qnstrategy = nullptr;
-	m_Var.clear();
+	m_bfactored = false;
+	m_bretainedK = false;
+}
+
+//-----------------------------------------------------------------------------
+void FENewtonSolver::Reset()
+{
+	FESolver::Reset();
+
+	// The solutions of this run become the initial guesses of the next run. If this run 
+	// did not make it to the end, we keep the later solutions of the run before it.
+	if (m_warmCur.empty() == false)
+	{
+		double tlast = m_warmCur.rbegin()->first;
+		for (auto it = m_warmPrev.upper_bound(tlast); it != m_warmPrev.end(); ++it) m_warmCur.insert(*it);
+		m_warmPrev.swap(m_warmCur);
+		m_warmCur.clear();
+	}
+
+	m_bnewRun = true;
+}
+
+//-----------------------------------------------------------------------------
+//! This sets the initial guess of the current time step to the converged solution
+//! of the previous run at the same time. If that run did not visit this time, the solution
+//! is interpolated between the two nearest time points. The solution is only applied to 
+//! the free nodal degrees of freedom. The prescribed values are imposed right away, so
+//! the first Newton iteration no longer needs to account for their increments.
+bool FENewtonSolver::WarmStart()
+{
+	bool bkeep = m_bretainedK; m_bretainedK = false;
+	if ((m_bwarmStart == false) || m_warmPrev.empty()) return false;
+
+	FEModel& fem = *GetFEModel();
+	double t = fem.GetTime().currentTime;
+	const double eps = 1e-9*(fabs(t) > 1.0 ? fabs(t) : 1.0);
+
+	// find the time points that bracket the current time
+	auto it1 = m_warmPrev.lower_bound(t - eps);
+	if (it1 == m_warmPrev.end()) return false;
+	const vector<double>& U1 = it1->second;
+	if ((int)U1.size() != m_neq) return false;
+
+	vector<double> U(U1);
+	if (it1->first > t + eps)
+	{
+		if (it1 == m_warmPrev.begin()) return false;
+		auto it0 = std::prev(it1);
+		const vector<double>& U0 = it0->second;
+		double w = (t - it0->first) / (it1->first - it0->first);
+		for (int i = 0; i < m_neq; ++i) U[i] = U0[i] + w*(U1[i] - U0[i]);
+	}
+
+	// set the increments of the free nodal dofs
+	FEMesh& mesh = fem.GetMesh();
+	for (int i = 0; i < mesh.Nodes(); ++i)
+	{
+		FENode& node = mesh.Node(i);
+		for (int j = 0; j < (int)node.m_ID.size(); ++j)
+		{
+			int n = node.m_ID[j];
+			if (n >= 0) m_Ui[n] = U[n] - m_Ut[n];
+		}
+	}
+
+	// update the model (this also enforces the prescribed values)
+	Update(m_ui);
+	zero(m_ui);
+	zero(m_Fd);
+
+	feLog("Warm start from solution of previous run at time = %lg\n", t);
+
+	// since the prescribed increments are now zero, the stiffness matrix of the previous run can be used as is
+	m_bkeepStiffness = (bkeep && (m_qnstrategy->m_maxups > 0));
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FENewtonSolver::StoreWarmStart()
+{
+	if (m_bwarmStart == false) return;
+	double t = GetFEModel()->GetTime().currentTime;
+	m_warmCur[t] = m_Ut;
 }
 
 //-----------------------------------------------------------------------------
@@ -583,6 +797,9 @@ bool FENewtonSolver::SolveStep()
 		feLog("\nconvergence summary\n");
 		feLog("    number of iterations   : %d\n", m_niter);
 		feLog("    number of reformations : %d\n", m_nref);
+
+		// remember the solution for the next run
+		StoreWarmStart();
 	}
 
 	// if we don't want to hold on to the stiffness matrix, let's clean it up
@@ -590,6 +807,7 @@ bool FENewtonSolver::SolveStep()
 	{
 		// clean up the solver
 		m_plinsolve->Destroy();
+		m_bfactored = false;
 
 		// clean up the stiffness matrix
 		m_pK->Clear();
@@ -619,6 +837,9 @@ bool FENewtonSolver::Quasin()
 	// do the presolve update
 	PrepStep();
 
+	// use the solution of the previous run as initial guess
+	WarmStart();
+
 	// Initialize QN method
 	QNInit();
 
@@ -837,6 +1058,14 @@ bool FENewtonSolver::QNInit()
 	// see if we reform at the start of every time step
 	bool breform = (m_breformtimestep || (m_qnstrategy->m_maxups == 0));
 
+	// a warm-started run can continue with the stiffness matrix of the previous run
+	if (m_bkeepStiffness)
+	{
+		breform = false;
+		m_bkeepStiffness = false;
+		feLog("Using stiffness matrix of previous run\n");
+	}
+
 	// if the force reform flag was set, we force a reform
 	// (This will be the case for the first time this is called, or when the previous time step failed)
 	if (m_bforceReform)
@@ -881,6 +1110,7 @@ void FENewtonSolver::SolveEquations(std::vector<double>& u, std::vector<double>&
 {
 	// call the strategy to solve the linear equations
 	TRACK_TIME(TimerID::Timer_LinSolve);
+	FE_PROFILE_SCOPE(GetFEModel(), "back solve");
 
 	// for iterative solvers, we pass the last solution as the initial guess
 	if (m_plinsolve->IsIterative())
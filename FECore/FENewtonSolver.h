@@ -31,6 +31,7 @@ SOFTWARE.*/
 #include "FENewtonStrategy.h"
 #include "FETimeInfo.h"
 #include "FELineSearch.h"
+#include <map>
 
 //-----------------------------------------------------------------------------
 // forward declarations
@@ -107,6 +108,9 @@ public: // overloaded from FESolver
 	//! Clean up
 	void Clean() override;
 
+	//! Reset data for a new run
+	void Reset() override;
+
 	//! serialization
 	void Serialize(DumpStream& ar) override;
 
@@ -146,6 +150,15 @@ public:
     //! recalculates the shape of the stiffness matrix
     bool CreateStiffness(bool breset);
 
+	//! add the memory used by the solver to the report
+	void MemoryReport(FEMemoryReport& report) override;
+
+protected:
+	//! print a warning when the projected memory exceeds the memory budget
+	void CheckMemoryBudget();
+
+public:
+
 	//! get the RHS
 	std::vector<double> GetLoadVector() override;
 
@@ -209,6 +222,12 @@ public:
 protected:
 	bool AllocateLinearSystem();
 
+	//! set the initial guess of the time step to the solution of the previous run (call after PrepStep)
+	bool WarmStart();
+
+	//! store the converged solution of the time step for the next run
+	void StoreWarmStart();
+
 public:
 	// line search options
 	FELineSearch*	m_lineSearch;
@@ -229,6 +248,12 @@ public:
 	bool				m_bforceReform;		//!< forces a reform in QNInit
 	bool				m_bdivreform;		//!< reform when diverging
 	bool				m_bdoreforms;		//!< do reformations
+	bool				m_bcolored;			//!< use graph-colored (lock-free) element assembly
+	bool				m_breuseProfile;	//!< keep the matrix structure when the contact profile did not change
+	bool				m_bprofileEnvelope;	//!< keep old contact entries in the matrix profile
+	double				m_memBudget;		//!< memory budget (in MB) that is checked before stiffness reformations (0 = no check)
+	bool				m_bwarmStart;		//!< use the converged solutions of the previous run as initial guess
+	bool				m_breuseStiffness;	//!< start a warm-started run with the factored stiffness matrix of the previous run (last step only)
 
 	// counters
 	int		m_nref;			//!< nr of stiffness retormations
@@ -259,9 +284,25 @@ public:
 	bool				m_cycle_buffer;	//!< cycle the qn buffer when updates larger than buffer size
 	double				m_cmax;			//!< max condition numbers
 
+private:
+	//! delete the linear solver and stiffness matrix
+	void ClearLinearSystem();
+
 private:
 	double	m_ls;	//!< line search factor calculated in last call to QNSolve
 
+	// warm start data
+	bool	m_bfactored;		//!< the linear solver holds a factorization
+	bool	m_bnewRun;			//!< the solver was reset since the last initialization
+	bool	m_bretainedK;		//!< the linear system of the previous run was kept
+	bool	m_bkeepStiffness;	//!< skip the stiffness reformation in the next QNInit
+	std::map<double, std::vector<double> >	m_warmPrev;	//!< converged solutions of the previous run
+	std::map<double, std::vector<double> >	m_warmCur;	//!< converged solutions of the current run
+
+	// used for projecting the memory of the next reformation
+	size_t	m_solverMem;	//!< memory used by the linear solver before the last reformation
+	int		m_solverNNZ;	//!< nr of nonzeroes of the matrix before the last reformation
+
 private:
 	ConvergenceInfo			m_residuNorm;	// residual convergence info
 	ConvergenceInfo			m_energyNorm;	// energy convergence info
@@ -71,6 +71,9 @@ public:
 	//! calculate the residual
 	virtual bool Residual(std::vector<double>& R, bool binit);
 
+	//! memory (in bytes) used for storing update vectors
+	virtual size_t MemoryUsage() { return 0; }
+
 public:
 	int		m_maxups;		//!< max nr of QN iters permitted between stiffness reformations
 	int		m_max_buf_size;	//!< max buffer size for update vector storage
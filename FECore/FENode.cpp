@@ -29,6 +29,63 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "FENode.h"
 #include "DumpStream.h"
+#include <algorithm>
+
+//=============================================================================
+// FENodeDofData
+//-----------------------------------------------------------------------------
+FENodeDofData::FENodeDofData()
+{
+	m_nodes = 0;
+	m_dofs = 0;
+}
+
+//-----------------------------------------------------------------------------
+void FENodeDofData::Create(int nodes, int dofs)
+{
+	m_nodes = nodes;
+	m_dofs = dofs;
+
+	int N = nodes*dofs;
+	m_ID.assign(N, -1);
+	m_BC.assign(N, 0);
+	m_val_t.assign(N, 0.0);
+	m_val_p.assign(N, 0.0);
+	m_Fr.assign(N, 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void FENodeDofData::Resize(int nodes)
+{
+	m_nodes = nodes;
+
+	int N = nodes*m_dofs;
+	m_ID.resize(N, -1);
+	m_BC.resize(N, 0);
+	m_val_t.resize(N, 0.0);
+	m_val_p.resize(N, 0.0);
+	m_Fr.resize(N, 0.0);
+}
+
+//-----------------------------------------------------------------------------
+void FENodeDofData::Clear()
+{
+	m_nodes = 0;
+	m_dofs = 0;
+	m_ID.clear();
+	m_BC.clear();
+	m_val_t.clear();
+	m_val_p.clear();
+	m_Fr.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FENodeDofData::Reset()
+{
+	std::fill(m_BC.begin(), m_BC.end(), DOF_OPEN);
+	std::fill(m_val_t.begin(), m_val_t.end(), 0.0);
+	std::fill(m_Fr.begin(), m_Fr.end(), 0.0);
+}
 
 //=============================================================================
 // FENode
@@ -48,40 +105,61 @@ FENode::FENode()
 //-----------------------------------------------------------------------------
 void FENode::SetDOFS(int n)
 {
+	// allocate storage if the number of dofs changes
+	if (dofs() != n) Allocate(n);
+
 	// initialize dof stuff
-	m_ID.assign(n, -1);
-	m_BC.assign(n, 0);
-	m_val_t.assign(n, 0.0);
-	m_val_p.assign(n, 0.0);
-	m_Fr.assign(n, 0.0);
+	std::fill(m_ID.begin(), m_ID.end(), -1);
+	std::fill(m_BC.begin(), m_BC.end(), 0);
+	std::fill(m_val_t.begin(), m_val_t.end(), 0.0);
+	std::fill(m_val_p.begin(), m_val_p.end(), 0.0);
+	std::fill(m_Fr.begin(), m_Fr.end(), 0.0);
 }
 
 //-----------------------------------------------------------------------------
-FENode::FENode(const FENode& n)
+// allocate the node's own storage for the dof arrays
+void FENode::Allocate(int n)
 {
-	m_r0 = n.m_r0;
-	m_rt = n.m_rt;
-	m_at = n.m_at;
-	m_rp = n.m_rp;
-	m_vp = n.m_vp;
-	m_ap = n.m_ap;
-	m_d0 = n.m_d0;
-    m_dt = n.m_dt;
-    m_dp = n.m_dp;
+	m_idata.assign(2*n, -1);
+	m_ddata.assign(3*n, 0.0);
 
-	m_nID = n.m_nID;
-	m_rid = n.m_rid;
-	m_nstate = n.m_nstate;
+	int* pi = m_idata.data();
+	double* pd = m_ddata.data();
+	m_ID.set(pi, n);
+	m_BC.set(pi + n, n);
+	m_val_t.set(pd, n);
+	m_val_p.set(pd + n, n);
+	m_Fr.set(pd + 2*n, n);
+}
 
-	m_ID = n.m_ID;
-	m_BC = n.m_BC;
-	m_val_t = n.m_val_t;
-	m_val_p = n.m_val_p;
-	m_Fr = n.m_Fr;
+//-----------------------------------------------------------------------------
+void FENode::Attach(FENodeDofData& data, int n, bool copyValues)
+{
+	int m = data.Dofs();
+	int i0 = n*m;
+	if (copyValues && (m_ID.begin() != data.m_ID.data() + i0))
+	{
+		int k = std::min(dofs(), m);
+		std::copy(m_ID.begin()   , m_ID.begin()    + k, data.m_ID.begin()    + i0);
+		std::copy(m_BC.begin()   , m_BC.begin()    + k, data.m_BC.begin()    + i0);
+		std::copy(m_val_t.begin(), m_val_t.begin() + k, data.m_val_t.begin() + i0);
+		std::copy(m_val_p.begin(), m_val_p.begin() + k, data.m_val_p.begin() + i0);
+		std::copy(m_Fr.begin()   , m_Fr.begin()    + k, data.m_Fr.begin()    + i0);
+	}
+
+	m_ID.set(data.m_ID.data() + i0, m);
+	m_BC.set(data.m_BC.data() + i0, m);
+	m_val_t.set(data.m_val_t.data() + i0, m);
+	m_val_p.set(data.m_val_p.data() + i0, m);
+	m_Fr.set(data.m_Fr.data() + i0, m);
+
+	// the node no longer needs its own storage
+	std::vector<int>().swap(m_idata);
+	std::vector<double>().swap(m_ddata);
 }
 
 //-----------------------------------------------------------------------------
-FENode& FENode::operator = (const FENode& n)
+void FENode::CopyGeometry(const FENode& n)
 {
 	m_r0 = n.m_r0;
 	m_rt = n.m_rt;
@@ -96,16 +174,83 @@ FENode& FENode::operator = (const FENode& n)
 	m_nID = n.m_nID;
 	m_rid = n.m_rid;
 	m_nstate = n.m_nstate;
+}
 
-	m_ID = n.m_ID;
-	m_BC = n.m_BC;
-	m_val_t = n.m_val_t;
-	m_val_p = n.m_val_p;
-	m_Fr = n.m_Fr;
+//-----------------------------------------------------------------------------
+// copy the dof values of n, reallocating only if the number of dofs differs
+void FENode::CopyDofs(const FENode& n)
+{
+	if (dofs() != n.dofs()) Allocate(n.dofs());
+	std::copy(n.m_ID.begin()   , n.m_ID.end()   , m_ID.begin());
+	std::copy(n.m_BC.begin()   , n.m_BC.end()   , m_BC.begin());
+	std::copy(n.m_val_t.begin(), n.m_val_t.end(), m_val_t.begin());
+	std::copy(n.m_val_p.begin(), n.m_val_p.end(), m_val_p.begin());
+	std::copy(n.m_Fr.begin()   , n.m_Fr.end()   , m_Fr.begin());
+}
+
+//-----------------------------------------------------------------------------
+// take over the dof storage of n (swapping the vectors keeps the views valid)
+void FENode::MoveDofs(FENode& n)
+{
+	m_idata.swap(n.m_idata);
+	m_ddata.swap(n.m_ddata);
+	std::swap(m_ID, n.m_ID);
+	std::swap(m_BC, n.m_BC);
+	std::swap(m_val_t, n.m_val_t);
+	std::swap(m_val_p, n.m_val_p);
+	std::swap(m_Fr, n.m_Fr);
+}
 
+//-----------------------------------------------------------------------------
+FENode::FENode(const FENode& n)
+{
+	CopyGeometry(n);
+	CopyDofs(n);
+}
+
+//-----------------------------------------------------------------------------
+FENode::FENode(FENode&& n) noexcept
+{
+	CopyGeometry(n);
+	MoveDofs(n);
+}
+
+//-----------------------------------------------------------------------------
+FENode& FENode::operator = (const FENode& n)
+{
+	if (this != &n)
+	{
+		CopyGeometry(n);
+		CopyDofs(n);
+	}
+	return (*this);
+}
+
+//-----------------------------------------------------------------------------
+FENode& FENode::operator = (FENode&& n) noexcept
+{
+	CopyGeometry(n);
+	MoveDofs(n);
 	return (*this);
 }
 
+//-----------------------------------------------------------------------------
+// helper functions for serializing the dof arrays
+// (These use the same format as std::vector so that archives remain compatible.)
+template <typename T> static void save_dofs(DumpStream& ar, const FENodeDofArray<T>& a)
+{
+	std::vector<T> v(a.begin(), a.end());
+	ar << v;
+}
+
+template <typename T> static void load_dofs(DumpStream& ar, FENodeDofArray<T>& a)
+{
+	std::vector<T> v;
+	ar >> v;
+	size_t n = std::min(v.size(), a.size());
+	std::copy(v.begin(), v.begin() + n, a.begin());
+}
+
 //-----------------------------------------------------------------------------
 // Serialize
 void FENode::Serialize(DumpStream& ar)
@@ -113,14 +258,37 @@ void FENode::Serialize(DumpStream& ar)
 	ar & m_nID;
 	ar & m_rt & m_at;
 	ar & m_rp & m_vp & m_ap;
-	ar & m_Fr;
-	ar & m_val_t & m_val_p;
+	if (ar.IsSaving())
+	{
+		save_dofs(ar, m_Fr);
+		save_dofs(ar, m_val_t);
+		save_dofs(ar, m_val_p);
+	}
+	else
+	{
+		// the nodal forces are stored first, so they determine the number of dofs
+		std::vector<double> Fr;
+		ar >> Fr;
+		int n = (int)Fr.size();
+		if (dofs() != n) Allocate(n);
+		std::copy(Fr.begin(), Fr.end(), m_Fr.begin());
+		load_dofs(ar, m_val_t);
+		load_dofs(ar, m_val_p);
+	}
     ar & m_dt & m_dp;
 	if (ar.IsShallow() == false)
 	{
 		ar & m_nstate;
-		ar & m_ID;
-		ar & m_BC;
+		if (ar.IsSaving())
+		{
+			save_dofs(ar, m_ID);
+			save_dofs(ar, m_BC);
+		}
+		else
+		{
+			load_dofs(ar, m_ID);
+			load_dofs(ar, m_BC);
+		}
 		ar & m_r0;
 		ar & m_rid;
 		ar & m_d0;
@@ -131,5 +299,5 @@ void FENode::Serialize(DumpStream& ar)
 //! Update nodal values, which copies the current values to the previous array
 void FENode::UpdateValues()
 {
-	m_val_p = m_val_t;
+	std::copy(m_val_t.begin(), m_val_t.end(), m_val_p.begin());
 }
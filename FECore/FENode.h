@@ -34,6 +34,70 @@ SOFTWARE.*/
 
 class DumpStream;
 
+//-----------------------------------------------------------------------------
+//! View of the values of one node in a per-dof array. The values are stored
+//! in FENodeDofData (for nodes of a mesh) or in the node itself.
+template <typename T> class FENodeDofArray
+{
+public:
+	FENodeDofArray() : m_pd(nullptr), m_n(0) {}
+
+	T& operator [] (int i) { return m_pd[i]; }
+	const T& operator [] (int i) const { return m_pd[i]; }
+
+	size_t size() const { return (size_t)m_n; }
+	bool empty() const { return (m_n == 0); }
+
+	T* begin() { return m_pd; }
+	T* end() { return m_pd + m_n; }
+	const T* begin() const { return m_pd; }
+	const T* end() const { return m_pd + m_n; }
+
+private:
+	void set(T* pd, int n) { m_pd = pd; m_n = n; }
+
+private:
+	T*		m_pd;
+	int		m_n;
+
+	friend class FENode;
+};
+
+//-----------------------------------------------------------------------------
+//! Structure-of-arrays storage for the nodal degrees of freedom of a mesh.
+//! The values of node i are stored at [i*dofs, (i+1)*dofs) in each array.
+class FECORE_API FENodeDofData
+{
+public:
+	FENodeDofData();
+
+	//! allocate storage and set default values
+	void Create(int nodes, int dofs);
+
+	//! change the number of nodes, keeping the values of existing nodes
+	void Resize(int nodes);
+
+	//! release all storage
+	void Clear();
+
+	//! reset the bc flags, current values and nodal forces
+	void Reset();
+
+	int Nodes() const { return m_nodes; }
+	int Dofs() const { return m_dofs; }
+
+public:
+	std::vector<int>		m_ID;		//!< nodal equation numbers
+	std::vector<int>		m_BC;		//!< boundary condition flags
+	std::vector<double>		m_val_t;	//!< current nodal DOF values
+	std::vector<double>		m_val_p;	//!< previous nodal DOF values
+	std::vector<double>		m_Fr;		//!< equivalent nodal forces
+
+private:
+	int		m_nodes;
+	int		m_dofs;
+};
+
 //-----------------------------------------------------------------------------
 //! This class defines a finite element node
 
@@ -44,6 +108,10 @@ class DumpStream;
 //! gives the equation number in the linear system of equations, (b) -1 if the
 //! dof is fixed, and (c) < -1 if the dof corresponds to a prescribed dof. In
 //! that case the corresponding equation number is given by -ID-2.
+//!
+//! The dof arrays (m_ID, m_BC, values and nodal forces) of the nodes of a mesh
+//! are stored contiguously in the mesh (see FENodeDofData). A node that is
+//! copied out of a mesh gets its own storage.
 
 class FECORE_API FENode
 {
@@ -63,12 +131,22 @@ public:
 	//! copy constructor
 	FENode(const FENode& n);
 
+	//! move constructor
+	FENode(FENode&& n) noexcept;
+
 	//! assignment operator
 	FENode& operator = (const FENode& n);
 
+	//! move assignment operator
+	FENode& operator = (FENode&& n) noexcept;
+
 	//! Set the number of DOFS
 	void SetDOFS(int n);
 
+	//! Use the storage of node n in data for the dof arrays
+	//! (If copyValues is true, the node's current values are copied to data first.)
+	void Attach(FENodeDofData& data, int n, bool copyValues = false);
+
 	//! Get the nodal ID
 	int GetID() const { return m_nID; }
 
@@ -154,11 +232,24 @@ public:
     vec3d   m_sp() { return m_rp - m_dp; }
 
 private:
-	std::vector<int>		m_BC;		//!< boundary condition array
-	std::vector<double>		m_val_t;	//!< current nodal DOF values
-	std::vector<double>		m_val_p;	//!< previous nodal DOF values
-	std::vector<double>		m_Fr;		//!< equivalent nodal forces
+	void Allocate(int n);
+	void CopyGeometry(const FENode& n);
+	void CopyDofs(const FENode& n);
+	void MoveDofs(FENode& n);
+
+private:
+	FENodeDofArray<int>		m_BC;		//!< boundary condition array
+	FENodeDofArray<double>	m_val_t;	//!< current nodal DOF values
+	FENodeDofArray<double>	m_val_p;	//!< previous nodal DOF values
+	FENodeDofArray<double>	m_Fr;		//!< equivalent nodal forces
 
 public:
-	std::vector<int>		m_ID;	//!< nodal equation numbers
+	FENodeDofArray<int>		m_ID;	//!< nodal equation numbers
+
+private:
+	// storage of the dof arrays for nodes that are not attached to a mesh
+	std::vector<int>		m_idata;	//!< ID and BC
+	std::vector<double>		m_ddata;	//!< current and previous values, and nodal forces
+
+	friend class FECheckpoint;
 };
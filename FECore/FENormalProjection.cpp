@@ -44,6 +44,13 @@ void FENormalProjection::Init()
 	m_OT.Init(m_tol);
 }
 
+//-----------------------------------------------------------------------------
+void FENormalProjection::Update()
+{
+	m_OT.Attach(&m_surf);
+	m_OT.Update(m_tol);
+}
+
 //-----------------------------------------------------------------------------
 //! This function finds the element which is intersected by the ray (r,n).
 //! It returns a pointer to the element, as well as the isoparametric coordinates
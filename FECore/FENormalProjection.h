@@ -42,6 +42,9 @@ public:
 	// initialization
 	void Init();
 
+	// update after the surface moved (refits or rebuilds the search structures as needed)
+	void Update();
+
 	void SetTolerance(double tol) { m_tol = tol; }
 	void SetSearchRadius(double srad) { m_rad = srad; }
 
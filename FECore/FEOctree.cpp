@@ -50,6 +50,8 @@ void OTnode::CreateChildren(const int max_level, const int max_elem)
 				node.cmax = vec3d(cmax.x-(1-i)*dc.x,
 								  cmax.y-(1-j)*dc.y,
 								  cmax.z-(1-k)*dc.z);
+				node.bmin = node.cmin;
+				node.bmax = node.cmax;
 				// update octree level
 				node.level = level + 1;
 				// find all surface elements in this child node
@@ -134,53 +136,53 @@ bool OTnode::RayIntersectsNode(vec3d p, vec3d n)
 	
 	// check intersection with x-faces
 	if (n.x) {
-		// face passing through cmin
-		t = (cmin.x - p.x)/n.x;
+		// face passing through bmin
+		t = (bmin.x - p.x)/n.x;
 		y = p.y + t*n.y;
 		z = p.z + t*n.z;
-		if ((y >= cmin.y) && (y <= cmax.y)
-			&& (z >= cmin.z) && (z <= cmax.z))
+		if ((y >= bmin.y) && (y <= bmax.y)
+			&& (z >= bmin.z) && (z <= bmax.z))
 			return true;
-		// face passing through cmax
-		t = (cmax.x - p.x)/n.x;
+		// face passing through bmax
+		t = (bmax.x - p.x)/n.x;
 		y = p.y + t*n.y;
 		z = p.z + t*n.z;
-		if ((y >= cmin.y) && (y <= cmax.y)
-			&& (z >= cmin.z) && (z <= cmax.z))
+		if ((y >= bmin.y) && (y <= bmax.y)
+			&& (z >= bmin.z) && (z <= bmax.z))
 			return true;
 	}
 	// check intersection with y-faces
 	if (n.y) {
-		// face passing through cmin
-		t = (cmin.y - p.y)/n.y;
+		// face passing through bmin
+		t = (bmin.y - p.y)/n.y;
 		x = p.x + t*n.x;
 		z = p.z + t*n.z;
-		if ((x >= cmin.x) && (x <= cmax.x)
-			&& (z >= cmin.z) && (z <= cmax.z))
+		if ((x >= bmin.x) && (x <= bmax.x)
+			&& (z >= bmin.z) && (z <= bmax.z))
 			return true;
-		// face passing through cmax
-		t = (cmax.y - p.y)/n.y;
+		// face passing through bmax
+		t = (bmax.y - p.y)/n.y;
 		x = p.x + t*n.x;
 		z = p.z + t*n.z;
-		if ((x >= cmin.x) && (x <= cmax.x)
-			&& (z >= cmin.z) && (z <= cmax.z))
+		if ((x >= bmin.x) && (x <= bmax.x)
+			&& (z >= bmin.z) && (z <= bmax.z))
 			return true;
 	}
 	// check intersection with z-faces
 	if (n.z) {
-		// face passing through cmin
-		t = (cmin.z - p.z)/n.z;
+		// face passing through bmin
+		t = (bmin.z - p.z)/n.z;
 		x = p.x + t*n.x;
 		y = p.y + t*n.y;
-		if ((x >= cmin.x) && (x <= cmax.x)
-			&& (y >= cmin.y) && (y <= cmax.y))
+		if ((x >= bmin.x) && (x <= bmax.x)
+			&& (y >= bmin.y) && (y <= bmax.y))
 			return true;
-		// face passing through cmax
-		t = (cmax.z - p.z)/n.z;
+		// face passing through bmax
+		t = (bmax.z - p.z)/n.z;
 		x = p.x + t*n.x;
 		y = p.y + t*n.y;
-		if ((x >= cmin.x) && (x <= cmax.x)
-			&& (y >= cmin.y) && (y <= cmax.y))
+		if ((x >= bmin.x) && (x <= bmax.x)
+			&& (y >= bmin.y) && (y <= bmax.y))
 			return true;
 	}
 	return false;
@@ -241,6 +243,65 @@ void OTnode::CountNodes(int& nnode, int& nlevel)
 	}
 }
 
+//-----------------------------------------------------------------------------
+// Grow the search box of this node so that it contains the current boxes 
+// of all its surface elements. The search box never shrinks below the node box.
+
+void OTnode::Refit(const vector<vec3d>& emin, const vector<vec3d>& emax)
+{
+	bmin = cmin;
+	bmax = cmax;
+
+	int nc = (int)children.size();
+	if (nc)
+	{
+		for (int i=0; i<nc; ++i)
+		{
+			OTnode& c = children[i];
+			c.Refit(emin, emax);
+			if (c.bmin.x < bmin.x) bmin.x = c.bmin.x;
+			if (c.bmin.y < bmin.y) bmin.y = c.bmin.y;
+			if (c.bmin.z < bmin.z) bmin.z = c.bmin.z;
+			if (c.bmax.x > bmax.x) bmax.x = c.bmax.x;
+			if (c.bmax.y > bmax.y) bmax.y = c.bmax.y;
+			if (c.bmax.z > bmax.z) bmax.z = c.bmax.z;
+		}
+	}
+	else
+	{
+		for (int i=0; i<(int)selist.size(); ++i)
+		{
+			const vec3d& fmin = emin[selist[i]];
+			const vec3d& fmax = emax[selist[i]];
+			if (fmin.x < bmin.x) bmin.x = fmin.x;
+			if (fmin.y < bmin.y) bmin.y = fmin.y;
+			if (fmin.z < bmin.z) bmin.z = fmin.z;
+			if (fmax.x > bmax.x) bmax.x = fmax.x;
+			if (fmax.y > bmax.y) bmax.y = fmax.y;
+			if (fmax.z > bmax.z) bmax.z = fmax.z;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Find the smallest edge of all non-empty leaves
+
+void OTnode::MinLeafSize(double& hmin)
+{
+	int nc = (int)children.size();
+	if (nc)
+	{
+		for (int i=0; i<nc; ++i) children[i].MinLeafSize(hmin);
+	}
+	else if (selist.empty() == false)
+	{
+		vec3d d = cmax - cmin;
+		if (d.x < hmin) hmin = d.x;
+		if (d.y < hmin) hmin = d.y;
+		if (d.z < hmin) hmin = d.z;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -251,6 +312,10 @@ FEOctree::FEOctree(FESurface* ps)
 	max_level = 6;
 	max_elem = 9;
 	assert(max_level && max_elem);
+
+	m_stol = 0.0;
+	m_frac = 0.25;
+	m_hmin = 0.0;
 }
 
 FEOctree::~FEOctree()
@@ -294,6 +359,8 @@ void FEOctree::Init(const double stol)
     double d = (root.cmax - root.cmin).norm()*stol;
     root.cmin -= vec3d(d, d, d);
     root.cmax += vec3d(d, d, d);
+	root.bmin = root.cmin;
+	root.bmax = root.cmax;
 	
 	// Recursively create children of this root
 	if (root.selist.size()) {
@@ -301,10 +368,84 @@ void FEOctree::Init(const double stol)
 			(root.selist.size() > max_elem))
 			root.CreateChildren(max_level, max_elem);
 	}
+
+	// store the data needed to decide when the tree needs to be rebuilt
+	m_stol = stol;
+	m_hmin = (root.cmax - root.cmin).norm();
+	root.MinLeafSize(m_hmin);
+
+	int NN = m_ps->Nodes();
+	m_rb.resize(NN);
+	for (i=0; i<NN; ++i) m_rb[i] = m_ps->Node(i).m_rt;
 	
 	return;
 }
 
+//-----------------------------------------------------------------------------
+
+bool FEOctree::Update(const double stol)
+{
+	assert(m_ps);
+
+	// rebuild if the tree was never built, or the surface or tolerance changed
+	int NN = m_ps->Nodes();
+	if (((int)m_rb.size() != NN) || ((int)root.selist.size() != m_ps->Elements()) || (stol != m_stol))
+	{
+		Init(stol);
+		return true;
+	}
+
+	// find the largest nodal displacement since the last build
+	double dmax2 = 0.0;
+	for (int i=0; i<NN; ++i)
+	{
+		vec3d dr = m_ps->Node(i).m_rt - m_rb[i];
+		double d2 = dr*dr;
+		if (d2 > dmax2) dmax2 = d2;
+	}
+
+	double dtol = m_frac*m_hmin;
+	if (dmax2 > dtol*dtol)
+	{
+		Init(stol);
+		return true;
+	}
+
+	Refit();
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+
+void FEOctree::Refit()
+{
+	// calculate the current element boxes
+	FEMesh& mesh = *(m_ps->GetMesh());
+	int NE = m_ps->Elements();
+	vector<vec3d> emin(NE), emax(NE);
+	for (int i=0; i<NE; ++i)
+	{
+		FESurfaceElement& el = m_ps->Element(i);
+		vec3d fmin = mesh.Node(el.m_node[0]).m_rt;
+		vec3d fmax = fmin;
+		for (int j=1; j<el.Nodes(); ++j)
+		{
+			vec3d r = mesh.Node(el.m_node[j]).m_rt;
+			if (r.x < fmin.x) fmin.x = r.x;
+			if (r.x > fmax.x) fmax.x = r.x;
+			if (r.y < fmin.y) fmin.y = r.y;
+			if (r.y > fmax.y) fmax.y = r.y;
+			if (r.z < fmin.z) fmin.z = r.z;
+			if (r.z > fmax.z) fmax.z = r.z;
+		}
+		emin[i] = fmin;
+		emax[i] = fmax;
+	}
+
+	// grow the node boxes
+	root.Refit(emin, emax);
+}
+
 void FEOctree::FindCandidateSurfaceElements(vec3d p, vec3d n, set<int>& sel)
 {
 	root.FindIntersectedLeaves(p, n, sel);
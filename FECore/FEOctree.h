@@ -50,10 +50,13 @@ public:
 	bool RayIntersectsNode(vec3d p, vec3d n);
 	void FindIntersectedLeaves(vec3d p, vec3d n, std::set<int>& sel);
 	void CountNodes(int& nnode, int& nlevel);
+	void Refit(const vector<vec3d>& emin, const vector<vec3d>& emax);
+	void MinLeafSize(double& hmin);
 	
 public:
 	int				level;		//!< node level
 	vec3d			cmin, cmax;	//!< node bounding box
+	vec3d			bmin, bmax;	//!< search box (node box grown to contain its elements' current boxes)
 	vector<int>		selist;		//!< list of surface elements inside this node
 	vector<OTnode>	children;	//!< children of this node
 	FESurface*		m_ps;		//!< the surface to search
@@ -74,13 +77,31 @@ public:
 	
 	//! initialize search structures
 	void Init(const double stol);
+
+	//! Update the search structures after the surface moved. The tree is only rebuilt
+	//! when a surface node moved more than the rebuild fraction of the smallest leaf size 
+	//! since the last build. Otherwise, the node boxes are refitted to the current 
+	//! element boxes. Returns true if the tree was rebuilt.
+	bool Update(const double stol);
+
+	//! set the fraction of the smallest leaf size that triggers a rebuild
+	void SetRebuildFraction(double f) { m_frac = f; }
 	
 	//! find all candidate surface elements intersected by ray
 	void FindCandidateSurfaceElements(vec3d p, vec3d n, std::set<int>& sel);
+
+protected:
+	//! grow the node boxes so they contain the current element boxes
+	void Refit();
 	
 protected:
 	FESurface*	m_ps;	//!< the surface to search
 	OTnode root;		//!< root node in octree
 	int max_level;		//!< maximum allowable number of levels in octree
 	int max_elem;		//!< maximum allowable number of elements in any node
+
+	double			m_stol;		//!< search tolerance of last build
+	double			m_frac;		//!< rebuild fraction
+	double			m_hmin;		//!< smallest leaf size of last build
+	vector<vec3d>	m_rb;		//!< surface node positions at last build
 };
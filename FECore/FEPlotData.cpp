@@ -39,6 +39,8 @@ FEPlotData::FEPlotData(FEModel* fem) : FECoreBase(fem)
 	m_nregion = FE_REGION_NODE;
 
 	m_arraySize = 0;
+	m_bconcurrent = false;
+	m_bsplit = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -49,6 +51,8 @@ FEPlotData::FEPlotData(FEModel* fem, Region_Type R, Var_Type t, Storage_Fmt s) :
     m_nregion = R;
 
 	m_arraySize = 0;
+	m_bconcurrent = false;
+	m_bsplit = false;
 }
 
 //-----------------------------------------------------------------------------
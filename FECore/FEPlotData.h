@@ -91,16 +91,35 @@ public:
     void SetDomainName(const char* szdom);
 	const char* GetDomainName() { return m_szdom;  }
 
+	//! Returns true if Save can be called concurrently with the Save of other concurrent plot variables
+	bool IsConcurrent() const { return m_bconcurrent; }
+
+	//! Returns true if the domain data can be evaluated over ranges of elements
+	bool IsSplittable() const { return m_bsplit; }
+
 protected:
 	void SetRegionType(Region_Type rt) { m_nregion = rt; }
 	void SetVarType(Var_Type vt) { m_ntype = vt; }
 	void SetStorageFormat(Storage_Fmt sf) { m_sfmt = sf; }
 
+	// Derived classes whose Save functions only read model data (i.e. they
+	// don't modify any member or shared data) can set this flag, which allows 
+	// the plot file to evaluate them in parallel.
+	void SetConcurrent(bool b) { m_bconcurrent = b; }
+
+	// Derived classes that store one value per element (FMT_ITEM) and that 
+	// implement the element range version of Save can set this flag, so that
+	// the plot file can split a domain over several threads.
+	void SetSplittable(bool b) { m_bsplit = b; }
+
 public: // override one of these functions depending on the Region_Type
 	virtual bool Save(FEMesh&    m, FEDataStream& a) { return false; }		// for FE_REGION_NODE
 	virtual bool Save(FEDomain&  D, FEDataStream& a) { return false; }		// for FE_REGION_DOMAIN
 	virtual bool Save(FESurface& S, FEDataStream& a) { return false; }		// for FE_REGION_SURFACE
 
+	// for FE_REGION_DOMAIN, only stores the data of elements [n0, n1)
+	virtual bool Save(FEDomain& D, int n0, int n1, FEDataStream& a) { return false; }
+
 public:
 	// will be called before Save
 	virtual bool PreSave() { return true; }
@@ -118,6 +137,8 @@ private:
 	Storage_Fmt		m_sfmt;			//!< data storage format
 	vector<int>		m_item;			//!< Data will only be stored for the item's in this list
     char			m_szdom[64];	//!< Data will only be stored for the domain with this name
+	bool			m_bconcurrent;	//!< Save can be evaluated concurrently
+	bool			m_bsplit;		//!< domain data can be saved over element ranges
 
 	int				m_arraySize;	//!< size of arrays (used by arrays)
 	vector<string>	m_arrayNames;	//!< optional names of array components (used by arrays)
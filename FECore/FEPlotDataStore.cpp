@@ -65,6 +65,7 @@ FEPlotDataStore::FEPlotDataStore()
 {
     m_plot.clear();
     m_nplot_compression = 0;
+    m_bplot_async = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -72,6 +73,7 @@ FEPlotDataStore::FEPlotDataStore(const FEPlotDataStore& plt)
 {
     m_splot_type = plt.m_splot_type;
     m_nplot_compression = plt.m_nplot_compression;
+    m_bplot_async = plt.m_bplot_async;
     m_plot = plt.m_plot;
 }
 
@@ -80,6 +82,7 @@ void FEPlotDataStore::operator = (const FEPlotDataStore& plt)
 {
     m_splot_type = plt.m_splot_type;
     m_nplot_compression = plt.m_nplot_compression;
+    m_bplot_async = plt.m_bplot_async;
     m_plot = plt.m_plot;
 }
 
@@ -102,6 +105,18 @@ void FEPlotDataStore::SetPlotCompression(int n)
     m_nplot_compression = n;
 }
 
+//-----------------------------------------------------------------------------
+bool FEPlotDataStore::GetPlotAsync() const
+{
+    return m_bplot_async;
+}
+
+//-----------------------------------------------------------------------------
+void FEPlotDataStore::SetPlotAsync(bool b)
+{
+    m_bplot_async = b;
+}
+
 //-----------------------------------------------------------------------------
 void FEPlotDataStore::SetPlotFileType(const std::string& fileType)
 {
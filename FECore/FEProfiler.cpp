@@ -0,0 +1,267 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#include "stdafx.h"
+#include "FEProfiler.h"
+#include "FECoreBase.h"
+#include "sys.h"
+#include <chrono>
+#include <stdio.h>
+#include <assert.h>
+
+//-----------------------------------------------------------------------------
+// data recorded for each thread
+struct FEProfiler::ThreadData
+{
+	struct Event
+	{
+		int		node;		// node in call tree
+		double	start;		// start time (in seconds, relative to m_t0)
+		double	duration;	// duration (in seconds)
+	};
+
+	std::vector<Node>	nodes;	// call tree
+	std::vector<int>	roots;	// root nodes of call tree
+	std::vector<int>	stack;	// currently open regions
+	std::vector<double>	start;	// start times of open regions
+	std::vector<Event>	events;	// trace events
+
+	void clear()
+	{
+		nodes.clear();
+		roots.clear();
+		stack.clear();
+		start.clear();
+		events.clear();
+	}
+};
+
+//-----------------------------------------------------------------------------
+FEProfiler::FEProfiler()
+{
+	m_enabled = false;
+	m_maxEvents = 1000000;
+	m_t0 = Now();
+}
+
+//-----------------------------------------------------------------------------
+FEProfiler::~FEProfiler()
+{
+	for (size_t i = 0; i < m_thread.size(); ++i) delete m_thread[i];
+	m_thread.clear();
+}
+
+//-----------------------------------------------------------------------------
+double FEProfiler::Now() const
+{
+	using namespace std::chrono;
+	return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Enable(bool b)
+{
+	// the thread data is allocated the first time the profiler is enabled
+	if (b && m_thread.empty())
+	{
+		int nt = omp_get_max_threads();
+		if (nt < 1) nt = 1;
+		m_thread.resize(nt);
+		for (int i = 0; i < nt; ++i) m_thread[i] = new ThreadData;
+		m_t0 = Now();
+	}
+	m_enabled = b;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::Reset()
+{
+	for (size_t i = 0; i < m_thread.size(); ++i) m_thread[i]->clear();
+	m_t0 = Now();
+}
+
+//-----------------------------------------------------------------------------
+int FEProfiler::Begin(const char* szname)
+{
+	int tid = omp_get_thread_num();
+	if ((tid < 0) || (tid >= (int)m_thread.size())) return -1;
+	ThreadData& td = *m_thread[tid];
+
+	// find the node in the list of children of the currently open region
+	int parent = (td.stack.empty() ? -1 : td.stack.back());
+	std::vector<int>& siblings = (parent >= 0 ? td.nodes[parent].children : td.roots);
+	int id = -1;
+	for (size_t i = 0; i < siblings.size(); ++i)
+	{
+		if (td.nodes[siblings[i]].name == szname) { id = siblings[i]; break; }
+	}
+
+	// add a new node if this is the first time this region is entered
+	if (id == -1)
+	{
+		id = (int)td.nodes.size();
+		siblings.push_back(id);
+
+		Node node;
+		node.name = szname;
+		node.parent = parent;
+		node.calls = 0;
+		node.time = 0.0;
+		td.nodes.push_back(node);
+	}
+
+	td.stack.push_back(id);
+	td.start.push_back(Now());
+
+	return id;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfiler::End(int id)
+{
+	double t = Now();
+
+	int tid = omp_get_thread_num();
+	if ((tid < 0) || (tid >= (int)m_thread.size())) return;
+	ThreadData& td = *m_thread[tid];
+
+	// this can happen when Reset was called while a region was open
+	if (td.stack.empty() || (td.stack.back() != id)) { assert(td.stack.empty()); return; }
+
+	double t0 = td.start.back();
+	td.stack.pop_back();
+	td.start.pop_back();
+
+	Node& node = td.nodes[id];
+	node.calls++;
+	node.time += t - t0;
+
+	if ((int)td.events.size() < m_maxEvents)
+	{
+		ThreadData::Event ev = { id, t0 - m_t0, t - t0 };
+		td.events.push_back(ev);
+	}
+}
+
+//-----------------------------------------------------------------------------
+int FEProfiler::Threads() const
+{
+	return (int)m_thread.size();
+}
+
+//-----------------------------------------------------------------------------
+int FEProfiler::Nodes(int thread) const
+{
+	return (int)m_thread[thread]->nodes.size();
+}
+
+//-----------------------------------------------------------------------------
+const FEProfiler::Node& FEProfiler::GetNode(int thread, int n) const
+{
+	return m_thread[thread]->nodes[n];
+}
+
+//-----------------------------------------------------------------------------
+// write a string, escaping the characters that are not allowed in JSON strings
+static void write_json_string(FILE* fp, const std::string& s)
+{
+	fputc('"', fp);
+	for (size_t i = 0; i < s.size(); ++i)
+	{
+		char c = s[i];
+		if ((c == '"') || (c == '\\')) { fputc('\\', fp); fputc(c, fp); }
+		else if ((unsigned char)c < 0x20) fputc(' ', fp);
+		else fputc(c, fp);
+	}
+	fputc('"', fp);
+}
+
+//-----------------------------------------------------------------------------
+// The trace file uses the JSON object format of the Chrome trace event format.
+// Each closed region is stored as a complete ("X") event. The call tree summary
+// is stored in an additional "summary" member, which trace viewers ignore.
+bool FEProfiler::WriteTrace(const char* szfile) const
+{
+	FILE* fp = fopen(szfile, "wt");
+	if (fp == nullptr) return false;
+
+	fprintf(fp, "{\n\"displayTimeUnit\": \"ms\",\n\"traceEvents\": [\n");
+	bool first = true;
+	for (size_t n = 0; n < m_thread.size(); ++n)
+	{
+		const ThreadData& td = *m_thread[n];
+		if (td.nodes.empty()) continue;
+
+		if (!first) fprintf(fp, ",\n");
+		fprintf(fp, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"thread %d\"}}", (int)n, (int)n);
+		first = false;
+
+		for (size_t i = 0; i < td.events.size(); ++i)
+		{
+			const ThreadData::Event& ev = td.events[i];
+			fprintf(fp, ",\n{\"name\": ");
+			write_json_string(fp, td.nodes[ev.node].name);
+			fprintf(fp, ", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3lf, \"dur\": %.3lf}", (int)n, ev.start*1e6, ev.duration*1e6);
+		}
+	}
+	fprintf(fp, "\n],\n\"summary\": [\n");
+
+	first = true;
+	for (size_t n = 0; n < m_thread.size(); ++n)
+	{
+		const ThreadData& td = *m_thread[n];
+		for (size_t i = 0; i < td.nodes.size(); ++i)
+		{
+			const Node& node = td.nodes[i];
+
+			// build the full path of this node
+			std::string path = node.name;
+			for (int p = node.parent; p >= 0; p = td.nodes[p].parent) path = td.nodes[p].name + "/" + path;
+
+			if (!first) fprintf(fp, ",\n");
+			fprintf(fp, "{\"thread\": %d, \"path\": ", (int)n);
+			write_json_string(fp, path);
+			fprintf(fp, ", \"calls\": %d, \"time\": %lg}", node.calls, node.time);
+			first = false;
+		}
+	}
+	fprintf(fp, "\n]\n}\n");
+
+	fclose(fp);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void FEProfileScope::Begin(const char* szcategory, FECoreBase* pc)
+{
+	std::string name = pc->GetName();
+	if (name.empty() && pc->GetTypeStr()) name = pc->GetTypeStr();
+	m_id = m_prof->Begin((std::string(szcategory) + ":" + name).c_str());
+}
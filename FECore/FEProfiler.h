@@ -0,0 +1,134 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+
+
+#pragma once
+#include "fecore_api.h"
+#include <vector>
+#include <string>
+
+class FECoreBase;
+
+//-----------------------------------------------------------------------------
+//! The profiler records the time spent in named, nested code regions. 
+//! Each thread keeps its own call tree so that regions can be opened
+//! inside parallel loops. When the profiler is disabled, opening a region
+//! only costs a flag test. 
+//! At the end of a run, the call tree can be printed, or the recorded events 
+//! can be written to a trace file that can be loaded in chrome://tracing or
+//! Perfetto.
+class FECORE_API FEProfiler
+{
+public:
+	//! a node in the call tree
+	struct Node
+	{
+		std::string			name;		//!< name of region
+		int					parent;		//!< index of parent node (-1 for root nodes)
+		int					calls;		//!< number of times the region was entered
+		double				time;		//!< total time spent in region (in seconds)
+		std::vector<int>	children;	//!< child nodes
+	};
+
+public:
+	FEProfiler();
+	~FEProfiler();
+
+	//! enable or disable the profiler
+	void Enable(bool b);
+
+	//! see if the profiler is enabled
+	bool IsEnabled() const { return m_enabled; }
+
+	//! clear all recorded data
+	void Reset();
+
+	//! Set the maximum number of trace events that are stored per thread.
+	//! The call tree is always updated, also when this limit is reached.
+	void SetMaxEvents(int n) { m_maxEvents = n; }
+
+	//! Enter a region. Returns the id that has to be passed to End, or -1
+	//! when nothing is recorded.
+	int Begin(const char* szname);
+
+	//! Leave a region
+	void End(int id);
+
+	//! number of threads for which data is recorded
+	int Threads() const;
+
+	//! number of nodes in a thread's call tree
+	int Nodes(int thread) const;
+
+	//! return a node of a thread's call tree
+	const Node& GetNode(int thread, int n) const;
+
+	//! write the recorded events and the call tree summary to a trace file (JSON)
+	bool WriteTrace(const char* szfile) const;
+
+private:
+	struct ThreadData;
+	double Now() const;
+
+private:
+	bool	m_enabled;
+	int		m_maxEvents;
+	double	m_t0;		//!< time stamp at which recording started
+	std::vector<ThreadData*>	m_thread;
+};
+
+//-----------------------------------------------------------------------------
+// Helper class for recording the time spent in a scope. 
+// For model components (domains, contact interfaces, loads, ...) the region name is 
+// composed of a category and the component's name (or type if it has no name). This
+// name is only constructed when the profiler is enabled.
+class FECORE_API FEProfileScope
+{
+public:
+	FEProfileScope(FEProfiler* prof, const char* szname) : m_prof(prof), m_id(-1)
+	{
+		if (prof && prof->IsEnabled()) m_id = prof->Begin(szname);
+	}
+
+	FEProfileScope(FEProfiler* prof, const char* szcategory, FECoreBase* pc) : m_prof(prof), m_id(-1)
+	{
+		if (prof && prof->IsEnabled()) Begin(szcategory, pc);
+	}
+
+	~FEProfileScope() { if (m_id >= 0) m_prof->End(m_id); }
+
+private:
+	void Begin(const char* szcategory, FECoreBase* pc);
+
+private:
+	FEProfiler*	m_prof;
+	int			m_id;
+};
+
+#define FE_PROFILE_SCOPE(fem, ...) FEProfileScope _profScope((fem)->GetProfiler(), __VA_ARGS__);
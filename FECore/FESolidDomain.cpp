@@ -64,6 +64,9 @@ bool FESolidDomain::Create(int nsize, FE_Element_Spec espec)
 
 	m_elemSpec = espec;
 
+	// the elements changed, so the cache is no longer valid
+	ClearReferenceCache();
+
 	return true;
 }
 
@@ -95,6 +98,7 @@ void FESolidDomain::CopyFrom(FEMeshPartition* pd)
 	FESolidDomain* psd = dynamic_cast<FESolidDomain*>(pd);
     m_Elem = psd->m_Elem;
 	ForEachElement([=](FEElement& el) { el.SetMeshPartition(this); });
+	ClearReferenceCache();
 }
 
 //-----------------------------------------------------------------------------
@@ -104,6 +108,9 @@ bool FESolidDomain::Init()
 	// base class first
 	if (FEDomain::Init() == false) return false;
 
+	// make sure the reference geometry is evaluated from the nodes
+	ClearReferenceCache();
+
 	// init solid element data
 	// TODO: In principle I could parallelize this, but right now this cannot be done
 	//       because of the try block. 
@@ -144,9 +151,102 @@ bool FESolidDomain::Init()
 		return false;
 	}
 
+	// build the reference geometry cache (if requested)
+	UpdateReferenceCache();
+
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+void FESolidDomain::ClearReferenceCache()
+{
+	m_refOffset.clear();
+	m_refGradOffset.clear();
+	m_refDetJ0.clear();
+	m_refJ0.clear();
+	m_refJ0i.clear();
+	m_refGradH.clear();
+}
+
+//-----------------------------------------------------------------------------
+//! Evaluate the reference Jacobians, their inverses and the reference shape function
+//! gradients at all integration points. These are used by invjac0, detJ0, ShapeGradient0
+//! and the reference base vectors instead of recomputing them from the nodal coordinates.
+void FESolidDomain::UpdateReferenceCache()
+{
+	ClearReferenceCache();
+
+	FEModel* fem = GetFEModel();
+	if ((fem == nullptr) || (fem->CacheReferenceGeometry() == false)) return;
+
+	// calculate the offsets
+	int NE = Elements();
+	vector<int> offset(NE + 1), gradOffset(NE + 1);
+	offset[0] = gradOffset[0] = 0;
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		offset[i + 1] = offset[i] + el.GaussPoints();
+		gradOffset[i + 1] = gradOffset[i] + el.GaussPoints()*el.Nodes();
+	}
+
+	vector<double> detJ0(offset[NE]);
+	vector<mat3d> J0(offset[NE]), J0i(offset[NE]);
+	vector<vec3d> gradH(gradOffset[NE]);
+
+	// Evaluate the reference geometry. Since the cache is still empty, this uses the 
+	// same functions as the uncached path so the cached values are identical.
+	bool bok = true;
+#pragma omp parallel for shared(bok)
+	for (int i = 0; i < NE; ++i)
+	{
+		FESolidElement& el = m_Elem[i];
+		int neln = el.Nodes();
+		int nint = el.GaussPoints();
+		try {
+			for (int n = 0; n < nint; ++n)
+			{
+				int m = offset[i] + n;
+
+				double Ji[3][3];
+				detJ0[m] = invjac0(el, Ji, n);
+				J0i[m] = mat3d(Ji);
+
+				vec3d g[3];
+				CoBaseVectors0(el, n, g);
+				J0[m] = mat3d(g[0].x, g[1].x, g[2].x,
+							  g[0].y, g[1].y, g[2].y,
+							  g[0].z, g[1].z, g[2].z);
+
+				vec3d* G = &gradH[gradOffset[i] + n*neln];
+				for (int a = 0; a < neln; ++a)
+				{
+					double Gr = el.Gr(n)[a];
+					double Gs = el.Gs(n)[a];
+					double Gt = el.Gt(n)[a];
+					G[a].x = Ji[0][0] * Gr + Ji[1][0] * Gs + Ji[2][0] * Gt;
+					G[a].y = Ji[0][1] * Gr + Ji[1][1] * Gs + Ji[2][1] * Gt;
+					G[a].z = Ji[0][2] * Gr + Ji[1][2] * Gs + Ji[2][2] * Gt;
+				}
+			}
+		}
+		catch (const NegativeJacobian&)
+		{
+			bok = false;
+		}
+	}
+
+	// Don't cache invalid geometry. The uncached functions will report the problem.
+	if (bok == false) return;
+
+	m_refOffset.swap(offset);
+	m_refGradOffset.swap(gradOffset);
+	m_refDetJ0.swap(detJ0);
+	m_refJ0.swap(J0);
+	m_refJ0i.swap(J0i);
+	m_refGradH.swap(gradH);
+}
+
 //-----------------------------------------------------------------------------
 // Reset data
 void FESolidDomain::Reset()
@@ -157,76 +257,22 @@ void FESolidDomain::Reset()
 }
 
 //-----------------------------------------------------------------------------
-//! This function finds the element in which point y lies and returns
-//! the isoparametric coordinates in r if an element is found
-//! (This has only been implemeneted for hexes!)
+//! This function finds the element in which point y lies (current configuration)
+//! and returns the isoparametric coordinates in r if an element is found.
+//! The search uses the spatial index of the mesh.
 FESolidElement* FESolidDomain::FindElement(const vec3d& y, double r[3])
 {
-    int i, j;
-    int NE = Elements();
-    vec3d x[FEElement::MAX_NODES];
-    for (i=0; i<NE; ++i)
-    {
-        // get the next element
-        FESolidElement& e = Element(i);
-        assert(e.Type() == FE_HEX8G8);
-        
-        // get the element nodal coordinates
-        int neln = e.Nodes();
-        for (j=0; j<neln; ++j) x[j] = m_pMesh->Node(e.m_node[j]).m_rt;
-        
-        // first, as a quick check, we see if y lies in the bounding box defined by x
-        FEBoundingBox box(x[0]);
-        for (j=1; j<neln; ++j) box.add(x[j]);
-        
-        if (box.IsInside(y))
-        {
-			// If the point y lies inside the box, we apply a Newton method to find
-			// the isoparametric coordinates r
-			ProjectToElement(e, y, r);
-            
-            // see if the point r lies inside the element
-            const double eps = 1.0001;
-            if ((r[0] >= -eps) && (r[0] <= eps) &&
-                (r[1] >= -eps) && (r[1] <= eps) &&
-                (r[2] >= -eps) && (r[2] <= eps)) return &e;
-        }
-    }
-    return 0;
+	return m_pMesh->FindSolidElement(y, r, this);
 }
 
-
 //-----------------------------------------------------------------------------
 //! This function finds the element in which point y lies and returns
 //! the isoparametric coordinates in r if an element is found
 FESolidElement* FESolidDomain::FindReferenceElement(const vec3d& y, double r[3])
 {
-	int NE = Elements();
-	vec3d x[FEElement::MAX_NODES];
-	for (int i = 0; i<NE; ++i)
-	{
-		// get the next element
-		FESolidElement& e = Element(i);
-
-		// get the element nodal coordinates
-		int neln = e.Nodes();
-		for (int j = 0; j<neln; ++j) x[j] = m_pMesh->Node(e.m_node[j]).m_r0;
-
-		// first, as a quick check, we see if y lies in the bounding box defined by x
-		FEBoundingBox box(x[0]);
-		for (int j = 1; j<neln; ++j) box.add(x[j]);
-
-		if (box.IsInside(y))
-		{
-			// If the point y lies inside the box, we apply a Newton method to find
-			// the isoparametric coordinates r
-			if (ProjectToReferenceElement(e, y, r)) return &e;
-		}
-	}
-	return 0;
+	return m_pMesh->FindReferenceSolidElement(y, r, this);
 }
 
-
 //-----------------------------------------------------------------------------
 void FESolidDomain::ProjectToElement(FESolidElement& el, const vec3d& p, double r[3])
 {
@@ -241,6 +287,7 @@ void FESolidDomain::ProjectToElement(FESolidElement& el, const vec3d& p, double
     const double tol = 1e-5;
     double dr[3], norm;
 	double H[MN], Gr[MN], Gs[MN], Gt[MN];
+    int ncount = 0;
     do
     {
 		// evaluate shape functions
@@ -272,7 +319,7 @@ void FESolidDomain::ProjectToElement(FESolidElement& el, const vec3d& p, double
                 
         norm = dr[0]*dr[0] + dr[1]*dr[1] + dr[2]*dr[2];
     }
-    while (norm > tol);	
+    while ((norm > tol) && (++ncount < 100));
 }
 
 //-----------------------------------------------------------------------------
@@ -326,6 +373,13 @@ bool FESolidDomain::ProjectToReferenceElement(FESolidElement& el, const vec3d& p
     while (norm > tol);
 
 	// check if point is inside element
+	return IsInsideElement(el, r);
+}
+
+//-----------------------------------------------------------------------------
+//! Check if the natural coordinates r lie inside the element's parametric domain
+bool FESolidDomain::IsInsideElement(const FESolidElement& el, const double r[3])
+{
 	if ((el.Shape() == ET_HEX8) || (el.Shape() == ET_HEX20) || (el.Shape() == ET_HEX27))
 	{
 		const double eps = 1.0001;
@@ -1037,6 +1091,16 @@ double FESolidDomain::defgradp(FESolidElement &el, mat3d &F, int n)
 //! The return value is the determinant of the Jacobian (not the inverse!)
 double FESolidDomain::invjac0(const FESolidElement& el, double Ji[3][3], int n)
 {
+	// see if we can use the cached values
+	int m = ReferenceCacheIndex(el, n);
+	if (m >= 0)
+	{
+		const mat3d& Jc = m_refJ0i[m];
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j) Ji[i][j] = Jc(i, j);
+		return m_refDetJ0[m];
+	}
+
     // nodal coordinates
     vec3d r0[FEElement::MAX_NODES];
 	GetReferenceNodalCoordinates(el, r0);
@@ -1858,6 +1922,10 @@ double FESolidDomain::detJt(FESolidElement &el, int n, const double alpha)
 //! Calculate jacobian with respect to reference frame
 double FESolidDomain::detJ0(FESolidElement &el, int n)
 {
+	// see if we can use the cached value
+	int m = ReferenceCacheIndex(el, n);
+	if (m >= 0) return m_refDetJ0[m];
+
     // nodal coordinates
     vec3d r0[FEElement::MAX_NODES];
 	GetReferenceNodalCoordinates(el, r0);
@@ -1899,6 +1967,17 @@ double FESolidDomain::detJ0(FESolidElement &el, int n)
 
 void FESolidDomain::CoBaseVectors0(FESolidElement& el, int j, vec3d g[3])
 {
+	// see if we can use the cached values
+	int m = ReferenceCacheIndex(el, j);
+	if (m >= 0)
+	{
+		const mat3d& J = m_refJ0[m];
+		g[0] = J.col(0);
+		g[1] = J.col(1);
+		g[2] = J.col(2);
+		return;
+	}
+
     // get the shape function derivatives
     double* Hr = el.Gr(j);
     double* Hs = el.Gs(j);
@@ -1974,6 +2053,17 @@ void FESolidDomain::CoBaseVectors(FESolidElement& el, int j, vec3d g[3], const d
 
 void FESolidDomain::ContraBaseVectors0(FESolidElement& el, int j, vec3d gcnt[3])
 {
+	// see if we can use the cached values
+	int m = ReferenceCacheIndex(el, j);
+	if (m >= 0)
+	{
+		const mat3d& Ji = m_refJ0i[m];
+		gcnt[0] = vec3d(Ji(0,0),Ji(0,1),Ji(0,2));
+		gcnt[1] = vec3d(Ji(1,0),Ji(1,1),Ji(1,2));
+		gcnt[2] = vec3d(Ji(2,0),Ji(2,1),Ji(2,2));
+		return;
+	}
+
     vec3d gcov[3];
     CoBaseVectors0(el, j, gcov);
     
@@ -2346,6 +2436,16 @@ double FESolidDomain::ShapeGradient(FESolidElement& el, int n, vec3d* GradH, con
 //-----------------------------------------------------------------------------
 double FESolidDomain::ShapeGradient0(FESolidElement& el, int n, vec3d* GradH)
 {
+	// see if we can use the cached values
+	int m = ReferenceCacheIndex(el, n);
+	if (m >= 0)
+	{
+		int ne = el.Nodes();
+		const vec3d* G = &m_refGradH[m_refGradOffset[el.GetLocalID()] + n*ne];
+		for (int i = 0; i < ne; ++i) GradH[i] = G[i];
+		return m_refDetJ0[m];
+	}
+
     // calculate jacobian
     double Ji[3][3];
     double detJ0 = invjac0(el, Ji, n);
@@ -2583,7 +2683,7 @@ void FESolidDomain::LoadVector(
 			for (int j = 0; j < neln; ++j)
 			{
 				FENode& node = mesh.Node(el.m_node[j]);
-				vector<int>& ID = node.m_ID;
+				FENodeDofArray<int>& ID = node.m_ID;
 				for (int k = 0; k < dofPerNode; ++k)
 				{
 					lm[dofPerNode*j + k] = ID[dofList[k]];
@@ -2658,7 +2758,7 @@ void FESolidDomain::LoadStiffness(FELinearSystem& LS, const FEDofList& dofList_a
 		for (int j = 0; j < neln; ++j)
 		{
 			FENode& node = mesh.Node(el.m_node[j]);
-			std::vector<int>& ID = node.m_ID;
+			FENodeDofArray<int>& ID = node.m_ID;
 
 			for (int k = 0; k < dofPerNode_a; ++k)
 				lma[dofPerNode_a*j + k] = ID[dofList_a[k]];
@@ -89,6 +89,9 @@ public:
 	//! returns true if the point lies in the element
 	bool ProjectToReferenceElement(FESolidElement& el, const vec3d& p, double r[3]);
 
+	//! check if the natural coordinates r lie inside the element
+	static bool IsInsideElement(const FESolidElement& el, const double r[3]);
+
     //! Calculate deformation gradient at integration point n
     double defgrad(FESolidElement& el, mat3d& F, int n);
 	double defgrad(FESolidElement& el, mat3d& F, int n, vec3d* r);
@@ -258,6 +261,21 @@ public:
 	//! get the nodal coordinates at previous state
 	void GetPreviousNodalCoordinates(const FESolidElement& el, vec3d* rp);
 
+public:
+	//! Rebuild the reference geometry cache. The cache is only created when the
+	//! model's cache_reference_geometry flag is set. Otherwise it is cleared.
+	void UpdateReferenceCache();
+
+	//! clear the reference geometry cache
+	void ClearReferenceCache();
+
+	//! see if the reference geometry is cached
+	bool HasReferenceCache() const { return (m_refOffset.empty() == false); }
+
+protected:
+	//! index of integration point n of element el in the reference geometry cache (or -1 if not cached)
+	int ReferenceCacheIndex(const FESolidElement& el, int n) const;
+
 public:
 	//! loop over elements
 	void ForEachSolidElement(std::function<void(FESolidElement& el)> f);
@@ -287,4 +305,21 @@ protected:
 
 	FEDofList	m_dofU;
 	FEDofList	m_dofSU;
+
+	// Optional cache of the reference geometry at the integration points.
+	// Integration point n of element i is stored at index m_refOffset[i] + n.
+	// The shape function gradients of that point start at m_refGradOffset[i] + n*neln.
+	vector<int>		m_refOffset;		//!< offset of first integration point of each element
+	vector<int>		m_refGradOffset;	//!< offset of first shape function gradient of each element
+	vector<double>	m_refDetJ0;			//!< reference Jacobian determinants
+	vector<mat3d>	m_refJ0;			//!< reference Jacobians (columns are the covariant basis vectors)
+	vector<mat3d>	m_refJ0i;			//!< inverse reference Jacobians
+	vector<vec3d>	m_refGradH;			//!< shape function gradients in reference frame
 };
+
+//-----------------------------------------------------------------------------
+inline int FESolidDomain::ReferenceCacheIndex(const FESolidElement& el, int n) const
+{
+	if (m_refOffset.empty() || (el.GetMeshPartition() != this)) return -1;
+	return m_refOffset[el.GetLocalID()] + n;
+}
@@ -805,7 +805,7 @@ FENodalDofInfo FESolver::GetDOFInfoFromEquation(int ieq)
 	for (int i = 0; i < mesh.Nodes(); ++i)
 	{
 		FENode& node = mesh.Node(i);
-		vector<int>& id = node.m_ID;
+		FENodeDofArray<int>& id = node.m_ID;
 		for (int j = 0; j < id.size(); ++j)
 		{
 			if (id[j] == ieq)
@@ -82,6 +82,7 @@ struct FENodalDofInfo
 //-----------------------------------------------------------------------------
 class FEModel;
 class FEGlobalMatrix;
+class FEMemoryReport;
 class LinearSolver;
 class FEGlobalVector;
 
@@ -168,6 +169,9 @@ public:
 	//! build the matrix profile
 	virtual void BuildMatrixProfile(FEGlobalMatrix& G, bool breset);
 
+	//! add the memory used by the solver to the report
+	virtual void MemoryReport(FEMemoryReport& report) {}
+
 	// see if the dofs in the dof list are active in this solver
 	bool HasActiveDofs(const FEDofList& dof);
 
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #include "stdafx.h"
 #include "FESurfacePairConstraint.h"
+#include "FESurface.h"
 
 REGISTER_SUPER_CLASS(FESurfacePairConstraint, FESURFACEPAIRINTERACTION_ID);
 
@@ -43,3 +44,14 @@ int FESurfacePairConstraint::InitEquations(int neq) { return 0; }
 
 //-----------------------------------------------------------------------------
 void FESurfacePairConstraint::Update(vector<double>& ui) {}
+
+//-----------------------------------------------------------------------------
+size_t FESurfacePairConstraint::MemoryUsage()
+{
+	size_t bytes = 0;
+	FESurface* ps = GetPrimarySurface();
+	if (ps) bytes += ps->MemoryUsage();
+	FESurface* ss = GetSecondarySurface();
+	if (ss && (ss != ps)) bytes += ss->MemoryUsage();
+	return bytes;
+}
@@ -79,5 +79,9 @@ public:
 	// update based on solution (use for updating Lagrange Multipliers)
 	virtual void Update(vector<double>& ui);
 
+	// Estimate of the memory (in bytes) used by this interface. The default returns 
+	// the memory used by the two surfaces.
+	virtual size_t MemoryUsage();
+
 	using FEModelComponent::Update;
 };
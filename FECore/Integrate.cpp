@@ -154,10 +154,7 @@ void FECORE_API IntegrateNCN(FESolidDomain& dom, FESolidElement& el, double C, m
 FECORE_API void AssembleSolidDomain(FESolidDomain& dom, FELinearSystem& ls, std::function<void(FESolidElement& el, matrix& ke)> elementIntegrand)
 {
 	// loop over all elements in domain
-	int NE = dom.Elements();
-#pragma omp parallel for shared (NE)
-	for (int i = 0; i<NE; ++i)
-	{
+	dom.ParallelElementLoop(ls, [&](int i) {
 		FESolidElement& el = dom.Element(i);
 		int ndofs = dom.GetElementDofs(el);
 
@@ -173,7 +170,7 @@ FECORE_API void AssembleSolidDomain(FESolidDomain& dom, FELinearSystem& ls, std:
 		ke.SetNodes(el.m_node);
 		ke.SetIndices(lm);
 		ls.Assemble(ke);
-	}
+	});
 }
 
 //-----------------------------------------------------------------------------
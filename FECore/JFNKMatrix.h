@@ -90,6 +90,9 @@ public: // these functions use the actual sparse matrix m_K
 	//! release memory for storing data
 	void Clear() override { m_K->Clear(); }
 
+	//! turn atomic assembly on or off
+	void SetAtomicAssembly(bool b) override { m_batomic = b; if (m_K) m_K->SetAtomicAssembly(b); }
+
 	// interface to compact matrices
 	double* Values() override { return m_K->Values(); }
 	int*    Indices() override { return m_K->Indices(); }
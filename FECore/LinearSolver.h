@@ -112,6 +112,10 @@ public:
 	// returns whether this is an iterative solver or not
 	virtual bool IsIterative() const;
 
+	//! Estimate of the memory (in bytes) used by the solver (e.g. for storing the factorization),
+	//! not counting the sparse matrix. Returns zero if unknown.
+	virtual size_t MemoryUsage() { return 0; }
+
 public:
 	const LinearSolverStats& GetStats() const;
 
@@ -0,0 +1,348 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#include "stdafx.h"
+#include "MBytecode.h"
+#include <math.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <cstring>
+#include <cassert>
+
+//-----------------------------------------------------------------------------
+// the max (absolute) value of integer exponents that are evaluated by multiplication
+#define MAX_POWI	64
+
+// batch size used for evaluating multiple variable sets
+#define BATCH_SIZE	64
+
+//-----------------------------------------------------------------------------
+// integer power via repeated squaring
+inline double powi(double x, int n)
+{
+	unsigned int m = (n < 0 ? -n : n);
+	double y = 1.0;
+	while (m)
+	{
+		if (m & 1) y *= x;
+		x *= x;
+		m >>= 1;
+	}
+	return (n < 0 ? 1.0 / y : y);
+}
+
+//-----------------------------------------------------------------------------
+MBytecode::MBytecode()
+{
+	m_bvalid = false;
+	m_out = -1;
+}
+
+//-----------------------------------------------------------------------------
+void MBytecode::Clear()
+{
+	m_bvalid = false;
+	m_const.clear();
+	m_code.clear();
+	m_out = -1;
+}
+
+//-----------------------------------------------------------------------------
+bool MBytecode::Compile(const MItem* pi)
+{
+	Clear();
+	if (pi == nullptr) return false;
+
+	// While compiling, constants are referred to by negative register numbers 
+	// (i.e. constant k is register -k-1) and instructions by their index.
+	m_out = compile(pi);
+	if (m_out == INT_MIN)
+	{
+		Clear();
+		return false;
+	}
+
+	// map the registers to their final location
+	finalize();
+	m_bvalid = true;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// returns the register that stores the value of the item, or INT_MIN on failure.
+int MBytecode::compile(const MItem* pi)
+{
+	const int FAILED = INT_MIN;
+
+	switch (pi->Type())
+	{
+	case MCONST:
+	case MFRAC :
+	case MNAMED:
+		return constant(mnumber(pi)->value());
+	case MVAR:
+		{
+			int n = mvar(pi)->index();
+			if (n < 0) return FAILED;
+			return emit(OP_VAR, n, 0);
+		}
+		break;
+	case MNEG:
+		{
+			int a = compile(munary(pi)->Item()); if (a == FAILED) return FAILED;
+			if (a < 0) return constant(-value(a));
+			return emit(OP_NEG, a, 0);
+		}
+		break;
+	case MADD:
+	case MSUB:
+	case MMUL:
+	case MDIV:
+		{
+			int a = compile(mbinary(pi)->LeftItem()); if (a == FAILED) return FAILED;
+			int b = compile(mbinary(pi)->RightItem()); if (b == FAILED) return FAILED;
+			if ((a < 0) && (b < 0))
+			{
+				double va = value(a), vb = value(b);
+				switch (pi->Type())
+				{
+				case MADD: return constant(va + vb);
+				case MSUB: return constant(va - vb);
+				case MMUL: return constant(va * vb);
+				case MDIV: return constant(va / vb);
+				}
+			}
+			switch (pi->Type())
+			{
+			case MADD: return emit(OP_ADD, a, b);
+			case MSUB: return emit(OP_SUB, a, b);
+			case MMUL: return emit(OP_MUL, a, b);
+			case MDIV: return emit(OP_DIV, a, b);
+			}
+		}
+		break;
+	case MPOW:
+		{
+			int a = compile(mbinary(pi)->LeftItem()); if (a == FAILED) return FAILED;
+			int b = compile(mbinary(pi)->RightItem()); if (b == FAILED) return FAILED;
+			if ((a < 0) && (b < 0)) return constant(pow(value(a), value(b)));
+			if (b < 0)
+			{
+				// integer exponents are replaced by multiplications
+				double vb = value(b);
+				int n = (int)vb;
+				if (((double)n == vb) && (abs(n) <= MAX_POWI))
+				{
+					if (n == 0) return constant(1.0);
+					if (n == 1) return a;
+					if (n == 2) return emit(OP_MUL, a, a);
+					return emit(OP_POWI, a, n);
+				}
+			}
+			return emit(OP_POW, a, b);
+		}
+		break;
+	case MF1D:
+		{
+			FUNCPTR f = mfnc1d(pi)->funcptr();
+			int a = compile(munary(pi)->Item()); if (a == FAILED) return FAILED;
+			if (a < 0) return constant(f(value(a)));
+			return emit(OP_F1D, a, 0, f);
+		}
+		break;
+	case MF2D:
+		{
+			FUNC2PTR f = mfnc2d(pi)->funcptr();
+			int a = compile(mbinary(pi)->LeftItem()); if (a == FAILED) return FAILED;
+			int b = compile(mbinary(pi)->RightItem()); if (b == FAILED) return FAILED;
+			if ((a < 0) && (b < 0)) return constant(f(value(a), value(b)));
+			return emit(OP_F2D, a, b, nullptr, f);
+		}
+		break;
+	case MSFNC:
+		return compile(msfncnd(pi)->Value());
+	}
+
+	// everything else cannot be compiled
+	return FAILED;
+}
+
+//-----------------------------------------------------------------------------
+// add a constant register (or find an existing one with the same value)
+int MBytecode::constant(double v)
+{
+	for (size_t i = 0; i < m_const.size(); ++i)
+	{
+		if (memcmp(&m_const[i], &v, sizeof(double)) == 0) return -(int)i - 1;
+	}
+	m_const.push_back(v);
+	return -(int)m_const.size();
+}
+
+//-----------------------------------------------------------------------------
+// add an instruction, unless an identical instruction already exists.
+int MBytecode::emit(int op, int a, int b, FUNCPTR f1, FUNC2PTR f2)
+{
+	// commutative operations are stored with sorted operands
+	if (((op == OP_ADD) || (op == OP_MUL)) && (a > b)) { int t = a; a = b; b = t; }
+
+	// common sub-expression elimination
+	for (size_t i = 0; i < m_code.size(); ++i)
+	{
+		const Instruction& c = m_code[i];
+		if ((c.op == op) && (c.a == a) && (c.b == b) && (c.f1 == f1) && (c.f2 == f2)) return (int)i;
+	}
+
+	Instruction c = { op, a, b, f1, f2 };
+	m_code.push_back(c);
+	return (int)m_code.size() - 1;
+}
+
+//-----------------------------------------------------------------------------
+// return the value of a constant register (only used during compilation)
+double MBytecode::value(int reg) const
+{
+	assert(reg < 0);
+	return m_const[-reg - 1];
+}
+
+//-----------------------------------------------------------------------------
+// Map the registers so that the constants are stored first, followed by the
+// results of the instructions.
+void MBytecode::finalize()
+{
+	int nc = (int)m_const.size();
+	for (size_t i = 0; i < m_code.size(); ++i)
+	{
+		Instruction& c = m_code[i];
+		switch (c.op)
+		{
+		case OP_VAR : break;
+		case OP_NEG :
+		case OP_POWI:
+		case OP_F1D :
+			c.a = (c.a < 0 ? -c.a - 1 : nc + c.a);
+			break;
+		default:
+			c.a = (c.a < 0 ? -c.a - 1 : nc + c.a);
+			c.b = (c.b < 0 ? -c.b - 1 : nc + c.b);
+		}
+	}
+	m_out = (m_out < 0 ? -m_out - 1 : nc + m_out);
+}
+
+//-----------------------------------------------------------------------------
+double MBytecode::Evaluate(const double* var) const
+{
+	assert(m_bvalid);
+	const int nc = (int)m_const.size();
+	const int nr = nc + (int)m_code.size();
+
+	// use a stack buffer for the registers, unless the program is large
+	double buf[256];
+	std::vector<double> tmp;
+	double* r = buf;
+	if (nr > 256) { tmp.resize(nr); r = &tmp[0]; }
+
+	for (int i = 0; i < nc; ++i) r[i] = m_const[i];
+
+	double* t = r + nc;
+	const int ni = (int)m_code.size();
+	for (int i = 0; i < ni; ++i)
+	{
+		const Instruction& c = m_code[i];
+		switch (c.op)
+		{
+		case OP_VAR : t[i] = var[c.a]; break;
+		case OP_NEG : t[i] = -r[c.a]; break;
+		case OP_ADD : t[i] = r[c.a] + r[c.b]; break;
+		case OP_SUB : t[i] = r[c.a] - r[c.b]; break;
+		case OP_MUL : t[i] = r[c.a] * r[c.b]; break;
+		case OP_DIV : t[i] = r[c.a] / r[c.b]; break;
+		case OP_POW : t[i] = pow(r[c.a], r[c.b]); break;
+		case OP_POWI: t[i] = powi(r[c.a], c.b); break;
+		case OP_F1D : t[i] = c.f1(r[c.a]); break;
+		case OP_F2D : t[i] = c.f2(r[c.a], r[c.b]); break;
+		}
+	}
+
+	return r[m_out];
+}
+
+//-----------------------------------------------------------------------------
+// The program is evaluated in batches, one instruction at a time for all 
+// variable sets in the batch, so that the inner loops can be vectorized.
+void MBytecode::Evaluate(int n, const double* var, double* out) const
+{
+	assert(m_bvalid);
+	const int B = BATCH_SIZE;
+	const int nc = (int)m_const.size();
+	const int nr = nc + (int)m_code.size();
+	const int ni = (int)m_code.size();
+
+	// register arrays
+	std::vector<double> R(nr*B);
+	for (int i = 0; i < nc; ++i)
+	{
+		for (int k = 0; k < B; ++k) R[i*B + k] = m_const[i];
+	}
+
+	for (int k0 = 0; k0 < n; k0 += B)
+	{
+		const int nb = (n - k0 < B ? n - k0 : B);
+		for (int i = 0; i < ni; ++i)
+		{
+			const Instruction& c = m_code[i];
+			double* t = &R[(nc + i)*B];
+			const double* a = (c.op == OP_VAR ? var + c.a*n + k0 : &R[c.a*B]);
+			switch (c.op)
+			{
+			case OP_VAR : for (int k = 0; k < nb; ++k) t[k] = a[k]; break;
+			case OP_NEG : for (int k = 0; k < nb; ++k) t[k] = -a[k]; break;
+			case OP_POWI: for (int k = 0; k < nb; ++k) t[k] = powi(a[k], c.b); break;
+			case OP_F1D : for (int k = 0; k < nb; ++k) t[k] = c.f1(a[k]); break;
+			default:
+				{
+					const double* b = &R[c.b*B];
+					switch (c.op)
+					{
+					case OP_ADD: for (int k = 0; k < nb; ++k) t[k] = a[k] + b[k]; break;
+					case OP_SUB: for (int k = 0; k < nb; ++k) t[k] = a[k] - b[k]; break;
+					case OP_MUL: for (int k = 0; k < nb; ++k) t[k] = a[k] * b[k]; break;
+					case OP_DIV: for (int k = 0; k < nb; ++k) t[k] = a[k] / b[k]; break;
+					case OP_POW: for (int k = 0; k < nb; ++k) t[k] = pow(a[k], b[k]); break;
+					case OP_F2D: for (int k = 0; k < nb; ++k) t[k] = c.f2(a[k], b[k]); break;
+					}
+				}
+			}
+		}
+
+		const double* r = &R[m_out*B];
+		for (int k = 0; k < nb; ++k) out[k0 + k] = r[k];
+	}
+}
@@ -0,0 +1,100 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+#pragma once
+#include "MItem.h"
+#include "fecore_api.h"
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// This class compiles a math expression into a flat, register-based program
+// that can be evaluated much faster than walking the expression tree.
+// During compilation, constant sub-expressions are folded and common
+// sub-expressions are evaluated only once. 
+// The program only depends on the variable indices, so evaluation is thread safe.
+class FECORE_API MBytecode
+{
+	enum OpCode {
+		OP_VAR,		// load a variable
+		OP_NEG,		// -a
+		OP_ADD,		// a + b
+		OP_SUB,		// a - b
+		OP_MUL,		// a * b
+		OP_DIV,		// a / b
+		OP_POW,		// pow(a, b)
+		OP_POWI,	// a^n (integer n)
+		OP_F1D,		// f(a)
+		OP_F2D		// f(a, b)
+	};
+
+	struct Instruction
+	{
+		int			op;		// op code
+		int			a, b;	// operand registers (or variable index for OP_VAR, or exponent for OP_POWI)
+		FUNCPTR		f1;		// function pointer for OP_F1D
+		FUNC2PTR	f2;		// function pointer for OP_F2D
+	};
+
+public:
+	MBytecode();
+
+	// compile an expression. Returns false if the expression contains items 
+	// that cannot be compiled, in which case the program remains invalid.
+	bool Compile(const MItem* pi);
+
+	// clear the program
+	void Clear();
+
+	// see if the program was compiled successfully
+	bool IsValid() const { return m_bvalid; }
+
+	// evaluate the program for one set of variable values
+	double Evaluate(const double* var) const;
+
+	// evaluate the program for n sets of variable values. The values are stored
+	// per variable, i.e. var[i*n + k] is the value of variable i for set k.
+	void Evaluate(int n, const double* var, double* out) const;
+
+	// number of instructions in the program
+	int Instructions() const { return (int)m_code.size(); }
+
+	// number of (constant) registers
+	int Constants() const { return (int)m_const.size(); }
+
+private:
+	int compile(const MItem* pi);
+	int constant(double v);
+	int emit(int op, int a, int b, FUNCPTR f1 = nullptr, FUNC2PTR f2 = nullptr);
+	double value(int reg) const;
+	void finalize();
+
+private:
+	bool						m_bvalid;	// program was compiled successfully
+	std::vector<double>			m_const;	// constant registers
+	std::vector<Instruction>	m_code;		// the instructions
+	int							m_out;		// the register that holds the result
+};
@@ -208,6 +208,7 @@ MSimpleExpression::MSimpleExpression(const MSimpleExpression& mo) : MathObject(m
 	// The copy c'tor of MathObject copied the variables, but any MVarRefs still point to the mo object, not this object's var list.
 	// Calling the following function fixes this
 	fixVariableRefs(m_item.ItemPtr());
+	compile();
 }
 
 //-----------------------------------------------------------------------------
@@ -222,6 +223,31 @@ void MSimpleExpression::operator=(const MSimpleExpression& mo)
 	// The = operator of MathObject copied the variables, but any MVarRefs still point to the mo object, not this object's var list.
 	// Calling the following function fixes this
 	fixVariableRefs(m_item.ItemPtr());
+	compile();
+}
+
+//-----------------------------------------------------------------------------
+void MSimpleExpression::compile()
+{
+	// Note that sequences (and other items that cannot be evaluated to a number)
+	// will fail to compile, in which case value_s falls back to the tree evaluation.
+	m_prg.Compile(m_item.ItemPtr());
+}
+
+//-----------------------------------------------------------------------------
+void MSimpleExpression::value_s(int n, const double* var, double* out) const
+{
+	if (m_prg.IsValid()) m_prg.Evaluate(n, var, out);
+	else
+	{
+		int nvar = (int)m_Var.size();
+		std::vector<double> v(nvar);
+		for (int k = 0; k < n; ++k)
+		{
+			for (int i = 0; i < nvar; ++i) v[i] = var[i*n + k];
+			out[k] = value(m_item.ItemPtr(), v);
+		}
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -28,6 +28,7 @@ SOFTWARE.*/
 
 #pragma once
 #include "MItem.h"
+#include "MBytecode.h"
 #include <vector>
 #include "fecore_api.h"
 
@@ -76,8 +77,9 @@ public:
 	MSimpleExpression(const MSimpleExpression& mo);
 	void operator = (const MSimpleExpression& mo);
 
-	void SetExpression(MITEM& e) { m_item = e; }
-	MITEM& GetExpression() { return m_item; }
+	void SetExpression(MITEM& e) { m_item = e; compile(); }
+
+	// The expression can only be changed via SetExpression, which recompiles it.
 	const MITEM& GetExpression() const { return m_item; }
 
 	// Create a simple expression object from a string
@@ -97,9 +99,18 @@ public:
 	double value_s(const std::vector<double>& var) const
 	{ 
 		assert(var.size() == m_Var.size());
+		if (m_prg.IsValid()) return m_prg.Evaluate(var.data());
 		return value(m_item.ItemPtr(), var); 
 	}
 
+	// Thread safe function to evaluate the expression for n sets of variables. 
+	// The values are stored per variable, i.e. var[i*n + k] is the value of 
+	// the i-th variable for set k. The results are stored in out, which must have size n.
+	void value_s(int n, const double* var, double* out) const;
+
+	// Compile the expression. This is done automatically when the expression is set.
+	void compile();
+
 	int Items();
 
 protected:
@@ -110,5 +121,6 @@ protected:
 	void fixVariableRefs(MItem* pi);
 
 protected:
-	MITEM	m_item;
+	MITEM		m_item;
+	MBytecode	m_prg;		// compiled expression, used by value_s
 };
@@ -357,3 +357,70 @@ SparseMatrixProfile SparseMatrixProfile::GetBlockProfile(int nrow0, int ncol0, i
 
 	return bMP;
 }
+
+//-----------------------------------------------------------------------------
+//! See if all entries of this profile are also in profile mp. 
+bool SparseMatrixProfile::IsSubsetOf(const SparseMatrixProfile& mp) const
+{
+	if ((m_nrow != mp.m_nrow) || (m_ncol != mp.m_ncol)) return false;
+
+	for (int j = 0; j < m_ncol; ++j)
+	{
+		const ColumnProfile& a = m_prof[j];
+		const ColumnProfile& b = mp.m_prof[j];
+		int na = a.size();
+		int nb = b.size();
+
+		// Both columns store sorted intervals, so we can walk them simultaneously
+		int k = 0;
+		for (int i = 0; i < na; ++i)
+		{
+			int n0 = a[i].start;
+			int n1 = a[i].end;
+			while (n0 <= n1)
+			{
+				while ((k < nb) && (b[k].end < n0)) ++k;
+				if ((k >= nb) || (b[k].start > n0)) return false;
+				n0 = b[k].end + 1;
+			}
+		}
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+//! Add all entries of profile mp to this profile.
+void SparseMatrixProfile::Merge(const SparseMatrixProfile& mp)
+{
+	assert((m_nrow == mp.m_nrow) && (m_ncol == mp.m_ncol));
+	if ((m_nrow != mp.m_nrow) || (m_ncol != mp.m_ncol)) return;
+
+#pragma omp parallel for schedule(dynamic, 1000)
+	for (int j = 0; j < m_ncol; ++j)
+	{
+		ColumnProfile& a = m_prof[j];
+		const ColumnProfile& b = mp.m_prof[j];
+		if (b.size() == 0) continue;
+
+		// merge the two sorted interval lists
+		ColumnProfile c;
+		c.reserve(a.size() + b.size());
+		int na = a.size(), nb = b.size();
+		int ia = 0, ib = 0;
+		while ((ia < na) || (ib < nb))
+		{
+			RowEntry r;
+			if ((ib >= nb) || ((ia < na) && (a[ia].start <= b[ib].start))) r = a[ia++];
+			else r = b[ib++];
+
+			int nc = c.size();
+			if ((nc > 0) && (r.start <= c[nc - 1].end + 1))
+			{
+				if (r.end > c[nc - 1].end) c[nc - 1].end = r.end;
+			}
+			else c.push_back(r.start, r.end);
+		}
+		a = c;
+	}
+}
@@ -126,6 +126,12 @@ public:
 	// Extracts a block profile
 	SparseMatrixProfile GetBlockProfile(int nrow0, int ncol0, int nrow1, int ncol1) const;
 
+	//! see if all entries of this profile are also in profile mp
+	bool IsSubsetOf(const SparseMatrixProfile& mp) const;
+
+	//! add all entries of profile mp to this profile
+	void Merge(const SparseMatrixProfile& mp);
+
 private:
 	int	m_nrow, m_ncol;				//!< dimensions of matrix
 	vector<ColumnProfile>	m_prof;	//!< the actual profile in condensed format
@@ -95,6 +95,18 @@ public: // functions to be overwritten in derived classes
 	//! scale matrix
 	virtual void scale(const vector<double>& L, const vector<double>& R);
 
+	//! Turn atomic updates in Assemble and add on or off. Atomic updates are on by default
+	//! and can only be turned off when the caller guarantees that concurrent calls never
+	//! write to the same matrix entries (e.g. during graph-colored element assembly).
+	virtual void SetAtomicAssembly(bool b) { m_batomic = b; }
+
+	//! see if atomic updates are used during assembly
+	bool AtomicAssembly() const { return m_batomic; }
+
+	//! Estimate of the memory (in bytes) used by this matrix. The default assumes 
+	//! compressed row (or column) storage.
+	virtual size_t MemoryUsage() const { return (size_t)m_nsize*(sizeof(double) + sizeof(int)) + (size_t)(m_nrow + 1)*sizeof(int); }
+
 public:
 	//! multiply with vector
 	bool mult_vector(double* x, double* r) override { assert(false); return false; }
@@ -111,4 +123,5 @@ protected:
 	// NOTE: These values are set by derived classes
 	int	m_nrow, m_ncol;		//!< dimension of matrix
 	int	m_nsize;			//!< number of nonzeroes (i.e. matrix elements actually allocated)
+	bool	m_batomic;		//!< use atomic updates during assembly
 };
@@ -29,17 +29,14 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "Timer.h"
 #include <stdio.h>
-#include <time.h>
+#include <chrono>
 #include <string>
 
 //-----------------------------------------------------------------------------
 // Define the data types used for measuring times.
-// This depends on the system
-#ifdef WIN32
-#define TIMER_TYPE clock_t
-#else
-#define TIMER_TYPE	time_t
-#endif
+// A monotonic clock is used on all systems, since time() only has a resolution
+// of one second, which is too coarse for timing the individual components.
+#define TIMER_TYPE std::chrono::steady_clock::time_point
 
 //-----------------------------------------------------------------------------
 // forward declaration of the functions to retrieve timing info
@@ -47,14 +44,9 @@ void sys_get_time(TIMER_TYPE& t);
 double sys_diff_time(TIMER_TYPE& t1, TIMER_TYPE& t0);
 
 //-----------------------------------------------------------------------------
-// OS-dependent timing functions
-#ifdef WIN32
-void sys_get_time(TIMER_TYPE& t) { t = clock(); }
-double sys_diff_time(TIMER_TYPE& t1, TIMER_TYPE& t0) { return (double) (t1 - t0) / CLOCKS_PER_SEC; }
-#else
-void sys_get_time(TIMER_TYPE& t) { time(&t); }
-double sys_diff_time(TIMER_TYPE& t1, TIMER_TYPE& t0) { return difftime(t1, t0); }
-#endif
+// timing functions
+void sys_get_time(TIMER_TYPE& t) { t = std::chrono::steady_clock::now(); }
+double sys_diff_time(TIMER_TYPE& t1, TIMER_TYPE& t0) { return std::chrono::duration<double>(t1 - t0).count(); }
 
 //-----------------------------------------------------------------------------
 // data storing timing info
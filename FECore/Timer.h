@@ -29,6 +29,7 @@ SOFTWARE.*/
 #pragma once
 #include "fecore_api.h"
 #include "FECoreKernel.h"
+#include "FEProfiler.h"
 #include <vector>
 #include <string>
 
@@ -102,4 +103,7 @@ private:
 	Timer*	m_timer;
 };
 
-#define TRACK_TIME(timerId) TimerTracker _trackTimer(GetFEModel()->GetTimer(timerId));
+// Note that this also records the time in the model's profiler (when enabled) so that the
+// timer buckets appear as regions in the profiler's call tree.
+#define TRACK_TIME(timerId) TimerTracker _trackTimer(GetFEModel()->GetTimer(timerId)); \
+	FEProfileScope _profileTimer(GetFEModel()->GetProfiler(), GetFEModel()->GetTimerName(timerId));
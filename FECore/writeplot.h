@@ -91,9 +91,9 @@ template <class T> void writeElementValue(FEMeshPartition& dom, FEDataStream& ar
 }
 
 //=================================================================================================
-template <class T> void writeAverageElementValue(FEMeshPartition& dom, FEDataStream& ar, std::function<T(const FEMaterialPoint& mp)> fnc)
+template <class T> void writeAverageElementValue(FEMeshPartition& dom, FEDataStream& ar, std::function<T(const FEMaterialPoint& mp)> fnc, int n0, int n1)
 {
-	for (int i = 0; i<dom.Elements(); ++i) {
+	for (int i = n0; i<n1; ++i) {
 		FEElement& el = dom.ElementRef(i);
 		T s(0.0);
 		for (int j = 0; j<el.GaussPoints(); ++j) s += fnc(*el.GetMaterialPoint(j));
@@ -101,6 +101,12 @@ template <class T> void writeAverageElementValue(FEMeshPartition& dom, FEDataStr
 	}
 }
 
+//=================================================================================================
+template <class T> void writeAverageElementValue(FEMeshPartition& dom, FEDataStream& ar, std::function<T(const FEMaterialPoint& mp)> fnc)
+{
+	writeAverageElementValue<T>(dom, ar, fnc, 0, dom.Elements());
+}
+
 //=================================================================================================
 template <class T> void writeAverageElementValue(FEMeshPartition& dom, FEDataStream& ar, std::function<T(FEElement& el, int ip)> fnc)
 {
@@ -135,9 +141,9 @@ template <class Tin, class Tout> void writeAverageElementValue(FEMeshPartition&
 }
 
 //=================================================================================================
-template <class T> void writeAverageElementValue(FEMeshPartition& dom, FEDataStream& ar, FEDomainParameter* var)
+template <class T> void writeAverageElementValue(FEMeshPartition& dom, FEDataStream& ar, FEDomainParameter* var, int n0, int n1)
 {
-	for (int i = 0; i<dom.Elements(); ++i) {
+	for (int i = n0; i<n1; ++i) {
 		FEElement& el = dom.ElementRef(i);
 		T s(0.0);
 		for (int j = 0; j < el.GaussPoints(); ++j)
@@ -149,6 +155,12 @@ template <class T> void writeAverageElementValue(FEMeshPartition& dom, FEDataStr
 	}
 }
 
+//=================================================================================================
+template <class T> void writeAverageElementValue(FEMeshPartition& dom, FEDataStream& ar, FEDomainParameter* var)
+{
+	writeAverageElementValue<T>(dom, ar, var, 0, dom.Elements());
+}
+
 //=================================================================================================
 template <class T> void writeIntegratedElementValue(FESolidDomain& dom, FEDataStream& ar, std::function<T(const FEMaterialPoint& mp)> fnc)
 {
@@ -280,3 +280,15 @@ void BlockMatrix::scale(const vector<double>& L, const vector<double>& R)
 		}
 	}
 }
+
+//-----------------------------------------------------------------------------
+//! turn atomic assembly on or off (for all blocks)
+void BlockMatrix::SetAtomicAssembly(bool b)
+{
+	m_batomic = b;
+	for (int n = 0; n < m_Block.size(); ++n)
+	{
+		BLOCK& bn = m_Block[n];
+		if (bn.pA) bn.pA->SetAtomicAssembly(b);
+	}
+}
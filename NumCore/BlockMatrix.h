@@ -101,6 +101,9 @@ public:
 	//! row and column scale
 	void scale(const vector<double>& L, const vector<double>& R) override;
 
+	//! turn atomic assembly on or off (for all blocks)
+	void SetAtomicAssembly(bool b) override;
+
 public:
 	//! return number of blocks
 	int Blocks() const { return (int) m_Block.size(); }
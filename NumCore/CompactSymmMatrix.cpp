@@ -40,55 +40,34 @@ CompactSymmMatrix::CompactSymmMatrix(int offset) : CompactMatrix(offset)
 bool CompactSymmMatrix::mult_vector(double* x, double* r)
 {
 	// get row count
-	int N = Rows();
-	int M = Columns();
-
-	// zero result vector
-	for (int j = 0; j<N; ++j) r[j] = 0.0;
-
-	// loop over all columns
-	for (int j = 0; j<M; ++j)
-	{
-		double* pv = m_pd + m_ppointers[j] - m_offset;
-		int* pi = m_pindices + m_ppointers[j] - m_offset;
-		int n = m_ppointers[j + 1] - m_ppointers[j];
+	const int N = Rows();
 
-		// add off-diagonal elements
-		for (int i = 1; i<n - 7; i += 8)
-		{
-			// add lower triangular element
-			r[pi[i    ] - m_offset] += pv[i    ] * x[j];
-			r[pi[i + 1] - m_offset] += pv[i + 1] * x[j];
-			r[pi[i + 2] - m_offset] += pv[i + 2] * x[j];
-			r[pi[i + 3] - m_offset] += pv[i + 3] * x[j];
-			r[pi[i + 4] - m_offset] += pv[i + 4] * x[j];
-			r[pi[i + 5] - m_offset] += pv[i + 5] * x[j];
-			r[pi[i + 6] - m_offset] += pv[i + 6] * x[j];
-			r[pi[i + 7] - m_offset] += pv[i + 7] * x[j];
-		}
-		for (int i = 0; i<(n - 1) % 8; ++i)
-			r[pi[n - 1 - i] - m_offset] += pv[n - 1 - i] * x[j];
+	// Since only the lower triangular part is stored, a column-wise product 
+	// would need to scatter into r. Instead, we use the transposed index to 
+	// gather the lower triangular part of each row, so that rows can be processed in parallel.
+	if (m_tptr.empty()) buildTransposeIndex();
 
-		// add diagonal element
-		double rj = pv[0] * x[j];
+	const int* ptpos = (m_nsize > 0 ? &m_tpos[0] : nullptr);
+	const int* ptind = (m_nsize > 0 ? &m_tind[0] : nullptr);
 
-		// add upper-triangular elements
-		for (int i = 1; i<n - 7; i += 8)
+	#pragma omp parallel for schedule(guided)
+	for (int j = 0; j<N; ++j)
+	{
+		// diagonal and upper-triangular elements (i.e. column j)
+		const double* pv = m_pd + m_ppointers[j] - m_offset;
+		const int* pi = m_pindices + m_ppointers[j] - m_offset;
+		const int n = m_ppointers[j + 1] - m_ppointers[j];
+		double rj = 0.0;
+		for (int i = 0; i<n; ++i) rj += pv[i] * x[pi[i] - m_offset];
+
+		// lower-triangular elements (i.e. row j)
+		for (int k = m_tptr[j]; k < m_tptr[j + 1]; ++k)
 		{
-			// add upper triangular element
-			rj += pv[i    ] * x[pi[i    ] - m_offset];
-			rj += pv[i + 1] * x[pi[i + 1] - m_offset];
-			rj += pv[i + 2] * x[pi[i + 2] - m_offset];
-			rj += pv[i + 3] * x[pi[i + 3] - m_offset];
-			rj += pv[i + 4] * x[pi[i + 4] - m_offset];
-			rj += pv[i + 5] * x[pi[i + 5] - m_offset];
-			rj += pv[i + 6] * x[pi[i + 6] - m_offset];
-			rj += pv[i + 7] * x[pi[i + 7] - m_offset];
+			const int i = ptind[k];
+			if (i != j) rj += m_pd[ptpos[k]] * x[i];
 		}
-		for (int i = 0; i<(n - 1) % 8; ++i)
-			rj += pv[n - 1 - i] * x[pi[n - 1 - i] - m_offset];
 
-		r[j] += rj;
+		r[j] = rj;
 	}
 
 	return true;
@@ -220,8 +199,12 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == I)
 				{
-					#pragma omp atomic
-					pm[n] += ke[i][j];
+					if (m_batomic)
+					{
+						#pragma omp atomic
+						pm[n] += ke[i][j];
+					}
+					else pm[n] += ke[i][j];
 					break;
 				}
 		}
@@ -256,8 +239,12 @@ void CompactSymmMatrix::Assemble(const matrix& ke, const vector<int>& LMi, const
 				for (int n = 0; n<l; ++n) 
 					if (pi[n] - m_offset == I)
 					{
-						#pragma omp atomic
-						pv[n] += ke[i][j];
+						if (m_batomic)
+						{
+							#pragma omp atomic
+							pv[n] += ke[i][j];
+						}
+						else pv[n] += ke[i][j];
 						break;
 					}
 			}
@@ -288,8 +275,12 @@ void CompactSymmMatrix::add(int i, int j, double v)
 			int m = pi[n];
 			if (m == i)
 			{
-				#pragma omp atomic
-				pd[n] += v;
+				if (m_batomic)
+				{
+					#pragma omp atomic
+					pd[n] += v;
+				}
+				else pd[n] += v;
 				return;
 			}
 			else if (m < i)
@@ -346,8 +337,12 @@ void CompactSymmMatrix::set(int i, int j, double v)
 			{
 				int k = m_ppointers[j] + n;
 				k -= m_offset;
+				if (m_batomic)
+				{
 #pragma omp critical
-				m_pd[k] = v;
+					m_pd[k] = v;
+				}
+				else m_pd[k] = v;
 				return;
 			}
 
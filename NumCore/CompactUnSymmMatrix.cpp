@@ -233,8 +233,12 @@ void CRSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == J)
 				{
+					if (m_batomic)
+					{
 #pragma omp atomic
-					pm[n] += kij;
+						pm[n] += kij;
+					}
+					else pm[n] += kij;
 					break;
 				}
 		}
@@ -280,8 +284,12 @@ void CRSSparseMatrix::add(int i, int j, double v)
 		int m = pi[n];
 		if (m == j)
 		{
+			if (m_batomic)
+			{
 #pragma omp atomic
-			pd[n] += v;
+				pd[n] += v;
+			}
+			else pd[n] += v;
 			return;
 		}
 		else if (m < j)
@@ -308,8 +316,12 @@ void CRSSparseMatrix::set(int i, int j, double v)
 	{
 		if (pi[n] == j + m_offset)
 		{
+			if (m_batomic)
+			{
 #pragma omp critical
-			m_pd[m_ppointers[i] + n - m_offset] = v;
+				m_pd[m_ppointers[i] + n - m_offset] = v;
+			}
+			else m_pd[m_ppointers[i] + n - m_offset] = v;
 			return;
 		}
 	}
@@ -359,38 +371,34 @@ double CRSSparseMatrix::diag(int i)
 //-----------------------------------------------------------------------------
 bool CRSSparseMatrix::mult_vector(double* x, double* r)
 {
-#ifdef MKL_ISS
-
 	// get the matrix size
 	const int N = Rows();
 
+#ifdef MKL_ISS
 	if (Offset() == 1)
 	{
 		const char transa = 'N';
 		mkl_dcsrgemv(&transa, &N, m_pd, m_ppointers, m_pindices, x, r);
+		return true;
 	}
-	else
-	{
-		assert(m_offset == 0);
-		// loop over all rows
+#endif
+
+	// loop over all rows
 	#pragma omp parallel for schedule(guided)
-		for (int i = 0; i < N; ++i)
+	for (int i = 0; i < N; ++i)
+	{
+		const double* pv = m_pd + (m_ppointers[i] - m_offset);
+		const int* pi = m_pindices + (m_ppointers[i] - m_offset);
+		const int n = m_ppointers[i + 1] - m_ppointers[i];
+		double ri = 0.0;
+		for (int j = 0; j < n; j ++)
 		{
-			const double* pv = m_pd + (m_ppointers[i] - m_offset);
-			const int* pi = m_pindices + (m_ppointers[i] - m_offset);
-			const int n = m_ppointers[i + 1] - m_ppointers[i];
-			r[i] = 0.0;
-			for (int j = 0; j < n; j ++)
-			{
-				r[i] += (*pv++) * x[*pi++ - m_offset];
-			}
+			ri += pv[j] * x[pi[j] - m_offset];
 		}
+		r[i] = ri;
 	}
 
 	return true;
-#else
-	return false;
-#endif
 }
 
 //! calculate the abs row sum 
@@ -657,8 +665,12 @@ void CCSSparseMatrix::Assemble(const matrix& ke, const vector<int>& LM)
 			for (; n<l; ++n)
 				if (pi[n] == I)
 				{
+					if (m_batomic)
+					{
 #pragma omp atomic
-					pm[n] += ke[i][j];
+						pm[n] += ke[i][j];
+					}
+					else pm[n] += ke[i][j];
 					break;
 				}
 		}
@@ -704,8 +716,12 @@ void CCSSparseMatrix::add(int i, int j, double v)
 		int m = pi[n];
 		if (m == i)
 		{
+			if (m_batomic)
+			{
 #pragma omp atomic
-			pd[n] += v;
+				pd[n] += v;
+			}
+			else pd[n] += v;
 			return;
 		}
 		else if (m < i)
@@ -731,8 +747,12 @@ void CCSSparseMatrix::set(int i, int j, double v)
 	{
 		if (pi[n] == i + m_offset)
 		{
+			if (m_batomic)
+			{
 #pragma omp critical
-			m_pd[m_ppointers[j] + n - m_offset] = v;
+				m_pd[m_ppointers[j] + n - m_offset] = v;
+			}
+			else m_pd[m_ppointers[j] + n - m_offset] = v;
 			return;
 		}
 	}
@@ -784,18 +804,20 @@ bool CCSSparseMatrix::mult_vector(double* x, double* r)
 {
 	// get the matrix size
 	const int N = Rows();
-	const int M = Columns();
 
-	// zero r
-	for (int i=0; i<N; ++i) r[i] = 0.0;
+	// use the transposed index so that we can gather the rows in parallel
+	if (m_tptr.empty()) buildTransposeIndex();
 
-	// loop over all columns
-	for (int i = 0; i<M; ++i)
+	const int* ptpos = (m_nsize > 0 ? &m_tpos[0] : nullptr);
+	const int* ptind = (m_nsize > 0 ? &m_tind[0] : nullptr);
+
+	// loop over all rows
+	#pragma omp parallel for schedule(guided)
+	for (int i = 0; i<N; ++i)
 	{
-		double* pv = m_pd + (m_ppointers[i] - m_offset);
-		int* pi = m_pindices + (m_ppointers[i] - m_offset);
-		int n = m_ppointers[i + 1] - m_ppointers[i];
-		for (int j = 0; j<n; j++)  r[pi[j] - m_offset] += pv[j] * x[i];
+		double ri = 0.0;
+		for (int k = m_tptr[i]; k < m_tptr[i + 1]; ++k) ri += m_pd[ptpos[k]] * x[ptind[k]];
+		r[i] = ri;
 	}
 
 	return true;
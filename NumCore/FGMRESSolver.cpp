@@ -190,7 +190,6 @@ void FGMRESSolver::DoJacobiPreconditioning(bool b)
 //-----------------------------------------------------------------------------
 SparseMatrix* FGMRESSolver::CreateSparseMatrix(Matrix_Type ntype)
 {
-#ifdef MKL_ISS
 	// Cleanup if necessary
 	if (m_pA) delete m_pA; 
 	m_pA = nullptr;
@@ -224,9 +223,6 @@ SparseMatrix* FGMRESSolver::CreateSparseMatrix(Matrix_Type ntype)
 
 	// return the matrix (Can be null if matrix format not supported!)
 	return m_pA;
-#else
-	return 0;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -247,9 +243,8 @@ void FGMRESSolver::Destroy()
 //-----------------------------------------------------------------------------
 bool FGMRESSolver::PreProcess() 
 {
-#ifdef MKL_ISS
 	// number of equations
-	MKL_INT N = m_pA->Rows();
+	int N = m_pA->Rows();
 
 	int M = (N < 150 ? N : 150); // this is the default value of ipar[14]
 
@@ -257,16 +252,17 @@ bool FGMRESSolver::PreProcess()
 	else if (m_maxiter > 0) M = m_maxiter;
 
 	// allocate temp storage
+#ifdef MKL_ISS
 	m_tmp.resize((N*(2 * M + 1) + (M*(M + 9)) / 2 + 1));
+#else
+	m_tmp.resize(N*(2 * M + 1) + (M + 1)*M + 3 * M + 1);
+#endif
 
 	m_Rv.resize(N);
 
 	m_W.resize(N, 1.0);
 
 	return true; 
-#else
-	return false;
-#endif
 }
 
 
@@ -314,12 +310,11 @@ bool FGMRESSolver::Factor()
 //-----------------------------------------------------------------------------
 bool FGMRESSolver::BackSolve(double* x, double* b)
 {
-#ifdef MKL_ISS
 	// make sure we have a matrix
 	if (m_pA == 0) return false;
 
 	// number of equations
-	MKL_INT N = m_pA->Rows();
+	int N = m_pA->Rows();
 
 	// data allocation
 	int M = (N < 150 ? N : 150); // this is the default value of ipar[4] and ipar[14]
@@ -335,6 +330,7 @@ bool FGMRESSolver::BackSolve(double* x, double* b)
 	vector<double> F(N);
 	for (int i = 0; i < N; ++i) F[i] = m_W[i] * b[i];
 
+#ifdef MKL_ISS
 	// initialize the solver
 	MKL_INT ipar[128] = { 0 };
 	double dpar[128] = { 0.0 };
@@ -419,6 +415,25 @@ bool FGMRESSolver::BackSolve(double* x, double* b)
 
 	dfgmres_get(&ivar, &x[0], &F[0], &RCI_request, ipar, dpar, &m_tmp[0], &itercount);
 
+	if (m_print_level > 0)
+	{
+		feLog("%3d = %lg (%lg), %lg (%lg)\n", ipar[3]+1, dpar[4], dpar[3], dpar[6], dpar[7]);
+	}
+
+//	MKL_Free_Buffers();
+#else
+	// use our own implementation
+	int itercount = 0;
+	bool bconverged = false;
+	switch (fgmres(x, &F[0], maxIter, nrestart, itercount))
+	{
+	case 0: bconverged = true; break;
+	case 1: bconverged = !m_maxIterFail; break;
+	default:
+		bconverged = false;
+	}
+#endif // MKL_ISS
+
 	if (m_do_jacobi)
 	{
 		for (int i = 0; i < N; ++i) x[i] *= m_W[i];
@@ -430,21 +445,153 @@ bool FGMRESSolver::BackSolve(double* x, double* b)
 		for (int i = 0; i < N; ++i) x[i] = m_Rv[i];
 	}
 
-	if (m_print_level > 0)
+	// update stats
+	UpdateStats(itercount);
+
+	return bconverged;
+}
+
+//-----------------------------------------------------------------------------
+// calculate w = A*R*v, where R is the (optional) right preconditioner
+bool FGMRESSolver::mult_operator(double* v, double* w)
+{
+	if (m_R)
 	{
-		feLog("%3d = %lg (%lg), %lg (%lg)\n", ipar[3]+1, dpar[4], dpar[3], dpar[6], dpar[7]);
+		if (m_R->mult_vector(v, &m_Rv[0]) == false) return false;
+		return m_pA->mult_vector(&m_Rv[0], w);
 	}
+	else return m_pA->mult_vector(v, w);
+}
 
-//	MKL_Free_Buffers();
+//-----------------------------------------------------------------------------
+// This implements the restarted, flexible GMRES algorithm with the same 
+// stopping criteria as the MKL version. The preconditioner is applied from the
+// right to each Krylov vector (as is done by the MKL version). 
+// The return value is 0 when converged, 1 when the max iterations were reached
+// and -1 on failure.
+int FGMRESSolver::fgmres(double* x, double* b, int maxIter, int M, int& niter)
+{
+	int N = m_pA->Rows();
 
-	// update stats
-	UpdateStats(itercount);
+	// the work arrays
+	double* V = &m_tmp[0];			// Krylov basis (N x (M+1))
+	double* Z = V + N*(M + 1);		// preconditioned basis (N x M)
+	double* H = Z + N*M;			// Hessenberg matrix ((M+1) x M, column major)
+	double* c = H + (M + 1)*M;		// Givens rotations
+	double* s = c + M;
+	double* g = s + M;				// rhs of least-squares problem (M+1)
 
-	return bconverged;
+	// set the convergence tolerance
+	double reltol = (m_reltol > 0 ? m_reltol : 1e-6);
+	double norm0 = sqrt(NumCore::dotProduct(N, b, b));
+	double tol = reltol*norm0 + m_abstol;
 
-#else
-	return false;
-#endif // MKL_ISS
+	// zero solution vector
+	for (int i = 0; i < N; ++i) x[i] = 0.0;
+	niter = 0;
+	if (norm0 == 0.0) return 0;
+
+	if (m_print_level > 0) feLog("FGMRES:\n");
+
+	double res = norm0;
+	bool bconverged = false;
+	while (true)
+	{
+		// calculate the residual
+		double* v0 = V;
+		if (niter == 0)
+		{
+			for (int i = 0; i < N; ++i) v0[i] = b[i];
+		}
+		else
+		{
+			if (mult_operator(x, v0) == false) return -1;
+			for (int i = 0; i < N; ++i) v0[i] = b[i] - v0[i];
+		}
+		double beta = sqrt(NumCore::dotProduct(N, v0, v0));
+		res = beta;
+		if ((beta == 0.0) || (m_doResidualTest && (beta <= tol))) { bconverged = true; break; }
+		if (niter >= maxIter) break;
+
+		for (int i = 0; i < N; ++i) v0[i] /= beta;
+		for (int i = 0; i <= M; ++i) g[i] = 0.0;
+		g[0] = beta;
+
+		// Arnoldi process
+		int k = 0;
+		bool bbreak = false;
+		while ((k < M) && (niter < maxIter) && !bbreak)
+		{
+			double* vk = V + k*N;
+			double* zk = (m_P ? Z + k*N : vk);
+			if (m_P && (m_P->mult_vector(vk, zk) == false)) return -1;
+
+			double* w = V + (k + 1)*N;
+			if (mult_operator(zk, w) == false) return -1;
+
+			// modified Gram-Schmidt
+			double* hk = H + k*(M + 1);
+			for (int i = 0; i <= k; ++i)
+			{
+				double* vi = V + i*N;
+				hk[i] = NumCore::dotProduct(N, w, vi);
+				NumCore::axpy(N, -hk[i], vi, w);
+			}
+			double hn = sqrt(NumCore::dotProduct(N, w, w));
+			hk[k + 1] = hn;
+
+			// apply the previous rotations to the new column
+			for (int i = 0; i < k; ++i)
+			{
+				double t = c[i] * hk[i] + s[i] * hk[i + 1];
+				hk[i + 1] = -s[i] * hk[i] + c[i] * hk[i + 1];
+				hk[i] = t;
+			}
+
+			// calculate the new rotation
+			double d = sqrt(hk[k] * hk[k] + hn*hn);
+			if (d == 0.0) return -1;
+			c[k] = hk[k] / d;
+			s[k] = hn / d;
+			hk[k] = d;
+			hk[k + 1] = 0.0;
+			g[k + 1] = -s[k] * g[k];
+			g[k] = c[k] * g[k];
+			res = fabs(g[k + 1]);
+
+			k++;
+			niter++;
+
+			if (m_print_level > 1) feLog("%3d = %lg (%lg)\n", niter, res, tol);
+
+			// a zero norm means the Krylov space is exhausted (breakdown), so we
+			// always end the cycle, since the next basis vector would be zero.
+			if (m_doResidualTest && (res <= tol)) bbreak = true;
+			else if (hn == 0.0) bbreak = true;
+			else
+			{
+				for (int i = 0; i < N; ++i) w[i] /= hn;
+			}
+		}
+
+		// solve the upper-triangular system H*y = g (overwrites g)
+		for (int i = k - 1; i >= 0; --i)
+		{
+			double yi = g[i];
+			for (int j = i + 1; j < k; ++j) yi -= H[i + j*(M + 1)] * g[j];
+			g[i] = yi / H[i + i*(M + 1)];
+		}
+
+		// update the solution
+		for (int i = 0; i < k; ++i) NumCore::axpy(N, g[i], (m_P ? Z + i*N : V + i*N), x);
+
+		// Note that convergence is (re)checked with the true residual at the top of the loop.
+		if (bbreak && !m_doResidualTest) { bconverged = true; break; }
+	}
+
+	if (m_print_level > 0) feLog("%3d = %lg (%lg)\n", niter, res, tol);
+
+	return (bconverged ? 0 : 1);
 }
 
 //! convenience function for solving linear system Ax = b
@@ -29,7 +29,8 @@ SOFTWARE.*/
 
 //-----------------------------------------------------------------------------
 //! This class implements an interface to the MKL FGMRES iterative solver for 
-//! nonsymmetric indefinite matrices (without pre-conditioning).
+//! nonsymmetric indefinite matrices (without pre-conditioning). When MKL is
+//! not available, a native implementation of (restarted) FGMRES is used.
 class FGMRESSolver : public IterativeLinearSolver
 {
 public:
@@ -105,6 +106,13 @@ public:
 protected:
 	SparseMatrix* GetSparseMatrix() { return m_pA; }
 
+private:
+	// native FGMRES implementation (used when MKL is not available)
+	int fgmres(double* x, double* b, int maxIter, int nrestart, int& niter);
+
+	// calculate w = A*R*v
+	bool mult_operator(double* v, double* w);
+
 private:
 	int		m_maxiter;			// max nr of iterations
 	int		m_nrestart;			// max nr of non-restarted iterations
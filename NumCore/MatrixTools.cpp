@@ -295,6 +295,22 @@ double NumCore::infNorm(const std::vector<double>& x)
 	return m;
 }
 
+// dot product of two arrays
+double NumCore::dotProduct(int n, const double* a, const double* b)
+{
+	double sum = 0.0;
+	#pragma omp parallel for reduction(+:sum)
+	for (int i = 0; i < n; ++i) sum += a[i] * b[i];
+	return sum;
+}
+
+// y = y + a*x
+void NumCore::axpy(int n, double a, const double* x, double* y)
+{
+	#pragma omp parallel for
+	for (int i = 0; i < n; ++i) y[i] += a*x[i];
+}
+
 // print compact matrix pattern to svn file
 void NumCore::print_svg(CompactMatrix* m, std::ostream &out, int i0, int j0, int i1, int j1)
 {
@@ -62,6 +62,12 @@ namespace NumCore
 	// inf-norm of a vector
 	double infNorm(const std::vector<double>& x);
 
+	// dot product of two arrays (parallel)
+	double dotProduct(int n, const double* a, const double* b);
+
+	// y = y + a*x (parallel)
+	void axpy(int n, double a, const double* x, double* y);
+
 	// print matrix sparsity pattern to svn file
 	void print_svg(CompactMatrix* m, std::ostream &out, int i0 = 0, int j0 = 0, int i1 = -1, int j1 = -1);
 
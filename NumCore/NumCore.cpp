@@ -26,6 +26,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "NumCore.h"
 #include "SkylineSolver.h"
+#include "SupernodalSolver.h"
 #include "LUSolver.h"
 #include "PardisoSolver.h"
 #include "RCICGSolver.h"
@@ -53,6 +54,7 @@ void NumCore::InitModule()
 	// register linear solvers
 	REGISTER_FECORE_CLASS(PardisoSolver  , "pardiso");
 	REGISTER_FECORE_CLASS(SkylineSolver  , "skyline");
+	REGISTER_FECORE_CLASS(SupernodalSolver, "supernodal");
 	REGISTER_FECORE_CLASS(LUSolver       , "LU"     );
 	REGISTER_FECORE_CLASS(FGMRESSolver        , "fgmres"   );
 	REGISTER_FECORE_CLASS(BoomerAMGSolver     , "boomeramg");
@@ -305,6 +305,17 @@ double PardisoSolver::condition_number()
 	return c;
 }
 
+//-----------------------------------------------------------------------------
+// Pardiso reports its memory (in kB) in iparm(15) (peak during analysis), iparm(16)
+// (permanent memory), and iparm(17) (memory for factorization and solve).
+size_t PardisoSolver::MemoryUsage()
+{
+	if (m_isFactored == false) return 0;
+	size_t kb = (size_t)m_iparm[15] + (size_t)m_iparm[16];
+	if ((size_t)m_iparm[14] > kb) kb = (size_t)m_iparm[14];
+	return kb * 1024;
+}
+
 //-----------------------------------------------------------------------------
 void PardisoSolver::Destroy()
 {
@@ -331,6 +342,7 @@ bool PardisoSolver::PreProcess() { return false; }
 bool PardisoSolver::Factor() { return false; }
 bool PardisoSolver::BackSolve(double* x, double* y) { return false; }
 void PardisoSolver::Destroy() {}
+size_t PardisoSolver::MemoryUsage() { return 0; }
 SparseMatrix* PardisoSolver::CreateSparseMatrix(Matrix_Type ntype) { return nullptr; }
 bool PardisoSolver::SetSparseMatrix(SparseMatrix* pA) { return false; }
 void PardisoSolver::PrintConditionNumber(bool b) {}
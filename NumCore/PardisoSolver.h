@@ -46,6 +46,8 @@ public:
 	bool BackSolve(double* x, double* y) override;
 	void Destroy() override;
 
+	size_t MemoryUsage() override;
+
 	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
 	bool SetSparseMatrix(SparseMatrix* pA) override;
 
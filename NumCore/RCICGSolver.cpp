@@ -29,6 +29,7 @@ SOFTWARE.*/
 #include "stdafx.h"
 #include "RCICGSolver.h"
 #include "IncompleteCholesky.h"
+#include "MatrixTools.h"
 
 //-----------------------------------------------------------------------------
 // We must undef PARDISO since it is defined as a function in mkl_solver.h
@@ -62,13 +63,9 @@ RCICGSolver::RCICGSolver(FEModel* fem) : IterativeLinearSolver(fem), m_pA(0), m_
 //-----------------------------------------------------------------------------
 SparseMatrix* RCICGSolver::CreateSparseMatrix(Matrix_Type ntype)
 {
-#ifdef MKL_ISS
 	if (ntype != REAL_SYMMETRIC) return 0;
 	m_pA = new CompactSymmMatrix(1);
 	return m_pA;
-#else
-	return 0;
-#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -208,7 +205,75 @@ bool RCICGSolver::BackSolve(double* x, double* b)
 
 	return (m_fail_max_iters ? bsuccess : true);
 #else
-	return false;
+	// make sure we have a matrix
+	if (m_pA == 0) return false;
+
+	// get number of equations
+	int n = m_pA->Rows();
+
+	// default max iterations (same as MKL)
+	int maxiter = (m_maxiter > 0 ? m_maxiter : (n < 150 ? n : 150));
+
+	// zero solution vector
+	for (int i = 0; i<n; ++i) x[i] = 0.0;
+
+	// work vectors
+	vector<double> r(b, b + n), z(n), p(n), q(n);
+
+	// initial residual
+	double norm0 = sqrt(NumCore::dotProduct(n, &r[0], &r[0]));
+	double tol = m_tol*norm0;
+	if (norm0 == 0.0) { UpdateStats(0); return true; }
+
+	// apply preconditioner
+	if (m_P) m_P->mult_vector(&r[0], &z[0]); else z = r;
+	p = z;
+	double rho = NumCore::dotProduct(n, &r[0], &z[0]);
+
+	// loop until converged
+	bool bsuccess = false;
+	int niter = 0;
+	double normr = norm0;
+	while (niter < maxiter)
+	{
+		// q = A*p
+		if (m_pA->mult_vector(&p[0], &q[0]) == false) break;
+
+		double pq = NumCore::dotProduct(n, &p[0], &q[0]);
+		if (pq == 0.0) break;
+		double alpha = rho / pq;
+
+		NumCore::axpy(n,  alpha, &p[0], x);
+		NumCore::axpy(n, -alpha, &q[0], &r[0]);
+		niter++;
+
+		// check convergence
+		normr = sqrt(NumCore::dotProduct(n, &r[0], &r[0]));
+		if (m_print_level == 1)
+		{
+			fprintf(stderr, "%3d = %lg (%lg)\n", niter, normr, tol);
+		}
+		if (normr <= tol) { bsuccess = true; break; }
+
+		// apply preconditioner
+		if (m_P) m_P->mult_vector(&r[0], &z[0]); else z = r;
+
+		double rho_new = NumCore::dotProduct(n, &r[0], &z[0]);
+		double beta = rho_new / rho;
+		rho = rho_new;
+
+		#pragma omp parallel for
+		for (int i = 0; i < n; ++i) p[i] = z[i] + beta*p[i];
+	}
+
+	if (m_print_level > 0)
+	{
+		fprintf(stderr, "%3d = %lg (%lg)\n", niter, normr, tol);
+	}
+
+	UpdateStats(niter);
+
+	return (m_fail_max_iters ? bsuccess : true);
 #endif // MKL_ISS
 }
 
@@ -28,6 +28,7 @@ SOFTWARE.*/
 #include "CompactSymmMatrix.h"
 
 // This class implements an interface to the RCI CG iterative solver from the MKL math library.
+// When MKL is not available, a native preconditioned CG implementation is used.
 class RCICGSolver : public IterativeLinearSolver
 {
 public:
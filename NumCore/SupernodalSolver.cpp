@@ -0,0 +1,912 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#include "stdafx.h"
+#include "SupernodalSolver.h"
+#include "CompactSymmMatrix.h"
+#include "CompactUnSymmMatrix.h"
+#include <FECore/log.h>
+#include <FECore/sys.h>
+#include <FECore/FEMemoryReport.h>
+#include <algorithm>
+#include <math.h>
+
+//-----------------------------------------------------------------------------
+// Subgraphs smaller than this are not dissected any further
+#define ND_LEAF_SIZE	64
+
+//-----------------------------------------------------------------------------
+// Nested dissection ordering of the graph (xadj, adj) with n vertices.
+// On return perm[k] is the vertex that is eliminated k-th. Separators are found
+// from the level structure of a breadth-first search started at a pseudo-peripheral 
+// vertex. The subgraphs are processed with an explicit stack, where each subgraph 
+// is assigned the range of the permutation that it must fill.
+static void nestedDissection(int n, const std::vector<int>& xadj, const std::vector<int>& adj, std::vector<int>& perm)
+{
+	perm.resize(n);
+	if (n == 0) return;
+
+	struct SubGraph
+	{
+		int	start;				// first position in perm
+		std::vector<int> v;		// vertices of subgraph
+	};
+
+	std::vector<int> tag(n, -1);	// identifies the subgraph a vertex is in
+	std::vector<int> level(n, -1);	// BFS level 
+	std::vector<int> queue; queue.reserve(n);
+	int stamp = 0;
+
+	// breadth-first search restricted to the current subgraph. Returns nr of levels
+	auto bfs = [&](int root, int id) {
+		queue.clear();
+		queue.push_back(root);
+		level[root] = 0;
+		int nlevels = 1;
+		for (size_t i = 0; i < queue.size(); ++i)
+		{
+			int v = queue[i];
+			for (int j = xadj[v]; j < xadj[v + 1]; ++j)
+			{
+				int w = adj[j];
+				if ((tag[w] == id) && (level[w] < 0))
+				{
+					level[w] = level[v] + 1;
+					if (level[w] + 1 > nlevels) nlevels = level[w] + 1;
+					queue.push_back(w);
+				}
+			}
+		}
+		return nlevels;
+	};
+
+	std::vector<SubGraph> stack(1);
+	stack[0].start = 0;
+	stack[0].v.resize(n);
+	for (int i = 0; i < n; ++i) stack[0].v[i] = i;
+
+	while (stack.empty() == false)
+	{
+		SubGraph g;
+		g.start = stack.back().start;
+		g.v.swap(stack.back().v);
+		stack.pop_back();
+
+		const int ns = (int)g.v.size();
+		if (ns <= ND_LEAF_SIZE)
+		{
+			for (int i = 0; i < ns; ++i) perm[g.start + i] = g.v[i];
+			continue;
+		}
+
+		// tag the vertices of this subgraph
+		int id = stamp++;
+		for (int i = 0; i < ns; ++i) { tag[g.v[i]] = id; level[g.v[i]] = -1; }
+
+		// if the subgraph is not connected, process the components separately
+		int nlevels = bfs(g.v[0], id);
+		if ((int)queue.size() < ns)
+		{
+			int start = g.start;
+			SubGraph c;
+			for (int i = 0; i < ns; ++i)
+			{
+				int v = g.v[i];
+				if (tag[v] != id) continue;
+				if (level[v] < 0) bfs(v, id);
+				c.start = start;
+				c.v = queue;
+				start += (int)queue.size();
+				for (size_t j = 0; j < queue.size(); ++j) tag[queue[j]] = -1;
+				stack.push_back(c);
+			}
+			continue;
+		}
+
+		// find a pseudo-peripheral vertex (i.e. a vertex at the end of a long BFS path)
+		int root = g.v[0];
+		for (int iter = 0; iter < 5; ++iter)
+		{
+			// pick the vertex of smallest degree in the last level
+			int last = queue.back();
+			int dmin = xadj[last + 1] - xadj[last];
+			for (int i = (int)queue.size() - 1; (i >= 0) && (level[queue[i]] == nlevels - 1); --i)
+			{
+				int v = queue[i];
+				int d = xadj[v + 1] - xadj[v];
+				if (d < dmin) { dmin = d; last = v; }
+			}
+
+			for (int i = 0; i < ns; ++i) level[g.v[i]] = -1;
+			int nl = bfs(last, id);
+			if (nl <= nlevels)
+			{
+				// no improvement, so restore the previous level structure
+				for (int i = 0; i < ns; ++i) level[g.v[i]] = -1;
+				nlevels = bfs(root, id);
+				break;
+			}
+			root = last;
+			nlevels = nl;
+		}
+
+		// a (nearly) complete graph cannot be dissected
+		if (nlevels <= 2)
+		{
+			for (int i = 0; i < ns; ++i) perm[g.start + i] = g.v[i];
+			for (int i = 0; i < ns; ++i) tag[g.v[i]] = -1;
+			continue;
+		}
+
+		// find the middle level. This level cannot be the first or last level
+		std::vector<int> cnt(nlevels, 0);
+		for (int i = 0; i < ns; ++i) cnt[level[g.v[i]]]++;
+		int lsep = 0, sum = 0;
+		for (lsep = 0; lsep < nlevels; ++lsep)
+		{
+			sum += cnt[lsep];
+			if (2 * sum > ns) break;
+		}
+		if (lsep < 1) lsep = 1;
+		if (lsep > nlevels - 2) lsep = nlevels - 2;
+
+		// The separator consists of the vertices in the middle level that are 
+		// connected to the next level. The other vertices are added to the first part.
+		SubGraph a, b;
+		std::vector<int> sep;
+		for (int i = 0; i < ns; ++i)
+		{
+			int v = g.v[i];
+			int l = level[v];
+			if (l < lsep) a.v.push_back(v);
+			else if (l > lsep) b.v.push_back(v);
+			else
+			{
+				bool bsep = false;
+				for (int j = xadj[v]; j < xadj[v + 1]; ++j)
+				{
+					int w = adj[j];
+					if ((tag[w] == id) && (level[w] == lsep + 1)) { bsep = true; break; }
+				}
+				if (bsep) sep.push_back(v); else a.v.push_back(v);
+			}
+		}
+		for (int i = 0; i < ns; ++i) tag[g.v[i]] = -1;
+
+		// the separator is eliminated last
+		const int na = (int)a.v.size();
+		const int nb = (int)b.v.size();
+		for (size_t i = 0; i < sep.size(); ++i) perm[g.start + na + nb + i] = sep[i];
+
+		a.start = g.start;
+		b.start = g.start + na;
+		stack.push_back(a);
+		stack.push_back(b);
+	}
+}
+
+//-----------------------------------------------------------------------------
+BEGIN_FECORE_CLASS(SupernodalSolver, LinearSolver)
+	ADD_PARAMETER(m_ordering, "ordering", 0, "nested_dissection\0natural\0");
+	ADD_PARAMETER(m_pivotTol, FE_RANGE_GREATER_OR_EQUAL(0.0), "pivot_tol");
+END_FECORE_CLASS();
+
+//-----------------------------------------------------------------------------
+SupernodalSolver::SupernodalSolver(FEModel* fem) : LinearSolver(fem), m_pA(nullptr)
+{
+	m_bsymm = true;
+	m_ordering = ND_ORDERING;
+	m_pivotTol = 1e-14;
+	m_bsymbolic = false;
+	m_neq = 0;
+	m_pivotMin = 0.0;
+	m_perturbed = 0;
+	m_bzeroPivot = false;
+}
+
+//-----------------------------------------------------------------------------
+SupernodalSolver::~SupernodalSolver()
+{
+	Destroy();
+}
+
+//-----------------------------------------------------------------------------
+SparseMatrix* SupernodalSolver::CreateSparseMatrix(Matrix_Type ntype)
+{
+	// allocate the correct matrix format depending on matrix symmetry type
+	switch (ntype)
+	{
+	case REAL_SYMMETRIC     : m_bsymm = true ; m_pA = new CompactSymmMatrix(0); break;
+	case REAL_UNSYMMETRIC   : m_bsymm = false; m_pA = new CRSSparseMatrix(0); break;
+	case REAL_SYMM_STRUCTURE: m_bsymm = false; m_pA = new CRSSparseMatrix(0); break;
+	default:
+		assert(false);
+		m_pA = nullptr;
+	}
+	m_bsymbolic = false;
+
+	return m_pA;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::SetSparseMatrix(SparseMatrix* pA)
+{
+	Destroy();
+	m_pA = dynamic_cast<CompactMatrix*>(pA);
+	if (m_pA == nullptr) return false;
+	m_bsymm = m_pA->isSymmetric();
+	m_bsymbolic = false;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::SameProfile()
+{
+	if (m_bsymbolic == false) return false;
+
+	int neq = m_pA->Rows();
+	int nnz = m_pA->NonZeroes();
+	if ((neq != m_neq) || ((int)m_ptr.size() != neq + 1) || ((int)m_ind.size() != nnz)) return false;
+
+	int* ptr = m_pA->Pointers();
+	int* ind = m_pA->Indices();
+	for (int i = 0; i <= neq; ++i) if (ptr[i] != m_ptr[i]) return false;
+	for (int i = 0; i < nnz; ++i) if (ind[i] != m_ind[i]) return false;
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::PreProcess()
+{
+	if (m_pA == nullptr) return false;
+
+	// We can reuse the symbolic factorization if the profile did not change
+	if (SameProfile() == false)
+	{
+		if (SymbolicFactorization() == false) return false;
+	}
+
+	return LinearSolver::PreProcess();
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::SymbolicFactorization()
+{
+	m_bsymbolic = false;
+
+	const int n = m_pA->Rows();
+	const int nnz = m_pA->NonZeroes();
+	const int offset = m_pA->Offset();
+	const bool browBased = m_pA->isRowBased();
+	int* ptr = m_pA->Pointers();
+	int* ind = m_pA->Indices();
+	m_neq = n;
+
+	// store the profile so we can detect changes
+	m_ptr.assign(ptr, ptr + n + 1);
+	m_ind.assign(ind, ind + nnz);
+
+	// build the adjacency graph of A + A^T (without the diagonal)
+	std::vector<int> xadj(n + 1, 0), adj;
+	for (int i = 0; i < n; ++i)
+	{
+		for (int k = ptr[i] - offset; k < ptr[i + 1] - offset; ++k)
+		{
+			int j = ind[k] - offset;
+			if (j != i) { xadj[i + 1]++; xadj[j + 1]++; }
+		}
+	}
+	for (int i = 0; i < n; ++i) xadj[i + 1] += xadj[i];
+	adj.resize(xadj[n]);
+	{
+		std::vector<int> pos(xadj.begin(), xadj.end() - 1);
+		for (int i = 0; i < n; ++i)
+		{
+			for (int k = ptr[i] - offset; k < ptr[i + 1] - offset; ++k)
+			{
+				int j = ind[k] - offset;
+				if (j != i) { adj[pos[i]++] = j; adj[pos[j]++] = i; }
+			}
+		}
+
+		// remove duplicates (these appear for unsymmetric formats)
+		int m = 0;
+		for (int i = 0; i < n; ++i)
+		{
+			int k0 = xadj[i], k1 = xadj[i + 1];
+			std::sort(adj.begin() + k0, adj.begin() + k1);
+			xadj[i] = m;
+			for (int k = k0; k < k1; ++k)
+			{
+				if ((k == k0) || (adj[k] != adj[k - 1])) adj[m++] = adj[k];
+			}
+		}
+		xadj[n] = m;
+		adj.resize(m);
+	}
+
+	// fill-reducing ordering
+	std::vector<int> perm;
+	if (m_ordering == ND_ORDERING) nestedDissection(n, xadj, adj, perm);
+	else
+	{
+		perm.resize(n);
+		for (int i = 0; i < n; ++i) perm[i] = i;
+	}
+	std::vector<int> iperm(n);
+	for (int i = 0; i < n; ++i) iperm[perm[i]] = i;
+
+	// elimination tree (Liu's algorithm with path compression)
+	std::vector<int> parent(n, -1), ancestor(n, -1);
+	for (int k = 0; k < n; ++k)
+	{
+		int v = perm[k];
+		for (int j = xadj[v]; j < xadj[v + 1]; ++j)
+		{
+			int i = iperm[adj[j]];
+			while ((i != -1) && (i < k))
+			{
+				int inext = ancestor[i];
+				ancestor[i] = k;
+				if (inext == -1) parent[i] = k;
+				i = inext;
+			}
+		}
+	}
+
+	// postorder the elimination tree. This does not change the fill-in, but makes 
+	// sure that the columns of a supernode are numbered consecutively.
+	{
+		std::vector<int> head(n, -1), next(n, -1), post; post.reserve(n);
+		for (int j = n - 1; j >= 0; --j)
+		{
+			if (parent[j] != -1) { next[j] = head[parent[j]]; head[parent[j]] = j; }
+		}
+		std::vector<int> stack;
+		for (int j = 0; j < n; ++j)
+		{
+			if (parent[j] != -1) continue;
+			stack.push_back(j);
+			while (stack.empty() == false)
+			{
+				int p = stack.back();
+				int c = head[p];
+				if (c == -1) { stack.pop_back(); post.push_back(p); }
+				else { head[p] = next[c]; stack.push_back(c); }
+			}
+		}
+
+		std::vector<int> ipost(n);
+		for (int k = 0; k < n; ++k) ipost[post[k]] = k;
+
+		m_perm.resize(n);
+		std::vector<int> parent2(n);
+		for (int k = 0; k < n; ++k)
+		{
+			m_perm[k] = perm[post[k]];
+			int p = parent[post[k]];
+			parent2[k] = (p == -1 ? -1 : ipost[p]);
+		}
+		parent.swap(parent2);
+	}
+	m_iperm.resize(n);
+	for (int i = 0; i < n; ++i) m_iperm[m_perm[i]] = i;
+
+	// column counts (including the diagonal) from the row subtrees
+	std::vector<int> cc(n, 1), mark(n, -1), nchild(n, 0);
+	for (int i = 0; i < n; ++i)
+	{
+		if (parent[i] != -1) nchild[parent[i]]++;
+		mark[i] = i;
+		int v = m_perm[i];
+		for (int j = xadj[v]; j < xadj[v + 1]; ++j)
+		{
+			int k = m_iperm[adj[j]];
+			if (k > i) continue;
+			while (mark[k] != i)
+			{
+				mark[k] = i;
+				cc[k]++;
+				k = parent[k];
+			}
+		}
+	}
+
+	// fundamental supernodes
+	m_sfirst.clear();
+	std::vector<int> snode(n);
+	for (int j = 0; j < n; ++j)
+	{
+		if ((j == 0) || (parent[j - 1] != j) || (cc[j - 1] != cc[j] + 1) || (nchild[j] > 1))
+			m_sfirst.push_back(j);
+		snode[j] = (int)m_sfirst.size() - 1;
+	}
+	const int ns = (int)m_sfirst.size();
+	m_sfirst.push_back(n);
+
+	// supernodal tree
+	m_sparent.assign(ns, -1);
+	for (int s = 0; s < ns; ++s)
+	{
+		int l = m_sfirst[s + 1] - 1;
+		if (parent[l] != -1) m_sparent[s] = snode[parent[l]];
+	}
+	m_schildPtr.assign(ns + 1, 0);
+	for (int s = 0; s < ns; ++s) if (m_sparent[s] != -1) m_schildPtr[m_sparent[s] + 1]++;
+	for (int s = 0; s < ns; ++s) m_schildPtr[s + 1] += m_schildPtr[s];
+	m_schild.resize(m_schildPtr[ns]);
+	{
+		std::vector<int> pos(m_schildPtr.begin(), m_schildPtr.end() - 1);
+		for (int s = 0; s < ns; ++s) if (m_sparent[s] != -1) m_schild[pos[m_sparent[s]]++] = s;
+	}
+
+	// row structure of supernodes
+	m_srowPtr.assign(ns + 1, 0);
+	for (int s = 0; s < ns; ++s) m_srowPtr[s + 1] = m_srowPtr[s] + cc[m_sfirst[s]];
+	m_srow.resize(m_srowPtr[ns]);
+	mark.assign(n, -1);
+	std::vector<int> tmp;
+	for (int s = 0; s < ns; ++s)
+	{
+		const int f = m_sfirst[s], l = m_sfirst[s + 1] - 1;
+		tmp.clear();
+		for (int j = f; j <= l; ++j) mark[j] = s;
+
+		// rows from A
+		for (int j = f; j <= l; ++j)
+		{
+			int v = m_perm[j];
+			for (int k = xadj[v]; k < xadj[v + 1]; ++k)
+			{
+				int i = m_iperm[adj[k]];
+				if ((i > l) && (mark[i] != s)) { mark[i] = s; tmp.push_back(i); }
+			}
+		}
+
+		// rows from the children's update matrices
+		for (int c = m_schildPtr[s]; c < m_schildPtr[s + 1]; ++c)
+		{
+			int sc = m_schild[c];
+			int kc = m_sfirst[sc + 1] - m_sfirst[sc];
+			for (int r = m_srowPtr[sc] + kc; r < m_srowPtr[sc + 1]; ++r)
+			{
+				int i = m_srow[r];
+				if ((i > l) && (mark[i] != s)) { mark[i] = s; tmp.push_back(i); }
+			}
+		}
+		std::sort(tmp.begin(), tmp.end());
+
+		int m = (l - f + 1) + (int)tmp.size();
+		if (m != m_srowPtr[s + 1] - m_srowPtr[s])
+		{
+			feLogError("Symbolic factorization failed.");
+			return false;
+		}
+
+		int* rows = &m_srow[m_srowPtr[s]];
+		for (int j = f; j <= l; ++j) *rows++ = j;
+		for (size_t i = 0; i < tmp.size(); ++i) *rows++ = tmp[i];
+	}
+
+	// relative indices of the update rows in the parent's row structure
+	std::vector<int>& pos = mark;
+	m_relPtr.assign(ns + 1, 0);
+	for (int s = 0; s < ns; ++s)
+	{
+		int k = m_sfirst[s + 1] - m_sfirst[s];
+		int m = m_srowPtr[s + 1] - m_srowPtr[s];
+		m_relPtr[s + 1] = m_relPtr[s] + (m - k);
+	}
+	m_rel.resize(m_relPtr[ns]);
+	for (int p = 0; p < ns; ++p)
+	{
+		for (int r = m_srowPtr[p]; r < m_srowPtr[p + 1]; ++r) pos[m_srow[r]] = r - m_srowPtr[p];
+		for (int c = m_schildPtr[p]; c < m_schildPtr[p + 1]; ++c)
+		{
+			int sc = m_schild[c];
+			int kc = m_sfirst[sc + 1] - m_sfirst[sc];
+			int* rel = &m_rel[m_relPtr[sc]];
+			for (int r = m_srowPtr[sc] + kc; r < m_srowPtr[sc + 1]; ++r) *rel++ = pos[m_srow[r]];
+		}
+	}
+
+	// map the entries of A to the fronts
+	m_aPtr.assign(ns + 1, 0);
+	std::vector<int> as(nnz);
+	for (int i = 0; i < n; ++i)
+	{
+		for (int k = ptr[i] - offset; k < ptr[i + 1] - offset; ++k)
+		{
+			int j = ind[k] - offset;
+			int b = std::min(m_iperm[i], m_iperm[j]);
+			as[k] = snode[b];
+			m_aPtr[as[k] + 1]++;
+		}
+	}
+	for (int s = 0; s < ns; ++s) m_aPtr[s + 1] += m_aPtr[s];
+	m_aIndex.resize(nnz);
+	{
+		std::vector<int> apos(m_aPtr.begin(), m_aPtr.end() - 1);
+		for (int k = 0; k < nnz; ++k) m_aIndex[apos[as[k]]++] = k;
+	}
+	m_aRow.resize(nnz);
+	m_aCol.resize(nnz);
+	{
+		// row index of each entry
+		std::vector<int> arow(nnz);
+		for (int i = 0; i < n; ++i)
+			for (int k = ptr[i] - offset; k < ptr[i + 1] - offset; ++k) arow[k] = i;
+
+		for (int s = 0; s < ns; ++s)
+		{
+			for (int r = m_srowPtr[s]; r < m_srowPtr[s + 1]; ++r) pos[m_srow[r]] = r - m_srowPtr[s];
+			for (int q = m_aPtr[s]; q < m_aPtr[s + 1]; ++q)
+			{
+				int k = m_aIndex[q];
+				// for row-based formats, the pointer index is the row
+				int I = (browBased ? arow[k] : ind[k] - offset);
+				int J = (browBased ? ind[k] - offset : arow[k]);
+				int ir = m_iperm[I], jc = m_iperm[J];
+
+				// symmetric matrices only store one triangle; we use the lower one.
+				if (m_bsymm && (ir < jc)) std::swap(ir, jc);
+				m_aRow[q] = pos[ir];
+				m_aCol[q] = pos[jc];
+			}
+		}
+	}
+
+	// group the supernodes by their height in the tree
+	std::vector<int> height(ns, 0);
+	int maxHeight = 0;
+	for (int s = 0; s < ns; ++s)
+	{
+		int p = m_sparent[s];
+		if ((p != -1) && (height[p] < height[s] + 1)) height[p] = height[s] + 1;
+		if (height[s] > maxHeight) maxHeight = height[s];
+	}
+	m_levelPtr.assign(maxHeight + 2, 0);
+	for (int s = 0; s < ns; ++s) m_levelPtr[height[s] + 1]++;
+	for (int i = 0; i <= maxHeight; ++i) m_levelPtr[i + 1] += m_levelPtr[i];
+	m_level.resize(ns);
+	{
+		std::vector<int> lpos(m_levelPtr.begin(), m_levelPtr.end() - 1);
+		for (int s = 0; s < ns; ++s) m_level[lpos[height[s]]++] = s;
+	}
+
+	// storage for the factors
+	m_Lptr.assign(ns + 1, 0);
+	m_Uptr.assign(ns + 1, 0);
+	double flops = 0.0;
+	for (int s = 0; s < ns; ++s)
+	{
+		size_t k = m_sfirst[s + 1] - m_sfirst[s];
+		size_t m = m_srowPtr[s + 1] - m_srowPtr[s];
+		m_Lptr[s + 1] = m_Lptr[s] + m*k;
+		m_Uptr[s + 1] = m_Uptr[s] + (m_bsymm ? 0 : k*(m - k));
+		for (size_t j = 0; j < k; ++j) { double r = (double)(m - j - 1); flops += (m_bsymm ? r*r : 2.0*r*r); }
+	}
+
+	size_t nnzL = 0;
+	for (int j = 0; j < n; ++j) nnzL += cc[j];
+
+	feLog("\tNr of supernodes .......................... : %d\n", ns);
+	feLog("\tNr of nonzeroes in factor ................. : %.0lf\n", (double)nnzL);
+	feLog("\tFlops for factorization (est.) ............ : %lg\n", flops);
+
+	m_bsymbolic = true;
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::Factor()
+{
+	if (m_pA == nullptr) return false;
+	if (m_neq == 0) return true;
+	if (m_bsymbolic == false) return false;
+
+	const int ns = (int)m_sfirst.size() - 1;
+	m_L.assign(m_Lptr[ns], 0.0);
+	m_U.assign(m_Uptr[ns], 0.0);
+	m_upd.assign(ns, std::vector<double>());
+
+	// tiny pivots are perturbed relative to the largest matrix entry
+	double amax = 0.0;
+	double* pv = m_pA->Values();
+	const int nnz = m_pA->NonZeroes();
+	for (int i = 0; i < nnz; ++i) if (fabs(pv[i]) > amax) amax = fabs(pv[i]);
+	m_pivotMin = m_pivotTol*amax;
+	m_perturbed = 0;
+	m_bzeroPivot = false;
+
+	// Supernodes at the same height do not depend on each other. Levels that have
+	// fewer supernodes than threads are done one at a time, with the threads working on
+	// the dense update instead. This is usually the case near the root of the tree.
+	const int nthreads = omp_get_max_threads();
+	const int nlevels = (int)m_levelPtr.size() - 1;
+	for (int l = 0; l < nlevels; ++l)
+	{
+		const int n0 = m_levelPtr[l];
+		const int n1 = m_levelPtr[l + 1];
+		if (n1 - n0 >= nthreads)
+		{
+			#pragma omp parallel for schedule(dynamic)
+			for (int i = n0; i < n1; ++i) FactorSupernode(m_level[i], false);
+		}
+		else
+		{
+			for (int i = n0; i < n1; ++i) FactorSupernode(m_level[i], true);
+		}
+	}
+	m_upd.clear();
+
+	if (m_bzeroPivot)
+	{
+		feLogError("Zero pivot encountered during factorization.");
+		return false;
+	}
+
+	if (m_perturbed > 0)
+	{
+		feLogWarning("%d pivots were perturbed during factorization.", m_perturbed);
+	}
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Assemble the frontal matrix of supernode s, do the partial factorization of its
+// pivot columns, and store the Schur complement as update matrix for the parent.
+void SupernodalSolver::FactorSupernode(int s, bool bparallel)
+{
+	const int k = m_sfirst[s + 1] - m_sfirst[s];
+	const int m = m_srowPtr[s + 1] - m_srowPtr[s];
+	const int nu = m - k;
+
+	// assemble the front (column major)
+	std::vector<double> F((size_t)m*m, 0.0);
+	const double* pv = m_pA->Values();
+	for (int q = m_aPtr[s]; q < m_aPtr[s + 1]; ++q)
+	{
+		F[m_aRow[q] + (size_t)m_aCol[q]*m] += pv[m_aIndex[q]];
+	}
+
+	// extend-add the update matrices of the children
+	for (int c = m_schildPtr[s]; c < m_schildPtr[s + 1]; ++c)
+	{
+		int sc = m_schild[c];
+		std::vector<double>& U = m_upd[sc];
+		const int* rel = &m_rel[m_relPtr[sc]];
+		const int nc = m_relPtr[sc + 1] - m_relPtr[sc];
+		for (int j = 0; j < nc; ++j)
+		{
+			double* Fj = &F[(size_t)rel[j]*m];
+			const double* Uj = &U[(size_t)j*nc];
+			for (int i = (m_bsymm ? j : 0); i < nc; ++i) Fj[rel[i]] += Uj[i];
+		}
+		std::vector<double>().swap(U);
+	}
+
+	// partial factorization of the pivot columns
+	for (int j = 0; j < k; ++j)
+	{
+		double* Fj = &F[(size_t)j*m];
+		double d = Fj[j];
+		if (fabs(d) <= m_pivotMin)
+		{
+			// we can't continue with a zero pivot, but we don't want to 
+			// create NANs either.
+			if (m_pivotMin == 0.0) { m_bzeroPivot = true; d = 1.0; }
+			else d = (d >= 0.0 ? m_pivotMin : -m_pivotMin);
+			Fj[j] = d;
+			#pragma omp atomic
+			m_perturbed++;
+		}
+
+		if (m_bsymm)
+		{
+			// update the remaining pivot columns (lower triangle only)
+			for (int c = j + 1; c < k; ++c)
+			{
+				double* Fc = &F[(size_t)c*m];
+				double w = Fj[c] / d;
+				if (w == 0.0) continue;
+				for (int r = c; r < m; ++r) Fc[r] -= Fj[r] * w;
+			}
+			for (int r = j + 1; r < m; ++r) Fj[r] /= d;
+		}
+		else
+		{
+			for (int r = j + 1; r < m; ++r) Fj[r] /= d;
+
+			// update the remaining pivot columns, and the pivot rows of the other columns
+			for (int c = j + 1; c < m; ++c)
+			{
+				double* Fc = &F[(size_t)c*m];
+				double u = Fc[j];
+				if (u == 0.0) continue;
+				int r1 = (c < k ? m : k);
+				for (int r = j + 1; r < r1; ++r) Fc[r] -= Fj[r] * u;
+			}
+		}
+	}
+
+	// update the trailing block (i.e. the Schur complement)
+	if (nu > 0)
+	{
+		std::vector<double>& U = m_upd[s];
+		U.assign((size_t)nu*nu, 0.0);
+		const bool bsymm = m_bsymm;
+		#pragma omp parallel for schedule(dynamic, 8) if(bparallel && (nu > 64))
+		for (int c = 0; c < nu; ++c)
+		{
+			double* Uc = &U[(size_t)c*nu];
+			const double* Fc = &F[(size_t)(k + c)*m + k];
+			int r0 = (bsymm ? c : 0);
+			for (int r = r0; r < nu; ++r) Uc[r] = Fc[r];
+
+			for (int p = 0; p < k; ++p)
+			{
+				const double* Lp = &F[(size_t)p*m + k];
+				double w = (bsymm ? Lp[c] * F[(size_t)p*m + p] : F[(size_t)(k + c)*m + p]);
+				if (w == 0.0) continue;
+				for (int r = r0; r < nu; ++r) Uc[r] -= Lp[r] * w;
+			}
+		}
+	}
+
+	// store the factors
+	double* L = &m_L[m_Lptr[s]];
+	for (size_t i = 0; i < (size_t)m*k; ++i) L[i] = F[i];
+	if (m_bsymm == false)
+	{
+		double* Us = &m_U[m_Uptr[s]];
+		for (int c = 0; c < nu; ++c)
+			for (int r = 0; r < k; ++r) Us[r + (size_t)c*k] = F[r + (size_t)(k + c)*m];
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool SupernodalSolver::BackSolve(double* x, double* b)
+{
+	const int n = m_neq;
+	if (n == 0) return true;
+
+	std::vector<double> y(n);
+	for (int i = 0; i < n; ++i) y[i] = b[m_perm[i]];
+
+	const int ns = (int)m_sfirst.size() - 1;
+
+	// forward substitution (unit lower triangular)
+	for (int s = 0; s < ns; ++s)
+	{
+		const int f = m_sfirst[s];
+		const int k = m_sfirst[s + 1] - f;
+		const int m = m_srowPtr[s + 1] - m_srowPtr[s];
+		const int* rows = &m_srow[m_srowPtr[s]];
+		const double* L = &m_L[m_Lptr[s]];
+		for (int j = 0; j < k; ++j)
+		{
+			double yj = y[f + j];
+			if (yj == 0.0) continue;
+			const double* Lj = L + (size_t)j*m;
+			for (int r = j + 1; r < m; ++r) y[rows[r]] -= Lj[r] * yj;
+		}
+	}
+
+	if (m_bsymm)
+	{
+		// diagonal
+		for (int s = 0; s < ns; ++s)
+		{
+			const int f = m_sfirst[s];
+			const int k = m_sfirst[s + 1] - f;
+			const int m = m_srowPtr[s + 1] - m_srowPtr[s];
+			const double* L = &m_L[m_Lptr[s]];
+			for (int j = 0; j < k; ++j) y[f + j] /= L[j + (size_t)j*m];
+		}
+
+		// backward substitution (L^T)
+		for (int s = ns - 1; s >= 0; --s)
+		{
+			const int f = m_sfirst[s];
+			const int k = m_sfirst[s + 1] - f;
+			const int m = m_srowPtr[s + 1] - m_srowPtr[s];
+			const int* rows = &m_srow[m_srowPtr[s]];
+			const double* L = &m_L[m_Lptr[s]];
+			for (int j = k - 1; j >= 0; --j)
+			{
+				const double* Lj = L + (size_t)j*m;
+				double t = y[f + j];
+				for (int r = j + 1; r < m; ++r) t -= Lj[r] * y[rows[r]];
+				y[f + j] = t;
+			}
+		}
+	}
+	else
+	{
+		// backward substitution (U)
+		for (int s = ns - 1; s >= 0; --s)
+		{
+			const int f = m_sfirst[s];
+			const int k = m_sfirst[s + 1] - f;
+			const int m = m_srowPtr[s + 1] - m_srowPtr[s];
+			const int* rows = &m_srow[m_srowPtr[s]];
+			const double* L = &m_L[m_Lptr[s]];
+			const double* U = &m_U[m_Uptr[s]];
+			for (int j = k - 1; j >= 0; --j)
+			{
+				double t = y[f + j];
+				for (int c = k; c < m; ++c) t -= U[j + (size_t)(c - k)*k] * y[rows[c]];
+				for (int c = j + 1; c < k; ++c) t -= L[j + (size_t)c*m] * y[f + c];
+				y[f + j] = t / L[j + (size_t)j*m];
+			}
+		}
+	}
+
+	for (int i = 0; i < n; ++i) x[m_perm[i]] = y[i];
+
+	// update stats
+	UpdateStats(1);
+
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+size_t SupernodalSolver::MemoryUsage()
+{
+	// symbolic factorization
+	size_t bytes = 0;
+	bytes += fecore_memory_size(m_ptr) + fecore_memory_size(m_ind);
+	bytes += fecore_memory_size(m_perm) + fecore_memory_size(m_iperm);
+	bytes += fecore_memory_size(m_sfirst) + fecore_memory_size(m_sparent);
+	bytes += fecore_memory_size(m_schildPtr) + fecore_memory_size(m_schild);
+	bytes += fecore_memory_size(m_srowPtr) + fecore_memory_size(m_srow);
+	bytes += fecore_memory_size(m_relPtr) + fecore_memory_size(m_rel);
+	bytes += fecore_memory_size(m_aPtr) + fecore_memory_size(m_aIndex) + fecore_memory_size(m_aRow) + fecore_memory_size(m_aCol);
+	bytes += fecore_memory_size(m_levelPtr) + fecore_memory_size(m_level);
+
+	// numerical factorization
+	bytes += fecore_memory_size(m_Lptr) + fecore_memory_size(m_L);
+	bytes += fecore_memory_size(m_Uptr) + fecore_memory_size(m_U);
+	for (size_t i = 0; i < m_upd.size(); ++i) bytes += fecore_memory_size(m_upd[i]);
+
+	return bytes;
+}
+
+//-----------------------------------------------------------------------------
+void SupernodalSolver::Destroy()
+{
+	// We only release the numerical factorization. The symbolic factorization
+	// is kept so that it can be reused if the matrix profile does not change.
+	std::vector<double>().swap(m_L);
+	std::vector<double>().swap(m_U);
+	m_upd.clear();
+	LinearSolver::Destroy();
+}
@@ -0,0 +1,121 @@
+/*This file is part of the FEBio source code and is licensed under the MIT license
+listed below.
+
+See Copyright-FEBio.txt for details.
+
+Copyright (c) 2021 University of Utah, The Trustees of Columbia University in
+the City of New York, and others.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.*/
+
+
+
+#pragma once
+#include <FECore/LinearSolver.h>
+#include <FECore/CompactMatrix.h>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+//! Sparse direct solver based on a supernodal multifrontal factorization.
+
+//! Symmetric matrices are factored as L*D*L^T, unsymmetric matrices as L*U, using
+//! the symmetrized sparsity pattern. The equations are reordered with nested
+//! dissection to reduce fill-in. The supernodes at the same level of the assembly
+//! tree are factored in parallel. No numerical pivoting is done (as with the
+//! skyline solver), but tiny pivots are perturbed.
+//! The symbolic factorization is only redone when the matrix profile changes.
+class SupernodalSolver : public LinearSolver
+{
+	enum { ND_ORDERING, NATURAL_ORDERING };
+
+public:
+	//! constructor
+	SupernodalSolver(FEModel* fem);
+
+	//! destructor
+	~SupernodalSolver();
+
+	//! Pre-process data (does the ordering and symbolic factorization)
+	bool PreProcess() override;
+
+	//! Factor matrix
+	bool Factor() override;
+
+	//! solve using factored matrix
+	bool BackSolve(double* x, double* b) override;
+
+	//! Clean-up (keeps the symbolic factorization)
+	void Destroy() override;
+
+	//! memory used by the symbolic and numerical factorization
+	size_t MemoryUsage() override;
+
+	//! Create a sparse matrix
+	SparseMatrix* CreateSparseMatrix(Matrix_Type ntype) override;
+
+	//! Set the sparse matrix
+	bool SetSparseMatrix(SparseMatrix* pA) override;
+
+private:
+	// see if the matrix profile is the same as for the last symbolic factorization
+	bool SameProfile();
+
+	// do the reordering and symbolic factorization
+	bool SymbolicFactorization();
+
+	// factor a supernode 
+	void FactorSupernode(int s, bool bparallel);
+
+private:
+	CompactMatrix*	m_pA;		//!< the sparse matrix
+	bool			m_bsymm;	//!< symmetric (LDLt) or unsymmetric (LU) factorization
+
+	// parameters
+	int		m_ordering;		//!< fill-reducing ordering
+	double	m_pivotTol;		//!< relative tolerance for pivot perturbation
+
+	// profile of the matrix that was used for the symbolic factorization
+	std::vector<int>	m_ptr;
+	std::vector<int>	m_ind;
+	bool				m_bsymbolic;
+
+	// symbolic factorization
+	int					m_neq;		//!< number of equations
+	std::vector<int>	m_perm;		//!< new-to-old equation index
+	std::vector<int>	m_iperm;	//!< old-to-new equation index
+	std::vector<int>	m_sfirst;	//!< first column of each supernode
+	std::vector<int>	m_sparent;	//!< parent supernode (or -1)
+	std::vector<int>	m_schildPtr, m_schild;	//!< children of each supernode
+	std::vector<int>	m_srowPtr, m_srow;		//!< row structure of each supernode
+	std::vector<int>	m_relPtr, m_rel;		//!< position of update rows in the parent's row structure
+	std::vector<int>	m_aPtr, m_aIndex, m_aRow, m_aCol;	//!< assembly map from A into the fronts
+	std::vector<int>	m_levelPtr, m_level;	//!< supernodes grouped by height in the assembly tree
+
+	// numerical factorization
+	std::vector<size_t>	m_Lptr;		//!< offset of the L-block of each supernode
+	std::vector<double>	m_L;		//!< L-blocks (column major, includes diagonal block)
+	std::vector<size_t>	m_Uptr;		//!< offset of the U-block of each supernode (LU only)
+	std::vector<double>	m_U;		//!< off-diagonal U-blocks (LU only)
+	std::vector< std::vector<double> >	m_upd;	//!< update matrices passed to parents
+	double	m_pivotMin;		//!< pivots smaller than this are perturbed
+	int		m_perturbed;	//!< nr of perturbed pivots
+	bool	m_bzeroPivot;	//!< a zero pivot was found
+
+	DECLARE_FECORE_CLASS();
+};